@@ -22,6 +22,7 @@
 
 #include <ajtcl/services/ServicesCommon.h>
 #include <ajtcl/alljoyn.h>
+#include <ajtcl/cdm/interfaces/CdmInterfaceErrors.h>
 
 typedef enum { false, true } bool;
 
@@ -95,6 +96,62 @@ typedef struct {
     uint32_t member_index_mask;
 } CdmPropertiesChangedByMethod;
 
+/**
+ * Policy for a property value written by a controller which violates the range, step or selectable values of the property
+ */
+typedef enum {
+    CDM_CONSTRAINT_POLICY_REJECT    = 0,    // reply with an error
+    CDM_CONSTRAINT_POLICY_SNAP      = 1,    // adjust the value to the nearest allowed value
+} CdmConstraintPolicy;
+
+/**
+ * Delivery of PropertiesChanged signals of an object
+ */
+typedef enum {
+    CDM_PROP_CHANGED_BROADCAST      = 0,    // global broadcast
+    CDM_PROP_CHANGED_SESSIONS       = 1,    // sent in each joined session, not sent if no session is joined
+} CdmPropChangedDelivery;
+
+/**
+ * Source of a property value replied to Get requests
+ */
+typedef enum {
+    CDM_PROPERTY_SOURCE_PULL        = 0,    // call the OnGet listener on every Get
+    CDM_PROPERTY_SOURCE_PUSH        = 1,    // reply the stored value, the application keeps it up to date by the Set API
+    CDM_PROPERTY_SOURCE_PULL_TTL    = 2,    // call the OnGet listener at most once per period, reply the stored value in between
+} CdmPropertySource;
+
+/**
+ * Listener latency statistics of an interface
+ */
+typedef struct {
+    uint32_t calls;         // timed listener calls
+    uint32_t overruns;      // calls which took longer than the budget
+    uint32_t maxLatency;    // longest call in ms
+} CdmLatencyStats;
+
+/**
+ * No allocation budget, given to Cdm_SetAllocBudget to stop checking
+ */
+#define CDM_ALLOC_BUDGET_NONE 0xFFFFFFFF
+
+/**
+ * Allocation statistics of an interface. Allocations are counted in the builds with CDM_ALLOC_TRACKING only.
+ */
+typedef struct {
+    uint32_t operations;    // Get, Set and method calls dispatched
+    uint32_t allocs;        // malloc, calloc and realloc calls
+    uint32_t frees;         // free calls
+    uint32_t bytes;         // bytes requested
+    uint32_t maxAllocs;     // most allocations of an operation
+    uint32_t overruns;      // operations which allocated more than the budget
+} CdmAllocStats;
+
+/**
+ * Token of a deferred reply
+ */
+typedef uint32_t CdmReplyToken;
+
 /**
  * Vendor defined interface handler
  */
@@ -183,6 +240,54 @@ void Cdm_Deinit();
  */
 AJ_Status Cdm_CreateInterface(CdmInterfaceTypes intfType, const char* objPath, void* listener);
 
+/**
+ * Set constraint policy of the interface.
+ * The policy applies to property values written by controllers. Values set by the application
+ * are always rejected if invalid. Supported by TargetTemperature, TargetTemperatureLevel, TargetHumidity
+ * and WindDirection, which snap by default, and FanSpeedLevel and MoistureOutputLevel, which reject by default.
+ * @param[in] objPath the object path including the interface
+ * @param[in] intfType interface type
+ * @param[in] policy constraint policy
+ * @return AJ_OK on success, AJ_ERR_NO_MATCH if the interface is not created, AJ_ERR_INVALID if the interface has no constrained property
+ */
+AJ_Status Cdm_SetConstraintPolicy(const char* objPath, CdmInterfaceTypes intfType, CdmConstraintPolicy policy);
+
+/**
+ * Set delivery of PropertiesChanged signals of the object. The default is CDM_PROP_CHANGED_BROADCAST.
+ * CDM_PROP_CHANGED_SESSIONS requires the application to report accepted sessions by Cdm_SessionJoined.
+ * @param[in] objPath the object path
+ * @param[in] delivery delivery
+ * @return AJ_OK on success, AJ_ERR_NO_MATCH if no interface is created on the object
+ */
+AJ_Status Cdm_SetPropertiesChangedDelivery(const char* objPath, CdmPropChangedDelivery delivery);
+
+/**
+ * Set source of a property value replied to Get requests. The default is CDM_PROPERTY_SOURCE_PULL.
+ * While the listener is not called, OnGetProperty of a vendor defined interface handler gets NULL listener.
+ * @param[in] objPath the object path
+ * @param[in] intfType interface type
+ * @param[in] propName property name, NULL for all properties of the interface
+ * @param[in] source property source
+ * @param[in] ttl period in milliseconds of CDM_PROPERTY_SOURCE_PULL_TTL, ignored otherwise
+ * @return AJ_OK on success, AJ_ERR_NO_MATCH if the interface is not created or has no such property
+ */
+AJ_Status Cdm_SetPropertySource(const char* objPath, CdmInterfaceTypes intfType, const char* propName, CdmPropertySource source, uint32_t ttl);
+
+/**
+ * Report a session accepted by the application, used for CDM_PROP_CHANGED_SESSIONS delivery.
+ * Lost sessions are removed by Cdm_MessageProcessor.
+ * If more sessions are joined than can be tracked, signals are broadcast until sessions are lost.
+ * @param[in] sessionId session id
+ * @return AJ_OK on success
+ */
+AJ_Status Cdm_SessionJoined(uint32_t sessionId);
+
+/**
+ * Report a lost session. Should be called with 0 when the bus is disconnected.
+ * @param[in] sessionId session id, 0 for all sessions
+ */
+void Cdm_SessionLost(uint32_t sessionId);
+
 /**
  * Start CDM service framework.
  * Objects with interfaces are registered.
@@ -190,6 +295,27 @@ AJ_Status Cdm_CreateInterface(CdmInterfaceTypes intfType, const char* objPath, v
  */
 AJ_Status Cdm_Start();
 
+/**
+ * Save the property values of all created interfaces to NVRAM.
+ * The image is versioned and written in native byte order.
+ * Vendor defined interfaces and description catalogs are not saved.
+ * @param[in] nvramId NVRAM id of the snapshot, between AJ_NVRAM_ID_APPS_BEGIN and AJ_NVRAM_ID_APPS_END
+ * @return AJ_OK on success
+ */
+AJ_Status Cdm_SaveSnapshot(const uint16_t nvramId);
+
+/**
+ * Restore property values saved by Cdm_SaveSnapshot without emitting PropertiesChanged.
+ * Must be called after the interfaces are created and before Cdm_Start.
+ * Records of objects or interfaces which are not created are skipped. A record which does not match
+ * the current property layout leaves that interface untouched, and the other records are still loaded.
+ * Description catalogs should be registered after loading.
+ * @param[in] nvramId NVRAM id of the snapshot
+ * @return AJ_OK on success, AJ_ERR_NO_MATCH if there is no snapshot, AJ_ERR_DISALLOWED after Cdm_Start,
+ *         AJ_ERR_INVALID if the image is not valid or some records do not match the property layout
+ */
+AJ_Status Cdm_LoadSnapshot(const uint16_t nvramId);
+
 /**
  * Enable security.
  * @param[in] busAttachment bus attachment
@@ -210,6 +336,78 @@ AJ_Status Cdm_EnableSecurity(AJ_BusAttachment* busAttachment, const uint32_t* su
  */
 AJSVC_ServiceStatus Cdm_MessageProcessor(AJ_BusAttachment* busAttachment, AJ_Message* msg, AJ_Status* status);
 
+/**
+ * Run expired timers of the CDM timer wheel, which drives the Timer interface countdown and timers registered by the application.
+ * Should be called from the message loop, also when no message is received. See Cdm_TimerWheelGetTimeout for the loop timeout.
+ * @param[in] busAttachment bus attachment
+ */
+void Cdm_ProcessTimers(AJ_BusAttachment* busAttachment);
+
+/**
+ * Set latency budget of the listener calls of an interface. OnGetProperty, OnSetProperty and OnMethodHandler dispatch
+ * is timed for built-in and vendor defined interfaces, and calls which take longer than the budget are logged and counted.
+ * Setting the budget clears the statistics.
+ * @param[in] objPath the object path
+ * @param[in] intfType interface type
+ * @param[in] budget budget in ms, 0 to stop timing
+ * @param[in] switchToPush true to switch a property whose OnGet listener overruns the budget to CDM_PROPERTY_SOURCE_PUSH
+ * @return AJ_OK on success, AJ_ERR_NO_MATCH if the interface is not created
+ */
+AJ_Status Cdm_SetLatencyBudget(const char* objPath, CdmInterfaceTypes intfType, uint32_t budget, bool switchToPush);
+
+/**
+ * Get listener latency statistics of an interface
+ * @param[in] objPath the object path
+ * @param[in] intfType interface type
+ * @param[out] stats statistics since the budget was set
+ * @return AJ_OK on success, AJ_ERR_NO_MATCH if the interface is not created
+ */
+AJ_Status Cdm_GetLatencyStats(const char* objPath, CdmInterfaceTypes intfType, CdmLatencyStats* stats);
+
+/**
+ * Set allocation budget of the operations of an interface. The allocations made while Cdm_MessageProcessor dispatches
+ * a Get, a Set or a method call, including the reply and the PropertiesChanged signals, are counted for the interface,
+ * and operations which allocate more than the budget are logged and counted. Setting the budget clears the statistics.
+ * @param[in] objPath the object path
+ * @param[in] intfType interface type
+ * @param[in] budget allocations per operation, CDM_ALLOC_BUDGET_NONE to stop checking
+ * @return AJ_OK on success, AJ_ERR_NO_MATCH if the interface is not created
+ */
+AJ_Status Cdm_SetAllocBudget(const char* objPath, CdmInterfaceTypes intfType, uint32_t budget);
+
+/**
+ * Get allocation statistics of an interface
+ * @param[in] objPath the object path
+ * @param[in] intfType interface type
+ * @param[out] stats statistics since the interface was created or the budget was set
+ * @return AJ_OK on success, AJ_ERR_NO_MATCH if the interface is not created
+ */
+AJ_Status Cdm_GetAllocStats(const char* objPath, CdmInterfaceTypes intfType, CdmAllocStats* stats);
+
+/**
+ * Defer the reply of the request being processed, to complete it later by Cdm_CompleteReply.
+ * Call it from an OnGet listener, or from the listener of SwitchOn, SwitchOff, ExecuteOperationalCommand,
+ * SetTargetTimeToStart, SetTargetTimeToStop, AcknowledgeAlert, AcknowledgeAllAlerts or ResetCumulativeEnergy,
+ * and return AJ_OK.
+ * The OnGet listeners called for Properties.GetAll cannot defer, and reply the value themselves.
+ * While the reply is deferred, the state change which the method would apply on success is left to the application.
+ * A deferred reply which is not completed within CDM_DEFERRED_REPLY_TIMEOUT ms is replied with a timeout error by Cdm_ProcessTimers.
+ * @param[out] token reply token
+ * @return AJ_OK on success, AJ_ERR_DISALLOWED if the reply of the request cannot be deferred,
+ *         AJ_ERR_RESOURCES if CDM_MAX_DEFERRED_REPLIES replies are already deferred
+ */
+AJ_Status Cdm_DeferReply(CdmReplyToken* token);
+
+/**
+ * Complete a deferred reply. A property Get is replied with the stored value, which the deferring OnGet listener
+ * does not change, so update it by the Set API first.
+ * @param[in] busAttachment bus attachment
+ * @param[in] token reply token given by Cdm_DeferReply
+ * @param[in] errorCode NOT_ERROR to reply success, otherwise the error to reply
+ * @return AJ_OK on success, AJ_ERR_NO_MATCH if the token is unknown, completed or timed out
+ */
+AJ_Status Cdm_CompleteReply(AJ_BusAttachment* busAttachment, CdmReplyToken token, ErrorCode errorCode);
+
 /**
  * Register vendor defined interface.
  * @param[in] intfName vendor defined interface name
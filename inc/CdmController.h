@@ -0,0 +1,241 @@
+/**
+ * @file
+ */
+/******************************************************************************
+ * Copyright AllSeen Alliance. All rights reserved.
+ *
+ *    Permission to use, copy, modify, and/or distribute this software for any
+ *    purpose with or without fee is hereby granted, provided that the above
+ *    copyright notice and this permission notice appear in all copies.
+ *
+ *    THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ *    WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ *    ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ *    WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ *    ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ *    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ ******************************************************************************/
+
+
+#ifndef CDMCONTROLLER_H_
+#define CDMCONTROLLER_H_
+
+#include <ajtcl/services/ServicesCommon.h>
+#include <ajtcl/alljoyn.h>
+#include <ajtcl/cdm/CdmControllee.h>
+
+/**
+ * Object list index of the proxy objects of remote CDM objects
+ */
+#ifndef CDM_CONTROLLER_OBJECTS_LIST_INDEX
+#define CDM_CONTROLLER_OBJECTS_LIST_INDEX (AJAPP_OBJECTS_LIST_INDEX + 1)
+#endif
+
+/**
+ * Timeout in ms of the GetAll calls which sync the property cache
+ */
+#ifndef CDM_CONTROLLER_CALL_TIMEOUT
+#define CDM_CONTROLLER_CALL_TIMEOUT 10000
+#endif
+
+/**
+ * Handler of an object found by Cdm_ControllerFindObjects
+ * @param[in] busName bus name of the device
+ * @param[in] objPath the object path
+ * @param[in] context context passed to Cdm_ControllerFindObjects
+ */
+typedef void (*CdmObjectFoundHandler)(const char* busName, const char* objPath, void* context);
+
+/**
+ * Controller listener. Any callback may be NULL.
+ */
+typedef struct {
+    /**
+     * Handler called when an unknown device announces CDM interfaces
+     * @param[in] busName bus name of the device
+     * @param[in] port session port of the device
+     * @return true to join a session and sync the properties of the device, false to ignore the device until it announces again
+     */
+    bool (*OnDeviceFound)(const char* busName, uint16_t port);
+
+    /**
+     * Handler called when all properties of a remote interface are cached
+     * @param[in] busName bus name of the device
+     * @param[in] objPath the object path
+     * @param[in] intfType interface type
+     * @param[in] status AJ_OK on success, otherwise the properties of the interface are not cached
+     */
+    void (*OnInterfaceSynced)(const char* busName, const char* objPath, CdmInterfaceTypes intfType, AJ_Status status);
+
+    /**
+     * Handler called when a PropertiesChanged signal updates a cached property
+     * @param[in] busName bus name of the device
+     * @param[in] objPath the object path
+     * @param[in] intfType interface type
+     * @param[in] propName property name
+     */
+    void (*OnPropertyChanged)(const char* busName, const char* objPath, CdmInterfaceTypes intfType, const char* propName);
+
+    /**
+     * Handler called when the session to a device is lost, after the cache of the device is dropped
+     * @param[in] busName bus name of the device
+     */
+    void (*OnDeviceLost)(const char* busName);
+} CdmControllerListener;
+
+/**
+ * Initialize CDM controller.
+ * The controller discovers devices announcing CDM interfaces, joins a session to each of them
+ * and keeps a cache of their properties, synced by GetAll and kept current by PropertiesChanged.
+ * @param[in] listener controller listener, NULL to join every device found
+ * @return AJ_OK on success
+ */
+AJ_Status Cdm_ControllerInit(const CdmControllerListener* listener);
+
+/**
+ * Deinitialize CDM controller. Sessions to the devices are left if the controller is started.
+ * Should also be called when the bus is disconnected, followed by Cdm_ControllerInit.
+ */
+void Cdm_ControllerDeinit();
+
+/**
+ * Start CDM controller after the bus is connected.
+ * The proxy object list is registered and match rules for Announce, PropertiesChanged and NameOwnerChanged signals are added.
+ * @param[in] busAttachment bus attachment
+ * @return AJ_OK on success
+ */
+AJ_Status Cdm_ControllerStart(AJ_BusAttachment* busAttachment);
+
+/**
+ * Function used to process CDM controller messages.
+ * Lost sessions are left to the application and other services.
+ * @param[in] busAttachment bus attachment
+ * @param[in] msg message
+ * @param[out] status status
+ * @return service status
+ */
+AJSVC_ServiceStatus Cdm_ControllerMessageProcessor(AJ_BusAttachment* busAttachment, AJ_Message* msg, AJ_Status* status);
+
+/**
+ * Find the announced objects which implement all of the interfaces.
+ * Every announcement is indexed, also of devices which are not joined. The objects of a bus name
+ * are replaced when it announces again and removed when it leaves the bus.
+ * The objects are walked in the list of the least implemented interface.
+ * @param[in] intfTypes interface types
+ * @param[in] numIntfTypes the number of interface types
+ * @param[in] handler handler called for each object found, may be NULL to count the objects
+ * @param[in] context context passed to the handler
+ * @return the number of objects found
+ */
+size_t Cdm_ControllerFindObjects(const CdmInterfaceTypes* intfTypes, size_t numIntfTypes, CdmObjectFoundHandler handler, void* context);
+
+/*
+ * Typed accessors of the property cache.
+ * String and array values point into the cache and are valid until the property is updated or the device is lost.
+ * Return AJ_OK on success, AJ_ERR_NO_MATCH if the property is unknown or not received yet,
+ * AJ_ERR_SIGNATURE if the property has another type.
+ */
+
+/**
+ * Get cached property of "y" type
+ * @param[in] busName bus name of the device
+ * @param[in] objPath the object path
+ * @param[in] intfType interface type
+ * @param[in] propName property name
+ * @param[out] value property value
+ * @return AJ_OK on success
+ */
+AJ_Status Cdm_ControllerGetUint8(const char* busName, const char* objPath, CdmInterfaceTypes intfType, const char* propName, uint8_t* value);
+
+/**
+ * Get cached property of "b" type
+ * @param[in] busName bus name of the device
+ * @param[in] objPath the object path
+ * @param[in] intfType interface type
+ * @param[in] propName property name
+ * @param[out] value property value
+ * @return AJ_OK on success
+ */
+AJ_Status Cdm_ControllerGetBool(const char* busName, const char* objPath, CdmInterfaceTypes intfType, const char* propName, bool* value);
+
+/**
+ * Get cached property of "q" type
+ * @param[in] busName bus name of the device
+ * @param[in] objPath the object path
+ * @param[in] intfType interface type
+ * @param[in] propName property name
+ * @param[out] value property value
+ * @return AJ_OK on success
+ */
+AJ_Status Cdm_ControllerGetUint16(const char* busName, const char* objPath, CdmInterfaceTypes intfType, const char* propName, uint16_t* value);
+
+/**
+ * Get cached property of "i" type
+ * @param[in] busName bus name of the device
+ * @param[in] objPath the object path
+ * @param[in] intfType interface type
+ * @param[in] propName property name
+ * @param[out] value property value
+ * @return AJ_OK on success
+ */
+AJ_Status Cdm_ControllerGetInt32(const char* busName, const char* objPath, CdmInterfaceTypes intfType, const char* propName, int32_t* value);
+
+/**
+ * Get cached property of "u" type
+ * @param[in] busName bus name of the device
+ * @param[in] objPath the object path
+ * @param[in] intfType interface type
+ * @param[in] propName property name
+ * @param[out] value property value
+ * @return AJ_OK on success
+ */
+AJ_Status Cdm_ControllerGetUint32(const char* busName, const char* objPath, CdmInterfaceTypes intfType, const char* propName, uint32_t* value);
+
+/**
+ * Get cached property of "d" type
+ * @param[in] busName bus name of the device
+ * @param[in] objPath the object path
+ * @param[in] intfType interface type
+ * @param[in] propName property name
+ * @param[out] value property value
+ * @return AJ_OK on success
+ */
+AJ_Status Cdm_ControllerGetDouble(const char* busName, const char* objPath, CdmInterfaceTypes intfType, const char* propName, double* value);
+
+/**
+ * Get cached property of "s" type
+ * @param[in] busName bus name of the device
+ * @param[in] objPath the object path
+ * @param[in] intfType interface type
+ * @param[in] propName property name
+ * @param[out] value property value
+ * @return AJ_OK on success
+ */
+AJ_Status Cdm_ControllerGetString(const char* busName, const char* objPath, CdmInterfaceTypes intfType, const char* propName, const char** value);
+
+/**
+ * Get cached property of "ay" type
+ * @param[in] busName bus name of the device
+ * @param[in] objPath the object path
+ * @param[in] intfType interface type
+ * @param[in] propName property name
+ * @param[out] value property value
+ * @param[out] count the number of elements
+ * @return AJ_OK on success
+ */
+AJ_Status Cdm_ControllerGetUint8Array(const char* busName, const char* objPath, CdmInterfaceTypes intfType, const char* propName, const uint8_t** value, size_t* count);
+
+/**
+ * Get cached property of "aq" type
+ * @param[in] busName bus name of the device
+ * @param[in] objPath the object path
+ * @param[in] intfType interface type
+ * @param[in] propName property name
+ * @param[out] value property value
+ * @param[out] count the number of elements
+ * @return AJ_OK on success
+ */
+AJ_Status Cdm_ControllerGetUint16Array(const char* busName, const char* objPath, CdmInterfaceTypes intfType, const char* propName, const uint16_t** value, size_t* count);
+
+#endif // CDMCONTROLLER_H_
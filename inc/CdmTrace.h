@@ -0,0 +1,187 @@
+/**
+ * @file
+ */
+/******************************************************************************
+ * Copyright AllSeen Alliance. All rights reserved.
+ *
+ *    Permission to use, copy, modify, and/or distribute this software for any
+ *    purpose with or without fee is hereby granted, provided that the above
+ *    copyright notice and this permission notice appear in all copies.
+ *
+ *    THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ *    WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ *    ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ *    WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ *    ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ *    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ ******************************************************************************/
+
+
+
+#ifndef CDMTRACE_H_
+#define CDMTRACE_H_
+
+#include <ajtcl/services/ServicesCommon.h>
+#include <ajtcl/alljoyn.h>
+#include <ajtcl/cdm/CdmControllee.h>
+
+/**
+ * Trace file magic, "CDMT"
+ */
+#define CDM_TRACE_MAGIC 0x544D4443
+
+/**
+ * Trace format version
+ */
+#define CDM_TRACE_VERSION 1
+
+/**
+ * Size of the buffers of the stand-in bus used by Cdm_TraceReplay
+ */
+#ifndef CDM_TRACE_REPLAY_BUFFER_SIZE
+#define CDM_TRACE_REPLAY_BUFFER_SIZE 4096
+#endif
+
+/**
+ * Trace record types
+ */
+#define CDM_TRACE_RECORD_IN   1   // message entering Cdm_MessageProcessor, followed by the whole message
+#define CDM_TRACE_RECORD_OUT  2   // bytes sent to the bus, followed by the bytes
+#define CDM_TRACE_RECORD_DONE 3   // end of Cdm_MessageProcessor, followed by CdmTraceDone
+
+/**
+ * Trace record flags
+ */
+#define CDM_TRACE_FLAG_TRUNCATED   0x01   // IN: the body was not in the receive buffer, only the header is recorded
+#define CDM_TRACE_FLAG_ENCRYPTED   0x02   // IN: decrypted before recording, OUT: sent encrypted
+#define CDM_TRACE_FLAG_UNSOLICITED 0x04   // OUT: sent outside of Cdm_MessageProcessor, e.g. by a property setter
+
+/**
+ * Trace file header. Fields are in host byte order.
+ */
+typedef struct {
+    uint32_t magic;     // CDM_TRACE_MAGIC
+    uint16_t version;   // CDM_TRACE_VERSION
+    uint16_t reserved;
+} CdmTraceFileHeader;
+
+/**
+ * Trace record header. Fields are in host byte order.
+ */
+typedef struct {
+    uint8_t type;       // CDM_TRACE_RECORD_*
+    uint8_t flags;      // CDM_TRACE_FLAG_*
+    uint16_t reserved;
+    uint32_t timestamp; // ms since Cdm_TraceStart
+    uint32_t length;    // number of bytes following the header
+} CdmTraceRecordHeader;
+
+/**
+ * Payload of a CDM_TRACE_RECORD_DONE record
+ */
+typedef struct {
+    uint32_t msgId;     // message identifier
+    uint32_t duration;  // time spent in Cdm_MessageProcessor in ms
+    uint8_t handled;    // true if Cdm_MessageProcessor handled the message
+    uint8_t status;     // AJ_Status returned through the status argument
+    uint16_t reserved;
+} CdmTraceDone;
+
+/**
+ * Trace output function
+ * @param[in] data bytes to write
+ * @param[in] len number of bytes
+ * @param[in] context context given to Cdm_TraceStart
+ * @return AJ_OK on success
+ */
+typedef AJ_Status (*CdmTraceWriteFunc)(const void* data, size_t len, void* context);
+
+/**
+ * Trace input function
+ * @param[out] data buffer
+ * @param[in] len number of bytes to read
+ * @param[in] context context given to Cdm_TraceReplay
+ * @return AJ_OK on success, AJ_ERR_END_OF_DATA at the end of the trace
+ */
+typedef AJ_Status (*CdmTraceReadFunc)(void* data, size_t len, void* context);
+
+/**
+ * Result of replaying a message
+ */
+typedef enum {
+    CDM_TRACE_OUTPUT_MATCHED = 0,   // same messages sent, serial numbers aside
+    CDM_TRACE_OUTPUT_MISMATCHED,    // different messages sent
+    CDM_TRACE_OUTPUT_SKIPPED,       // not replayed, e.g. truncated
+    CDM_TRACE_OUTPUT_ENCRYPTED      // replayed but not comparable, the recorded output was sent encrypted
+} CdmTraceOutputResult;
+
+/**
+ * Replay report of a message
+ */
+typedef struct {
+    uint32_t index;             // index of the message in the trace
+    uint32_t msgId;             // message identifier recorded
+    uint32_t recordedDuration;  // ms recorded
+    uint32_t replayedDuration;  // ms of the replay
+    AJ_Status status;           // status of the replay
+    CdmTraceOutputResult output;
+} CdmTraceReplayReport;
+
+/**
+ * Replay summary
+ */
+typedef struct {
+    uint32_t messages;          // messages in the trace
+    uint32_t matched;
+    uint32_t mismatched;
+    uint32_t skipped;
+    uint32_t encrypted;         // replayed but not compared, see CDM_TRACE_OUTPUT_ENCRYPTED
+    uint32_t recordedDuration;  // total ms recorded
+    uint32_t replayedDuration;  // total ms of the replay
+} CdmTraceReplayStats;
+
+/**
+ * Replay report handler
+ * @param[in] report report of a replayed message
+ * @param[in] context context given to Cdm_TraceReplay
+ */
+typedef void (*CdmTraceReplayHandler)(const CdmTraceReplayReport* report, void* context);
+
+/**
+ * Start recording the messages entering Cdm_MessageProcessor and the bytes sent to the bus.
+ * The send function of the bus attachment is wrapped until Cdm_TraceStop.
+ * Messages are recorded after decryption so that they can be replayed without the session keys.
+ * The bytes sent are recorded as they go to the bus, i.e. after encryption, since AJ_DeliverMsg encrypts
+ * right before sending. Encrypted output therefore cannot be compared by Cdm_TraceReplay.
+ * Stop the trace before the bus attachment reconnects, as connecting sets the send function again.
+ * @param[in] busAttachment bus attachment
+ * @param[in] write trace output function
+ * @param[in] context context passed to write
+ * @return AJ_OK on success, AJ_ERR_DISALLOWED if a trace is already running
+ */
+AJ_Status Cdm_TraceStart(AJ_BusAttachment* busAttachment, CdmTraceWriteFunc write, void* context);
+
+/**
+ * Stop recording and restore the send function of the bus attachment.
+ * Recording also stops when the trace output function fails.
+ */
+void Cdm_TraceStop(void);
+
+/**
+ * Replay a trace against the objects of this controllee, as fast as possible.
+ * The messages are fed through a stand-in bus attachment to AJ_UnmarshalMsg and Cdm_MessageProcessor,
+ * and the bytes sent while processing each message are compared with the recorded ones.
+ * Secure interfaces are registered without security during the replay, as the trace holds decrypted messages.
+ * Messages whose recorded output was sent encrypted are still replayed, but their output is not compared
+ * and they are reported as CDM_TRACE_OUTPUT_ENCRYPTED rather than as mismatched or skipped.
+ * It must be called after Cdm_Start, with the objects and the property values the trace was recorded with.
+ * @param[in] read trace input function
+ * @param[in] context context passed to read and handler
+ * @param[in] handler report handler called after each message, may be NULL
+ * @param[out] stats replay summary, may be NULL
+ * @return AJ_OK on success, AJ_ERR_INVALID if the trace format is not supported
+ */
+AJ_Status Cdm_TraceReplay(CdmTraceReadFunc read, void* context, CdmTraceReplayHandler handler, CdmTraceReplayStats* stats);
+
+#endif // CDMTRACE_H_
@@ -0,0 +1,34 @@
+/******************************************************************************
+ * Copyright AllSeen Alliance. All rights reserved.
+ *
+ *    Permission to use, copy, modify, and/or distribute this software for any
+ *    purpose with or without fee is hereby granted, provided that the above
+ *    copyright notice and this permission notice appear in all copies.
+ *
+ *    THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ *    WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ *    ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ *    WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ *    ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ *    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ ******************************************************************************/
+
+
+#ifndef CDMDESCRIPTIONCATALOG_H_
+#define CDMDESCRIPTIONCATALOG_H_
+
+#include <ajtcl/alljoyn.h>
+
+/**
+ * Description catalog record
+ * A catalog is a read-only array of records owned by the application. It must stay valid while it is registered.
+ */
+typedef struct {
+    const char* languageTag;
+    uint16_t code;
+    const char* name;
+    const char* description;
+} CdmDescriptionRecord;
+
+#endif /* CDMDESCRIPTIONCATALOG_H_ */
@@ -0,0 +1,71 @@
+/******************************************************************************
+ * Copyright AllSeen Alliance. All rights reserved.
+ *
+ *    Permission to use, copy, modify, and/or distribute this software for any
+ *    purpose with or without fee is hereby granted, provided that the above
+ *    copyright notice and this permission notice appear in all copies.
+ *
+ *    THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ *    WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ *    ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ *    WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ *    ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ *    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ ******************************************************************************/
+
+
+#ifndef CDMSENSORHISTORY_H_
+#define CDMSENSORHISTORY_H_
+
+#include <ajtcl/alljoyn.h>
+#include <ajtcl/cdm/CdmControllee.h>
+
+#ifndef CDM_SENSOR_HISTORY_INTERFACE_NAME
+#define CDM_SENSOR_HISTORY_INTERFACE_NAME "org.alljoyn.SmartSpaces.Extension.SensorHistory"
+#endif
+
+/**
+ * Sensor history resolution
+ */
+typedef enum {
+    SENSOR_HISTORY_RAW = 0,
+    SENSOR_HISTORY_MINUTE = 1,
+    SENSOR_HISTORY_HOUR = 2,
+    MAX_SENSOR_HISTORY_RESOLUTION = SENSOR_HISTORY_HOUR
+} SensorHistoryResolution;
+
+/**
+ * Register sensor history interface as a vendor defined interface.
+ * The interface has GetHistory method (interfaceName<s resolution<y now>u timestamps>au values>ad) which returns
+ * the whole history of the sensor interface on the object in a single reply. Timestamps are milliseconds since registration.
+ * @param[out] intfType registered interface type, to be used for Cdm_CreateInterface
+ * @return AJ_OK on success
+ */
+AJ_Status Cdm_SensorHistoryRegisterInterface(CdmInterfaceTypes* intfType);
+
+/**
+ * Enable history of a sensor interface.
+ * The sensor history interface must be created on the object. Supported sensor interfaces are CurrentTemperature,
+ * CurrentHumidity, CurrentAirQuality, CurrentAirQualityLevel, CurrentPower and WaterLevel.
+ * Values given to their Set functions are recorded to fixed size ring buffers allocated here,
+ * and are averaged into per minute and per hour buffers.
+ * @param[in] objPath the object path including the interface
+ * @param[in] intfType sensor interface type
+ * @param[in] rawCapacity the number of raw samples to keep
+ * @param[in] minuteCapacity the number of minutes to keep
+ * @param[in] hourCapacity the number of hours to keep
+ * @return AJ_OK on success
+ */
+AJ_Status Cdm_SensorHistoryEnable(const char* objPath, CdmInterfaceTypes intfType, const uint16_t rawCapacity,
+                                  const uint16_t minuteCapacity, const uint16_t hourCapacity);
+
+/**
+ * Disable history of a sensor interface and release its buffers.
+ * @param[in] objPath the object path including the interface
+ * @param[in] intfType sensor interface type
+ * @return AJ_OK on success
+ */
+AJ_Status Cdm_SensorHistoryDisable(const char* objPath, CdmInterfaceTypes intfType);
+
+#endif /* CDMSENSORHISTORY_H_ */
@@ -0,0 +1,86 @@
+/******************************************************************************
+ * Copyright AllSeen Alliance. All rights reserved.
+ *
+ *    Permission to use, copy, modify, and/or distribute this software for any
+ *    purpose with or without fee is hereby granted, provided that the above
+ *    copyright notice and this permission notice appear in all copies.
+ *
+ *    THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ *    WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ *    ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ *    WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ *    ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ *    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ ******************************************************************************/
+
+
+#ifndef CDMTIMERWHEEL_H_
+#define CDMTIMERWHEEL_H_
+
+#include <ajtcl/alljoyn.h>
+#include <ajtcl/cdm/CdmControllee.h>
+
+typedef struct _CdmTimer CdmTimer;
+
+/**
+ * Timer callback
+ * @param[in] busAttachment bus attachment passed to Cdm_ProcessTimers
+ * @param[in] timer expired timer. It can be scheduled again or cancelled in the callback.
+ * @param[in] context context given to Cdm_TimerWheelInitTimer
+ */
+typedef void (*CdmTimerCallback)(AJ_BusAttachment* busAttachment, CdmTimer* timer, void* context);
+
+/**
+ * Timer entry. It is owned by the caller and must be cancelled before it is freed.
+ * The members are used by the timer wheel only.
+ */
+struct _CdmTimer {
+    CdmTimer* next;
+    CdmTimer* prev;
+    bool expiring;
+    uint32_t expiry;
+    uint32_t period;
+    CdmTimerCallback callback;
+    void* context;
+};
+
+/**
+ * Initialize timer entry.
+ * @param[in] timer timer entry
+ * @param[in] callback callback called from Cdm_ProcessTimers on expiry
+ * @param[in] context context passed to callback
+ */
+void Cdm_TimerWheelInitTimer(CdmTimer* timer, CdmTimerCallback callback, void* context);
+
+/**
+ * Schedule timer. A scheduled timer is rescheduled.
+ * Timers are kept in a hierarchical wheel of 100ms ticks, so insert and cancel do not depend on the number of timers.
+ * @param[in] timer timer entry
+ * @param[in] delay time to the first expiry in ms, less than 2^31
+ * @param[in] period repeat period in ms, less than 2^31, 0 for a one-shot timer
+ */
+void Cdm_TimerWheelSchedule(CdmTimer* timer, uint32_t delay, uint32_t period);
+
+/**
+ * Cancel timer. Cancelling a timer which is not scheduled has no effect.
+ * @param[in] timer timer entry
+ */
+void Cdm_TimerWheelCancel(CdmTimer* timer);
+
+/**
+ * Check if timer is scheduled.
+ * @param[in] timer timer entry
+ * @return true if scheduled
+ */
+bool Cdm_TimerWheelIsScheduled(const CdmTimer* timer);
+
+/**
+ * Get the time until Cdm_ProcessTimers has a timer to run, to be used as the timeout of AJ_UnmarshalMsg.
+ * Timers due in more than 6.4 s may cause up to three earlier returns, when they move down the wheel levels.
+ * @param[in] maxTimeout timeout returned when there is no earlier timer, in ms
+ * @return timeout in ms
+ */
+uint32_t Cdm_TimerWheelGetTimeout(uint32_t maxTimeout);
+
+#endif /* CDMTIMERWHEEL_H_ */
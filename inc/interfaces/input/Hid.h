@@ -42,6 +42,30 @@ typedef struct {
     int32_t max;
 } SupportedInputEvent;
 
+/**
+ * Input event types (same values as the Linux input subsystem)
+ */
+#define HID_EVENT_TYPE_SYN  0x00
+#define HID_EVENT_TYPE_KEY  0x01
+#define HID_EVENT_TYPE_REL  0x02
+#define HID_EVENT_TYPE_ABS  0x03
+
+/**
+ * Key event value for an auto-repeat
+ */
+#define HID_KEY_VALUE_REPEAT 2
+
+/**
+ * Coalescing options applied to injected events before OnInjectEvents is called
+ */
+typedef enum {
+    HID_COALESCE_NONE                = 0x00,
+    HID_COALESCE_MERGE_RELATIVE      = 0x01, /**< merge relative-axis events with the same type and code */
+    HID_COALESCE_DROP_KEY_REPEATS    = 0x02, /**< drop key repeats following a repeat of the same key */
+    HID_COALESCE_CLAMP_TO_SUPPORTED  = 0x04, /**< clamp values to the min/max of SupportedEvents */
+    HID_COALESCE_ALL                 = 0x07
+} HidCoalescingOption;
+
 typedef struct {
     /**
      * Handler for getting SupportedInputEvent property
@@ -69,6 +93,16 @@ typedef struct {
  */
 AJ_Status Cdm_HidInterfaceGetSupportedEvents(const char* objPath, SupportedInputEvent* supportedEvents);
 
+/**
+ * Borrow supported events of Hid interface without copying. It is valid until the next change of supported events.
+ * @param[in] objPath the object path including the interface
+ * @param[out] supportedEvents List of supported input events by a device.
+ * @param[out] supportedEventListSize SupportedInputEvent List size
+ * @param[out] revision revision of supported events, changed by every change of supported events, can be NULL
+ * @return AJ_OK on success
+ */
+AJ_Status Cdm_HidInterfaceBorrowSupportedEvents(const char* objPath, const SupportedInputEvent** supportedEvents, size_t* supportedEventListSize, uint32_t* revision);
+
 /**
  * Set displayLanguage of Hid interface
  * @param[in] busAttachment bus attachment
@@ -79,4 +113,14 @@ AJ_Status Cdm_HidInterfaceGetSupportedEvents(const char* objPath, SupportedInput
  */
 AJ_Status Cdm_HidInterfaceSetSupportedEvents(AJ_BusAttachment* busAttachment, const char* objPath, const SupportedInputEvent* supportedEvents, const size_t supportedEventListSize);
 
+/**
+ * Set coalescing options of Hid interface
+ * Events of an InjectEvents call are coalesced before being passed to OnInjectEvents.
+ * Relative-axis events are merged up to the next key or absolute-axis event.
+ * @param[in] objPath the object path including the interface
+ * @param[in] options bitwise OR of HidCoalescingOption values (HID_COALESCE_NONE disables coalescing)
+ * @return AJ_OK on success
+ */
+AJ_Status Cdm_HidInterfaceSetEventCoalescing(const char* objPath, const uint8_t options);
+
 #endif /* HID_H_ */
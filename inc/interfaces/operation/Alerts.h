@@ -23,6 +23,7 @@
 #include <ajtcl/alljoyn.h>
 #include <ajtcl/cdm/CdmControllee.h>
 #include <ajtcl/cdm/interfaces/CdmInterfaceErrors.h>
+#include <ajtcl/cdm/interfaces/CdmDescriptionCatalog.h>
 
 /**
  * AlertRecord struct
@@ -92,6 +93,16 @@ typedef struct {
  */
 AJ_Status Cdm_AlertsInterfaceGetAlerts(const char* objPath, AlertRecord* alerts);
 
+/**
+ * Borrow Alerts of Alerts interface without copying. It is valid until the next change of Alerts.
+ * @param[in] objPath the object path including the interface
+ * @param[out] alerts List of current pending alerts
+ * @param[out] alertsNumber Alerts number
+ * @param[out] revision revision of Alerts, changed by every change of Alerts, can be NULL
+ * @return AJ_OK on success
+ */
+AJ_Status Cdm_AlertsInterfaceBorrowAlerts(const char* objPath, const AlertRecord** alerts, size_t* alertsNumber, uint32_t* revision);
+
 /**
  * Set Alerts of Alerts interface
  * @param[in] busAttachment bus attachment
@@ -103,5 +114,50 @@ AJ_Status Cdm_AlertsInterfaceGetAlerts(const char* objPath, AlertRecord* alerts)
 AJ_Status Cdm_AlertsInterfaceSetAlerts(AJ_BusAttachment* busAttachment, const char* objPath,
     const AlertRecord* alerts, const size_t alertsNumber);
 
+/**
+ * Raise an alert of Alerts interface
+ * @param[in] busAttachment bus attachment
+ * @param[in] objPath the object path including the interface
+ * @param[in] alert Alert to be added, or to replace the pending alert with the same alert code
+ * @return AJ_OK on success
+ */
+AJ_Status Cdm_AlertsInterfaceRaiseAlert(AJ_BusAttachment* busAttachment, const char* objPath, const AlertRecord* alert);
+
+/**
+ * Clear an alert of Alerts interface
+ * @param[in] busAttachment bus attachment
+ * @param[in] objPath the object path including the interface
+ * @param[in] alertCode Alert code of the alert to be cleared
+ * @return AJ_OK on success
+ */
+AJ_Status Cdm_AlertsInterfaceClearAlert(AJ_BusAttachment* busAttachment, const char* objPath, const uint16_t alertCode);
+
+/**
+ * Clear all alerts of Alerts interface
+ * @param[in] busAttachment bus attachment
+ * @param[in] objPath the object path including the interface
+ * @return AJ_OK on success
+ */
+AJ_Status Cdm_AlertsInterfaceClearAllAlerts(AJ_BusAttachment* busAttachment, const char* objPath);
+
+/**
+ * Acknowledge an alert of Alerts interface locally
+ * @param[in] busAttachment bus attachment
+ * @param[in] objPath the object path including the interface
+ * @param[in] alertCode Alert code of the alert to be acknowledged
+ * @return AJ_OK on success
+ */
+AJ_Status Cdm_AlertsInterfaceAcknowledgeAlert(AJ_BusAttachment* busAttachment, const char* objPath, const uint16_t alertCode);
+
+/**
+ * Set alert codes description catalog of Alerts interface
+ * GetAlertCodesDescription is replied from the catalog instead of OnGetAlertCodesDescription while it is set.
+ * @param[in] objPath the object path including the interface
+ * @param[in] records Description records of all languages. code is the alert code, name is not used.
+ * @param[in] numRecords the number of records, 0 to unset the catalog
+ * @return AJ_OK on success
+ */
+AJ_Status Cdm_AlertsInterfaceSetAlertCodesDescriptionCatalog(const char* objPath, const CdmDescriptionRecord* records, const uint16_t numRecords);
+
 
 #endif /* ALERTS_H_ */
@@ -92,6 +92,15 @@ AJ_Status Cdm_ChannelInterfaceGetChannelId(const char* objPath, char* channelId)
  */
 AJ_Status Cdm_ChannelInterfaceSetChannelId(AJ_BusAttachment* busAttachment, const char* objPath, const char* channelId);
 
+/**
+ * Borrow channel id of Channel interface without copying. It is valid until the next change of channel id.
+ * @param[in] objPath the object path including the interface
+ * @param[out] channelId channel id
+ * @param[out] length channel id length, can be NULL
+ * @return AJ_OK on success
+ */
+AJ_Status Cdm_ChannelInterfaceBorrowChannelId(const char* objPath, const char** channelId, size_t* length);
+
 /**
  * Get total number of channels of Channel interface
  * @param[in] objPath the object path including the interface
@@ -118,4 +127,17 @@ AJ_Status Cdm_ChannelInterfaceSetTotalNumberOfChannels(AJ_BusAttachment* busAtta
  */
 AJ_Status Cdm_ChannelInterfaceEmitChannelListChanged(AJ_BusAttachment* busAttachment, const char* objPath, const uint32_t sessionId);
 
+/**
+ * Load channel list of Channel interface
+ * The list is copied into a table owned by the framework, and GetChannelList is served from it
+ * instead of calling OnGetChannelList. TotalNumberOfChannels follows the number of loaded channels.
+ * ChannelListChanged is emitted only when the content of the list changes.
+ * @param[in] busAttachment bus attachment
+ * @param[in] objPath the object path including the interface
+ * @param[in] channels list of channel info records, in the order they are reported
+ * @param[in] numChannels the number of channel info records
+ * @return AJ_OK on success
+ */
+AJ_Status Cdm_ChannelInterfaceLoadChannelList(AJ_BusAttachment* busAttachment, const char* objPath, const ChannelInfoRecord* channels, const uint16_t numChannels);
+
 #endif /* CHANNEL_H_ */
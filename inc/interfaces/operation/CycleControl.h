@@ -87,6 +87,17 @@ AJ_Status Cdm_CycleControlInterfaceSetOperationalState(AJ_BusAttachment* busAtta
  */
 AJ_Status Cdm_CycleControlInterfaceGetSupportedOperationalStates(const char* objPath, uint8_t* supportedOperationalStates);
 
+/**
+ * Borrow SupportedOperationalStates of CycleControl interface without copying.
+ * It is valid until the next change of SupportedOperationalStates.
+ * @param[in] objPath the object path including the interface
+ * @param[out] supportedOperationalStates supported operational states
+ * @param[out] supportedModeSize number of supported operational states
+ * @param[out] revision revision of SupportedOperationalStates, changed by every change of SupportedOperationalStates, can be NULL
+ * @return AJ_OK on success
+ */
+AJ_Status Cdm_CycleControlInterfaceBorrowSupportedOperationalStates(const char* objPath, const uint8_t** supportedOperationalStates, size_t* supportedModeSize, uint32_t* revision);
+
 /**
  * Set SupportedOperationalStates of CycleControl interface
  * @param[in] busAttachment bus attachment
@@ -24,6 +24,14 @@
 #include <ajtcl/cdm/CdmControllee.h>
 #include <ajtcl/cdm/interfaces/CdmInterfaceErrors.h>
 
+/**
+ * Power sample for energy accounting
+ */
+typedef struct {
+    uint32_t timestamp; //milliseconds, from any monotonic clock that wraps around at 2^32
+    double power; //watts (W)
+} EnergyUsagePowerSample;
+
 /**
  * EnergyUsage interface listener
  */
@@ -112,4 +120,27 @@ AJ_Status Cdm_EnergyUsageInterfaceGetUpdateMinTime(const char* objPath, uint16_t
  */
 AJ_Status Cdm_EnergyUsageInterfaceSetUpdateMinTime(AJ_BusAttachment* busAttachment, const char* objPath, const uint16_t updateMinTime);
 
+/**
+ * Enable or disable energy accounting of EnergyUsage interface
+ * While enabled, CumulativeEnergy is integrated from the power samples given to Cdm_EnergyUsageInterfaceIngestPowerSamples,
+ * starting from the current CumulativeEnergy, and ResetCumulativeEnergy is handled even without OnResetCumulativeEnergy.
+ * @param[in] objPath the object path including the interface
+ * @param[in] enable true to enable
+ * @return AJ_OK on success
+ */
+AJ_Status Cdm_EnergyUsageInterfaceSetEnergyAccounting(const char* objPath, const bool enable);
+
+/**
+ * Ingest power samples to energy accounting of EnergyUsage interface
+ * CumulativeEnergy is emitted at most once per call, when it moved by Precision or more and UpdateMinTime has passed
+ * since the last emission in sample time. If the object has CurrentPower interface, CurrentPower is updated to the last
+ * sample in the same way with the Precision and UpdateMinTime of CurrentPower interface.
+ * @param[in] busAttachment bus attachment
+ * @param[in] objPath the object path including the interface
+ * @param[in] samples power samples in time order
+ * @param[in] numSamples the number of samples
+ * @return AJ_OK on success, AJ_ERR_DISALLOWED if energy accounting is not enabled
+ */
+AJ_Status Cdm_EnergyUsageInterfaceIngestPowerSamples(AJ_BusAttachment* busAttachment, const char* objPath, const EnergyUsagePowerSample* samples, const size_t numSamples);
+
 #endif /* ENERGYUSAGE_H_ */
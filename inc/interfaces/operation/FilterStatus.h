@@ -152,6 +152,15 @@ AJ_Status Cdm_FilterStatusInterfaceGetManufacturer(const char* objPath, char* ma
  */
 AJ_Status Cdm_FilterStatusInterfaceSetManufacturer(AJ_BusAttachment* busAttachment, const char* objPath, const char* manufacturer);
 
+/**
+ * Borrow manufacturer of FilterStatus interface without copying. It is valid until the next change of manufacturer.
+ * @param[in] objPath the object path including the interface
+ * @param[out] manufacturer manufacturer
+ * @param[out] length manufacturer length, can be NULL
+ * @return AJ_OK on success
+ */
+AJ_Status Cdm_FilterStatusInterfaceBorrowManufacturer(const char* objPath, const char** manufacturer, size_t* length);
+
 /**
  * Get part number of FilterStatus interface
  * @param[in] objPath the object path including the interface
@@ -169,6 +178,15 @@ AJ_Status Cdm_FilterStatusInterfaceGetPartNumber(const char* objPath, char* part
  */
 AJ_Status Cdm_FilterStatusInterfaceSetPartNumber(AJ_BusAttachment* busAttachment, const char* objPath, const char* partNumber);
 
+/**
+ * Borrow part number of FilterStatus interface without copying. It is valid until the next change of part number.
+ * @param[in] objPath the object path including the interface
+ * @param[out] partNumber part number
+ * @param[out] length part number length, can be NULL
+ * @return AJ_OK on success
+ */
+AJ_Status Cdm_FilterStatusInterfaceBorrowPartNumber(const char* objPath, const char** partNumber, size_t* length);
+
 /**
  * Get url of FilterStatus interface
  * @param[in] objPath the object path including the interface
@@ -186,6 +204,15 @@ AJ_Status Cdm_FilterStatusInterfaceGetUrl(const char* objPath, char* url);
  */
 AJ_Status Cdm_FilterStatusInterfaceSetUrl(AJ_BusAttachment* busAttachment, const char* objPath, const char* url);
 
+/**
+ * Borrow url of FilterStatus interface without copying. It is valid until the next change of url.
+ * @param[in] objPath the object path including the interface
+ * @param[out] url url
+ * @param[out] length url length, can be NULL
+ * @return AJ_OK on success
+ */
+AJ_Status Cdm_FilterStatusInterfaceBorrowUrl(const char* objPath, const char** url, size_t* length);
+
 /**
  * Get life remaining of FilterStatus interface
  * @param[in] objPath the object path including the interface
@@ -203,4 +230,21 @@ AJ_Status Cdm_FilterStatusInterfaceGetLifeRemaining(const char* objPath, uint8_t
  */
 AJ_Status Cdm_FilterStatusInterfaceSetLifeRemaining(AJ_BusAttachment* busAttachment, const char* objPath, const uint8_t value);
 
+/**
+ * Start decreasing LifeRemaining of FilterStatus interface while the filter is in use.
+ * The used time is derived from LifeRemaining and ExpectedLifeInDays, which should be set before,
+ * and is advanced every minute by the timer wheel run from Cdm_ProcessTimers.
+ * Setting LifeRemaining to 100 restarts the tracking for a new filter.
+ * @param[in] objPath the object path including the interface. It must stay valid while the interface exists.
+ * @return AJ_OK on success, AJ_ERR_INVALID if ExpectedLifeInDays is 0
+ */
+AJ_Status Cdm_FilterStatusInterfaceStartLifeTracking(const char* objPath);
+
+/**
+ * Stop decreasing LifeRemaining of FilterStatus interface while the filter is not in use.
+ * @param[in] objPath the object path including the interface
+ * @return AJ_OK on success
+ */
+AJ_Status Cdm_FilterStatusInterfaceStopLifeTracking(const char* objPath);
+
 #endif /* FILTERSTATUS_H_ */
@@ -96,6 +96,16 @@ AJ_Status Cdm_HeatingZoneInterfaceSetMaxHeatingLevels(AJ_BusAttachment* busAttac
  */
 AJ_Status Cdm_HeatingZoneInterfaceGetHeatingLevels(const char* objPath, uint8_t* heatingLevels);
 
+/**
+ * Borrow HeatingLevels of HeatingZone interface without copying. It is valid until the next change of HeatingLevels.
+ * @param[in] objPath the object path including the interface
+ * @param[out] heatingLevels heating levels
+ * @param[out] heatingLevelsSize number of heating levels
+ * @param[out] revision revision of HeatingLevels, changed by every change of HeatingLevels, can be NULL
+ * @return AJ_OK on success
+ */
+AJ_Status Cdm_HeatingZoneInterfaceBorrowHeatingLevels(const char* objPath, const uint8_t** heatingLevels, size_t* heatingLevelsSize, uint32_t* revision);
+
 /**
  * Set HeatingLevels of HeatingZone interface
  * @param[in] busAttachment bus attachment
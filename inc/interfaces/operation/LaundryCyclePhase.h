@@ -23,6 +23,7 @@
 #include <ajtcl/alljoyn.h>
 #include <ajtcl/cdm/CdmControllee.h>
 #include <ajtcl/cdm/interfaces/CdmInterfaceErrors.h>
+#include <ajtcl/cdm/interfaces/CdmDescriptionCatalog.h>
 
 /**
  * LaundryCyclePhaseCyclePhaseDescriptor struct
@@ -101,4 +102,14 @@ AJ_Status Cdm_LaundryCyclePhaseInterfaceGetSupportedCyclePhases(const char* objP
  */
 AJ_Status Cdm_LaundryCyclePhaseInterfaceSetSupportedCyclePhases(AJ_BusAttachment* busAttachment, const char* objPath, const uint8_t* supportedCyclePhases, const size_t supportedCyclePhasesListSize);
 
+/**
+ * Set vendor phases description catalog of LaundryCyclePhase interface
+ * GetVendorPhasesDescription is replied from the catalog instead of OnGetVendorPhasesDescription while it is set.
+ * @param[in] objPath the object path including the interface
+ * @param[in] records Description records of all languages. name is the phase name, code is the phase.
+ * @param[in] numRecords the number of records, 0 to unset the catalog
+ * @return AJ_OK on success
+ */
+AJ_Status Cdm_LaundryCyclePhaseInterfaceSetVendorPhasesDescriptionCatalog(const char* objPath, const CdmDescriptionRecord* records, const uint16_t numRecords);
+
 #endif /* LAUNDRYCYCLEPHASE_H_ */
@@ -55,6 +55,16 @@ typedef struct {
  */
 AJ_Status Cdm_PlugInUnitsInterfaceGetPlugInUnits(const char* objPath, PlugInInfo* units);
 
+/**
+ * Borrow plugInUnits of PlugInUnits interface without copying. It is valid until the next change of plugInUnits.
+ * @param[in] objPath the object path including the interface
+ * @param[out] units plug in units
+ * @param[out] plugInInfoSize number of plug in units
+ * @param[out] revision revision of plugInUnits, changed by every change of plugInUnits, can be NULL
+ * @return AJ_OK on success
+ */
+AJ_Status Cdm_PlugInUnitsInterfaceBorrowPlugInUnits(const char* objPath, const PlugInInfo** units, size_t* plugInInfoSize, uint32_t* revision);
+
 /**
  * Set plugInUnits of PlugInUnits interface
  * @param[in] busAttachment bus attachment
@@ -23,6 +23,13 @@
 #include <ajtcl/alljoyn.h>
 #include <ajtcl/cdm/CdmControllee.h>
 
+/**
+ * Handler called when RapidModeMinutesRemaining counted down by the framework reaches 0.
+ * @param[in] busAttachment bus attachment
+ * @param[in] objPath object path
+ */
+typedef void (*RapidModeTimedExpiredHandler)(AJ_BusAttachment* busAttachment, const char* objPath);
+
 /**
  * RapidModeTimed interface listener
  */
@@ -86,4 +93,14 @@ AJ_Status Cdm_RapidModeTimedInterfaceGetMaxSetMinutes(const char* objPath, uint1
  */
 AJ_Status Cdm_RapidModeTimedInterfaceSetMaxSetMinutes(AJ_BusAttachment* busAttachment, const char* objPath, const uint16_t value);
 
+/**
+ * Let the framework count down RapidModeMinutesRemaining of RapidModeTimed interface.
+ * Whenever RapidModeMinutesRemaining is set to a non-zero value, it is decremented and emitted every minute
+ * by the timer wheel run from Cdm_ProcessTimers.
+ * @param[in] objPath the object path including the interface. It must stay valid while the interface exists.
+ * @param[in] handler handler called when rapid mode time is over, can be NULL
+ * @return AJ_OK on success
+ */
+AJ_Status Cdm_RapidModeTimedInterfaceEnableCountdown(const char* objPath, RapidModeTimedExpiredHandler handler);
+
 #endif /* RAPIDMODETIMED_H_ */
@@ -47,6 +47,9 @@ AJ_Status Cdm_RemoteControllabilityInterfaceGetIsControllable(const char* objPat
 
 /**
  * Set isControllable of RemoteControllability interface
+ * IsControllable is true when the interface is created. While it is false, property sets and
+ * method calls other than Get methods on any interface of the object are replied with
+ * RemoteControlDisabled without calling the listeners.
  * @param[in] busAttachment bus attachment
  * @param[in] objPath the object path including the interface
  * @param[in] isControllable isControllable
@@ -27,6 +27,21 @@
 #define TIMER_FEATURE_NOT_APPLIED 0x80000000
 #define TIMER_NOT_SUPPORTED 0x80000001
 
+/**
+ * Target time reached by the countdown engine
+ */
+typedef enum {
+    TIMER_TARGET_TIME_TO_START = 0,
+    TIMER_TARGET_TIME_TO_STOP = 1
+} TimerTargetTime;
+
+/**
+ * Handler called when TargetTimeToStart or TargetTimeToStop counted by the engine reaches 0.
+ * @param[in] busAttachment bus attachment
+ * @param[in] objPath object path
+ * @param[in] targetTime reached target time
+ */
+typedef void (*TimerTargetTimeHandler)(AJ_BusAttachment* busAttachment, const char* objPath, const TimerTargetTime targetTime);
 
 /**
  * Timer interface listener
@@ -204,4 +219,34 @@ AJ_Status Cdm_TimerInterfaceGetTargetDuration(const char* objPath, int32_t* targ
  */
 AJ_Status Cdm_TimerInterfaceSetTargetDuration(AJ_BusAttachment* busAttachment, const char* objPath, const int32_t targetDuration);
 
+/**
+ * Enable the countdown engine of Timer interface.
+ * ReferenceTimer, TargetTimeToStart, TargetTimeToStop, EstimatedTimeToEnd and RunningTime are then computed
+ * from the clock when they are read, and their changes are emitted in one PropertiesChanged signal every emitInterval.
+ * SetTargetTimeToStart and SetTargetTimeToStop are accepted without a listener; the listener handlers, if set, can reject them.
+ * Cdm_ProcessTimers should be called from the message loop.
+ * @param[in] objPath the object path including the interface. It must stay valid while the interface exists.
+ * @param[in] emitInterval seconds between PropertiesChanged signals of counting properties, 0 to emit only when they are set
+ * @param[in] handler handler called when a target time is reached, can be NULL
+ * @return AJ_OK on success
+ */
+AJ_Status Cdm_TimerInterfaceEnableEngine(const char* objPath, const uint16_t emitInterval, TimerTargetTimeHandler handler);
+
+/**
+ * Start counting RunningTime and EstimatedTimeToEnd.
+ * EstimatedTimeToEnd is counted down from TargetDuration minus RunningTime if TargetDuration is set.
+ * @param[in] busAttachment bus attachment
+ * @param[in] objPath the object path including the interface
+ * @return AJ_OK on success, AJ_ERR_DISALLOWED if the engine is not enabled
+ */
+AJ_Status Cdm_TimerInterfaceStartRunning(AJ_BusAttachment* busAttachment, const char* objPath);
+
+/**
+ * Stop counting RunningTime and EstimatedTimeToEnd.
+ * @param[in] busAttachment bus attachment
+ * @param[in] objPath the object path including the interface
+ * @return AJ_OK on success, AJ_ERR_DISALLOWED if the engine is not enabled
+ */
+AJ_Status Cdm_TimerInterfaceStopRunning(AJ_BusAttachment* busAttachment, const char* objPath);
+
 #endif /* TIMER_H_ */
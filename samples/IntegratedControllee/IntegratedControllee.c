@@ -34,6 +34,7 @@
 #include <ajtcl/services/ServicesHandlers.h>
 #include <ajtcl/services/Common/AllJoynLogo.h>
 #include <ajtcl/cdm/CdmControllee.h>
+#include <ajtcl/cdm/interfaces/CdmTimerWheel.h>
 #include <ajtcl/cdm/interfaces/environment/CurrentAirQuality.h>
 #include <ajtcl/cdm/interfaces/environment/CurrentAirQualityLevel.h>
 #include <ajtcl/cdm/interfaces/environment/CurrentTemperature.h>
@@ -193,6 +194,9 @@ static AJSVC_ServiceStatus AJApp_MessageProcessor(AJ_BusAttachment* busAttachmen
         session_accepted |= (port == AJ_ABOUT_SERVICE_PORT);
         session_accepted |= AJSVC_CheckSessionAccepted(port, sessionId, joiner);
         *status = AJ_BusReplyAcceptSession(msg, session_accepted);
+        if (*status == AJ_OK && session_accepted) {
+            Cdm_SessionJoined(sessionId);
+        }
         AJ_AlwaysPrintf(("%s session session_id=%u joiner=%s for port %u\n", (session_accepted ? "Accepted" : "Rejected"), sessionId, joiner, port));
     } else {
         switch (currentServicesInitializationState) {
@@ -215,6 +219,8 @@ static AJ_Status AJApp_DisconnectHandler(AJ_BusAttachment* busAttachment, uint8_
 {
     AJ_Status status = AJ_OK;
 
+    Cdm_SessionLost(0);
+
     if (restart) {
         AJ_BusUnbindSession(busAttachment, AJ_ABOUT_SERVICE_PORT);
     }
@@ -2745,7 +2751,7 @@ int AJ_Main(void)
         }
 
         if (status == AJ_OK) {
-            status = AJ_UnmarshalMsg(&busAttachment, &msg, AJAPP_UNMARSHAL_TIMEOUT);
+            status = AJ_UnmarshalMsg(&busAttachment, &msg, Cdm_TimerWheelGetTimeout(AJAPP_UNMARSHAL_TIMEOUT));
             isUnmarshalingSuccessful = (status == AJ_OK);
 
             if (status == AJ_ERR_TIMEOUT) {
@@ -2770,6 +2776,8 @@ int AJ_Main(void)
 
             //Unmarshaled messages must be closed to free resources
             AJ_CloseMsg(&msg);
+
+            Cdm_ProcessTimers(&busAttachment);
         }
 
         if (status == AJ_ERR_READ || status == AJ_ERR_WRITE || status == AJ_ERR_RESTART || status == AJ_ERR_RESTART_APP) {
@@ -0,0 +1,39 @@
+/******************************************************************************
+ * Copyright AllSeen Alliance. All rights reserved.
+ *
+ *    Permission to use, copy, modify, and/or distribute this software for any
+ *    purpose with or without fee is hereby granted, provided that the above
+ *    copyright notice and this permission notice appear in all copies.
+ *
+ *    THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ *    WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ *    ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ *    WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ *    ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ *    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ ******************************************************************************/
+
+
+#ifndef CDMALLOCTRACKINGIMPL_H_
+#define CDMALLOCTRACKINGIMPL_H_
+
+#include <ajtcl/alljoyn.h>
+
+/**
+ * Allocation counters of the process
+ */
+typedef struct {
+    uint32_t allocs;
+    uint32_t frees;
+    uint32_t bytes;
+} CdmAllocCounter;
+
+/**
+ * Read the allocation counters. They count when CDM_ALLOC_TRACKING is defined and malloc, calloc, realloc and free
+ * are wrapped at link time, and stay zero otherwise.
+ * @param[out] counter allocation counters
+ */
+void CdmGetAllocCounter(CdmAllocCounter* counter);
+
+#endif /* CDMALLOCTRACKINGIMPL_H_ */
@@ -14,10 +14,23 @@
  *    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
  ******************************************************************************/
 
+/**
+ * Per-module definition of the current module for debug logging.  Must be defined
+ * prior to first inclusion of aj_debug.h.
+ */
+#define AJ_MODULE CDM
+
 #include <stdlib.h>
 #include <string.h>
+#include <ajtcl/aj_debug.h>
+#include <ajtcl/aj_nvram.h>
 #include <ajtcl/cdm/CdmControllee.h>
+#include <ajtcl/cdm/interfaces/CdmInterfaceErrors.h>
 #include "CdmControlleeImpl.h"
+#include "CdmTraceImpl.h"
+#include "CdmAllocTrackingImpl.h"
+#include "../interfaces/CdmArrayBufferImpl.h"
+#include "../interfaces/CdmTimerWheelImpl.h"
 #include "../interfaces/operation/AlertsImpl.h"
 #include "../interfaces/operation/AudioVolumeImpl.h"
 #include "../interfaces/operation/AudioVideoInputImpl.h"
@@ -63,6 +76,75 @@
 
 #define CDM_OBJECT_LIST_INDEX AJAPP_OBJECTS_LIST_INDEX
 
+#ifndef NDEBUG
+#ifndef ER_DEBUG_CDM
+#define ER_DEBUG_CDM 0
+#endif
+AJ_EXPORT uint8_t dbgCDM = ER_DEBUG_CDM;
+#endif
+
+#define SNAPSHOT_MAGIC 0x534D4443 //"CDMS"
+#define SNAPSHOT_FORMAT_VERSION 3 //bumped whenever the record layout of an interface changes
+#define SNAPSHOT_INITIAL_CAPACITY 256
+
+#ifndef CDM_MAX_SESSIONS
+#define CDM_MAX_SESSIONS 8
+#endif
+
+#ifndef CDM_MAX_DEFERRED_REPLIES
+#define CDM_MAX_DEFERRED_REPLIES 4
+#endif
+
+#ifndef CDM_DEFERRED_REPLY_TIMEOUT
+#define CDM_DEFERRED_REPLY_TIMEOUT 10000
+#endif
+
+#define MAX_SENDER_SIZE 32
+
+typedef struct {
+    uint32_t magic;
+    uint16_t formatVersion;
+    uint16_t numRecords;
+    uint32_t payloadSize;
+    uint32_t checksum;
+} SnapshotHeader;
+
+typedef struct {
+    uint16_t intfType;
+    uint16_t pathLen;
+    uint32_t dataLen;
+} SnapshotRecordHeader;
+
+//What is kept of a request to reply it after the message is released
+typedef struct {
+    CdmReplyToken token;
+    uint32_t msgId;
+    uint32_t serialNum;
+    uint32_t sessionId;
+    uint8_t flags;
+    char sender[MAX_SENDER_SIZE];
+    uint32_t propId;
+    const char* signature;
+    CdmTimer timer;
+} DeferredReply;
+
+typedef struct {
+    CdmInterfaceTypes intfType;
+    uint8_t memberIndex;
+} DeferrableMethod;
+
+//Methods without output arguments whose handlers check CdmIsReplyDeferred
+static const DeferrableMethod deferrableMethods[] = {
+    { ON_CONTROL_INTERFACE, 1 },        //SwitchOn
+    { OFF_CONTROL_INTERFACE, 1 },       //SwitchOff
+    { CYCLE_CONTROL_INTERFACE, 4 },     //ExecuteOperationalCommand
+    { TIMER_INTERFACE, 7 },             //SetTargetTimeToStart
+    { TIMER_INTERFACE, 8 },             //SetTargetTimeToStop
+    { ALERTS_INTERFACE, 3 },            //AcknowledgeAlert
+    { ALERTS_INTERFACE, 4 },            //AcknowledgeAllAlerts
+    { ENERGY_USAGE_INTERFACE, 4 },      //ResetCumulativeEnergy
+};
+
 static const char* const* intfDescs[MAX_BASIC_INTERFACE_TYPE];
 static InterfaceCreator intfCreator[MAX_BASIC_INTERFACE_TYPE] = { NULL, };
 static InterfaceDestructor intfDestructor[MAX_BASIC_INTERFACE_TYPE] = { NULL, };
@@ -70,11 +152,28 @@ static OnGetProperty onGetProperty[MAX_BASIC_INTERFACE_TYPE] = { NULL, };
 static OnSetProperty onSetProperty[MAX_BASIC_INTERFACE_TYPE] = { NULL, };
 static EmitPropertiesChanged emitPropertiesChanged[MAX_BASIC_INTERFACE_TYPE] = { NULL, };
 static OnMethodHandler onMethodHandler[MAX_BASIC_INTERFACE_TYPE] = { NULL, };
+static SaveProperties saveProperties[MAX_BASIC_INTERFACE_TYPE] = { NULL, };
+static LoadProperties loadProperties[MAX_BASIC_INTERFACE_TYPE] = { NULL, };
+static SetConstraintPolicy setConstraintPolicy[MAX_BASIC_INTERFACE_TYPE] = { NULL, };
 static CdmObjectInfo* objInfoFirst;
 static CdmObjectInfo* objInfoLast;
 static AJ_Object* ajObjects;
+static AJ_Object* insecureObjects = NULL;
 static VendorDefinedInterfaceInfo* vendorDefinedIntfInfoFirst;
 static VendorDefinedInterfaceInfo* vendorDefinedIntfInfoLast;
+static uint32_t sessionIds[CDM_MAX_SESSIONS];
+static uint8_t numSessions;
+static bool sessionsOverflowed;
+static DeferredReply deferredReplies[CDM_MAX_DEFERRED_REPLIES];
+static CdmReplyToken lastReplyToken;
+static AJ_Message* deferrableMsg;
+static uint32_t deferrablePropId;
+static const char* deferrableSignature;
+static DeferredReply* deferredReply;
+static bool valuePulled;
+static CdmAllocCounter allocWatchStart;
+static CdmInterfaceInfo* allocWatchIntf;
+static const char* allocWatchPath;
 
 static VendorDefinedInterfaceInfo* GetVendorDefinedInterfaceInfo(CdmInterfaceTypes intfType)
 {
@@ -91,6 +190,20 @@ static VendorDefinedInterfaceInfo* GetVendorDefinedInterfaceInfo(CdmInterfaceTyp
     return intfInfo;
 }
 
+static const char* const* GetInterfaceDesc(CdmInterfaceTypes intfType)
+{
+    if (intfType > UNDEFINED_INTERFACE && intfType < VENDOR_DEFINED_INTERFACE) {
+        return intfDescs[intfType];
+    } else if (intfType > VENDOR_DEFINED_INTERFACE) {
+        VendorDefinedInterfaceInfo* vendorDefinedIntfInfo = GetVendorDefinedInterfaceInfo(intfType);
+        if (vendorDefinedIntfInfo) {
+            return vendorDefinedIntfInfo->intfDesc;
+        }
+    }
+
+    return NULL;
+}
+
 AJ_Status Cdm_Init()
 {
     intfDescs[ALERTS_INTERFACE] = intfDescOperationAlerts;
@@ -143,8 +256,8 @@ AJ_Status Cdm_Init()
     intfCreator[CLOSED_STATUS_INTERFACE] = CreateClosedStatusInterface;
     intfCreator[CURRENT_POWER_INTERFACE] = CreateCurrentPowerInterface;
     intfCreator[CYCLE_CONTROL_INTERFACE] = CreateCycleControlInterface;
-    intfCreator[DISH_WASHING_CYCLE_PHASE_INTERFACE] = CreateLaundryCyclePhaseInterface;
-    intfCreator[LAUNDRY_CYCLE_PHASE_INTERFACE] = CreateDishWashingCyclePhaseInterface;
+    intfCreator[DISH_WASHING_CYCLE_PHASE_INTERFACE] = CreateDishWashingCyclePhaseInterface;
+    intfCreator[LAUNDRY_CYCLE_PHASE_INTERFACE] = CreateLaundryCyclePhaseInterface;
     intfCreator[ON_CONTROL_INTERFACE] = CreateOnControlInterface;
     intfCreator[OFF_CONTROL_INTERFACE] = CreateOffControlInterface;
     intfCreator[ON_OFF_STATUS_INTERFACE] = CreateOnOffStatusInterface;
@@ -301,6 +414,8 @@ AJ_Status Cdm_Init()
     emitPropertiesChanged[TARGET_TEMPERATURE_LEVEL_INTERFACE] = TargetTemperatureLevelInterfaceEmitPropertiesChanged;
     emitPropertiesChanged[HVAC_FAN_MODE_INTERFACE] = HvacFanModeInterfaceEmitPropertiesChanged;
     emitPropertiesChanged[RAPID_MODE_TIMED_INTERFACE] = RapidModeTimedInterfaceEmitPropertiesChanged;
+    emitPropertiesChanged[ALERTS_INTERFACE] = AlertsInterfaceEmitPropertiesChanged; //There is no writable property, but Alerts can be changed by acknowledge method calls
+    emitPropertiesChanged[TIMER_INTERFACE] = TimerInterfaceEmitPropertiesChanged; //There is no writable property, but target times are kept by the countdown engine
 
     onMethodHandler[ALERTS_INTERFACE] = AlertsInterfaceOnMethodHandler;
     onMethodHandler[CHANNEL_INTERFACE] = ChannelInterfaceOnMethodHandler;
@@ -315,6 +430,99 @@ AJ_Status Cdm_Init()
     onMethodHandler[TIMER_INTERFACE] = TimerInterfaceOnMethodHandler;
     onMethodHandler[HID_INTERFACE] = HidInterfaceOnMethodHandler;
 
+    saveProperties[ALERTS_INTERFACE] = AlertsInterfaceSaveProperties;
+    saveProperties[AUDIO_VOLUME_INTERFACE] = AudioVolumeInterfaceSaveProperties;
+    saveProperties[AUDIO_VIDEO_INPUT_INTERFACE] = AudioVideoInputInterfaceSaveProperties;
+    saveProperties[CHANNEL_INTERFACE] = ChannelInterfaceSaveProperties;
+    saveProperties[CLOSED_STATUS_INTERFACE] = ClosedStatusInterfaceSaveProperties;
+    saveProperties[CURRENT_POWER_INTERFACE] = CurrentPowerInterfaceSaveProperties;
+    saveProperties[CYCLE_CONTROL_INTERFACE] = CycleControlInterfaceSaveProperties;
+    saveProperties[DISH_WASHING_CYCLE_PHASE_INTERFACE] = DishWashingCyclePhaseInterfaceSaveProperties;
+    saveProperties[LAUNDRY_CYCLE_PHASE_INTERFACE] = LaundryCyclePhaseInterfaceSaveProperties;
+    saveProperties[ON_CONTROL_INTERFACE] = OnControlInterfaceSaveProperties;
+    saveProperties[OFF_CONTROL_INTERFACE] = OffControlInterfaceSaveProperties;
+    saveProperties[ON_OFF_STATUS_INTERFACE] = OnOffStatusInterfaceSaveProperties;
+    saveProperties[OVEN_CYCLE_PHASE_INTERFACE] = OvenCyclePhaseInterfaceSaveProperties;
+    saveProperties[FAN_SPEED_LEVEL_INTERFACE] = FanSpeedLevelInterfaceSaveProperties;
+    saveProperties[BATTERY_STATUS_INTERFACE] = BatteryStatusInterfaceSaveProperties;
+    saveProperties[CLIMATE_CONTROL_MODE_INTERFACE] = ClimateControlModeInterfaceSaveProperties;
+    saveProperties[ENERGY_USAGE_INTERFACE] = EnergyUsageInterfaceSaveProperties;
+    saveProperties[HEATING_ZONE_INTERFACE] = HeatingZoneInterfaceSaveProperties;
+    saveProperties[RAPID_MODE_INTERFACE] = RapidModeInterfaceSaveProperties;
+    saveProperties[REMOTE_CONTROLLABILITY_INTERFACE] = RemoteControllabilityInterfaceSaveProperties;
+    saveProperties[REPEAT_MODE_INTERFACE] = RepeatModeInterfaceSaveProperties;
+    saveProperties[RESOURCE_SAVING_INTERFACE] = ResourceSavingInterfaceSaveProperties;
+    saveProperties[AIR_RECIRCULATION_MODE_INTERFACE] = AirRecirculationModeInterfaceSaveProperties;
+    saveProperties[ROBOT_CLEANING_CYCLE_PHASE_INTERFACE] = RobotCleaningCyclePhaseInterfaceSaveProperties;
+    saveProperties[SOIL_LEVEL_INTERFACE] = SoilLevelInterfaceSaveProperties;
+    saveProperties[SPIN_SPEED_LEVEL_INTERFACE] = SpinSpeedLevelInterfaceSaveProperties;
+    saveProperties[TIMER_INTERFACE] = TimerInterfaceSaveProperties;
+    saveProperties[MOISTURE_OUTPUT_LEVEL_INTERFACE] = MoistureOutputLevelInterfaceSaveProperties;
+    saveProperties[FILTER_STATUS_INTERFACE] = FilterStatusInterfaceSaveProperties;
+    saveProperties[CURRENT_AIR_QUALITY_INTERFACE] = CurrentAirQualityInterfaceSaveProperties;
+    saveProperties[CURRENT_AIR_QUALITY_LEVEL_INTERFACE] = CurrentAirQualityLevelInterfaceSaveProperties;
+    saveProperties[CURRENT_TEMPERATURE_INTERFACE] = CurrentTemperatureInterfaceSaveProperties;
+    saveProperties[TARGET_TEMPERATURE_INTERFACE] = TargetTemperatureInterfaceSaveProperties;
+    saveProperties[WATER_LEVEL_INTERFACE] = WaterLevelInterfaceSaveProperties;
+    saveProperties[WIND_DIRECTION_INTERFACE] = WindDirectionInterfaceSaveProperties;
+    saveProperties[HID_INTERFACE] = HidInterfaceSaveProperties;
+    saveProperties[CURRENT_HUMIDITY_INTERFACE] = CurrentHumidityInterfaceSaveProperties;
+    saveProperties[TARGET_HUMIDITY_INTERFACE] = TargetHumidityInterfaceSaveProperties;
+    saveProperties[TARGET_TEMPERATURE_LEVEL_INTERFACE] = TargetTemperatureLevelInterfaceSaveProperties;
+    saveProperties[HVAC_FAN_MODE_INTERFACE] = HvacFanModeInterfaceSaveProperties;
+    saveProperties[PLUG_IN_UNITS_INTERFACE] = PlugInUnitsInterfaceSaveProperties;
+    saveProperties[RAPID_MODE_TIMED_INTERFACE] = RapidModeTimedInterfaceSaveProperties;
+
+    loadProperties[ALERTS_INTERFACE] = AlertsInterfaceLoadProperties;
+    loadProperties[AUDIO_VOLUME_INTERFACE] = AudioVolumeInterfaceLoadProperties;
+    loadProperties[AUDIO_VIDEO_INPUT_INTERFACE] = AudioVideoInputInterfaceLoadProperties;
+    loadProperties[CHANNEL_INTERFACE] = ChannelInterfaceLoadProperties;
+    loadProperties[CLOSED_STATUS_INTERFACE] = ClosedStatusInterfaceLoadProperties;
+    loadProperties[CURRENT_POWER_INTERFACE] = CurrentPowerInterfaceLoadProperties;
+    loadProperties[CYCLE_CONTROL_INTERFACE] = CycleControlInterfaceLoadProperties;
+    loadProperties[DISH_WASHING_CYCLE_PHASE_INTERFACE] = DishWashingCyclePhaseInterfaceLoadProperties;
+    loadProperties[LAUNDRY_CYCLE_PHASE_INTERFACE] = LaundryCyclePhaseInterfaceLoadProperties;
+    loadProperties[ON_CONTROL_INTERFACE] = OnControlInterfaceLoadProperties;
+    loadProperties[OFF_CONTROL_INTERFACE] = OffControlInterfaceLoadProperties;
+    loadProperties[ON_OFF_STATUS_INTERFACE] = OnOffStatusInterfaceLoadProperties;
+    loadProperties[OVEN_CYCLE_PHASE_INTERFACE] = OvenCyclePhaseInterfaceLoadProperties;
+    loadProperties[FAN_SPEED_LEVEL_INTERFACE] = FanSpeedLevelInterfaceLoadProperties;
+    loadProperties[BATTERY_STATUS_INTERFACE] = BatteryStatusInterfaceLoadProperties;
+    loadProperties[CLIMATE_CONTROL_MODE_INTERFACE] = ClimateControlModeInterfaceLoadProperties;
+    loadProperties[ENERGY_USAGE_INTERFACE] = EnergyUsageInterfaceLoadProperties;
+    loadProperties[HEATING_ZONE_INTERFACE] = HeatingZoneInterfaceLoadProperties;
+    loadProperties[RAPID_MODE_INTERFACE] = RapidModeInterfaceLoadProperties;
+    loadProperties[REMOTE_CONTROLLABILITY_INTERFACE] = RemoteControllabilityInterfaceLoadProperties;
+    loadProperties[REPEAT_MODE_INTERFACE] = RepeatModeInterfaceLoadProperties;
+    loadProperties[RESOURCE_SAVING_INTERFACE] = ResourceSavingInterfaceLoadProperties;
+    loadProperties[AIR_RECIRCULATION_MODE_INTERFACE] = AirRecirculationModeInterfaceLoadProperties;
+    loadProperties[ROBOT_CLEANING_CYCLE_PHASE_INTERFACE] = RobotCleaningCyclePhaseInterfaceLoadProperties;
+    loadProperties[SOIL_LEVEL_INTERFACE] = SoilLevelInterfaceLoadProperties;
+    loadProperties[SPIN_SPEED_LEVEL_INTERFACE] = SpinSpeedLevelInterfaceLoadProperties;
+    loadProperties[TIMER_INTERFACE] = TimerInterfaceLoadProperties;
+    loadProperties[MOISTURE_OUTPUT_LEVEL_INTERFACE] = MoistureOutputLevelInterfaceLoadProperties;
+    loadProperties[FILTER_STATUS_INTERFACE] = FilterStatusInterfaceLoadProperties;
+    loadProperties[CURRENT_AIR_QUALITY_INTERFACE] = CurrentAirQualityInterfaceLoadProperties;
+    loadProperties[CURRENT_AIR_QUALITY_LEVEL_INTERFACE] = CurrentAirQualityLevelInterfaceLoadProperties;
+    loadProperties[CURRENT_TEMPERATURE_INTERFACE] = CurrentTemperatureInterfaceLoadProperties;
+    loadProperties[TARGET_TEMPERATURE_INTERFACE] = TargetTemperatureInterfaceLoadProperties;
+    loadProperties[WATER_LEVEL_INTERFACE] = WaterLevelInterfaceLoadProperties;
+    loadProperties[WIND_DIRECTION_INTERFACE] = WindDirectionInterfaceLoadProperties;
+    loadProperties[HID_INTERFACE] = HidInterfaceLoadProperties;
+    loadProperties[CURRENT_HUMIDITY_INTERFACE] = CurrentHumidityInterfaceLoadProperties;
+    loadProperties[TARGET_HUMIDITY_INTERFACE] = TargetHumidityInterfaceLoadProperties;
+    loadProperties[TARGET_TEMPERATURE_LEVEL_INTERFACE] = TargetTemperatureLevelInterfaceLoadProperties;
+    loadProperties[HVAC_FAN_MODE_INTERFACE] = HvacFanModeInterfaceLoadProperties;
+    loadProperties[PLUG_IN_UNITS_INTERFACE] = PlugInUnitsInterfaceLoadProperties;
+    loadProperties[RAPID_MODE_TIMED_INTERFACE] = RapidModeTimedInterfaceLoadProperties;
+
+    setConstraintPolicy[TARGET_TEMPERATURE_INTERFACE] = TargetTemperatureInterfaceSetConstraintPolicy;
+    setConstraintPolicy[TARGET_TEMPERATURE_LEVEL_INTERFACE] = TargetTemperatureLevelInterfaceSetConstraintPolicy;
+    setConstraintPolicy[TARGET_HUMIDITY_INTERFACE] = TargetHumidityInterfaceSetConstraintPolicy;
+    setConstraintPolicy[WIND_DIRECTION_INTERFACE] = WindDirectionInterfaceSetConstraintPolicy;
+    setConstraintPolicy[FAN_SPEED_LEVEL_INTERFACE] = FanSpeedLevelInterfaceSetConstraintPolicy;
+    setConstraintPolicy[MOISTURE_OUTPUT_LEVEL_INTERFACE] = MoistureOutputLevelInterfaceSetConstraintPolicy;
+
     objInfoFirst = NULL;
     objInfoLast = NULL;
 
@@ -332,6 +540,7 @@ void Cdm_Deinit()
     CdmInterfaceInfo* tempIntfInfo = NULL;
     VendorDefinedInterfaceInfo* vendorDefinedIntfInfo = NULL;
     VendorDefinedInterfaceInfo* tempVendorDefinedIntfInfo = NULL;
+    uint8_t i = 0;
 
     while (objInfo) {
         intfInfo = objInfo->intfFirst;
@@ -352,6 +561,9 @@ void Cdm_Deinit()
                 }
             }
 
+            if (intfInfo->propSources) {
+                free(intfInfo->propSources);
+            }
             tempIntfInfo = intfInfo;
             intfInfo = intfInfo->intfNext;
             free(tempIntfInfo);
@@ -374,7 +586,16 @@ void Cdm_Deinit()
 
     if (ajObjects) {
         free(ajObjects);
+        ajObjects = NULL;
+    }
+    CdmArrayBufferFreeScratch();
+
+    for (i = 0; i < CDM_MAX_DEFERRED_REPLIES; i++) {
+        Cdm_TimerWheelCancel(&deferredReplies[i].timer);
     }
+    memset(deferredReplies, 0, sizeof(deferredReplies));
+
+    Cdm_SessionLost(0);
 }
 
 static CdmObjectInfo* FindObject(const char* objPath)
@@ -431,6 +652,7 @@ AJ_Status Cdm_CreateInterface(CdmInterfaceTypes intfType, const char* objPath, v
     memset(intfInfo, 0, sizeof(CdmInterfaceInfo));
     intfInfo->intfType = intfType;
     intfInfo->listener = listener;
+    intfInfo->allocBudget = CDM_ALLOC_BUDGET_NONE;
 
     if (!vendorDefinedIntfHandler) {
         status = intfCreator[intfType](&intfInfo->properties);
@@ -465,9 +687,277 @@ AJ_Status Cdm_CreateInterface(CdmInterfaceTypes intfType, const char* objPath, v
         objInfo->intfLast->intfNext = intfInfo;
         objInfo->intfLast = intfInfo;
     }
+
+    if (intfType == REMOTE_CONTROLLABILITY_INTERFACE) {
+        objInfo->remoteControllability = intfInfo;
+    }
+
+    return AJ_OK;
+}
+
+AJ_Status Cdm_SetConstraintPolicy(const char* objPath, CdmInterfaceTypes intfType, CdmConstraintPolicy policy)
+{
+    void* properties = NULL;
+
+    if (!objPath) {
+        return AJ_ERR_INVALID;
+    }
+
+    if (intfType <= UNDEFINED_INTERFACE || intfType >= MAX_BASIC_INTERFACE_TYPE || !setConstraintPolicy[intfType]) {
+        return AJ_ERR_INVALID;
+    }
+
+    if (policy != CDM_CONSTRAINT_POLICY_REJECT && policy != CDM_CONSTRAINT_POLICY_SNAP) {
+        return AJ_ERR_INVALID;
+    }
+
+    properties = GetProperties(objPath, intfType);
+    if (!properties) {
+        return AJ_ERR_NO_MATCH;
+    }
+
+    setConstraintPolicy[intfType](properties, policy);
+
+    return AJ_OK;
+}
+
+AJ_Status Cdm_SetPropertiesChangedDelivery(const char* objPath, CdmPropChangedDelivery delivery)
+{
+    CdmObjectInfo* objInfo = NULL;
+
+    if (!objPath) {
+        return AJ_ERR_INVALID;
+    }
+
+    if (delivery != CDM_PROP_CHANGED_BROADCAST && delivery != CDM_PROP_CHANGED_SESSIONS) {
+        return AJ_ERR_INVALID;
+    }
+
+    objInfo = FindObject(objPath);
+    if (!objInfo) {
+        return AJ_ERR_NO_MATCH;
+    }
+
+    objInfo->propChangedDelivery = delivery;
+
+    return AJ_OK;
+}
+
+static CdmInterfaceInfo* FindInterface(const char* objPath, CdmInterfaceTypes intfType)
+{
+    CdmObjectInfo* objInfo = FindObject(objPath);
+    CdmInterfaceInfo* intfInfo = NULL;
+
+    if (objInfo) {
+        intfInfo = objInfo->intfFirst;
+        while (intfInfo && intfInfo->intfType != intfType) {
+            intfInfo = intfInfo->intfNext;
+        }
+    }
+
+    return intfInfo;
+}
+
+static AJ_Status AllocPropertySources(CdmInterfaceInfo* intfInfo)
+{
+    const char* const* intfDesc = NULL;
+    uint8_t numMembers = 0;
+
+    if (intfInfo->propSources) {
+        return AJ_OK;
+    }
+
+    intfDesc = GetInterfaceDesc(intfInfo->intfType);
+    if (!intfDesc) {
+        return AJ_ERR_NO_MATCH;
+    }
+
+    while (intfDesc[numMembers + 1]) {
+        numMembers++;
+    }
+
+    intfInfo->propSources = (CdmPropertySourceInfo*)malloc(sizeof(CdmPropertySourceInfo) * numMembers);
+    if (!intfInfo->propSources) {
+        return AJ_ERR_RESOURCES;
+    }
+    memset(intfInfo->propSources, 0, sizeof(CdmPropertySourceInfo) * numMembers);
+    intfInfo->numPropSources = numMembers;
+
+    return AJ_OK;
+}
+
+AJ_Status Cdm_SetPropertySource(const char* objPath, CdmInterfaceTypes intfType, const char* propName, CdmPropertySource source, uint32_t ttl)
+{
+    AJ_Status status = AJ_OK;
+    CdmInterfaceInfo* intfInfo = NULL;
+    const char* const* intfDesc = NULL;
+    uint8_t i = 0;
+    bool found = false;
+
+    if (!objPath) {
+        return AJ_ERR_INVALID;
+    }
+
+    if (source != CDM_PROPERTY_SOURCE_PULL && source != CDM_PROPERTY_SOURCE_PUSH && source != CDM_PROPERTY_SOURCE_PULL_TTL) {
+        return AJ_ERR_INVALID;
+    }
+
+    intfInfo = FindInterface(objPath, intfType);
+    if (!intfInfo) {
+        return AJ_ERR_NO_MATCH;
+    }
+
+    status = AllocPropertySources(intfInfo);
+    if (status != AJ_OK) {
+        return status;
+    }
+    intfDesc = GetInterfaceDesc(intfType);
+
+    //member index of a property is the index of its description entry, not counting the interface name
+    for (i = 0; i < intfInfo->numPropSources; i++) {
+        const char* member = intfDesc[i + 1];
+
+        if (member[0] != '@') {
+            continue;
+        }
+        if (propName) {
+            size_t len = strlen(propName);
+            if (strncmp(member + 1, propName, len) || !strchr("<>=", member[len + 1])) {
+                continue;
+            }
+        }
+
+        intfInfo->propSources[i].source = source;
+        intfInfo->propSources[i].ttl = ttl;
+        intfInfo->propSources[i].pulled = false;
+        found = true;
+    }
+
+    return found ? AJ_OK : AJ_ERR_NO_MATCH;
+}
+
+AJ_Status Cdm_SetLatencyBudget(const char* objPath, CdmInterfaceTypes intfType, uint32_t budget, bool switchToPush)
+{
+    CdmInterfaceInfo* intfInfo = NULL;
+
+    if (!objPath) {
+        return AJ_ERR_INVALID;
+    }
+
+    intfInfo = FindInterface(objPath, intfType);
+    if (!intfInfo) {
+        return AJ_ERR_NO_MATCH;
+    }
+
+    intfInfo->latencyBudget = budget;
+    intfInfo->latencySwitchToPush = switchToPush;
+    memset(&intfInfo->latencyStats, 0, sizeof(CdmLatencyStats));
+
+    return AJ_OK;
+}
+
+AJ_Status Cdm_GetLatencyStats(const char* objPath, CdmInterfaceTypes intfType, CdmLatencyStats* stats)
+{
+    CdmInterfaceInfo* intfInfo = NULL;
+
+    if (!objPath || !stats) {
+        return AJ_ERR_INVALID;
+    }
+
+    intfInfo = FindInterface(objPath, intfType);
+    if (!intfInfo) {
+        return AJ_ERR_NO_MATCH;
+    }
+
+    memcpy(stats, &intfInfo->latencyStats, sizeof(CdmLatencyStats));
+
+    return AJ_OK;
+}
+
+AJ_Status Cdm_SetAllocBudget(const char* objPath, CdmInterfaceTypes intfType, uint32_t budget)
+{
+    CdmInterfaceInfo* intfInfo = NULL;
+
+    if (!objPath) {
+        return AJ_ERR_INVALID;
+    }
+
+    intfInfo = FindInterface(objPath, intfType);
+    if (!intfInfo) {
+        return AJ_ERR_NO_MATCH;
+    }
+
+    intfInfo->allocBudget = budget;
+    memset(&intfInfo->allocStats, 0, sizeof(CdmAllocStats));
+
+    return AJ_OK;
+}
+
+AJ_Status Cdm_GetAllocStats(const char* objPath, CdmInterfaceTypes intfType, CdmAllocStats* stats)
+{
+    CdmInterfaceInfo* intfInfo = NULL;
+
+    if (!objPath || !stats) {
+        return AJ_ERR_INVALID;
+    }
+
+    intfInfo = FindInterface(objPath, intfType);
+    if (!intfInfo) {
+        return AJ_ERR_NO_MATCH;
+    }
+
+    memcpy(stats, &intfInfo->allocStats, sizeof(CdmAllocStats));
+
+    return AJ_OK;
+}
+
+AJ_Status Cdm_SessionJoined(uint32_t sessionId)
+{
+    uint8_t i = 0;
+
+    if (sessionId == 0) {
+        return AJ_ERR_INVALID;
+    }
+
+    for (i = 0; i < numSessions; i++) {
+        if (sessionIds[i] == sessionId) {
+            return AJ_OK;
+        }
+    }
+
+    if (numSessions == CDM_MAX_SESSIONS) {
+        sessionsOverflowed = true;
+        return AJ_ERR_RESOURCES;
+    }
+
+    sessionIds[numSessions++] = sessionId;
+
     return AJ_OK;
 }
 
+void Cdm_SessionLost(uint32_t sessionId)
+{
+    uint8_t i = 0;
+
+    if (sessionId == 0) {
+        numSessions = 0;
+        sessionsOverflowed = false;
+        return;
+    }
+
+    for (i = 0; i < numSessions; i++) {
+        if (sessionIds[i] == sessionId) {
+            sessionIds[i] = sessionIds[--numSessions];
+            break;
+        }
+    }
+
+    //Untracked sessions may be gone only when all are
+    if (numSessions == 0) {
+        sessionsOverflowed = false;
+    }
+}
+
 static void CleanInterfaceDescs()
 {
     CdmObjectInfo* objInfo = objInfoFirst;
@@ -554,54 +1044,493 @@ AJ_Status Cdm_Start()
     return AJ_OK;
 }
 
-AJ_Status Cdm_EnableSecurity(AJ_BusAttachment* busAttachment, const uint32_t* suites, const size_t numOfSuites,
-                             AJ_AuthListenerFunc authListenerCallback)
+static void FreeInsecureObjects(void)
 {
-    AJ_Status status = AJ_OK;
+    int i = 0, j = 0;
 
-    status = AJ_BusEnableSecurity(busAttachment, suites, numOfSuites);
-    if (status == AJ_OK) {
-        AJ_BusSetAuthListenerCallback(busAttachment, authListenerCallback);
+    if (!insecureObjects) {
+        return;
     }
 
-    return status;
+    for (i = 0; insecureObjects[i].path; i++) {
+        AJ_InterfaceDescription* intfDesc = (AJ_InterfaceDescription*)insecureObjects[i].interfaces;
+        if (!intfDesc) {
+            continue;
+        }
+        for (j = 0; intfDesc[j]; j++) {
+            if (intfDesc[j] != ajObjects[i].interfaces[j]) {
+                free((void*)intfDesc[j]);
+            }
+        }
+        free(intfDesc);
+    }
+    free(insecureObjects);
+    insecureObjects = NULL;
 }
 
-static bool IsCdmMsg(uint32_t msgId)
+AJ_Status CdmRegisterInsecureObjects(bool insecure)
 {
-    if ((msgId >> 24) == CDM_OBJECT_LIST_INDEX) {
-        return true;
+    int numOfObjs = 0;
+    int i = 0, j = 0, k = 0;
+
+    if (!insecure) {
+        if (insecureObjects) {
+            AJ_RegisterObjectList(ajObjects, CDM_OBJECT_LIST_INDEX);
+            FreeInsecureObjects();
+        }
+        return AJ_OK;
     }
 
-    return false;
-}
+    if (!ajObjects) {
+        return AJ_ERR_UNEXPECTED;
+    }
+    if (insecureObjects) {
+        return AJ_OK;
+    }
 
-static uint8_t GetObjectIndex(uint32_t msgId)
-{
-    return (uint8_t)((msgId & 0x00FF0000) >> 16);
-}
+    while (ajObjects[numOfObjs].path) {
+        numOfObjs++;
+    }
+    insecureObjects = (AJ_Object*)malloc(sizeof(AJ_Object) * (numOfObjs+1));
+    if (!insecureObjects) {
+        return AJ_ERR_RESOURCES;
+    }
+    memset(insecureObjects, 0, sizeof(AJ_Object) * (numOfObjs+1));
 
-static uint8_t GetInterfaceIndex(uint32_t msgId)
-{
-    return (uint8_t)((msgId & 0x0000FF00) >> 8);
-}
+    for (i = 0; i < numOfObjs; i++) {
+        const AJ_InterfaceDescription* orgIntfDesc = ajObjects[i].interfaces;
+        AJ_InterfaceDescription* intfDesc = NULL;
+        int numOfIntfs = 0;
 
-static uint8_t GetMemberIndex(uint32_t msgId)
-{
-    return (uint8_t)(msgId & 0x0000FF);
-}
+        memcpy(&insecureObjects[i], &ajObjects[i], sizeof(AJ_Object));
+        insecureObjects[i].interfaces = NULL;
+        while (orgIntfDesc[numOfIntfs]) {
+            numOfIntfs++;
+        }
+        intfDesc = (AJ_InterfaceDescription*)malloc(sizeof(AJ_InterfaceDescription) * (numOfIntfs+1));
+        if (!intfDesc) {
+            FreeInsecureObjects();
+            return AJ_ERR_RESOURCES;
+        }
+        memset(intfDesc, 0, sizeof(AJ_InterfaceDescription) * (numOfIntfs+1));
+        insecureObjects[i].interfaces = intfDesc;
 
-static CdmObjectInfo* GetObjectInfo(uint8_t objIndex)
-{
-    CdmObjectInfo* objInfo = objInfoFirst;
-    uint8_t i = 0;
+        for (j = 0; j < numOfIntfs; j++) {
+            const char** desc = NULL;
+            int numOfMembers = 0;
 
-    for (i=0; i<objIndex; i++) {
-        if (!objInfo) {
-            break;
+            //'$' marks a secure interface, the interface name itself is the same
+            if (orgIntfDesc[j][0][0] != '$') {
+                intfDesc[j] = orgIntfDesc[j];
+                continue;
+            }
+            while (orgIntfDesc[j][numOfMembers]) {
+                numOfMembers++;
+            }
+            desc = (const char**)malloc(sizeof(const char*) * (numOfMembers+1));
+            if (!desc) {
+                FreeInsecureObjects();
+                return AJ_ERR_RESOURCES;
+            }
+            for (k = 0; k <= numOfMembers; k++) {
+                desc[k] = orgIntfDesc[j][k];
+            }
+            desc[0]++;
+            intfDesc[j] = desc;
         }
-
-        objInfo = objInfo->objNext;
+    }
+
+    AJ_RegisterObjectList(insecureObjects, CDM_OBJECT_LIST_INDEX);
+
+    return AJ_OK;
+}
+
+AJ_Status CdmSnapshotWrite(CdmSnapshotWriter* writer, const void* data, size_t len)
+{
+    if (!writer || (!data && len)) {
+        return AJ_ERR_INVALID;
+    }
+
+    if (writer->size + len > writer->capacity) {
+        size_t capacity = writer->capacity ? writer->capacity : SNAPSHOT_INITIAL_CAPACITY;
+        uint8_t* buf = NULL;
+
+        while (capacity < writer->size + len) {
+            capacity *= 2;
+        }
+        buf = (uint8_t*)realloc(writer->buf, capacity);
+        if (!buf) {
+            return AJ_ERR_RESOURCES;
+        }
+        writer->buf = buf;
+        writer->capacity = capacity;
+    }
+
+    if (len) {
+        memcpy(writer->buf + writer->size, data, len);
+        writer->size += len;
+    }
+
+    return AJ_OK;
+}
+
+AJ_Status CdmSnapshotWriteArray(CdmSnapshotWriter* writer, const void* data, size_t elemSize, size_t count)
+{
+    AJ_Status status = AJ_OK;
+    uint32_t num = (uint32_t)count;
+
+    if (!data) {
+        num = 0;
+    }
+
+    status = CdmSnapshotWrite(writer, &num, sizeof(num));
+    if (status == AJ_OK) {
+        status = CdmSnapshotWrite(writer, data, elemSize * num);
+    }
+
+    return status;
+}
+
+AJ_Status CdmSnapshotWriteString(CdmSnapshotWriter* writer, const char* str)
+{
+    return CdmSnapshotWriteArray(writer, str, sizeof(char), str ? strlen(str) : 0);
+}
+
+AJ_Status CdmSnapshotRead(CdmSnapshotReader* reader, void* data, size_t len)
+{
+    if (!reader || !data) {
+        return AJ_ERR_INVALID;
+    }
+
+    if (len > reader->size - reader->offset) {
+        return AJ_ERR_END_OF_DATA;
+    }
+
+    memcpy(data, reader->buf + reader->offset, len);
+    reader->offset += len;
+
+    return AJ_OK;
+}
+
+AJ_Status CdmSnapshotReadArray(CdmSnapshotReader* reader, void** data, size_t elemSize, size_t* count)
+{
+    AJ_Status status = AJ_OK;
+    uint32_t num = 0;
+
+    if (!data || !count || !elemSize) {
+        return AJ_ERR_INVALID;
+    }
+
+    status = CdmSnapshotRead(reader, &num, sizeof(num));
+    if (status != AJ_OK) {
+        return status;
+    }
+
+    if (num > (reader->size - reader->offset) / elemSize) {
+        return AJ_ERR_END_OF_DATA;
+    }
+
+    *data = NULL;
+    *count = num;
+    if (num) {
+        *data = malloc(elemSize * num);
+        if (!(*data)) {
+            return AJ_ERR_RESOURCES;
+        }
+        CdmSnapshotRead(reader, *data, elemSize * num);
+    }
+
+    return AJ_OK;
+}
+
+AJ_Status CdmSnapshotReadString(CdmSnapshotReader* reader, char** str)
+{
+    AJ_Status status = AJ_OK;
+    uint32_t len = 0;
+
+    if (!str) {
+        return AJ_ERR_INVALID;
+    }
+
+    status = CdmSnapshotRead(reader, &len, sizeof(len));
+    if (status != AJ_OK) {
+        return status;
+    }
+
+    if (len > reader->size - reader->offset) {
+        return AJ_ERR_END_OF_DATA;
+    }
+
+    *str = (char*)malloc(len + 1);
+    if (!(*str)) {
+        return AJ_ERR_RESOURCES;
+    }
+    CdmSnapshotRead(reader, *str, len);
+    (*str)[len] = '\0';
+
+    return AJ_OK;
+}
+
+static uint32_t SnapshotChecksum(const uint8_t* buf, size_t size)
+{
+    uint32_t hash = 2166136261U; //FNV-1a
+    size_t i = 0;
+
+    for (i = 0; i < size; i++) {
+        hash ^= buf[i];
+        hash *= 16777619U;
+    }
+
+    return hash;
+}
+
+AJ_Status Cdm_SaveSnapshot(const uint16_t nvramId)
+{
+    AJ_Status status = AJ_OK;
+    CdmSnapshotWriter writer = { NULL, 0, 0 };
+    SnapshotHeader header = { SNAPSHOT_MAGIC, SNAPSHOT_FORMAT_VERSION, 0, 0, 0 };
+    CdmObjectInfo* objInfo = objInfoFirst;
+    CdmInterfaceInfo* intfInfo = NULL;
+    AJ_NV_DATASET* handle = NULL;
+
+    while (objInfo && status == AJ_OK) {
+        size_t pathLen = strlen(objInfo->path);
+
+        intfInfo = objInfo->intfFirst;
+        while (intfInfo && status == AJ_OK) {
+            if (intfInfo->intfType > UNDEFINED_INTERFACE && intfInfo->intfType < VENDOR_DEFINED_INTERFACE &&
+                saveProperties[intfInfo->intfType]) {
+                SnapshotRecordHeader record = { (uint16_t)intfInfo->intfType, (uint16_t)pathLen, 0 };
+                size_t recordOffset = writer.size;
+
+                if (pathLen > 0xFFFF || header.numRecords == 0xFFFF) {
+                    status = AJ_ERR_RESOURCES;
+                    break;
+                }
+                status = CdmSnapshotWrite(&writer, &record, sizeof(record));
+                if (status == AJ_OK) {
+                    status = CdmSnapshotWrite(&writer, objInfo->path, pathLen);
+                }
+                if (status == AJ_OK) {
+                    status = saveProperties[intfInfo->intfType](intfInfo->properties, &writer);
+                }
+                if (status == AJ_OK) {
+                    record.dataLen = (uint32_t)(writer.size - recordOffset - sizeof(record) - pathLen);
+                    memcpy(writer.buf + recordOffset, &record, sizeof(record));
+                    header.numRecords++;
+                }
+            }
+            intfInfo = intfInfo->intfNext;
+        }
+        objInfo = objInfo->objNext;
+    }
+
+    if (status == AJ_OK && sizeof(header) + writer.size > 0xFFFF) {
+        status = AJ_ERR_RESOURCES;
+    }
+
+    if (status == AJ_OK) {
+        header.payloadSize = (uint32_t)writer.size;
+        header.checksum = SnapshotChecksum(writer.buf, writer.size);
+
+        handle = AJ_NVRAM_Open(nvramId, "w", (uint16_t)(sizeof(header) + writer.size));
+        if (!handle) {
+            status = AJ_ERR_FAILURE;
+        } else {
+            if (AJ_NVRAM_Write(&header, sizeof(header), handle) != sizeof(header) ||
+                (writer.size && AJ_NVRAM_Write(writer.buf, (uint16_t)writer.size, handle) != writer.size)) {
+                status = AJ_ERR_WRITE;
+            }
+            AJ_NVRAM_Close(handle);
+        }
+    }
+
+    if (writer.buf) {
+        free(writer.buf);
+    }
+
+    return status;
+}
+
+static CdmInterfaceInfo* FindSnapshotInterface(const char* path, size_t pathLen, CdmInterfaceTypes intfType)
+{
+    CdmObjectInfo* objInfo = objInfoFirst;
+    CdmInterfaceInfo* intfInfo = NULL;
+
+    while (objInfo) {
+        if (strlen(objInfo->path) == pathLen && !memcmp(objInfo->path, path, pathLen)) {
+            break;
+        }
+        objInfo = objInfo->objNext;
+    }
+
+    if (objInfo) {
+        intfInfo = objInfo->intfFirst;
+        while (intfInfo) {
+            if (intfInfo->intfType == intfType) {
+                break;
+            }
+            intfInfo = intfInfo->intfNext;
+        }
+    }
+
+    return intfInfo;
+}
+
+//Check a record against the current property layout by loading it into a block with the defaults
+static bool IsSnapshotRecordValid(CdmInterfaceTypes intfType, const CdmSnapshotReader* record)
+{
+    CdmSnapshotReader reader = *record;
+    void* properties = NULL;
+    bool valid = false;
+
+    if (intfCreator[intfType](&properties) != AJ_OK) {
+        return false;
+    }
+    valid = (loadProperties[intfType](properties, &reader) == AJ_OK && reader.offset == reader.size) ? true : false;
+    intfDestructor[intfType](properties);
+
+    return valid;
+}
+
+AJ_Status Cdm_LoadSnapshot(const uint16_t nvramId)
+{
+    AJ_Status status = AJ_OK;
+    SnapshotHeader header;
+    CdmSnapshotReader payload = { NULL, 0, 0 };
+    uint8_t* buf = NULL;
+    AJ_NV_DATASET* handle = NULL;
+    uint16_t numMismatched = 0;
+    uint16_t i = 0;
+
+    if (ajObjects) {
+        return AJ_ERR_DISALLOWED;
+    }
+
+    if (!AJ_NVRAM_Exist(nvramId)) {
+        return AJ_ERR_NO_MATCH;
+    }
+
+    handle = AJ_NVRAM_Open(nvramId, "r", 0);
+    if (!handle) {
+        return AJ_ERR_FAILURE;
+    }
+
+    if (AJ_NVRAM_Read(&header, sizeof(header), handle) != sizeof(header)) {
+        status = AJ_ERR_READ;
+    } else if (header.magic != SNAPSHOT_MAGIC || header.formatVersion != SNAPSHOT_FORMAT_VERSION ||
+               header.payloadSize > 0xFFFF - sizeof(header)) {
+        status = AJ_ERR_INVALID;
+    } else if (header.payloadSize) {
+        buf = (uint8_t*)malloc(header.payloadSize);
+        if (!buf) {
+            status = AJ_ERR_RESOURCES;
+        } else if (AJ_NVRAM_Read(buf, (uint16_t)header.payloadSize, handle) != header.payloadSize) {
+            status = AJ_ERR_READ;
+        }
+    }
+    AJ_NVRAM_Close(handle);
+
+    if (status == AJ_OK && SnapshotChecksum(buf, header.payloadSize) != header.checksum) {
+        status = AJ_ERR_INVALID;
+    }
+
+    payload.buf = buf;
+    payload.size = header.payloadSize;
+    for (i = 0; status == AJ_OK && i < header.numRecords; i++) {
+        SnapshotRecordHeader record;
+        CdmSnapshotReader reader = { NULL, 0, 0 };
+        CdmInterfaceInfo* intfInfo = NULL;
+
+        status = CdmSnapshotRead(&payload, &record, sizeof(record));
+        if (status != AJ_OK) {
+            break;
+        }
+        if (record.pathLen > payload.size - payload.offset ||
+            record.dataLen > payload.size - payload.offset - record.pathLen) {
+            status = AJ_ERR_END_OF_DATA;
+            break;
+        }
+
+        reader.buf = payload.buf + payload.offset + record.pathLen;
+        reader.size = record.dataLen;
+
+        //records of objects or interfaces which are not created any more are skipped
+        if (record.intfType > UNDEFINED_INTERFACE && record.intfType < VENDOR_DEFINED_INTERFACE &&
+            loadProperties[record.intfType]) {
+            intfInfo = FindSnapshotInterface((const char*)(payload.buf + payload.offset), record.pathLen, (CdmInterfaceTypes)record.intfType);
+        }
+        if (intfInfo) {
+            //a record which does not fit the current property layout leaves the properties as the application set them
+            if (!IsSnapshotRecordValid((CdmInterfaceTypes)record.intfType, &reader) ||
+                loadProperties[record.intfType](intfInfo->properties, &reader) != AJ_OK) {
+                numMismatched++;
+            }
+        }
+
+        payload.offset += record.pathLen + record.dataLen;
+    }
+
+    if (buf) {
+        free(buf);
+    }
+
+    if (status == AJ_OK && numMismatched) {
+        AJ_WarnPrintf(("%u snapshot records do not match the property layout and are not loaded\n", numMismatched));
+        status = AJ_ERR_INVALID;
+    }
+
+    return status;
+}
+
+AJ_Status Cdm_EnableSecurity(AJ_BusAttachment* busAttachment, const uint32_t* suites, const size_t numOfSuites,
+                             AJ_AuthListenerFunc authListenerCallback)
+{
+    AJ_Status status = AJ_OK;
+
+    status = AJ_BusEnableSecurity(busAttachment, suites, numOfSuites);
+    if (status == AJ_OK) {
+        AJ_BusSetAuthListenerCallback(busAttachment, authListenerCallback);
+    }
+
+    return status;
+}
+
+static bool IsCdmMsg(uint32_t msgId)
+{
+    if ((msgId >> 24) == CDM_OBJECT_LIST_INDEX) {
+        return true;
+    }
+
+    return false;
+}
+
+static uint8_t GetObjectIndex(uint32_t msgId)
+{
+    return (uint8_t)((msgId & 0x00FF0000) >> 16);
+}
+
+static uint8_t GetInterfaceIndex(uint32_t msgId)
+{
+    return (uint8_t)((msgId & 0x0000FF00) >> 8);
+}
+
+static uint8_t GetMemberIndex(uint32_t msgId)
+{
+    return (uint8_t)(msgId & 0x0000FF);
+}
+
+static CdmObjectInfo* GetObjectInfo(uint8_t objIndex)
+{
+    CdmObjectInfo* objInfo = objInfoFirst;
+    uint8_t i = 0;
+
+    for (i=0; i<objIndex; i++) {
+        if (!objInfo) {
+            break;
+        }
+
+        objInfo = objInfo->objNext;
     }
 
     return objInfo;
@@ -650,6 +1579,123 @@ static void EmitPropChangedByMethod(CdmInterfaceTypes intfType, AJ_BusAttachment
     }
 }
 
+static uint32_t StartLatencyWatch(const CdmInterfaceInfo* intfInfo)
+{
+    return intfInfo->latencyBudget ? CdmTimerWheelNow() : 0;
+}
+
+static void StopLatencyWatch(CdmInterfaceInfo* intfInfo, const char* objPath, uint8_t memberIndex, uint32_t start, bool isGet)
+{
+    uint32_t latency = 0;
+
+    if (!intfInfo->latencyBudget) {
+        return;
+    }
+
+    latency = CdmTimerWheelNow() - start;
+    intfInfo->latencyStats.calls++;
+    if (latency > intfInfo->latencyStats.maxLatency) {
+        intfInfo->latencyStats.maxLatency = latency;
+    }
+    if (latency <= intfInfo->latencyBudget) {
+        return;
+    }
+
+    intfInfo->latencyStats.overruns++;
+    AJ_WarnPrintf(("Listener of %s interface %d member %u took %u ms over budget %u ms\n",
+                   objPath, intfInfo->intfType, memberIndex, latency, intfInfo->latencyBudget));
+
+    if (isGet && intfInfo->latencySwitchToPush && AllocPropertySources(intfInfo) == AJ_OK && memberIndex < intfInfo->numPropSources) {
+        intfInfo->propSources[memberIndex].source = CDM_PROPERTY_SOURCE_PUSH;
+    }
+}
+
+static void StartAllocWatch(void)
+{
+    CdmGetAllocCounter(&allocWatchStart);
+    allocWatchIntf = NULL;
+    allocWatchPath = NULL;
+}
+
+//Charges the allocations of the message being processed to the interface
+static void WatchAllocs(CdmInterfaceInfo* intfInfo, const char* objPath)
+{
+    allocWatchIntf = intfInfo;
+    allocWatchPath = objPath;
+}
+
+static void StopAllocWatch(uint32_t msgId)
+{
+    CdmAllocCounter counter;
+    CdmAllocStats* stats = NULL;
+    uint32_t allocs = 0;
+
+    if (!allocWatchIntf) {
+        return;
+    }
+
+    CdmGetAllocCounter(&counter);
+    allocs = counter.allocs - allocWatchStart.allocs;
+    stats = &allocWatchIntf->allocStats;
+    stats->operations++;
+    stats->allocs += allocs;
+    stats->frees += counter.frees - allocWatchStart.frees;
+    stats->bytes += counter.bytes - allocWatchStart.bytes;
+    if (allocs > stats->maxAllocs) {
+        stats->maxAllocs = allocs;
+    }
+    if (allocWatchIntf->allocBudget != CDM_ALLOC_BUDGET_NONE && allocs > allocWatchIntf->allocBudget) {
+        stats->overruns++;
+        AJ_WarnPrintf(("Message 0x%08x to %s interface %d made %u allocations over budget %u\n",
+                       msgId, allocWatchPath, allocWatchIntf->intfType, allocs, allocWatchIntf->allocBudget));
+    }
+    allocWatchIntf = NULL;
+}
+
+//Returns NULL when the stored value is replied without calling the OnGet listener
+static void* GetListenerOfPropGet(CdmInterfaceInfo* intfInfo, uint8_t memberIndex)
+{
+    CdmPropertySourceInfo* propSource = NULL;
+    uint32_t now = 0;
+
+    if (!intfInfo->propSources || memberIndex >= intfInfo->numPropSources) {
+        return intfInfo->listener;
+    }
+
+    propSource = &intfInfo->propSources[memberIndex];
+    switch (propSource->source) {
+    case CDM_PROPERTY_SOURCE_PUSH:
+        return NULL;
+
+    case CDM_PROPERTY_SOURCE_PULL_TTL:
+        now = CdmTimerWheelNow();
+        if (propSource->pulled && (now - propSource->pullTime) < propSource->ttl) {
+            return NULL;
+        }
+        return intfInfo->listener;
+
+    default:
+        return intfInfo->listener;
+    }
+}
+
+//The TTL starts only when the listener gave a value, so a failed or deferred Get is pulled again
+static void MarkPulled(CdmInterfaceInfo* intfInfo, uint8_t memberIndex)
+{
+    CdmPropertySourceInfo* propSource = NULL;
+
+    if (!intfInfo->propSources || memberIndex >= intfInfo->numPropSources) {
+        return;
+    }
+
+    propSource = &intfInfo->propSources[memberIndex];
+    if (propSource->source == CDM_PROPERTY_SOURCE_PULL_TTL) {
+        propSource->pulled = true;
+        propSource->pullTime = CdmTimerWheelNow();
+    }
+}
+
+//context is not NULL when a deferred Get is completed, then the stored value is replied
 static AJ_Status PropGetHandler(AJ_Message* replyMsg, uint32_t propId, void* context)
 {
     uint8_t objIndex = GetObjectIndex(propId);
@@ -661,9 +1707,22 @@ static AJ_Status PropGetHandler(AJ_Message* replyMsg, uint32_t propId, void* con
     if (objInfo) {
         CdmInterfaceInfo* intfInfo = GetInterfaceInfoOfObject(objInfo, intfIndex);
         if (intfInfo) {
+            void* listener = context ? NULL : GetListenerOfPropGet(intfInfo, memberIndex);
+            if (!context) {
+                WatchAllocs(intfInfo, objInfo->path);
+            }
+            uint32_t start = listener ? StartLatencyWatch(intfInfo) : 0;
+            bool pulled = false;
+
             if (intfInfo->intfType > UNDEFINED_INTERFACE && intfInfo->intfType < VENDOR_DEFINED_INTERFACE) {
                 if (onGetProperty[intfInfo->intfType]) {
-                    status = onGetProperty[intfInfo->intfType](replyMsg, objInfo->path, intfInfo->properties, memberIndex, intfInfo->listener);
+                    //the handlers reply the stored value when the listener fails, so they report a pulled value
+                    valuePulled = false;
+                    status = onGetProperty[intfInfo->intfType](replyMsg, objInfo->path, intfInfo->properties, memberIndex, listener);
+                    pulled = valuePulled;
+                    if (listener) {
+                        StopLatencyWatch(intfInfo, objInfo->path, memberIndex, start, true);
+                    }
                 }
             } else if (intfInfo->intfType > VENDOR_DEFINED_INTERFACE) {
                 VendorDefinedInterfaceInfo* vendorDefinedIntfInfo = GetVendorDefinedInterfaceInfo(intfInfo->intfType);
@@ -673,7 +1732,11 @@ static AJ_Status PropGetHandler(AJ_Message* replyMsg, uint32_t propId, void* con
 
                 if (vendorDefinedIntfInfo->handler) {
                     if (vendorDefinedIntfInfo->handler->OnGetProperty) {
-                        status = vendorDefinedIntfInfo->handler->OnGetProperty(replyMsg, objInfo->path, intfInfo->properties, memberIndex, intfInfo->listener);
+                        status = vendorDefinedIntfInfo->handler->OnGetProperty(replyMsg, objInfo->path, intfInfo->properties, memberIndex, listener);
+                        pulled = (status == AJ_OK && !CdmIsReplyDeferred());
+                        if (listener) {
+                            StopLatencyWatch(intfInfo, objInfo->path, memberIndex, start, true);
+                        }
                     } else {
                         status = AJ_ERR_NULL;
                     }
@@ -683,6 +1746,10 @@ static AJ_Status PropGetHandler(AJ_Message* replyMsg, uint32_t propId, void* con
             } else {
                 status = AJ_ERR_INVALID;
             }
+
+            if (listener && pulled) {
+                MarkPulled(intfInfo, memberIndex);
+            }
         } else {
             status = AJ_ERR_NULL;
         }
@@ -708,9 +1775,12 @@ static AJ_Status PropSetHandler(AJ_Message* replyMsg, uint32_t propId, void* con
             propChanged->intfType = intfInfo->intfType;
             propChanged->properties = intfInfo->properties;
             propChanged->member_index = memberIndex;
+            WatchAllocs(intfInfo, objInfo->path);
             if (intfInfo->intfType > UNDEFINED_INTERFACE && intfInfo->intfType < VENDOR_DEFINED_INTERFACE) {
                 if (onSetProperty[intfInfo->intfType]) {
+                    uint32_t start = StartLatencyWatch(intfInfo);
                     status = onSetProperty[intfInfo->intfType](replyMsg, objInfo->path, intfInfo->properties, memberIndex, intfInfo->listener, &propChanged->changed);
+                    StopLatencyWatch(intfInfo, objInfo->path, memberIndex, start, false);
                 }
             } else if (intfInfo->intfType > VENDOR_DEFINED_INTERFACE) {
                 VendorDefinedInterfaceInfo* vendorDefinedIntfInfo = GetVendorDefinedInterfaceInfo(intfInfo->intfType);
@@ -720,7 +1790,9 @@ static AJ_Status PropSetHandler(AJ_Message* replyMsg, uint32_t propId, void* con
 
                 if (vendorDefinedIntfInfo->handler) {
                     if (vendorDefinedIntfInfo->handler->OnSetProperty) {
+                        uint32_t start = StartLatencyWatch(intfInfo);
                         status = vendorDefinedIntfInfo->handler->OnSetProperty(replyMsg, objInfo->path, intfInfo->properties, memberIndex, intfInfo->listener, &propChanged->changed);
+                        StopLatencyWatch(intfInfo, objInfo->path, memberIndex, start, false);
                     } else {
                         status = AJ_ERR_NULL;
                     }
@@ -740,11 +1812,334 @@ static AJ_Status PropSetHandler(AJ_Message* replyMsg, uint32_t propId, void* con
     return status;
 }
 
+//The flag is read through the interface info, whose properties block can be replaced
+static bool IsRemoteControlDisabled(CdmObjectInfo* objInfo)
+{
+    return (objInfo->remoteControllability &&
+            !RemoteControllabilityInterfaceIsControllable(objInfo->remoteControllability->properties)) ? true : false;
+}
+
+static bool IsQueryMethod(CdmInterfaceInfo* intfInfo, uint8_t memberIndex)
+{
+    const char* const* intfDesc = GetInterfaceDesc(intfInfo->intfType);
+
+    if (!intfDesc) {
+        return false;
+    }
+
+    //Get methods only read the state of the device
+    return (strncmp(intfDesc[memberIndex + 1], "?Get", 4) == 0) ? true : false;
+}
+
+static AJ_Status ReplyRemoteControlDisabled(AJ_Message* msg)
+{
+    AJ_Status status = AJ_OK;
+    AJ_Message reply;
+
+    status = AJ_MarshalErrorMsgWithInfo(msg, &reply, GetInterfaceErrorName(REMOTE_CONTROL_DISABLED), GetInterfaceErrorMessage(REMOTE_CONTROL_DISABLED));
+    if (status == AJ_OK) {
+        status = AJ_DeliverMsg(&reply);
+    }
+
+    return status;
+}
+
+static bool IsDeferrableMethod(CdmInterfaceInfo* intfInfo, uint8_t memberIndex)
+{
+    size_t i = 0;
+
+    for (i = 0; i < sizeof(deferrableMethods) / sizeof(deferrableMethods[0]); i++) {
+        if (deferrableMethods[i].intfType == intfInfo->intfType && deferrableMethods[i].memberIndex == memberIndex) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+static void BeginDeferrable(AJ_Message* msg, uint32_t propId, const char* signature)
+{
+    deferrableMsg = msg;
+    deferrablePropId = propId;
+    deferrableSignature = signature;
+    deferredReply = NULL;
+}
+
+static DeferredReply* EndDeferrable(void)
+{
+    DeferredReply* deferred = deferredReply;
+
+    deferrableMsg = NULL;
+    deferredReply = NULL;
+
+    return deferred;
+}
+
+static void ReleaseDeferredReply(DeferredReply* deferred)
+{
+    Cdm_TimerWheelCancel(&deferred->timer);
+    memset(deferred, 0, sizeof(DeferredReply));
+}
+
+//Rebuild the parts of the request used by AJ_MarshalReplyMsg and AJ_MarshalErrorMsgWithInfo
+static void RestoreRequest(AJ_BusAttachment* busAttachment, const DeferredReply* deferred, AJ_Message* msg, AJ_MsgHeader* hdr)
+{
+    memset(hdr, 0, sizeof(AJ_MsgHeader));
+    hdr->msgType = AJ_MSG_METHOD_CALL;
+    hdr->flags = deferred->flags;
+    hdr->serialNum = deferred->serialNum;
+
+    memset(msg, 0, sizeof(AJ_Message));
+    msg->msgId = deferred->msgId;
+    msg->hdr = hdr;
+    msg->sender = deferred->sender;
+    msg->sessionId = deferred->sessionId;
+    msg->bus = busAttachment;
+}
+
+static void DeferredReplyTimeout(AJ_BusAttachment* busAttachment, CdmTimer* timer, void* context)
+{
+    DeferredReply* deferred = (DeferredReply*)context;
+    AJ_MsgHeader hdr;
+    AJ_Message msg;
+    AJ_Message reply;
+
+    RestoreRequest(busAttachment, deferred, &msg, &hdr);
+    if (AJ_MarshalStatusMsg(&msg, &reply, AJ_ERR_TIMEOUT) == AJ_OK) {
+        AJ_DeliverMsg(&reply);
+    }
+    ReleaseDeferredReply(deferred);
+}
+
+AJ_Status Cdm_DeferReply(CdmReplyToken* token)
+{
+    DeferredReply* deferred = NULL;
+    uint8_t i = 0;
+
+    if (!token) {
+        return AJ_ERR_INVALID;
+    }
+
+    if (!deferrableMsg || deferredReply) {
+        return AJ_ERR_DISALLOWED;
+    }
+
+    if (!deferrableMsg->sender || strlen(deferrableMsg->sender) >= MAX_SENDER_SIZE) {
+        return AJ_ERR_RESOURCES;
+    }
+
+    for (i = 0; i < CDM_MAX_DEFERRED_REPLIES; i++) {
+        if (!deferredReplies[i].token) {
+            deferred = &deferredReplies[i];
+            break;
+        }
+    }
+    if (!deferred) {
+        return AJ_ERR_RESOURCES;
+    }
+
+    if (++lastReplyToken == 0) {
+        lastReplyToken = 1;
+    }
+    deferred->token = lastReplyToken;
+    deferred->msgId = deferrableMsg->msgId;
+    deferred->serialNum = deferrableMsg->hdr->serialNum;
+    deferred->flags = deferrableMsg->hdr->flags;
+    deferred->sessionId = deferrableMsg->sessionId;
+    strcpy(deferred->sender, deferrableMsg->sender);
+    deferred->propId = deferrablePropId;
+    deferred->signature = deferrableSignature;
+    Cdm_TimerWheelInitTimer(&deferred->timer, DeferredReplyTimeout, deferred);
+    Cdm_TimerWheelSchedule(&deferred->timer, CDM_DEFERRED_REPLY_TIMEOUT, 0);
+
+    deferredReply = deferred;
+    *token = deferred->token;
+
+    return AJ_OK;
+}
+
+bool CdmIsReplyDeferred(void)
+{
+    return deferredReply ? true : false;
+}
+
+void CdmMarkValuePulled(void)
+{
+    valuePulled = true;
+}
+
+AJ_Status Cdm_CompleteReply(AJ_BusAttachment* busAttachment, CdmReplyToken token, ErrorCode errorCode)
+{
+    AJ_Status status = AJ_OK;
+    DeferredReply* deferred = NULL;
+    AJ_MsgHeader hdr;
+    AJ_Message msg;
+    AJ_Message reply;
+    uint8_t i = 0;
+
+    if (!busAttachment || !token) {
+        return AJ_ERR_INVALID;
+    }
+
+    for (i = 0; i < CDM_MAX_DEFERRED_REPLIES; i++) {
+        if (deferredReplies[i].token == token) {
+            deferred = &deferredReplies[i];
+            break;
+        }
+    }
+    if (!deferred) {
+        return AJ_ERR_NO_MATCH;
+    }
+
+    RestoreRequest(busAttachment, deferred, &msg, &hdr);
+    if (errorCode != NOT_ERROR) {
+        status = AJ_MarshalErrorMsgWithInfo(&msg, &reply, GetInterfaceErrorName(errorCode), GetInterfaceErrorMessage(errorCode));
+    } else {
+        status = AJ_MarshalReplyMsg(&msg, &reply);
+        if (status == AJ_OK && deferred->signature) {
+            status = AJ_MarshalVariant(&reply, deferred->signature);
+            if (status == AJ_OK) {
+                status = PropGetHandler(&reply, deferred->propId, deferred);
+            }
+            if (status != AJ_OK) {
+                //marshalling the status starts a new reply in place of the partial one
+                status = AJ_MarshalStatusMsg(&msg, &reply, status);
+            }
+        }
+    }
+    if (status == AJ_OK) {
+        status = AJ_DeliverMsg(&reply);
+    }
+    ReleaseDeferredReply(deferred);
+
+    return status;
+}
+
+//AJ_BusPropGet which leaves the reply to Cdm_CompleteReply if the listener defers it
+static AJ_Status PropGet(AJ_Message* msg)
+{
+    AJ_Status status = AJ_OK;
+    DeferredReply* deferred = NULL;
+    uint32_t propId = 0;
+    const char* signature = NULL;
+    AJ_Message reply;
+
+    status = AJ_UnmarshalPropertyArgs(msg, &propId, &signature);
+    if (status == AJ_OK) {
+        status = AJ_MarshalReplyMsg(msg, &reply);
+    }
+    if (status == AJ_OK) {
+        status = AJ_MarshalVariant(&reply, signature);
+    }
+    if (status == AJ_OK) {
+        BeginDeferrable(msg, propId, signature);
+        status = PropGetHandler(&reply, propId, NULL);
+        deferred = EndDeferrable();
+    }
+
+    //a deferred reply is left partly marshalled, Cdm_CompleteReply marshals a new one
+    if (deferred) {
+        if (status == AJ_OK) {
+            return AJ_OK;
+        }
+        ReleaseDeferredReply(deferred);
+    }
+    if (status != AJ_OK) {
+        AJ_MarshalStatusMsg(msg, &reply, status);
+    }
+
+    return AJ_DeliverMsg(&reply);
+}
+
+//Properties.GetAll, used by controllers to sync their cache. Listeners are called as for Get, but cannot defer.
+static AJ_Status PropGetAll(AJ_Message* msg, uint8_t objIndex, CdmObjectInfo* objInfo)
+{
+    AJ_Status status = AJ_OK;
+    const char* intfName = NULL;
+    const char* const* intfDesc = NULL;
+    CdmInterfaceInfo* intfInfo = NULL;
+    uint8_t intfIndex = 1;
+    uint8_t i = 0;
+    AJ_Message reply;
+    AJ_Arg array;
+
+    status = AJ_UnmarshalArgs(msg, "s", &intfName);
+    if (status != AJ_OK) {
+        return status;
+    }
+
+    for (intfInfo = objInfo->intfFirst; intfInfo; intfInfo = intfInfo->intfNext, intfIndex++) {
+        intfDesc = GetInterfaceDesc(intfInfo->intfType);
+        if (intfDesc && !strcmp((intfDesc[0][0] == '$') ? intfDesc[0] + 1 : intfDesc[0], intfName)) {
+            break;
+        }
+    }
+    if (!intfInfo) {
+        AJ_MarshalStatusMsg(msg, &reply, AJ_ERR_NO_MATCH);
+        return AJ_DeliverMsg(&reply);
+    }
+
+    status = AJ_MarshalReplyMsg(msg, &reply);
+    if (status == AJ_OK) {
+        status = AJ_MarshalContainer(&reply, &array, AJ_ARG_ARRAY);
+    }
+    for (i = 0; status == AJ_OK && intfDesc[i + 1]; i++) {
+        const char* member = intfDesc[i + 1];
+        size_t nameLen = 0;
+        AJ_Arg entry;
+        AJ_Arg name;
+
+        if (member[0] != '@') {
+            continue;
+        }
+        nameLen = strcspn(member + 1, "<>=");
+        if (member[nameLen + 1] == '<') { //write-only
+            continue;
+        }
+
+        status = AJ_MarshalContainer(&reply, &entry, AJ_ARG_DICT_ENTRY);
+        if (status == AJ_OK) {
+            status = AJ_MarshalArg(&reply, AJ_InitArg(&name, AJ_ARG_STRING, 0, member + 1, nameLen));
+        }
+        if (status == AJ_OK) {
+            status = AJ_MarshalVariant(&reply, member + nameLen + 2);
+        }
+        if (status == AJ_OK) {
+            status = PropGetHandler(&reply, AJ_ENCODE_MESSAGE_ID(CDM_OBJECT_LIST_INDEX, objIndex, intfIndex, i), NULL);
+        }
+        if (status == AJ_OK) {
+            status = AJ_MarshalCloseContainer(&reply, &entry);
+        }
+    }
+    if (status == AJ_OK) {
+        status = AJ_MarshalCloseContainer(&reply, &array);
+    }
+
+    //marshalling the status starts a new reply in place of the partial one
+    if (status != AJ_OK) {
+        AJ_MarshalStatusMsg(msg, &reply, status);
+    }
+
+    return AJ_DeliverMsg(&reply);
+}
+
 AJSVC_ServiceStatus Cdm_MessageProcessor(AJ_BusAttachment* busAttachment, AJ_Message* msg, AJ_Status* status)
 {
     AJSVC_ServiceStatus serviceStatus = AJSVC_SERVICE_STATUS_HANDLED;
 
-    if (IsCdmMsg(msg->msgId)) {
+    CdmTraceMessageBegin(msg);
+    StartAllocWatch();
+
+    if (msg->msgId == AJ_SIGNAL_SESSION_LOST || msg->msgId == AJ_SIGNAL_SESSION_LOST_WITH_REASON) {
+        uint32_t sessionId = 0;
+
+        //Leave the message to the application and the built-in handlers
+        if (AJ_UnmarshalArgs(msg, "u", &sessionId) == AJ_OK) {
+            Cdm_SessionLost(sessionId);
+        }
+        AJ_ResetArgs(msg);
+        serviceStatus = AJSVC_SERVICE_STATUS_NOT_HANDLED;
+    } else if (IsCdmMsg(msg->msgId)) {
         uint8_t objIndex = GetObjectIndex(msg->msgId);
         uint8_t intfIndex = GetInterfaceIndex(msg->msgId);
         uint8_t memberIndex = GetMemberIndex(msg->msgId);
@@ -753,7 +2148,11 @@ AJSVC_ServiceStatus Cdm_MessageProcessor(AJ_BusAttachment* busAttachment, AJ_Mes
         if (objInfo) {
             if (intfIndex == (uint8_t)0) { //org.freedesktop.DBus.Properties handling
                 if (memberIndex == AJ_PROP_GET) {
-                    *status = AJ_BusPropGet(msg, PropGetHandler, NULL);
+                    *status = PropGet(msg);
+                } else if (memberIndex == AJ_PROP_GET_ALL) {
+                    *status = PropGetAll(msg, objIndex, objInfo);
+                } else if (memberIndex == AJ_PROP_SET && IsRemoteControlDisabled(objInfo)) {
+                    *status = ReplyRemoteControlDisabled(msg);
                 } else if (memberIndex == AJ_PROP_SET) {
                     CdmPropertiesChanged propChanged;
                     memset(&propChanged, 0 , sizeof(CdmPropertiesChanged));
@@ -779,13 +2178,22 @@ AJSVC_ServiceStatus Cdm_MessageProcessor(AJ_BusAttachment* busAttachment, AJ_Mes
                 }
             } else { //method
                 CdmInterfaceInfo* intfInfo = GetInterfaceInfoOfObject(objInfo, intfIndex);
-                if (intfInfo) {
+                if (intfInfo && IsRemoteControlDisabled(objInfo) && !IsQueryMethod(intfInfo, memberIndex)) {
+                    *status = ReplyRemoteControlDisabled(msg);
+                } else if (intfInfo) {
                     CdmPropertiesChangedByMethod propChangedByMethod;
+                    WatchAllocs(intfInfo, objInfo->path);
                     propChangedByMethod.properties = intfInfo->properties;
                     propChangedByMethod.member_index_mask = 0;
                     if (intfInfo->intfType > UNDEFINED_INTERFACE && intfInfo->intfType < VENDOR_DEFINED_INTERFACE) {
                         if (onMethodHandler[intfInfo->intfType]) {
+                            uint32_t start = StartLatencyWatch(intfInfo);
+                            if (IsDeferrableMethod(intfInfo, memberIndex)) {
+                                BeginDeferrable(msg, 0, NULL);
+                            }
                             *status = onMethodHandler[intfInfo->intfType](msg, objInfo->path, memberIndex, intfInfo->listener, &propChangedByMethod);
+                            EndDeferrable();
+                            StopLatencyWatch(intfInfo, objInfo->path, memberIndex, start, false);
                             if (*status == AJ_OK && propChangedByMethod.member_index_mask != 0) {
                                 EmitPropChangedByMethod(intfInfo->intfType, busAttachment, objInfo->path, propChangedByMethod.properties, propChangedByMethod.member_index_mask);
                             }
@@ -800,7 +2208,9 @@ AJSVC_ServiceStatus Cdm_MessageProcessor(AJ_BusAttachment* busAttachment, AJ_Mes
 
                         if (vendorDefinedIntfInfo->handler) {
                             if (vendorDefinedIntfInfo->handler->OnMethodHandler) {
+                                uint32_t start = StartLatencyWatch(intfInfo);
                                 *status = vendorDefinedIntfInfo->handler->OnMethodHandler(msg, objInfo->path, memberIndex, intfInfo->listener, &propChangedByMethod);
+                                StopLatencyWatch(intfInfo, objInfo->path, memberIndex, start, false);
                                 if (*status == AJ_OK && propChangedByMethod.member_index_mask != 0) {
                                     EmitPropChangedByMethod(intfInfo->intfType, busAttachment, objInfo->path, propChangedByMethod.properties, propChangedByMethod.member_index_mask);
                                 }
@@ -824,35 +2234,22 @@ AJSVC_ServiceStatus Cdm_MessageProcessor(AJ_BusAttachment* busAttachment, AJ_Mes
         serviceStatus = AJSVC_SERVICE_STATUS_NOT_HANDLED;
     }
 
+    StopAllocWatch(msg->msgId);
+    CdmTraceMessageEnd(msg, serviceStatus, *status);
+
     return serviceStatus;
 }
 
-void* GetProperties(const char* objPath, CdmInterfaceTypes intfType)
+void Cdm_ProcessTimers(AJ_BusAttachment* busAttachment)
 {
-    CdmObjectInfo* objInfo = NULL;
-
-    if (!objPath) {
-        return NULL;
-    }
-
-    objInfo = FindObject(objPath);
-    if (objInfo) {
-        CdmInterfaceInfo* intfInfo = objInfo->intfFirst;
-
-        while (intfInfo) {
-            if (intfInfo->intfType == intfType) {
-                break;
-            }
-
-            intfInfo = intfInfo->intfNext;
-        }
+    CdmTimerWheelRun(busAttachment);
+}
 
-        if (intfInfo) {
-            return intfInfo->properties;
-        }
-    }
+void* GetProperties(const char* objPath, CdmInterfaceTypes intfType)
+{
+    CdmInterfaceInfo* intfInfo = FindInterface(objPath, intfType);
 
-    return NULL;
+    return intfInfo ? intfInfo->properties : NULL;
 }
 
 AJ_Status MakeMsgId(const char* objPath, CdmInterfaceTypes intfType, uint8_t memberIndex, uint32_t* msgId)
@@ -908,6 +2305,32 @@ AJ_Status MakeMsgId(const char* objPath, CdmInterfaceTypes intfType, uint8_t mem
     return AJ_OK;
 }
 
+bool CdmNextPropChangedTarget(uint32_t msgId, CdmPropChangedTarget* target)
+{
+    CdmObjectInfo* objInfo = NULL;
+
+    if (target->index == 0) {
+        objInfo = GetObjectInfo(GetObjectIndex(msgId));
+        if (!objInfo || objInfo->propChangedDelivery == CDM_PROP_CHANGED_BROADCAST || sessionsOverflowed) {
+            target->sessionId = 0;
+            target->flags = AJ_FLAG_GLOBAL_BROADCAST;
+            target->index = CDM_MAX_SESSIONS + 1;
+            return true;
+        }
+    } else if (target->index > CDM_MAX_SESSIONS) {
+        return false;
+    }
+
+    if (target->index >= numSessions) {
+        return false;
+    }
+
+    target->sessionId = sessionIds[target->index++];
+    target->flags = 0;
+
+    return true;
+}
+
 AJ_Status MakePropChangedId(const char* objPath, uint32_t* msgId)
 {
     CdmObjectInfo* objInfo = objInfoFirst;
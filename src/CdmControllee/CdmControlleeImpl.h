@@ -20,11 +20,25 @@
 #include <ajtcl/alljoyn.h>
 #include <ajtcl/cdm/CdmControllee.h>
 
+typedef struct {
+    CdmPropertySource source;
+    uint32_t ttl;
+    uint32_t pullTime;
+    bool pulled;
+} CdmPropertySourceInfo;
+
 typedef struct cdmIntfInfo {
     CdmInterfaceTypes intfType;
     void* properties;
     void* listener;
     struct cdmIntfInfo* intfNext;
+    CdmPropertySourceInfo* propSources;
+    uint8_t numPropSources;
+    uint32_t latencyBudget;
+    bool latencySwitchToPush;
+    CdmLatencyStats latencyStats;
+    uint32_t allocBudget;
+    CdmAllocStats allocStats;
 } CdmInterfaceInfo;
 
 typedef struct cdmObjInfo {
@@ -33,6 +47,8 @@ typedef struct cdmObjInfo {
     CdmInterfaceInfo* intfLast;
     AJ_InterfaceDescription* ajIntfDesc;
     struct cdmObjInfo* objNext;
+    CdmInterfaceInfo* remoteControllability;
+    CdmPropChangedDelivery propChangedDelivery;
 } CdmObjectInfo;
 
 typedef struct {
@@ -42,6 +58,12 @@ typedef struct {
     bool changed;
 } CdmPropertiesChanged;
 
+typedef struct {
+    uint32_t sessionId;
+    uint8_t flags;
+    uint8_t index;
+} CdmPropChangedTarget;
+
 typedef struct vendorDefinedIntfInfo {
     const char* intfName;
     CdmInterfaceTypes intfType;
@@ -57,4 +79,104 @@ typedef AJ_Status (*OnSetProperty)(AJ_Message* replyMsg, const char* objPath, vo
 typedef AJ_Status (*EmitPropertiesChanged)(AJ_BusAttachment* busAttachment, const char* objPath, void* properties, uint8_t memberIndex);
 typedef AJ_Status (*OnMethodHandler)(AJ_Message* msg, const char* objPath, uint8_t memberIndex, void* listener, CdmPropertiesChangedByMethod* propChangedByMethod);
 
+typedef struct {
+    uint8_t* buf;
+    size_t size;
+    size_t capacity;
+} CdmSnapshotWriter;
+
+typedef struct {
+    const uint8_t* buf;
+    size_t size;
+    size_t offset;
+} CdmSnapshotReader;
+
+typedef AJ_Status (*SaveProperties)(void* properties, CdmSnapshotWriter* writer);
+typedef AJ_Status (*LoadProperties)(void* properties, CdmSnapshotReader* reader);
+typedef void (*SetConstraintPolicy)(void* properties, CdmConstraintPolicy policy);
+
+/**
+ * Append raw bytes to a snapshot image.
+ * @param[in] writer snapshot writer
+ * @param[in] data bytes to append
+ * @param[in] len number of bytes
+ * @return AJ_OK on success
+ */
+AJ_Status CdmSnapshotWrite(CdmSnapshotWriter* writer, const void* data, size_t len);
+
+/**
+ * Append an array as a uint32 element count followed by the elements.
+ * @param[in] writer snapshot writer
+ * @param[in] data array elements, may be NULL when count is 0
+ * @param[in] elemSize size of an element
+ * @param[in] count number of elements
+ * @return AJ_OK on success
+ */
+AJ_Status CdmSnapshotWriteArray(CdmSnapshotWriter* writer, const void* data, size_t elemSize, size_t count);
+
+/**
+ * Append a string as a uint32 length followed by the characters.
+ * @param[in] writer snapshot writer
+ * @param[in] str string, NULL is written as an empty string
+ * @return AJ_OK on success
+ */
+AJ_Status CdmSnapshotWriteString(CdmSnapshotWriter* writer, const char* str);
+
+/**
+ * Read raw bytes from a snapshot image.
+ * @param[in] reader snapshot reader
+ * @param[out] data destination
+ * @param[in] len number of bytes
+ * @return AJ_OK on success, AJ_ERR_END_OF_DATA if the record is too short
+ */
+AJ_Status CdmSnapshotRead(CdmSnapshotReader* reader, void* data, size_t len);
+
+/**
+ * Read an array written by CdmSnapshotWriteArray into a newly allocated buffer.
+ * @param[in] reader snapshot reader
+ * @param[out] data allocated elements, NULL when count is 0. The caller frees it.
+ * @param[in] elemSize size of an element
+ * @param[out] count number of elements
+ * @return AJ_OK on success
+ */
+AJ_Status CdmSnapshotReadArray(CdmSnapshotReader* reader, void** data, size_t elemSize, size_t* count);
+
+/**
+ * Read a string written by CdmSnapshotWriteString into a newly allocated buffer.
+ * @param[in] reader snapshot reader
+ * @param[out] str allocated null-terminated string. The caller frees it.
+ * @return AJ_OK on success
+ */
+AJ_Status CdmSnapshotReadString(CdmSnapshotReader* reader, char** str);
+
+/**
+ * Get the next target of a PropertiesChanged signal, according to the delivery of the object.
+ * Marshal and deliver the signal once per target.
+ * @param[in] msgId PropertiesChanged message identifier made by MakePropChangedId
+ * @param[in,out] target target, zero initialized before the first call
+ * @return true if the signal should be sent to the target
+ */
+bool CdmNextPropChangedTarget(uint32_t msgId, CdmPropChangedTarget* target);
+
+/**
+ * Check whether the listener called by a method or OnGet handler deferred the reply by Cdm_DeferReply.
+ * The handler then neither replies nor applies the result of the method, nor stores the value given by the listener.
+ * @return true if the reply is deferred
+ */
+bool CdmIsReplyDeferred(void);
+
+/**
+ * Called by the OnGetProperty handlers of built-in interfaces when the OnGet listener gave a value,
+ * which starts the TTL of a CDM_PROPERTY_SOURCE_PULL_TTL property.
+ */
+void CdmMarkValuePulled(void);
+
+/**
+ * Register the CDM objects with copies of the secure interface descriptions without the security mark,
+ * or register the objects made by Cdm_Start again. Used to replay decrypted messages of a trace.
+ * @param[in] insecure true to register the insecure copies
+ * @return AJ_OK on success
+ */
+AJ_Status CdmRegisterInsecureObjects(bool insecure);
+
 #endif /* CDMCONTROLLEEIMPL_H_ */
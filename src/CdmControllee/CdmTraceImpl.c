@@ -0,0 +1,504 @@
+/******************************************************************************
+ * Copyright AllSeen Alliance. All rights reserved.
+ *
+ *    Permission to use, copy, modify, and/or distribute this software for any
+ *    purpose with or without fee is hereby granted, provided that the above
+ *    copyright notice and this permission notice appear in all copies.
+ *
+ *    THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ *    WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ *    ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ *    WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ *    ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ *    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ ******************************************************************************/
+
+
+
+/**
+ * Per-module definition of the current module for debug logging.  Must be defined
+ * prior to first inclusion of aj_debug.h.
+ */
+#define AJ_MODULE CDM
+
+#include <stdlib.h>
+#include <string.h>
+#include <ajtcl/aj_debug.h>
+#include <ajtcl/cdm/CdmTrace.h>
+#include "CdmControlleeImpl.h"
+#include "CdmTraceImpl.h"
+#include "../interfaces/CdmTimerWheelImpl.h"
+
+#define PAD8(n) (((n) + 7) & ~7)
+#define SERIAL_OFFSET 8 //offset of serialNum in AJ_MsgHeader
+#define TRACE_BUFFER_INITIAL_CAPACITY 256
+
+typedef struct {
+    uint8_t* data;
+    size_t size;
+    size_t capacity;
+} TraceBuffer;
+
+typedef struct {
+    const uint8_t* in;  //message being fed to AJ_UnmarshalMsg
+    size_t inSize;
+    size_t inPos;
+    TraceBuffer out;    //bytes sent while replaying the message
+} ReplayTransport;
+
+static AJ_BusAttachment* traceBus = NULL;
+static CdmTraceWriteFunc traceWrite = NULL;
+static void* traceContext = NULL;
+static AJ_TxFunc traceSend = NULL;
+static uint32_t traceEpoch = 0;
+static bool traceInMessage = false;
+static uint32_t traceMsgStart = 0;
+
+static bool IsHostOrder(char endianess)
+{
+    const uint16_t one = 1;
+
+    return endianess == ((*(const uint8_t*)&one) ? 'l' : 'B');
+}
+
+static uint32_t Swap32(uint32_t v)
+{
+    return (v >> 24) | ((v >> 8) & 0xFF00) | ((v << 8) & 0xFF0000) | (v << 24);
+}
+
+static uint32_t ReadUint32(const uint8_t* p, char endianess)
+{
+    if (endianess == 'l') {
+        return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+    }
+    return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | (uint32_t)p[3];
+}
+
+static AJ_Status TraceBufferAppend(TraceBuffer* buffer, const void* data, size_t len)
+{
+    if (buffer->size + len > buffer->capacity) {
+        size_t capacity = buffer->capacity ? buffer->capacity : TRACE_BUFFER_INITIAL_CAPACITY;
+        uint8_t* grown = NULL;
+
+        while (capacity < buffer->size + len) {
+            capacity *= 2;
+        }
+        grown = (uint8_t*)realloc(buffer->data, capacity);
+        if (!grown) {
+            return AJ_ERR_RESOURCES;
+        }
+        buffer->data = grown;
+        buffer->capacity = capacity;
+    }
+    memcpy(buffer->data + buffer->size, data, len);
+    buffer->size += len;
+
+    return AJ_OK;
+}
+
+static AJ_Status TraceOut(const void* data, size_t len)
+{
+    AJ_Status status = AJ_OK;
+
+    if (!traceWrite) {
+        return AJ_ERR_DISALLOWED;
+    }
+
+    status = traceWrite(data, len, traceContext);
+    if (status != AJ_OK) {
+        //Keep the send function wrapped until Cdm_TraceStop, it passes the bytes through
+        AJ_ErrPrintf(("Trace write failed: %s, recording stopped\n", AJ_StatusText(status)));
+        traceWrite = NULL;
+    }
+
+    return status;
+}
+
+static AJ_Status TraceRecord(uint8_t type, uint8_t flags, uint32_t length)
+{
+    CdmTraceRecordHeader record;
+
+    memset(&record, 0, sizeof(record));
+    record.type = type;
+    record.flags = flags;
+    record.timestamp = CdmTimerWheelNow() - traceEpoch;
+    record.length = length;
+
+    return TraceOut(&record, sizeof(record));
+}
+
+static AJ_Status TraceSend(AJ_IOBuffer* buf)
+{
+    uint32_t len = AJ_IO_BUF_AVAIL(buf);
+
+    if (traceWrite && len) {
+        uint8_t flags = traceInMessage ? 0 : CDM_TRACE_FLAG_UNSOLICITED;
+
+        //A message starts at the beginning of the buffer unless it did not fit in the buffer
+        if (buf->readPtr == buf->bufStart && len >= sizeof(AJ_MsgHeader) && (buf->readPtr[2] & AJ_FLAG_ENCRYPTED)) {
+            flags |= CDM_TRACE_FLAG_ENCRYPTED;
+        }
+        if (TraceRecord(CDM_TRACE_RECORD_OUT, flags, len) == AJ_OK) {
+            TraceOut(buf->readPtr, len);
+        }
+    }
+
+    return traceSend(buf);
+}
+
+AJ_Status Cdm_TraceStart(AJ_BusAttachment* busAttachment, CdmTraceWriteFunc write, void* context)
+{
+    CdmTraceFileHeader fileHeader;
+
+    if (!busAttachment || !write) {
+        return AJ_ERR_INVALID;
+    }
+    if (traceBus) {
+        return AJ_ERR_DISALLOWED;
+    }
+
+    traceWrite = write;
+    traceContext = context;
+    memset(&fileHeader, 0, sizeof(fileHeader));
+    fileHeader.magic = CDM_TRACE_MAGIC;
+    fileHeader.version = CDM_TRACE_VERSION;
+    if (TraceOut(&fileHeader, sizeof(fileHeader)) != AJ_OK) {
+        return AJ_ERR_WRITE;
+    }
+
+    traceBus = busAttachment;
+    traceSend = busAttachment->sock.tx.send;
+    busAttachment->sock.tx.send = TraceSend;
+    traceEpoch = CdmTimerWheelNow();
+    traceInMessage = false;
+
+    return AJ_OK;
+}
+
+void Cdm_TraceStop(void)
+{
+    if (traceBus && traceBus->sock.tx.send == TraceSend) {
+        traceBus->sock.tx.send = traceSend;
+    }
+    traceBus = NULL;
+    traceWrite = NULL;
+    traceContext = NULL;
+    traceSend = NULL;
+    traceInMessage = false;
+}
+
+void CdmTraceMessageBegin(AJ_Message* msg)
+{
+    AJ_MsgHeader header;
+    const uint8_t* fields = NULL;
+    const uint8_t* body = NULL;
+    uint32_t fieldsLen = 0;
+    uint32_t bodyLen = 0;
+    uint8_t flags = 0;
+
+    if (!traceWrite || msg->bus != traceBus || !msg->hdr) {
+        return;
+    }
+
+    //The fixed header fields are in host order after unmarshaling, the rest is as received
+    memcpy(&header, msg->hdr, sizeof(header));
+    fields = (const uint8_t*)msg->hdr + sizeof(AJ_MsgHeader);
+    fieldsLen = PAD8(header.headerLen);
+    body = fields + fieldsLen;
+    bodyLen = msg->bodyBytes;
+    if (body > msg->bus->sock.rx.writePtr || (uint32_t)(msg->bus->sock.rx.writePtr - body) < bodyLen) {
+        flags |= CDM_TRACE_FLAG_TRUNCATED;
+        bodyLen = 0;
+    }
+    if (header.flags & AJ_FLAG_ENCRYPTED) {
+        //The body was decrypted in place, record it as a plain message
+        flags |= CDM_TRACE_FLAG_ENCRYPTED;
+        header.flags &= ~AJ_FLAG_ENCRYPTED;
+    }
+    header.bodyLen = bodyLen;
+    if (!IsHostOrder(header.endianess)) {
+        header.bodyLen = Swap32(header.bodyLen);
+        header.serialNum = Swap32(header.serialNum);
+        header.headerLen = Swap32(header.headerLen);
+    }
+
+    if (TraceRecord(CDM_TRACE_RECORD_IN, flags, sizeof(header) + fieldsLen + bodyLen) == AJ_OK &&
+        TraceOut(&header, sizeof(header)) == AJ_OK && TraceOut(fields, fieldsLen) == AJ_OK) {
+        TraceOut(body, bodyLen);
+    }
+    traceInMessage = true;
+    traceMsgStart = CdmTimerWheelNow();
+}
+
+void CdmTraceMessageEnd(AJ_Message* msg, AJSVC_ServiceStatus serviceStatus, AJ_Status status)
+{
+    CdmTraceDone done;
+
+    if (!traceInMessage || msg->bus != traceBus) {
+        return;
+    }
+    traceInMessage = false;
+    if (!traceWrite) {
+        return;
+    }
+
+    memset(&done, 0, sizeof(done));
+    done.msgId = msg->msgId;
+    done.duration = CdmTimerWheelNow() - traceMsgStart;
+    done.handled = (serviceStatus == AJSVC_SERVICE_STATUS_HANDLED);
+    done.status = (uint8_t)status;
+    if (TraceRecord(CDM_TRACE_RECORD_DONE, 0, sizeof(done)) == AJ_OK) {
+        TraceOut(&done, sizeof(done));
+    }
+}
+
+static AJ_Status ReplayRecv(AJ_IOBuffer* buf, uint32_t len, uint32_t timeout)
+{
+    ReplayTransport* transport = (ReplayTransport*)buf->context;
+    size_t avail = transport->inSize - transport->inPos;
+
+    if (!avail) {
+        return AJ_ERR_TIMEOUT;
+    }
+    if (avail > AJ_IO_BUF_SPACE(buf)) {
+        avail = AJ_IO_BUF_SPACE(buf);
+    }
+    memcpy(buf->writePtr, transport->in + transport->inPos, avail);
+    buf->writePtr += avail;
+    transport->inPos += avail;
+
+    return AJ_OK;
+}
+
+static AJ_Status ReplaySend(AJ_IOBuffer* buf)
+{
+    ReplayTransport* transport = (ReplayTransport*)buf->context;
+    AJ_Status status = TraceBufferAppend(&transport->out, buf->readPtr, AJ_IO_BUF_AVAIL(buf));
+
+    AJ_IO_BUF_RESET(buf);
+
+    return status;
+}
+
+static size_t MessageLength(const uint8_t* data, size_t size)
+{
+    size_t len = 0;
+
+    if (size < sizeof(AJ_MsgHeader)) {
+        return size;
+    }
+    len = sizeof(AJ_MsgHeader) + PAD8(ReadUint32(data + 12, data[0])) + ReadUint32(data + 4, data[0]);
+
+    return (len < size) ? len : size;
+}
+
+//Compares message by message, leaving out the serial numbers which depend on the bus attachment
+static bool IsSameOutput(const uint8_t* recorded, size_t recordedSize, const uint8_t* replayed, size_t replayedSize)
+{
+    while (recordedSize && replayedSize) {
+        size_t len = MessageLength(recorded, recordedSize);
+
+        if (len != MessageLength(replayed, replayedSize)) {
+            return false;
+        }
+        if (len < sizeof(AJ_MsgHeader)) {
+            return !memcmp(recorded, replayed, len) && (recordedSize == replayedSize);
+        }
+        if (memcmp(recorded, replayed, SERIAL_OFFSET) ||
+            memcmp(recorded + SERIAL_OFFSET + 4, replayed + SERIAL_OFFSET + 4, len - SERIAL_OFFSET - 4)) {
+            return false;
+        }
+        recorded += len;
+        recordedSize -= len;
+        replayed += len;
+        replayedSize -= len;
+    }
+
+    return !recordedSize && !replayedSize;
+}
+
+static AJ_Status ReadRecordPayload(CdmTraceReadFunc read, void* context, uint32_t length, TraceBuffer* payload)
+{
+    payload->size = 0;
+    if (length > payload->capacity) {
+        uint8_t* grown = (uint8_t*)realloc(payload->data, length);
+        if (!grown) {
+            return AJ_ERR_RESOURCES;
+        }
+        payload->data = grown;
+        payload->capacity = length;
+    }
+    payload->size = length;
+
+    return length ? read(payload->data, length, context) : AJ_OK;
+}
+
+AJ_Status Cdm_TraceReplay(CdmTraceReadFunc read, void* context, CdmTraceReplayHandler handler, CdmTraceReplayStats* stats)
+{
+    AJ_Status status = AJ_OK;
+    CdmTraceFileHeader fileHeader;
+    CdmTraceRecordHeader record;
+    CdmTraceReplayStats total;
+    CdmTraceReplayReport report;
+    CdmTraceDone done;
+    AJ_BusAttachment bus;
+    AJ_Message msg;
+    ReplayTransport transport;
+    TraceBuffer payload;
+    TraceBuffer messageIn;
+    TraceBuffer recordedOut;
+    uint8_t* rxData = NULL;
+    uint8_t* txData = NULL;
+    uint8_t inFlags = 0;
+    uint8_t outFlags = 0;
+    bool pending = false;
+    uint32_t start = 0;
+
+    if (!read) {
+        return AJ_ERR_INVALID;
+    }
+
+    status = read(&fileHeader, sizeof(fileHeader), context);
+    if (status != AJ_OK) {
+        return status;
+    }
+    if (fileHeader.magic != CDM_TRACE_MAGIC || fileHeader.version != CDM_TRACE_VERSION) {
+        return AJ_ERR_INVALID;
+    }
+
+    rxData = (uint8_t*)malloc(CDM_TRACE_REPLAY_BUFFER_SIZE);
+    txData = (uint8_t*)malloc(CDM_TRACE_REPLAY_BUFFER_SIZE);
+    if (!rxData || !txData) {
+        free(rxData);
+        free(txData);
+        return AJ_ERR_RESOURCES;
+    }
+
+    status = CdmRegisterInsecureObjects(true);
+    if (status != AJ_OK) {
+        free(rxData);
+        free(txData);
+        return status;
+    }
+
+    memset(&total, 0, sizeof(total));
+    memset(&transport, 0, sizeof(transport));
+    memset(&payload, 0, sizeof(payload));
+    memset(&messageIn, 0, sizeof(messageIn));
+    memset(&recordedOut, 0, sizeof(recordedOut));
+    memset(&bus, 0, sizeof(bus));
+    AJ_IOBufInit(&bus.sock.rx, rxData, CDM_TRACE_REPLAY_BUFFER_SIZE, AJ_IO_BUF_RX, &transport);
+    bus.sock.rx.recv = ReplayRecv;
+    AJ_IOBufInit(&bus.sock.tx, txData, CDM_TRACE_REPLAY_BUFFER_SIZE, AJ_IO_BUF_TX, &transport);
+    bus.sock.tx.send = ReplaySend;
+
+    while (status == AJ_OK) {
+        status = read(&record, sizeof(record), context);
+        if (status == AJ_OK) {
+            status = ReadRecordPayload(read, context, record.length, &payload);
+        }
+        if (status != AJ_OK) {
+            break;
+        }
+
+        switch (record.type) {
+        case CDM_TRACE_RECORD_IN:
+            messageIn.size = 0;
+            recordedOut.size = 0;
+            status = TraceBufferAppend(&messageIn, payload.data, payload.size);
+            inFlags = record.flags;
+            outFlags = 0;
+            pending = (status == AJ_OK);
+            break;
+
+        case CDM_TRACE_RECORD_OUT:
+            if (pending && !(record.flags & CDM_TRACE_FLAG_UNSOLICITED)) {
+                status = TraceBufferAppend(&recordedOut, payload.data, payload.size);
+                outFlags |= record.flags;
+            }
+            break;
+
+        case CDM_TRACE_RECORD_DONE:
+            if (!pending || payload.size < sizeof(done)) {
+                break;
+            }
+            pending = false;
+            memcpy(&done, payload.data, sizeof(done));
+
+            memset(&report, 0, sizeof(report));
+            report.index = total.messages++;
+            report.msgId = done.msgId;
+            report.recordedDuration = done.duration;
+            report.status = AJ_OK;
+            report.output = CDM_TRACE_OUTPUT_SKIPPED;
+            total.recordedDuration += done.duration;
+
+            if (!(inFlags & CDM_TRACE_FLAG_TRUNCATED)) {
+                AJSVC_ServiceStatus serviceStatus = AJSVC_SERVICE_STATUS_NOT_HANDLED;
+
+                transport.in = messageIn.data;
+                transport.inSize = messageIn.size;
+                transport.inPos = 0;
+                transport.out.size = 0;
+                AJ_IO_BUF_RESET(&bus.sock.rx);
+                AJ_IO_BUF_RESET(&bus.sock.tx);
+
+                start = CdmTimerWheelNow();
+                report.status = AJ_UnmarshalMsg(&bus, &msg, 0);
+                if (report.status == AJ_OK) {
+                    serviceStatus = Cdm_MessageProcessor(&bus, &msg, &report.status);
+                }
+                AJ_CloseMsg(&msg);
+                report.replayedDuration = CdmTimerWheelNow() - start;
+                total.replayedDuration += report.replayedDuration;
+
+                if (outFlags & CDM_TRACE_FLAG_ENCRYPTED) {
+                    //The recorded bytes are ciphertext while the replay sends plain messages
+                    report.output = CDM_TRACE_OUTPUT_ENCRYPTED;
+                } else if ((serviceStatus == AJSVC_SERVICE_STATUS_HANDLED) == done.handled) {
+                    report.output = IsSameOutput(recordedOut.data, recordedOut.size, transport.out.data, transport.out.size) ?
+                                    CDM_TRACE_OUTPUT_MATCHED : CDM_TRACE_OUTPUT_MISMATCHED;
+                } else {
+                    report.output = CDM_TRACE_OUTPUT_MISMATCHED;
+                }
+            }
+
+            if (report.output == CDM_TRACE_OUTPUT_MATCHED) {
+                total.matched++;
+            } else if (report.output == CDM_TRACE_OUTPUT_MISMATCHED) {
+                total.mismatched++;
+            } else if (report.output == CDM_TRACE_OUTPUT_ENCRYPTED) {
+                total.encrypted++;
+            } else {
+                total.skipped++;
+            }
+            if (handler) {
+                handler(&report, context);
+            }
+            break;
+
+        default:
+            //Unknown records are skipped for forward compatibility
+            break;
+        }
+    }
+
+    if (status == AJ_ERR_END_OF_DATA) {
+        status = AJ_OK;
+    }
+
+    CdmRegisterInsecureObjects(false);
+    free(payload.data);
+    free(messageIn.data);
+    free(recordedOut.data);
+    free(transport.out.data);
+    free(rxData);
+    free(txData);
+
+    if (stats) {
+        memcpy(stats, &total, sizeof(total));
+    }
+
+    return status;
+}
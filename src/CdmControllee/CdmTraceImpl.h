@@ -0,0 +1,38 @@
+/******************************************************************************
+ * Copyright AllSeen Alliance. All rights reserved.
+ *
+ *    Permission to use, copy, modify, and/or distribute this software for any
+ *    purpose with or without fee is hereby granted, provided that the above
+ *    copyright notice and this permission notice appear in all copies.
+ *
+ *    THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ *    WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ *    ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ *    WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ *    ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ *    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ ******************************************************************************/
+
+
+#ifndef CDMTRACEIMPL_H_
+#define CDMTRACEIMPL_H_
+
+#include <ajtcl/alljoyn.h>
+#include <ajtcl/cdm/CdmTrace.h>
+
+/**
+ * Record a message entering Cdm_MessageProcessor, if a trace is running on its bus attachment.
+ * @param[in] msg message, before any argument is unmarshaled
+ */
+void CdmTraceMessageBegin(AJ_Message* msg);
+
+/**
+ * Record the end of Cdm_MessageProcessor.
+ * @param[in] msg message given to CdmTraceMessageBegin
+ * @param[in] serviceStatus service status returned by Cdm_MessageProcessor
+ * @param[in] status status returned through the status argument
+ */
+void CdmTraceMessageEnd(AJ_Message* msg, AJSVC_ServiceStatus serviceStatus, AJ_Status status);
+
+#endif /* CDMTRACEIMPL_H_ */
@@ -0,0 +1,419 @@
+/******************************************************************************
+ * Copyright AllSeen Alliance. All rights reserved.
+ *
+ *    Permission to use, copy, modify, and/or distribute this software for any
+ *    purpose with or without fee is hereby granted, provided that the above
+ *    copyright notice and this permission notice appear in all copies.
+ *
+ *    THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ *    WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ *    ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ *    WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ *    ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ *    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ ******************************************************************************/
+
+
+#include <stdlib.h>
+#include <string.h>
+#include <ajtcl/cdm/CdmController.h>
+#include "../CdmControllee/CdmControlleeImpl.h"
+#include "../interfaces/operation/AlertsImpl.h"
+#include "../interfaces/operation/AudioVolumeImpl.h"
+#include "../interfaces/operation/AudioVideoInputImpl.h"
+#include "../interfaces/operation/ChannelImpl.h"
+#include "../interfaces/operation/ClosedStatusImpl.h"
+#include "../interfaces/operation/CurrentPowerImpl.h"
+#include "../interfaces/operation/CycleControlImpl.h"
+#include "../interfaces/operation/DishWashingCyclePhaseImpl.h"
+#include "../interfaces/operation/LaundryCyclePhaseImpl.h"
+#include "../interfaces/operation/OnControlImpl.h"
+#include "../interfaces/operation/OffControlImpl.h"
+#include "../interfaces/operation/OnOffStatusImpl.h"
+#include "../interfaces/operation/OvenCyclePhaseImpl.h"
+#include "../interfaces/operation/FanSpeedLevelImpl.h"
+#include "../interfaces/operation/BatteryStatusImpl.h"
+#include "../interfaces/operation/ClimateControlModeImpl.h"
+#include "../interfaces/operation/EnergyUsageImpl.h"
+#include "../interfaces/operation/HeatingZoneImpl.h"
+#include "../interfaces/operation/RapidModeImpl.h"
+#include "../interfaces/operation/RemoteControllabilityImpl.h"
+#include "../interfaces/operation/RepeatModeImpl.h"
+#include "../interfaces/operation/ResourceSavingImpl.h"
+#include "../interfaces/operation/AirRecirculationModeImpl.h"
+#include "../interfaces/operation/RobotCleaningCyclePhaseImpl.h"
+#include "../interfaces/operation/SoilLevelImpl.h"
+#include "../interfaces/operation/SpinSpeedLevelImpl.h"
+#include "../interfaces/operation/TimerImpl.h"
+#include "../interfaces/operation/MoistureOutputLevelImpl.h"
+#include "../interfaces/operation/FilterStatusImpl.h"
+#include "../interfaces/environment/CurrentAirQualityImpl.h"
+#include "../interfaces/environment/CurrentAirQualityLevelImpl.h"
+#include "../interfaces/environment/CurrentTemperatureImpl.h"
+#include "../interfaces/environment/TargetTemperatureImpl.h"
+#include "../interfaces/environment/WaterLevelImpl.h"
+#include "../interfaces/environment/WindDirectionImpl.h"
+#include "../interfaces/input/HidImpl.h"
+#include "../interfaces/environment/CurrentHumidityImpl.h"
+#include "../interfaces/environment/TargetHumidityImpl.h"
+#include "../interfaces/environment/TargetTemperatureLevelImpl.h"
+#include "../interfaces/operation/HvacFanModeImpl.h"
+#include "../interfaces/operation/PlugInUnitsImpl.h"
+#include "../interfaces/operation/RapidModeTimedImpl.h"
+#include "CdmAnnouncementIndexImpl.h"
+
+static const CdmKnownInterface knownInterfaces[] = {
+    { ALERTS_INTERFACE, intfDescOperationAlerts },
+    { AUDIO_VOLUME_INTERFACE, intfDescOperationAudioVolume },
+    { AUDIO_VIDEO_INPUT_INTERFACE, intfDescOperationAudioVideoInput },
+    { CHANNEL_INTERFACE, intfDescOperationChannel },
+    { CLOSED_STATUS_INTERFACE, intfDescOperationClosedStatus },
+    { CURRENT_POWER_INTERFACE, intfDescOperationCurrentPower },
+    { CYCLE_CONTROL_INTERFACE, intfDescOperationCycleControl },
+    { DISH_WASHING_CYCLE_PHASE_INTERFACE, intfDescOperationDishWashingCyclePhase },
+    { LAUNDRY_CYCLE_PHASE_INTERFACE, intfDescOperationLaundryCyclePhase },
+    { ON_CONTROL_INTERFACE, intfDescOperationOnControl },
+    { OFF_CONTROL_INTERFACE, intfDescOperationOffControl },
+    { ON_OFF_STATUS_INTERFACE, intfDescOperationOnOffStatus },
+    { OVEN_CYCLE_PHASE_INTERFACE, intfDescOperationOvenCyclePhase },
+    { FAN_SPEED_LEVEL_INTERFACE, intfDescOperationFanSpeedLevel },
+    { BATTERY_STATUS_INTERFACE, intfDescOperationBatteryStatus },
+    { CLIMATE_CONTROL_MODE_INTERFACE, intfDescOperationClimateControlMode },
+    { ENERGY_USAGE_INTERFACE, intfDescOperationEnergyUsage },
+    { HEATING_ZONE_INTERFACE, intfDescOperationHeatingZone },
+    { RAPID_MODE_INTERFACE, intfDescOperationRapidMode },
+    { REMOTE_CONTROLLABILITY_INTERFACE, intfDescOperationRemoteControllability },
+    { REPEAT_MODE_INTERFACE, intfDescOperationRepeatMode },
+    { RESOURCE_SAVING_INTERFACE, intfDescOperationResourceSaving },
+    { AIR_RECIRCULATION_MODE_INTERFACE, intfDescOperationAirRecirculationMode },
+    { ROBOT_CLEANING_CYCLE_PHASE_INTERFACE, intfDescOperationRobotCleaningCyclePhase },
+    { SOIL_LEVEL_INTERFACE, intfDescOperationSoilLevel },
+    { SPIN_SPEED_LEVEL_INTERFACE, intfDescOperationSpinSpeedLevel },
+    { TIMER_INTERFACE, intfDescOperationTimer },
+    { MOISTURE_OUTPUT_LEVEL_INTERFACE, intfDescOperationMoistureOutputLevel },
+    { FILTER_STATUS_INTERFACE, intfDescOperationFilterStatus },
+    { CURRENT_AIR_QUALITY_INTERFACE, intfDescEnvironmentCurrentAirQuality },
+    { CURRENT_AIR_QUALITY_LEVEL_INTERFACE, intfDescEnvironmentCurrentAirQualityLevel },
+    { CURRENT_TEMPERATURE_INTERFACE, intfDescEnvironmentCurrentTemperature },
+    { TARGET_TEMPERATURE_INTERFACE, intfDescEnvironmentTargetTemperature },
+    { WATER_LEVEL_INTERFACE, intfDescEnvironmentWaterLevel },
+    { WIND_DIRECTION_INTERFACE, intfDescEnvironmentWindDirection },
+    { HID_INTERFACE, intfDescInputHid },
+    { CURRENT_HUMIDITY_INTERFACE, intfDescEnvironmentCurrentHumidity },
+    { TARGET_HUMIDITY_INTERFACE, intfDescEnvironmentTargetHumidity },
+    { TARGET_TEMPERATURE_LEVEL_INTERFACE, intfDescEnvironmentTargetTemperatureLevel },
+    { HVAC_FAN_MODE_INTERFACE, intfDescOperationHvacFanMode },
+    { PLUG_IN_UNITS_INTERFACE, intfDescOperationPlugInUnits },
+    { RAPID_MODE_TIMED_INTERFACE, intfDescOperationRapidModeTimed },
+};
+
+//Lists of the indexed objects per interface type
+static CdmIndexPosting* postingFirst[MAX_BASIC_INTERFACE_TYPE];
+static uint16_t postingCount[MAX_BASIC_INTERFACE_TYPE];
+static CdmIndexedBus* busFirst;
+
+const char* CdmGetInterfaceName(const char* const* intfDesc)
+{
+    const char* intfName = intfDesc[0];
+
+    //Skip the secure interface prefix
+    if (*intfName == '$') {
+        intfName++;
+    }
+
+    return intfName;
+}
+
+const CdmKnownInterface* CdmFindKnownInterface(const char* intfName)
+{
+    size_t i;
+
+    for (i = 0; i < sizeof(knownInterfaces) / sizeof(knownInterfaces[0]); i++) {
+        if (!strcmp(CdmGetInterfaceName(knownInterfaces[i].intfDesc), intfName)) {
+            return &knownInterfaces[i];
+        }
+    }
+
+    return NULL;
+}
+
+const CdmKnownInterface* CdmGetKnownInterface(CdmInterfaceTypes intfType)
+{
+    size_t i;
+
+    for (i = 0; i < sizeof(knownInterfaces) / sizeof(knownInterfaces[0]); i++) {
+        if (knownInterfaces[i].intfType == intfType) {
+            return &knownInterfaces[i];
+        }
+    }
+
+    return NULL;
+}
+
+static CdmIndexedBus* FindBus(const char* busName)
+{
+    CdmIndexedBus* bus = busFirst;
+
+    while (bus) {
+        if (!strcmp(bus->busName, busName)) {
+            break;
+        }
+        bus = bus->busNext;
+    }
+
+    return bus;
+}
+
+static void UnlinkObject(CdmIndexedObject* obj)
+{
+    uint8_t intfType;
+    uint8_t i = 0;
+
+    for (intfType = 0; intfType < MAX_BASIC_INTERFACE_TYPE; intfType++) {
+        if (obj->intfMask & ((uint64_t)1 << intfType)) {
+            CdmIndexPosting* posting = &obj->postings[i++];
+
+            if (posting->prev) {
+                posting->prev->next = posting->next;
+            } else {
+                postingFirst[intfType] = posting->next;
+            }
+            if (posting->next) {
+                posting->next->prev = posting->prev;
+            }
+            postingCount[intfType]--;
+        }
+    }
+}
+
+static AJ_Status LinkObject(CdmIndexedObject* obj)
+{
+    uint8_t intfType;
+    uint8_t numPostings = 0;
+    uint8_t i = 0;
+
+    for (intfType = 0; intfType < MAX_BASIC_INTERFACE_TYPE; intfType++) {
+        if (obj->intfMask & ((uint64_t)1 << intfType)) {
+            numPostings++;
+        }
+    }
+
+    obj->postings = (CdmIndexPosting*)calloc(numPostings, sizeof(CdmIndexPosting));
+    if (!obj->postings) {
+        return AJ_ERR_RESOURCES;
+    }
+
+    for (intfType = 0; intfType < MAX_BASIC_INTERFACE_TYPE; intfType++) {
+        if (obj->intfMask & ((uint64_t)1 << intfType)) {
+            CdmIndexPosting* posting = &obj->postings[i++];
+
+            posting->obj = obj;
+            posting->next = postingFirst[intfType];
+            if (posting->next) {
+                posting->next->prev = posting;
+            }
+            postingFirst[intfType] = posting;
+            postingCount[intfType]++;
+        }
+    }
+
+    return AJ_OK;
+}
+
+static void FreeObjects(CdmIndexedBus* bus)
+{
+    CdmIndexedObject* obj = bus->objFirst;
+
+    while (obj) {
+        CdmIndexedObject* objNext = obj->objNext;
+
+        if (obj->postings) {
+            UnlinkObject(obj);
+            free(obj->postings);
+        }
+        free(obj->objPath);
+        free(obj);
+        obj = objNext;
+    }
+    bus->objFirst = NULL;
+}
+
+static AJ_Status AddObject(CdmIndexedBus* bus, const char* objPath, uint64_t intfMask)
+{
+    CdmIndexedObject* obj = NULL;
+
+    //Paths may be listed more than once in an announcement
+    obj = bus->objFirst;
+    while (obj) {
+        if (!strcmp(obj->objPath, objPath)) {
+            obj->intfMask |= intfMask;
+            return AJ_OK;
+        }
+        obj = obj->objNext;
+    }
+
+    obj = (CdmIndexedObject*)calloc(1, sizeof(CdmIndexedObject));
+    if (!obj) {
+        return AJ_ERR_RESOURCES;
+    }
+    obj->objPath = (char*)malloc(strlen(objPath) + 1);
+    if (!obj->objPath) {
+        free(obj);
+        return AJ_ERR_RESOURCES;
+    }
+    strcpy(obj->objPath, objPath);
+    obj->bus = bus;
+    obj->intfMask = intfMask;
+    obj->objNext = bus->objFirst;
+    bus->objFirst = obj;
+
+    return AJ_OK;
+}
+
+AJ_Status CdmIndexAnnouncement(const char* busName, AJ_Message* msg)
+{
+    AJ_Status status;
+    AJ_Arg objArray;
+    AJ_Arg objStruct;
+    AJ_Arg intfArray;
+    CdmIndexedBus* bus = NULL;
+    CdmIndexedObject* obj = NULL;
+    const char* objPath = NULL;
+    const char* intfName = NULL;
+
+    bus = FindBus(busName);
+    if (!bus) {
+        bus = (CdmIndexedBus*)calloc(1, sizeof(CdmIndexedBus));
+        if (!bus) {
+            return AJ_ERR_RESOURCES;
+        }
+        bus->busName = (char*)malloc(strlen(busName) + 1);
+        if (!bus->busName) {
+            free(bus);
+            return AJ_ERR_RESOURCES;
+        }
+        strcpy(bus->busName, busName);
+        bus->busNext = busFirst;
+        busFirst = bus;
+    } else {
+        FreeObjects(bus);
+    }
+
+    status = AJ_UnmarshalContainer(msg, &objArray, AJ_ARG_ARRAY);
+    while (status == AJ_OK) {
+        uint64_t intfMask = 0;
+
+        status = AJ_UnmarshalContainer(msg, &objStruct, AJ_ARG_STRUCT);
+        if (status != AJ_OK) {
+            break;
+        }
+        status = AJ_UnmarshalArgs(msg, "o", &objPath);
+        if (status == AJ_OK) {
+            status = AJ_UnmarshalContainer(msg, &intfArray, AJ_ARG_ARRAY);
+        }
+        while (status == AJ_OK) {
+            status = AJ_UnmarshalArgs(msg, "s", &intfName);
+            if (status == AJ_OK) {
+                const CdmKnownInterface* known = CdmFindKnownInterface(intfName);
+                if (known) {
+                    intfMask |= (uint64_t)1 << known->intfType;
+                }
+            }
+        }
+        if (status == AJ_ERR_NO_MORE) {
+            status = AJ_UnmarshalCloseContainer(msg, &intfArray);
+        }
+        if (status == AJ_OK) {
+            status = AJ_UnmarshalCloseContainer(msg, &objStruct);
+        }
+        if (status == AJ_OK && intfMask) {
+            status = AddObject(bus, objPath, intfMask);
+        }
+    }
+    if (status == AJ_ERR_NO_MORE) {
+        status = AJ_UnmarshalCloseContainer(msg, &objArray);
+    }
+
+    //Index the objects once all interfaces of each path are known
+    obj = bus->objFirst;
+    while (obj && status == AJ_OK) {
+        status = LinkObject(obj);
+        obj = obj->objNext;
+    }
+
+    if (status != AJ_OK || !bus->objFirst) {
+        CdmIndexRemove(busName);
+    }
+
+    return status;
+}
+
+const CdmIndexedObject* CdmIndexGetObjects(const char* busName)
+{
+    CdmIndexedBus* bus = FindBus(busName);
+
+    return bus ? bus->objFirst : NULL;
+}
+
+void CdmIndexRemove(const char* busName)
+{
+    CdmIndexedBus** link = &busFirst;
+
+    while (*link) {
+        CdmIndexedBus* bus = *link;
+
+        if (!strcmp(bus->busName, busName)) {
+            *link = bus->busNext;
+            FreeObjects(bus);
+            free(bus->busName);
+            free(bus);
+            break;
+        }
+        link = &bus->busNext;
+    }
+}
+
+void CdmIndexClear()
+{
+    while (busFirst) {
+        CdmIndexRemove(busFirst->busName);
+    }
+}
+
+size_t CdmIndexFind(const CdmInterfaceTypes* intfTypes, size_t numIntfTypes, CdmObjectFoundHandler handler, void* context)
+{
+    CdmIndexPosting* posting = NULL;
+    uint64_t intfMask = 0;
+    size_t numFound = 0;
+    size_t i;
+    int shortest = -1;
+
+    if (!intfTypes || !numIntfTypes) {
+        return 0;
+    }
+
+    for (i = 0; i < numIntfTypes; i++) {
+        if (intfTypes[i] <= UNDEFINED_INTERFACE || intfTypes[i] >= MAX_BASIC_INTERFACE_TYPE) {
+            return 0;
+        }
+        intfMask |= (uint64_t)1 << intfTypes[i];
+        if (shortest < 0 || postingCount[intfTypes[i]] < postingCount[shortest]) {
+            shortest = intfTypes[i];
+        }
+    }
+
+    //Walk the shortest list and check the rest of the interfaces by the mask
+    posting = postingFirst[shortest];
+    while (posting) {
+        if ((posting->obj->intfMask & intfMask) == intfMask) {
+            numFound++;
+            if (handler) {
+                handler(posting->obj->bus->busName, posting->obj->objPath, context);
+            }
+        }
+        posting = posting->next;
+    }
+
+    return numFound;
+}
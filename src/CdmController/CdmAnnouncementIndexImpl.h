@@ -0,0 +1,108 @@
+/******************************************************************************
+ * Copyright AllSeen Alliance. All rights reserved.
+ *
+ *    Permission to use, copy, modify, and/or distribute this software for any
+ *    purpose with or without fee is hereby granted, provided that the above
+ *    copyright notice and this permission notice appear in all copies.
+ *
+ *    THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ *    WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ *    ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ *    WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ *    ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ *    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ ******************************************************************************/
+
+
+#ifndef CDMANNOUNCEMENTINDEXIMPL_H_
+#define CDMANNOUNCEMENTINDEXIMPL_H_
+
+#include <ajtcl/alljoyn.h>
+#include <ajtcl/cdm/CdmController.h>
+
+typedef struct {
+    CdmInterfaceTypes intfType;
+    const char* const* intfDesc;
+} CdmKnownInterface;
+
+struct indexedBus;
+
+typedef struct indexPosting {
+    struct indexedObject* obj;
+    struct indexPosting* prev;
+    struct indexPosting* next;
+} CdmIndexPosting;
+
+typedef struct indexedObject {
+    struct indexedBus* bus;
+    char* objPath;
+    uint64_t intfMask;              // bit per CdmInterfaceTypes
+    CdmIndexPosting* postings;      // one per interface in intfMask
+    struct indexedObject* objNext;
+} CdmIndexedObject;
+
+typedef struct indexedBus {
+    char* busName;
+    CdmIndexedObject* objFirst;
+    struct indexedBus* busNext;
+} CdmIndexedBus;
+
+/**
+ * Get the interface name without the secure prefix
+ * @param[in] intfDesc interface description
+ * @return interface name
+ */
+const char* CdmGetInterfaceName(const char* const* intfDesc);
+
+/**
+ * Find a CDM interface by name
+ * @param[in] intfName interface name
+ * @return the interface, NULL if it is not a CDM interface
+ */
+const CdmKnownInterface* CdmFindKnownInterface(const char* intfName);
+
+/**
+ * Get a CDM interface by type
+ * @param[in] intfType interface type
+ * @return the interface, NULL if it is not a CDM interface
+ */
+const CdmKnownInterface* CdmGetKnownInterface(CdmInterfaceTypes intfType);
+
+/**
+ * Replace the indexed objects of a bus name by the object descriptions of an Announce signal
+ * @param[in] busName bus name of the announcer
+ * @param[in] msg Announce message, unmarshalled up to the object descriptions
+ * @return AJ_OK on success
+ */
+AJ_Status CdmIndexAnnouncement(const char* busName, AJ_Message* msg);
+
+/**
+ * Get the indexed objects of a bus name
+ * @param[in] busName bus name
+ * @return the first object, NULL if the bus name announced no CDM interface
+ */
+const CdmIndexedObject* CdmIndexGetObjects(const char* busName);
+
+/**
+ * Remove the indexed objects of a bus name which left the bus
+ * @param[in] busName bus name
+ */
+void CdmIndexRemove(const char* busName);
+
+/**
+ * Remove all indexed objects
+ */
+void CdmIndexClear();
+
+/**
+ * Find the indexed objects implementing all of the interfaces
+ * @param[in] intfTypes interface types
+ * @param[in] numIntfTypes the number of interface types
+ * @param[in] handler handler called for each object found
+ * @param[in] context context passed to the handler
+ * @return the number of objects found
+ */
+size_t CdmIndexFind(const CdmInterfaceTypes* intfTypes, size_t numIntfTypes, CdmObjectFoundHandler handler, void* context);
+
+#endif /* CDMANNOUNCEMENTINDEXIMPL_H_ */
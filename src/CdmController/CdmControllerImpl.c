@@ -0,0 +1,973 @@
+/******************************************************************************
+ * Copyright AllSeen Alliance. All rights reserved.
+ *
+ *    Permission to use, copy, modify, and/or distribute this software for any
+ *    purpose with or without fee is hereby granted, provided that the above
+ *    copyright notice and this permission notice appear in all copies.
+ *
+ *    THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ *    WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ *    ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ *    WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ *    ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ *    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ ******************************************************************************/
+
+
+#define AJ_MODULE CDM_CONTROLLER
+
+#include <stdlib.h>
+#include <string.h>
+#include <ajtcl/aj_debug.h>
+#include <ajtcl/cdm/CdmController.h>
+#include "CdmAnnouncementIndexImpl.h"
+
+#ifndef NDEBUG
+#ifndef ER_DEBUG_CDM_CONTROLLER
+#define ER_DEBUG_CDM_CONTROLLER 0
+#endif
+AJ_EXPORT uint8_t dbgCDM_CONTROLLER = ER_DEBUG_CDM_CONTROLLER;
+#endif
+
+#define ANNOUNCE_MATCH_RULE "type='signal',sessionless='t',interface='org.alljoyn.About',member='Announce'"
+#define PROPERTIES_CHANGED_MATCH_RULE "type='signal',interface='org.freedesktop.DBus.Properties',member='PropertiesChanged'"
+#define NAME_OWNER_CHANGED_MATCH_RULE "type='signal',interface='org.freedesktop.DBus',member='NameOwnerChanged'"
+
+typedef enum {
+    SYNC_PENDING,
+    SYNC_DONE,
+    SYNC_FAILED,
+} CdmSyncState;
+
+typedef enum {
+    DEVICE_FOUND,
+    DEVICE_JOINING,
+    DEVICE_JOINED,
+} CdmDeviceState;
+
+typedef struct {
+    bool valid;
+    union {
+        uint8_t y;
+        uint32_t b;
+        uint16_t q;
+        int32_t i;
+        uint32_t u;
+        double d;
+    } value;
+    void* data;     // value of "s", "ay" and "aq" properties
+    size_t size;    // size of data in bytes
+} CdmCachedProperty;
+
+typedef struct remoteInterface {
+    CdmInterfaceTypes intfType;
+    const char* const* intfDesc;
+    CdmCachedProperty* props;   // indexed by member index
+    uint8_t numMembers;
+    CdmSyncState syncState;
+    struct remoteInterface* intfNext;
+} CdmRemoteInterface;
+
+typedef struct remoteObject {
+    uint8_t proxyIndex;
+    CdmRemoteInterface* intfFirst;
+    struct remoteObject* objNext;
+} CdmRemoteObject;
+
+typedef struct remoteDevice {
+    char* busName;
+    uint16_t port;
+    uint32_t sessionId;
+    CdmDeviceState state;
+    CdmRemoteObject* objFirst;
+    struct remoteDevice* deviceNext;
+} CdmRemoteDevice;
+
+//Every remote object only needs the Properties interface for GetAll and PropertiesChanged
+static const AJ_InterfaceDescription proxyInterfaces[] = {
+    AJ_PropertiesIface,
+    NULL
+};
+
+static const CdmControllerListener* controllerListener;
+static AJ_BusAttachment* controllerBus;
+static AJ_Object* proxyObjects;
+static uint8_t numProxyObjects;
+static CdmRemoteDevice* deviceFirst;
+static CdmRemoteDevice* joiningDevice;
+static CdmRemoteDevice* syncingDevice;
+static CdmRemoteInterface* syncingIntf;
+static const char* syncingPath;
+static uint32_t syncMsgId;
+static uint32_t syncSerial;
+
+/**
+ * Returns the signature of the property member if the member is a property named propName
+ */
+static const char* GetPropertySignature(const char* member, const char* propName)
+{
+    size_t len = strlen(propName);
+
+    if (member[0] != '@' || strncmp(member + 1, propName, len)) {
+        return NULL;
+    }
+    if (member[len + 1] != '>' && member[len + 1] != '<' && member[len + 1] != '=') {
+        return NULL;
+    }
+
+    return member + len + 2;
+}
+
+static CdmCachedProperty* FindCachedProperty(CdmRemoteInterface* intf, const char* propName, const char** signature)
+{
+    uint8_t i;
+
+    for (i = 0; i < intf->numMembers; i++) {
+        const char* sig = GetPropertySignature(intf->intfDesc[i + 1], propName);
+        if (sig) {
+            if (signature) {
+                *signature = sig;
+            }
+            return &intf->props[i];
+        }
+    }
+
+    return NULL;
+}
+
+static bool IsCachedSignature(const char* signature)
+{
+    static const char* const cachedSignatures[] = { "y", "b", "q", "i", "u", "d", "s", "ay", "aq", NULL };
+    uint8_t i;
+
+    for (i = 0; cachedSignatures[i]; i++) {
+        if (!strcmp(signature, cachedSignatures[i])) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+static void ClearCachedProperty(CdmCachedProperty* prop)
+{
+    if (prop->data) {
+        free(prop->data);
+    }
+    memset(prop, 0, sizeof(CdmCachedProperty));
+}
+
+static const char* GetProxyPath(uint8_t proxyIndex)
+{
+    if (proxyIndex < numProxyObjects) {
+        return proxyObjects[proxyIndex].path;
+    }
+
+    return NULL;
+}
+
+static AJ_Status GetProxyIndex(const char* objPath, uint8_t* proxyIndex)
+{
+    AJ_Object* objects = NULL;
+    char* path = NULL;
+    uint8_t i;
+
+    for (i = 0; i < numProxyObjects; i++) {
+        if (!strcmp(proxyObjects[i].path, objPath)) {
+            *proxyIndex = i;
+            return AJ_OK;
+        }
+    }
+
+    if (numProxyObjects == 0xFF) {
+        return AJ_ERR_RESOURCES;
+    }
+
+    path = (char*)malloc(strlen(objPath) + 1);
+    if (!path) {
+        return AJ_ERR_RESOURCES;
+    }
+    strcpy(path, objPath);
+
+    objects = (AJ_Object*)realloc(proxyObjects, sizeof(AJ_Object) * (numProxyObjects + 2));
+    if (!objects) {
+        free(path);
+        return AJ_ERR_RESOURCES;
+    }
+    proxyObjects = objects;
+
+    memset(&proxyObjects[numProxyObjects], 0, sizeof(AJ_Object) * 2);
+    proxyObjects[numProxyObjects].path = path;
+    proxyObjects[numProxyObjects].interfaces = proxyInterfaces;
+    proxyObjects[numProxyObjects].flags = AJ_OBJ_FLAG_IS_PROXY;
+    *proxyIndex = numProxyObjects++;
+
+    //The list may have moved
+    if (controllerBus) {
+        AJ_RegisterObjectList(proxyObjects, CDM_CONTROLLER_OBJECTS_LIST_INDEX);
+    }
+
+    return AJ_OK;
+}
+
+static CdmRemoteDevice* FindDevice(const char* busName)
+{
+    CdmRemoteDevice* device = deviceFirst;
+
+    while (device) {
+        if (!strcmp(device->busName, busName)) {
+            break;
+        }
+        device = device->deviceNext;
+    }
+
+    return device;
+}
+
+static CdmRemoteObject* FindObject(CdmRemoteDevice* device, uint8_t proxyIndex)
+{
+    CdmRemoteObject* obj = device->objFirst;
+
+    while (obj) {
+        if (obj->proxyIndex == proxyIndex) {
+            break;
+        }
+        obj = obj->objNext;
+    }
+
+    return obj;
+}
+
+static CdmRemoteInterface* FindInterface(CdmRemoteObject* obj, CdmInterfaceTypes intfType)
+{
+    CdmRemoteInterface* intf = obj->intfFirst;
+
+    while (intf) {
+        if (intf->intfType == intfType) {
+            break;
+        }
+        intf = intf->intfNext;
+    }
+
+    return intf;
+}
+
+static AJ_Status AddInterface(CdmRemoteDevice* device, const char* objPath, const CdmKnownInterface* known)
+{
+    AJ_Status status;
+    CdmRemoteObject* obj = NULL;
+    CdmRemoteInterface* intf = NULL;
+    uint8_t proxyIndex = 0;
+    uint8_t numMembers = 0;
+
+    status = GetProxyIndex(objPath, &proxyIndex);
+    if (status != AJ_OK) {
+        return status;
+    }
+
+    obj = FindObject(device, proxyIndex);
+    if (!obj) {
+        obj = (CdmRemoteObject*)calloc(1, sizeof(CdmRemoteObject));
+        if (!obj) {
+            return AJ_ERR_RESOURCES;
+        }
+        obj->proxyIndex = proxyIndex;
+        obj->objNext = device->objFirst;
+        device->objFirst = obj;
+    }
+
+    if (FindInterface(obj, known->intfType)) {
+        return AJ_OK;
+    }
+
+    while (known->intfDesc[numMembers + 1]) {
+        numMembers++;
+    }
+
+    intf = (CdmRemoteInterface*)calloc(1, sizeof(CdmRemoteInterface));
+    if (!intf) {
+        return AJ_ERR_RESOURCES;
+    }
+    intf->props = (CdmCachedProperty*)calloc(numMembers, sizeof(CdmCachedProperty));
+    if (!intf->props) {
+        free(intf);
+        return AJ_ERR_RESOURCES;
+    }
+    intf->intfType = known->intfType;
+    intf->intfDesc = known->intfDesc;
+    intf->numMembers = numMembers;
+    intf->syncState = SYNC_PENDING;
+    intf->intfNext = obj->intfFirst;
+    obj->intfFirst = intf;
+
+    return AJ_OK;
+}
+
+static void FreeDevice(CdmRemoteDevice* device)
+{
+    CdmRemoteObject* obj = device->objFirst;
+
+    while (obj) {
+        CdmRemoteObject* objNext = obj->objNext;
+        CdmRemoteInterface* intf = obj->intfFirst;
+
+        while (intf) {
+            CdmRemoteInterface* intfNext = intf->intfNext;
+            uint8_t i;
+
+            for (i = 0; i < intf->numMembers; i++) {
+                ClearCachedProperty(&intf->props[i]);
+            }
+            free(intf->props);
+            free(intf);
+            intf = intfNext;
+        }
+        free(obj);
+        obj = objNext;
+    }
+
+    free(device->busName);
+    free(device);
+}
+
+static void RemoveDevice(CdmRemoteDevice* device)
+{
+    CdmRemoteDevice** link = &deviceFirst;
+
+    while (*link) {
+        if (*link == device) {
+            *link = device->deviceNext;
+            break;
+        }
+        link = &(*link)->deviceNext;
+    }
+
+    if (joiningDevice == device) {
+        joiningDevice = NULL;
+    }
+    if (syncingDevice == device) {
+        syncingDevice = NULL;
+        syncingIntf = NULL;
+    }
+
+    FreeDevice(device);
+}
+
+static AJ_Status UpdateCachedProperty(AJ_Message* msg, CdmRemoteInterface* intf, const char* propName, bool* updated)
+{
+    AJ_Status status;
+    AJ_Arg arg;
+    CdmCachedProperty* prop = NULL;
+    const char* signature = NULL;
+    const char* variantSig = NULL;
+    void* data = NULL;
+
+    *updated = false;
+
+    status = AJ_UnmarshalVariant(msg, &variantSig);
+    if (status != AJ_OK) {
+        return status;
+    }
+
+    prop = FindCachedProperty(intf, propName, &signature);
+    if (!prop || strcmp(signature, variantSig) || !IsCachedSignature(signature)) {
+        //Properties of other types are not cached
+        return AJ_SkipArg(msg);
+    }
+
+    status = AJ_UnmarshalArg(msg, &arg);
+    if (status != AJ_OK) {
+        return status;
+    }
+
+    if (signature[0] == 's' || signature[0] == 'a') {
+        size_t size = (signature[0] == 's') ? strlen(arg.val.v_string) + 1 : arg.len;
+
+        data = malloc(size ? size : 1);
+        if (!data) {
+            return AJ_ERR_RESOURCES;
+        }
+        memcpy(data, arg.val.v_data, size);
+        ClearCachedProperty(prop);
+        prop->data = data;
+        prop->size = size;
+    } else {
+        ClearCachedProperty(prop);
+        switch (signature[0]) {
+        case 'y':
+            prop->value.y = *arg.val.v_byte;
+            break;
+
+        case 'b':
+            prop->value.b = *arg.val.v_bool;
+            break;
+
+        case 'q':
+            prop->value.q = *arg.val.v_uint16;
+            break;
+
+        case 'i':
+            prop->value.i = *arg.val.v_int32;
+            break;
+
+        case 'u':
+            prop->value.u = *arg.val.v_uint32;
+            break;
+
+        case 'd':
+            prop->value.d = *arg.val.v_double;
+            break;
+        }
+    }
+    prop->valid = true;
+    *updated = true;
+
+    return AJ_OK;
+}
+
+/**
+ * Unmarshal a{sv} of GetAll reply or PropertiesChanged signal into the cache
+ */
+static AJ_Status UpdateCachedProperties(AJ_Message* msg, CdmRemoteDevice* device, const char* objPath, CdmRemoteInterface* intf, bool notify)
+{
+    AJ_Status status;
+    AJ_Arg array;
+    AJ_Arg entry;
+    const char* propName = NULL;
+    bool updated = false;
+
+    status = AJ_UnmarshalContainer(msg, &array, AJ_ARG_ARRAY);
+    while (status == AJ_OK) {
+        status = AJ_UnmarshalContainer(msg, &entry, AJ_ARG_DICT_ENTRY);
+        if (status != AJ_OK) {
+            break;
+        }
+        status = AJ_UnmarshalArgs(msg, "s", &propName);
+        if (status == AJ_OK) {
+            status = UpdateCachedProperty(msg, intf, propName, &updated);
+        }
+        if (status == AJ_OK) {
+            status = AJ_UnmarshalCloseContainer(msg, &entry);
+        }
+        if (status == AJ_OK && updated && notify && controllerListener && controllerListener->OnPropertyChanged) {
+            controllerListener->OnPropertyChanged(device->busName, objPath, intf->intfType, propName);
+        }
+    }
+    if (status == AJ_ERR_NO_MORE) {
+        status = AJ_UnmarshalCloseContainer(msg, &array);
+    }
+
+    return status;
+}
+
+static void SendNextRequest(void)
+{
+    AJ_Status status;
+    CdmRemoteDevice* device = NULL;
+
+    if (!controllerBus || joiningDevice || syncingIntf) {
+        return;
+    }
+
+    device = deviceFirst;
+    while (device) {
+        CdmRemoteDevice* deviceNext = device->deviceNext;
+
+        if (device->state == DEVICE_FOUND) {
+            status = AJ_BusJoinSession(controllerBus, device->busName, device->port, NULL);
+            if (status == AJ_OK) {
+                device->state = DEVICE_JOINING;
+                joiningDevice = device;
+                return;
+            }
+            AJ_WarnPrintf(("Joining session to %s failed: %s\n", device->busName, AJ_StatusText(status)));
+            RemoveDevice(device);
+        } else if (device->state == DEVICE_JOINED) {
+            CdmRemoteObject* obj = device->objFirst;
+
+            while (obj) {
+                CdmRemoteInterface* intf = obj->intfFirst;
+
+                while (intf) {
+                    if (intf->syncState == SYNC_PENDING) {
+                        AJ_Message msg;
+                        uint32_t msgId = AJ_ENCODE_MESSAGE_ID(CDM_CONTROLLER_OBJECTS_LIST_INDEX, obj->proxyIndex, 0, AJ_PROP_GET_ALL);
+
+                        status = AJ_MarshalMethodCall(controllerBus, &msg, msgId, device->busName, device->sessionId, 0, CDM_CONTROLLER_CALL_TIMEOUT);
+                        if (status == AJ_OK) {
+                            status = AJ_MarshalArgs(&msg, "s", CdmGetInterfaceName(intf->intfDesc));
+                        }
+                        if (status == AJ_OK) {
+                            syncSerial = msg.hdr->serialNum;
+                            status = AJ_DeliverMsg(&msg);
+                        }
+                        if (status == AJ_OK) {
+                            syncingDevice = device;
+                            syncingIntf = intf;
+                            syncingPath = GetProxyPath(obj->proxyIndex);
+                            syncMsgId = AJ_REPLY_ID(msgId);
+                            return;
+                        }
+                        intf->syncState = SYNC_FAILED;
+                        if (controllerListener && controllerListener->OnInterfaceSynced) {
+                            controllerListener->OnInterfaceSynced(device->busName, GetProxyPath(obj->proxyIndex), intf->intfType, status);
+                        }
+                    }
+                    intf = intf->intfNext;
+                }
+                obj = obj->objNext;
+            }
+        }
+        device = deviceNext;
+    }
+}
+
+static AJ_Status AnnounceHandler(AJ_BusAttachment* busAttachment, AJ_Message* msg)
+{
+    AJ_Status status;
+    CdmRemoteDevice* device = NULL;
+    const CdmIndexedObject* obj = NULL;
+    bool created = false;
+    uint16_t version = 0;
+    uint16_t port = 0;
+
+    if (!msg->sender || !strcmp(msg->sender, AJ_GetUniqueName(busAttachment))) {
+        return AJ_OK;
+    }
+
+    status = AJ_UnmarshalArgs(msg, "qq", &version, &port);
+    if (status == AJ_OK) {
+        status = CdmIndexAnnouncement(msg->sender, msg);
+    }
+    obj = CdmIndexGetObjects(msg->sender);
+    if (status != AJ_OK || !obj) {
+        return status;
+    }
+
+    device = FindDevice(msg->sender);
+    if (!device) {
+        device = (CdmRemoteDevice*)calloc(1, sizeof(CdmRemoteDevice));
+        if (!device) {
+            return AJ_ERR_RESOURCES;
+        }
+        device->busName = (char*)malloc(strlen(msg->sender) + 1);
+        if (!device->busName) {
+            free(device);
+            return AJ_ERR_RESOURCES;
+        }
+        strcpy(device->busName, msg->sender);
+        device->port = port;
+        device->state = DEVICE_FOUND;
+        created = true;
+    }
+
+    //Interfaces which are no longer announced stay in the cache until the session is lost
+    while (obj && status == AJ_OK) {
+        uint8_t intfType;
+
+        for (intfType = 0; intfType < MAX_BASIC_INTERFACE_TYPE && status == AJ_OK; intfType++) {
+            if (obj->intfMask & ((uint64_t)1 << intfType)) {
+                status = AddInterface(device, obj->objPath, CdmGetKnownInterface((CdmInterfaceTypes)intfType));
+            }
+        }
+        obj = obj->objNext;
+    }
+
+    if (created) {
+        if (status != AJ_OK ||
+            (controllerListener && controllerListener->OnDeviceFound && !controllerListener->OnDeviceFound(device->busName, port))) {
+            FreeDevice(device);
+            return status;
+        }
+        device->deviceNext = deviceFirst;
+        deviceFirst = device;
+    }
+
+    SendNextRequest();
+
+    return status;
+}
+
+static AJ_Status JoinSessionReplyHandler(AJ_Message* msg)
+{
+    AJ_Status status = AJ_ERR_FAILURE;
+    CdmRemoteDevice* device = joiningDevice;
+    uint32_t replyCode = 0;
+    uint32_t sessionId = 0;
+
+    joiningDevice = NULL;
+
+    if (msg->hdr->msgType != AJ_MSG_ERROR) {
+        status = AJ_UnmarshalArgs(msg, "uu", &replyCode, &sessionId);
+    }
+    if (status == AJ_OK && replyCode == AJ_JOINSESSION_REPLY_SUCCESS) {
+        device->sessionId = sessionId;
+        device->state = DEVICE_JOINED;
+    } else {
+        AJ_WarnPrintf(("Joining session to %s failed: %u\n", device->busName, replyCode));
+        RemoveDevice(device);
+    }
+
+    SendNextRequest();
+
+    return status;
+}
+
+static AJ_Status GetAllReplyHandler(AJ_Message* msg)
+{
+    AJ_Status status = AJ_ERR_FAILURE;
+    CdmRemoteDevice* device = syncingDevice;
+    CdmRemoteInterface* intf = syncingIntf;
+    const char* objPath = syncingPath;
+
+    syncingDevice = NULL;
+    syncingIntf = NULL;
+
+    if (msg->hdr->msgType != AJ_MSG_ERROR) {
+        status = UpdateCachedProperties(msg, device, objPath, intf, false);
+    }
+    intf->syncState = (status == AJ_OK) ? SYNC_DONE : SYNC_FAILED;
+    if (controllerListener && controllerListener->OnInterfaceSynced) {
+        controllerListener->OnInterfaceSynced(device->busName, objPath, intf->intfType, status);
+    }
+
+    SendNextRequest();
+
+    return status;
+}
+
+static AJ_Status PropertiesChangedHandler(AJ_Message* msg)
+{
+    AJ_Status status;
+    CdmRemoteDevice* device = NULL;
+    CdmRemoteObject* obj = NULL;
+    CdmRemoteInterface* intf = NULL;
+    const CdmKnownInterface* known = NULL;
+    const char* intfName = NULL;
+
+    device = msg->sender ? FindDevice(msg->sender) : NULL;
+    if (device) {
+        obj = FindObject(device, (uint8_t)(msg->msgId >> 16));
+    }
+    if (!obj) {
+        return AJ_OK;
+    }
+
+    status = AJ_UnmarshalArgs(msg, "s", &intfName);
+    if (status != AJ_OK) {
+        return status;
+    }
+    known = CdmFindKnownInterface(intfName);
+    if (known) {
+        intf = FindInterface(obj, known->intfType);
+    }
+    if (!intf) {
+        return AJ_OK;
+    }
+
+    status = UpdateCachedProperties(msg, device, GetProxyPath(obj->proxyIndex), intf, true);
+    if (status == AJ_OK) {
+        AJ_Arg array;
+        const char* propName = NULL;
+
+        status = AJ_UnmarshalContainer(msg, &array, AJ_ARG_ARRAY);
+        while (status == AJ_OK) {
+            status = AJ_UnmarshalArgs(msg, "s", &propName);
+            if (status == AJ_OK) {
+                CdmCachedProperty* prop = FindCachedProperty(intf, propName, NULL);
+                if (prop) {
+                    ClearCachedProperty(prop);
+                }
+            }
+        }
+        if (status == AJ_ERR_NO_MORE) {
+            status = AJ_UnmarshalCloseContainer(msg, &array);
+        }
+    }
+
+    return status;
+}
+
+static void NameOwnerChanged(AJ_Message* msg)
+{
+    const char* busName = NULL;
+    const char* oldOwner = NULL;
+    const char* newOwner = NULL;
+
+    if (AJ_UnmarshalArgs(msg, "sss", &busName, &oldOwner, &newOwner) == AJ_OK && newOwner && !*newOwner) {
+        CdmIndexRemove(busName);
+    }
+}
+
+static void SessionLost(uint32_t sessionId)
+{
+    CdmRemoteDevice* device = deviceFirst;
+
+    while (device) {
+        if (device->state == DEVICE_JOINED && device->sessionId == sessionId) {
+            char* busName = device->busName;
+
+            //Keep the bus name for the listener
+            device->busName = NULL;
+            RemoveDevice(device);
+            if (controllerListener && controllerListener->OnDeviceLost) {
+                controllerListener->OnDeviceLost(busName);
+            }
+            free(busName);
+            break;
+        }
+        device = device->deviceNext;
+    }
+
+    SendNextRequest();
+}
+
+AJ_Status Cdm_ControllerInit(const CdmControllerListener* listener)
+{
+    Cdm_ControllerDeinit();
+    controllerListener = listener;
+
+    return AJ_OK;
+}
+
+void Cdm_ControllerDeinit()
+{
+    uint8_t i;
+
+    while (deviceFirst) {
+        CdmRemoteDevice* device = deviceFirst;
+
+        if (controllerBus && device->state == DEVICE_JOINED) {
+            AJ_BusLeaveSession(controllerBus, device->sessionId);
+        }
+        RemoveDevice(device);
+    }
+
+    CdmIndexClear();
+
+    if (controllerBus) {
+        AJ_RegisterObjectList(NULL, CDM_CONTROLLER_OBJECTS_LIST_INDEX);
+    }
+    for (i = 0; i < numProxyObjects; i++) {
+        free((char*)proxyObjects[i].path);
+    }
+    if (proxyObjects) {
+        free(proxyObjects);
+    }
+    proxyObjects = NULL;
+    numProxyObjects = 0;
+    controllerBus = NULL;
+    controllerListener = NULL;
+}
+
+AJ_Status Cdm_ControllerStart(AJ_BusAttachment* busAttachment)
+{
+    AJ_Status status;
+
+    if (!busAttachment) {
+        return AJ_ERR_INVALID;
+    }
+
+    controllerBus = busAttachment;
+    AJ_RegisterObjectList(proxyObjects, CDM_CONTROLLER_OBJECTS_LIST_INDEX);
+
+    status = AJ_BusSetSignalRule(busAttachment, ANNOUNCE_MATCH_RULE, AJ_BUS_SIGNAL_ALLOW);
+    if (status == AJ_OK) {
+        status = AJ_BusSetSignalRule(busAttachment, PROPERTIES_CHANGED_MATCH_RULE, AJ_BUS_SIGNAL_ALLOW);
+    }
+    if (status == AJ_OK) {
+        status = AJ_BusSetSignalRule(busAttachment, NAME_OWNER_CHANGED_MATCH_RULE, AJ_BUS_SIGNAL_ALLOW);
+    }
+
+    return status;
+}
+
+AJSVC_ServiceStatus Cdm_ControllerMessageProcessor(AJ_BusAttachment* busAttachment, AJ_Message* msg, AJ_Status* status)
+{
+    AJSVC_ServiceStatus serviceStatus = AJSVC_SERVICE_STATUS_HANDLED;
+
+    if (msg->msgId == AJ_SIGNAL_ABOUT_ANNOUNCE) {
+        *status = AnnounceHandler(busAttachment, msg);
+    } else if (msg->msgId == AJ_REPLY_ID(AJ_METHOD_JOIN_SESSION) && joiningDevice) {
+        *status = JoinSessionReplyHandler(msg);
+    } else if (msg->msgId == syncMsgId && syncingIntf && msg->replySerial == syncSerial) {
+        *status = GetAllReplyHandler(msg);
+    } else if ((msg->msgId >> 24) == CDM_CONTROLLER_OBJECTS_LIST_INDEX && (msg->msgId & 0xFFFF) == AJ_PROP_CHANGED) {
+        *status = PropertiesChangedHandler(msg);
+    } else if (msg->msgId == AJ_SIGNAL_NAME_OWNER_CHANGED) {
+        //Leave the message to the application and other services
+        NameOwnerChanged(msg);
+        AJ_ResetArgs(msg);
+        serviceStatus = AJSVC_SERVICE_STATUS_NOT_HANDLED;
+    } else if (msg->msgId == AJ_SIGNAL_SESSION_LOST || msg->msgId == AJ_SIGNAL_SESSION_LOST_WITH_REASON) {
+        uint32_t sessionId = 0;
+
+        //Leave the message to the application and other services
+        if (AJ_UnmarshalArgs(msg, "u", &sessionId) == AJ_OK) {
+            SessionLost(sessionId);
+        }
+        AJ_ResetArgs(msg);
+        serviceStatus = AJSVC_SERVICE_STATUS_NOT_HANDLED;
+    } else {
+        serviceStatus = AJSVC_SERVICE_STATUS_NOT_HANDLED;
+    }
+
+    return serviceStatus;
+}
+
+size_t Cdm_ControllerFindObjects(const CdmInterfaceTypes* intfTypes, size_t numIntfTypes, CdmObjectFoundHandler handler, void* context)
+{
+    return CdmIndexFind(intfTypes, numIntfTypes, handler, context);
+}
+
+static AJ_Status GetCachedProperty(const char* busName, const char* objPath, CdmInterfaceTypes intfType, const char* propName,
+                                   const char* signature, CdmCachedProperty** prop)
+{
+    CdmRemoteDevice* device = NULL;
+    CdmRemoteObject* obj = NULL;
+    CdmRemoteInterface* intf = NULL;
+    const char* propSig = NULL;
+    uint8_t i;
+
+    if (!busName || !objPath || !propName) {
+        return AJ_ERR_INVALID;
+    }
+
+    device = FindDevice(busName);
+    if (device) {
+        for (i = 0; i < numProxyObjects; i++) {
+            if (!strcmp(proxyObjects[i].path, objPath)) {
+                obj = FindObject(device, i);
+                break;
+            }
+        }
+    }
+    if (obj) {
+        intf = FindInterface(obj, intfType);
+    }
+    if (intf) {
+        *prop = FindCachedProperty(intf, propName, &propSig);
+    }
+    if (!intf || !*prop) {
+        return AJ_ERR_NO_MATCH;
+    }
+    if (strcmp(propSig, signature)) {
+        return AJ_ERR_SIGNATURE;
+    }
+    if (!(*prop)->valid) {
+        return AJ_ERR_NO_MATCH;
+    }
+
+    return AJ_OK;
+}
+
+AJ_Status Cdm_ControllerGetUint8(const char* busName, const char* objPath, CdmInterfaceTypes intfType, const char* propName, uint8_t* value)
+{
+    CdmCachedProperty* prop = NULL;
+    AJ_Status status = GetCachedProperty(busName, objPath, intfType, propName, "y", &prop);
+
+    if (status == AJ_OK && value) {
+        *value = prop->value.y;
+    }
+
+    return status;
+}
+
+AJ_Status Cdm_ControllerGetBool(const char* busName, const char* objPath, CdmInterfaceTypes intfType, const char* propName, bool* value)
+{
+    CdmCachedProperty* prop = NULL;
+    AJ_Status status = GetCachedProperty(busName, objPath, intfType, propName, "b", &prop);
+
+    if (status == AJ_OK && value) {
+        *value = prop->value.b ? true : false;
+    }
+
+    return status;
+}
+
+AJ_Status Cdm_ControllerGetUint16(const char* busName, const char* objPath, CdmInterfaceTypes intfType, const char* propName, uint16_t* value)
+{
+    CdmCachedProperty* prop = NULL;
+    AJ_Status status = GetCachedProperty(busName, objPath, intfType, propName, "q", &prop);
+
+    if (status == AJ_OK && value) {
+        *value = prop->value.q;
+    }
+
+    return status;
+}
+
+AJ_Status Cdm_ControllerGetInt32(const char* busName, const char* objPath, CdmInterfaceTypes intfType, const char* propName, int32_t* value)
+{
+    CdmCachedProperty* prop = NULL;
+    AJ_Status status = GetCachedProperty(busName, objPath, intfType, propName, "i", &prop);
+
+    if (status == AJ_OK && value) {
+        *value = prop->value.i;
+    }
+
+    return status;
+}
+
+AJ_Status Cdm_ControllerGetUint32(const char* busName, const char* objPath, CdmInterfaceTypes intfType, const char* propName, uint32_t* value)
+{
+    CdmCachedProperty* prop = NULL;
+    AJ_Status status = GetCachedProperty(busName, objPath, intfType, propName, "u", &prop);
+
+    if (status == AJ_OK && value) {
+        *value = prop->value.u;
+    }
+
+    return status;
+}
+
+AJ_Status Cdm_ControllerGetDouble(const char* busName, const char* objPath, CdmInterfaceTypes intfType, const char* propName, double* value)
+{
+    CdmCachedProperty* prop = NULL;
+    AJ_Status status = GetCachedProperty(busName, objPath, intfType, propName, "d", &prop);
+
+    if (status == AJ_OK && value) {
+        *value = prop->value.d;
+    }
+
+    return status;
+}
+
+AJ_Status Cdm_ControllerGetString(const char* busName, const char* objPath, CdmInterfaceTypes intfType, const char* propName, const char** value)
+{
+    CdmCachedProperty* prop = NULL;
+    AJ_Status status = GetCachedProperty(busName, objPath, intfType, propName, "s", &prop);
+
+    if (status == AJ_OK && value) {
+        *value = (const char*)prop->data;
+    }
+
+    return status;
+}
+
+AJ_Status Cdm_ControllerGetUint8Array(const char* busName, const char* objPath, CdmInterfaceTypes intfType, const char* propName, const uint8_t** value, size_t* count)
+{
+    CdmCachedProperty* prop = NULL;
+    AJ_Status status = GetCachedProperty(busName, objPath, intfType, propName, "ay", &prop);
+
+    if (status == AJ_OK && value && count) {
+        *value = (const uint8_t*)prop->data;
+        *count = prop->size;
+    }
+
+    return status;
+}
+
+AJ_Status Cdm_ControllerGetUint16Array(const char* busName, const char* objPath, CdmInterfaceTypes intfType, const char* propName, const uint16_t** value, size_t* count)
+{
+    CdmCachedProperty* prop = NULL;
+    AJ_Status status = GetCachedProperty(busName, objPath, intfType, propName, "aq", &prop);
+
+    if (status == AJ_OK && value && count) {
+        *value = (const uint16_t*)prop->data;
+        *count = prop->size / sizeof(uint16_t);
+    }
+
+    return status;
+}
@@ -0,0 +1,97 @@
+/******************************************************************************
+ * Copyright AllSeen Alliance. All rights reserved.
+ *
+ *    Permission to use, copy, modify, and/or distribute this software for any
+ *    purpose with or without fee is hereby granted, provided that the above
+ *    copyright notice and this permission notice appear in all copies.
+ *
+ *    THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ *    WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ *    ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ *    WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ *    ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ *    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ ******************************************************************************/
+
+#include <stdlib.h>
+#include <string.h>
+#include "CdmArrayBufferImpl.h"
+
+static void* scratch = NULL;
+static size_t scratchCapacity = 0;
+
+AJ_Status CdmArrayBufferReserve(void** data, size_t* capacity, size_t elemSize, size_t count)
+{
+    size_t newCapacity = *capacity ? *capacity : 1;
+    void* newData = NULL;
+
+    if (*data && count <= *capacity) {
+        return AJ_OK;
+    }
+
+    while (newCapacity < count) {
+        newCapacity *= 2;
+    }
+    if (newCapacity > (size_t)-1 / elemSize) {
+        return AJ_ERR_RESOURCES;
+    }
+
+    newData = realloc(*data, elemSize * newCapacity);
+    if (!newData) {
+        return AJ_ERR_RESOURCES;
+    }
+    *data = newData;
+    *capacity = newCapacity;
+
+    return AJ_OK;
+}
+
+AJ_Status CdmArrayBufferAssign(void** data, size_t* size, size_t* capacity, size_t elemSize, const void* values, size_t count, bool* changed)
+{
+    AJ_Status status = AJ_OK;
+
+    if (changed) {
+        *changed = false;
+    }
+
+    if (*data && *size == count && (!count || !memcmp(*data, values, elemSize * count))) {
+        return AJ_OK;
+    }
+
+    status = CdmArrayBufferReserve(data, capacity, elemSize, count);
+    if (status != AJ_OK) {
+        return status;
+    }
+
+    if (count) {
+        memcpy(*data, values, elemSize * count);
+    }
+    *size = count;
+    if (changed) {
+        *changed = true;
+    }
+
+    return AJ_OK;
+}
+
+void* CdmArrayBufferScratch(size_t elemSize, size_t count)
+{
+    size_t capacity = scratchCapacity / elemSize;
+
+    if (CdmArrayBufferReserve(&scratch, &capacity, elemSize, count) != AJ_OK) {
+        return NULL;
+    }
+    scratchCapacity = capacity * elemSize;
+
+    return scratch;
+}
+
+void CdmArrayBufferFreeScratch(void)
+{
+    if (scratch) {
+        free(scratch);
+    }
+    scratch = NULL;
+    scratchCapacity = 0;
+}
@@ -0,0 +1,63 @@
+/******************************************************************************
+ * Copyright AllSeen Alliance. All rights reserved.
+ *
+ *    Permission to use, copy, modify, and/or distribute this software for any
+ *    purpose with or without fee is hereby granted, provided that the above
+ *    copyright notice and this permission notice appear in all copies.
+ *
+ *    THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ *    WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ *    ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ *    WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ *    ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ *    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ ******************************************************************************/
+
+
+#ifndef CDMARRAYBUFFERIMPL_H_
+#define CDMARRAYBUFFERIMPL_H_
+
+#include <ajtcl/alljoyn.h>
+#include <ajtcl/cdm/CdmControllee.h>
+
+/**
+ * Make room for count elements in the buffer of an array property. The buffer only grows, so that storing
+ * a list of the same or a smaller size again does not allocate. A buffer is allocated even for an empty list.
+ * @param[in,out] data buffer, NULL if not allocated yet
+ * @param[in,out] capacity number of elements the buffer can hold
+ * @param[in] elemSize element size
+ * @param[in] count number of elements to hold
+ * @return AJ_OK on success
+ */
+AJ_Status CdmArrayBufferReserve(void** data, size_t* capacity, size_t elemSize, size_t count);
+
+/**
+ * Store a list in the buffer of an array property, growing the buffer if needed.
+ * The list is compared with the stored one first, and is not copied if it is the same.
+ * @param[in,out] data buffer, NULL if not allocated yet
+ * @param[in,out] size number of elements stored
+ * @param[in,out] capacity number of elements the buffer can hold
+ * @param[in] elemSize element size, of a type without padding
+ * @param[in] values list to store, can be NULL if count is 0
+ * @param[in] count number of elements of the list
+ * @param[out] changed true if the stored list is changed, can be NULL
+ * @return AJ_OK on success
+ */
+AJ_Status CdmArrayBufferAssign(void** data, size_t* size, size_t* capacity, size_t elemSize, const void* values, size_t count, bool* changed);
+
+/**
+ * Get the scratch buffer shared by the OnGet paths, which the listener fills before the result is compared
+ * with the stored list. It only grows and is valid until the next call.
+ * @param[in] elemSize element size
+ * @param[in] count number of elements
+ * @return scratch buffer, NULL if it cannot be allocated
+ */
+void* CdmArrayBufferScratch(size_t elemSize, size_t count);
+
+/**
+ * Release the scratch buffer
+ */
+void CdmArrayBufferFreeScratch(void);
+
+#endif /* CDMARRAYBUFFERIMPL_H_ */
@@ -0,0 +1,119 @@
+/******************************************************************************
+ * Copyright AllSeen Alliance. All rights reserved.
+ *
+ *    Permission to use, copy, modify, and/or distribute this software for any
+ *    purpose with or without fee is hereby granted, provided that the above
+ *    copyright notice and this permission notice appear in all copies.
+ *
+ *    THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ *    WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ *    ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ *    WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ *    ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ *    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ ******************************************************************************/
+
+
+
+#include <math.h>
+#include "CdmConstraintImpl.h"
+
+#define STEP_TOLERANCE 1e-6
+#define MAX_SELECTABLE_VALUE 255
+
+void CdmConstraintInit(CdmConstraint* constraint, double minValue, double maxValue, double stepValue)
+{
+    constraint->minValue = minValue;
+    constraint->maxValue = maxValue;
+    constraint->stepValue = stepValue;
+    constraint->selectable = NULL;
+}
+
+static bool IsOnStep(const CdmConstraint* constraint, double value)
+{
+    double steps = 0;
+
+    if (constraint->stepValue <= 0.0) {
+        return true;
+    }
+
+    steps = floor((value - constraint->minValue) / constraint->stepValue + 0.5);
+
+    return (fabs(value - (constraint->minValue + steps * constraint->stepValue)) <= constraint->stepValue * STEP_TOLERANCE) ? true : false;
+}
+
+static bool IsSelectable(const CdmConstraint* constraint, double value)
+{
+    if (!constraint->selectable) {
+        return true;
+    }
+
+    if (value < 0 || value > MAX_SELECTABLE_VALUE || value != floor(value)) {
+        return false;
+    }
+
+    return CdmValueSetContains(constraint->selectable, (uint8_t)value);
+}
+
+AJ_Status CdmConstraintCheck(const CdmConstraint* constraint, double value)
+{
+    if (value < constraint->minValue || value > constraint->maxValue) {
+        return AJ_ERR_RANGE;
+    }
+
+    if (!IsOnStep(constraint, value) || !IsSelectable(constraint, value)) {
+        return AJ_ERR_INVALID;
+    }
+
+    return AJ_OK;
+}
+
+AJ_Status CdmConstraintApply(const CdmConstraint* constraint, CdmConstraintPolicy policy, double* value)
+{
+    double snapped = *value;
+    int distance = 0;
+
+    if (policy != CDM_CONSTRAINT_POLICY_SNAP) {
+        return CdmConstraintCheck(constraint, *value);
+    }
+
+    if (constraint->minValue > constraint->maxValue) {
+        return AJ_ERR_INVALID;
+    }
+
+    if (snapped < constraint->minValue) {
+        snapped = constraint->minValue;
+    } else if (snapped > constraint->maxValue) {
+        snapped = constraint->maxValue;
+    }
+
+    if (constraint->selectable) {
+        double origin = floor(snapped + 0.5);
+
+        for (distance = 0; distance <= MAX_SELECTABLE_VALUE; distance++) {
+            if (CdmConstraintCheck(constraint, origin - distance) == AJ_OK) {
+                snapped = origin - distance;
+                break;
+            }
+            if (distance > 0 && CdmConstraintCheck(constraint, origin + distance) == AJ_OK) {
+                snapped = origin + distance;
+                break;
+            }
+        }
+        if (distance > MAX_SELECTABLE_VALUE) {
+            return AJ_ERR_INVALID;
+        }
+    } else if (constraint->stepValue > 0.0) {
+        double steps = floor((snapped - constraint->minValue) / constraint->stepValue + 0.5);
+
+        snapped = constraint->minValue + steps * constraint->stepValue;
+        if (snapped > constraint->maxValue) {
+            snapped -= constraint->stepValue;
+        }
+    }
+
+    *value = snapped;
+
+    return AJ_OK;
+}
@@ -0,0 +1,65 @@
+/******************************************************************************
+ * Copyright AllSeen Alliance. All rights reserved.
+ *
+ *    Permission to use, copy, modify, and/or distribute this software for any
+ *    purpose with or without fee is hereby granted, provided that the above
+ *    copyright notice and this permission notice appear in all copies.
+ *
+ *    THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ *    WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ *    ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ *    WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ *    ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ *    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ ******************************************************************************/
+
+
+
+#ifndef CDMCONSTRAINTIMPL_H_
+#define CDMCONSTRAINTIMPL_H_
+
+#include <ajtcl/alljoyn.h>
+#include <ajtcl/cdm/CdmControllee.h>
+#include "CdmValueSetImpl.h"
+
+/**
+ * Constraint of a writable property value. Interfaces fill it from their already resolved
+ * properties, so a value is validated without looking the object up again.
+ * A value is allowed if it is within [minValue, maxValue], on the step grid starting at minValue
+ * when stepValue is not 0, and in the selectable set when selectable is not NULL.
+ */
+typedef struct {
+    double minValue;
+    double maxValue;
+    double stepValue;
+    const CdmValueSet* selectable;
+} CdmConstraint;
+
+/**
+ * Initialize constraint with a range
+ * @param[in] constraint constraint
+ * @param[in] minValue minimum value
+ * @param[in] maxValue maximum value
+ * @param[in] stepValue step value, 0 if any value in the range is allowed
+ */
+void CdmConstraintInit(CdmConstraint* constraint, double minValue, double maxValue, double stepValue);
+
+/**
+ * Validate a value against constraint
+ * @param[in] constraint constraint
+ * @param[in] value value
+ * @return AJ_OK if the value is allowed, AJ_ERR_RANGE if out of range, AJ_ERR_INVALID if not on the step grid or not selectable
+ */
+AJ_Status CdmConstraintCheck(const CdmConstraint* constraint, double value);
+
+/**
+ * Apply constraint to a value according to policy
+ * @param[in] constraint constraint
+ * @param[in] policy CDM_CONSTRAINT_POLICY_REJECT to validate only, CDM_CONSTRAINT_POLICY_SNAP to adjust to the nearest allowed value
+ * @param[in,out] value value
+ * @return AJ_OK on success, otherwise the status of CdmConstraintCheck or AJ_ERR_INVALID if no value is allowed
+ */
+AJ_Status CdmConstraintApply(const CdmConstraint* constraint, CdmConstraintPolicy policy, double* value);
+
+#endif /* CDMCONSTRAINTIMPL_H_ */
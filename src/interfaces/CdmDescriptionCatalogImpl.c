@@ -0,0 +1,283 @@
+/******************************************************************************
+ * Copyright AllSeen Alliance. All rights reserved.
+ *
+ *    Permission to use, copy, modify, and/or distribute this software for any
+ *    purpose with or without fee is hereby granted, provided that the above
+ *    copyright notice and this permission notice appear in all copies.
+ *
+ *    THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ *    WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ *    ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ *    WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ *    ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ *    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ ******************************************************************************/
+
+
+#include <stdlib.h>
+#include <string.h>
+#include <ajtcl/cdm/interfaces/CdmInterfaceErrors.h>
+#include "CdmDescriptionCatalogImpl.h"
+
+static bool IsSameLanguage(const char* languageTag1, const char* languageTag2)
+{
+    //language tags are case insensitive
+    while (*languageTag1 && *languageTag2) {
+        char c1 = *languageTag1++;
+        char c2 = *languageTag2++;
+        if (c1 >= 'A' && c1 <= 'Z') {
+            c1 += 'a' - 'A';
+        }
+        if (c2 >= 'A' && c2 <= 'Z') {
+            c2 += 'a' - 'A';
+        }
+        if (c1 != c2) {
+            return false;
+        }
+    }
+
+    return (*languageTag1 == *languageTag2) ? true : false;
+}
+
+static uint32_t WritePadding(uint8_t* body, uint32_t offset, uint32_t alignment)
+{
+    uint32_t aligned = (offset + alignment - 1) & ~(alignment - 1);
+
+    if (body) {
+        memset(body + offset, 0, aligned - offset);
+    }
+
+    return aligned;
+}
+
+static uint32_t WriteString(uint8_t* body, uint32_t offset, const char* str)
+{
+    uint32_t len = str ? (uint32_t)strlen(str) : 0;
+
+    offset = WritePadding(body, offset, 4);
+    if (body) {
+        memcpy(body + offset, &len, sizeof(uint32_t));
+        if (len) {
+            memcpy(body + offset + sizeof(uint32_t), str, len);
+        }
+        body[offset + sizeof(uint32_t) + len] = '\0';
+    }
+
+    return offset + sizeof(uint32_t) + len + 1;
+}
+
+//The first record of a (languageTag, code) pair wins
+static bool IsFirstRecordOfCode(const CdmDescriptionCatalog* catalog, uint16_t index, const char* languageTag)
+{
+    uint16_t i = 0;
+
+    for (i = 0; i < index; i++) {
+        if (catalog->records[i].code == catalog->records[index].code && IsSameLanguage(catalog->records[i].languageTag, languageTag)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+//Writes a(qs) or a(yss) in native byte order the way AJ_MarshalArgs would. Returns the body size, body can be NULL to measure.
+static uint32_t WriteBody(const CdmDescriptionCatalog* catalog, const char* languageTag, bool withName, uint8_t* body)
+{
+    uint32_t offset = sizeof(uint32_t);
+    uint32_t start = 0;
+    uint32_t arrayLen = 0;
+    uint16_t i = 0;
+
+    offset = WritePadding(body, offset, 8);
+    start = offset;
+    for (i = 0; i < catalog->numRecords; i++) {
+        const CdmDescriptionRecord* record = &catalog->records[i];
+
+        if (!IsSameLanguage(record->languageTag, languageTag) || !IsFirstRecordOfCode(catalog, i, languageTag)) {
+            continue;
+        }
+
+        offset = WritePadding(body, offset, 8);
+        if (withName) {
+            if (body) {
+                body[offset] = (uint8_t)record->code;
+            }
+            offset += sizeof(uint8_t);
+            offset = WriteString(body, offset, record->name);
+        } else {
+            if (body) {
+                memcpy(body + offset, &record->code, sizeof(uint16_t));
+            }
+            offset += sizeof(uint16_t);
+        }
+        offset = WriteString(body, offset, record->description);
+    }
+
+    if (body) {
+        arrayLen = offset - start;
+        memcpy(body, &arrayLen, sizeof(uint32_t));
+    }
+
+    return offset;
+}
+
+//Marshals the same body by AJ_MarshalArgs, for encrypted replies which cannot be delivered in parts
+static AJ_Status MarshalBody(const CdmDescriptionCatalog* catalog, const char* languageTag, AJ_Message* reply)
+{
+    AJ_Status status = AJ_OK;
+    AJ_Arg array;
+    AJ_Arg strc;
+    uint16_t i = 0;
+
+    status = AJ_MarshalContainer(reply, &array, AJ_ARG_ARRAY);
+    for (i = 0; status == AJ_OK && i < catalog->numRecords; i++) {
+        const CdmDescriptionRecord* record = &catalog->records[i];
+
+        if (!IsSameLanguage(record->languageTag, languageTag) || !IsFirstRecordOfCode(catalog, i, languageTag)) {
+            continue;
+        }
+
+        status = AJ_MarshalContainer(reply, &strc, AJ_ARG_STRUCT);
+        if (status == AJ_OK) {
+            if (catalog->withName) {
+                status = AJ_MarshalArgs(reply, "yss", (uint8_t)record->code, record->name ? record->name : "", record->description);
+            } else {
+                status = AJ_MarshalArgs(reply, "qs", record->code, record->description);
+            }
+        }
+        if (status == AJ_OK) {
+            status = AJ_MarshalCloseContainer(reply, &strc);
+        }
+    }
+    if (status == AJ_OK) {
+        status = AJ_MarshalCloseContainer(reply, &array);
+    }
+
+    return status;
+}
+
+static const CdmDescriptionCatalogBody* FindBody(const CdmDescriptionCatalog* catalog, const char* languageTag)
+{
+    uint16_t i = 0;
+
+    for (i = 0; i < catalog->numBodies; i++) {
+        if (IsSameLanguage(catalog->bodies[i].languageTag, languageTag)) {
+            return &catalog->bodies[i];
+        }
+    }
+
+    return NULL;
+}
+
+AJ_Status CdmDescriptionCatalogSet(CdmDescriptionCatalog* catalog, const CdmDescriptionRecord* records, const uint16_t numRecords, const bool withName)
+{
+    uint16_t i = 0;
+
+    if (!catalog) {
+        return AJ_ERR_INVALID;
+    }
+
+    if (!records && numRecords) {
+        return AJ_ERR_INVALID;
+    }
+
+    for (i = 0; i < numRecords; i++) {
+        if (!records[i].languageTag || !records[i].description) {
+            return AJ_ERR_INVALID;
+        }
+        if (withName && records[i].code > 0xFF) {
+            return AJ_ERR_RANGE;
+        }
+    }
+
+    CdmDescriptionCatalogClear(catalog);
+    if (numRecords == 0) {
+        return AJ_OK;
+    }
+
+    catalog->bodies = (CdmDescriptionCatalogBody*)malloc(sizeof(CdmDescriptionCatalogBody) * numRecords);
+    if (!catalog->bodies) {
+        return AJ_ERR_RESOURCES;
+    }
+    catalog->records = records;
+    catalog->numRecords = numRecords;
+    catalog->withName = withName;
+
+    for (i = 0; i < numRecords; i++) {
+        CdmDescriptionCatalogBody* body = NULL;
+
+        if (FindBody(catalog, records[i].languageTag)) {
+            continue;
+        }
+
+        body = &catalog->bodies[catalog->numBodies];
+        body->languageTag = records[i].languageTag;
+        body->bodySize = WriteBody(catalog, body->languageTag, withName, NULL);
+        body->body = (uint8_t*)malloc(body->bodySize);
+        if (!body->body) {
+            CdmDescriptionCatalogClear(catalog);
+            return AJ_ERR_RESOURCES;
+        }
+        WriteBody(catalog, body->languageTag, withName, body->body);
+        catalog->numBodies++;
+    }
+
+    return AJ_OK;
+}
+
+void CdmDescriptionCatalogClear(CdmDescriptionCatalog* catalog)
+{
+    uint16_t i = 0;
+
+    if (!catalog) {
+        return;
+    }
+
+    if (catalog->bodies) {
+        for (i = 0; i < catalog->numBodies; i++) {
+            free(catalog->bodies[i].body);
+        }
+        free(catalog->bodies);
+    }
+    memset(catalog, 0, sizeof(CdmDescriptionCatalog));
+}
+
+bool CdmDescriptionCatalogIsSet(const CdmDescriptionCatalog* catalog)
+{
+    return (catalog && catalog->numBodies > 0) ? true : false;
+}
+
+AJ_Status CdmDescriptionCatalogReply(const CdmDescriptionCatalog* catalog, AJ_Message* msg, const char* languageTag)
+{
+    AJ_Status status = AJ_OK;
+    const CdmDescriptionCatalogBody* body = NULL;
+    AJ_Message reply;
+
+    if (!catalog || !languageTag) {
+        return AJ_ERR_INVALID;
+    }
+
+    body = FindBody(catalog, languageTag);
+
+    if (!body) {
+        AJ_MarshalErrorMsgWithInfo(msg, &reply, GetInterfaceErrorName(LANGUAGE_NOT_SUPPORTED), GetInterfaceErrorMessage(LANGUAGE_NOT_SUPPORTED));
+        return AJ_DeliverMsg(&reply);
+    }
+
+    status = AJ_MarshalReplyMsg(msg, &reply);
+    if (status == AJ_OK && (reply.hdr->flags & AJ_FLAG_ENCRYPTED)) {
+        //AJ_DeliverMsgPartial refuses encrypted messages
+        status = MarshalBody(catalog, languageTag, &reply);
+    } else if (status == AJ_OK) {
+        status = AJ_DeliverMsgPartial(&reply, body->bodySize);
+        if (status == AJ_OK) {
+            status = AJ_MarshalRaw(&reply, body->body, body->bodySize);
+        }
+    }
+    if (status == AJ_OK) {
+        status = AJ_DeliverMsg(&reply);
+    }
+
+    return status;
+}
@@ -0,0 +1,77 @@
+/******************************************************************************
+ * Copyright AllSeen Alliance. All rights reserved.
+ *
+ *    Permission to use, copy, modify, and/or distribute this software for any
+ *    purpose with or without fee is hereby granted, provided that the above
+ *    copyright notice and this permission notice appear in all copies.
+ *
+ *    THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ *    WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ *    ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ *    WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ *    ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ *    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ ******************************************************************************/
+
+
+#ifndef CDMDESCRIPTIONCATALOGIMPL_H_
+#define CDMDESCRIPTIONCATALOGIMPL_H_
+
+#include <ajtcl/alljoyn.h>
+#include <ajtcl/cdm/CdmControllee.h>
+#include <ajtcl/cdm/interfaces/CdmDescriptionCatalog.h>
+
+/**
+ * Pre-marshalled reply body of one language
+ */
+typedef struct {
+    const char* languageTag;
+    uint8_t* body;
+    uint32_t bodySize;
+} CdmDescriptionCatalogBody;
+
+/**
+ * Description catalog
+ */
+typedef struct {
+    const CdmDescriptionRecord* records;
+    uint16_t numRecords;
+    bool withName;
+    CdmDescriptionCatalogBody* bodies;
+    uint16_t numBodies;
+} CdmDescriptionCatalog;
+
+/**
+ * Register records to catalog and build the reply bodies of all languages
+ * @param[in] catalog catalog
+ * @param[in] records records
+ * @param[in] numRecords the number of records
+ * @param[in] withName true if the reply signature is a(yss), false if a(qs)
+ * @return AJ_OK on success
+ */
+AJ_Status CdmDescriptionCatalogSet(CdmDescriptionCatalog* catalog, const CdmDescriptionRecord* records, const uint16_t numRecords, const bool withName);
+
+/**
+ * Release catalog
+ * @param[in] catalog catalog
+ */
+void CdmDescriptionCatalogClear(CdmDescriptionCatalog* catalog);
+
+/**
+ * Check whether catalog has records
+ * @param[in] catalog catalog
+ * @return true if records are registered
+ */
+bool CdmDescriptionCatalogIsSet(const CdmDescriptionCatalog* catalog);
+
+/**
+ * Reply to method call with the reply body of language. Encrypted replies are marshalled from the records.
+ * @param[in] catalog catalog
+ * @param[in] msg method call message
+ * @param[in] languageTag language tag
+ * @return AJ_OK on success
+ */
+AJ_Status CdmDescriptionCatalogReply(const CdmDescriptionCatalog* catalog, AJ_Message* msg, const char* languageTag);
+
+#endif /* CDMDESCRIPTIONCATALOGIMPL_H_ */
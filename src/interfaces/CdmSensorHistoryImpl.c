@@ -0,0 +1,404 @@
+/******************************************************************************
+ * Copyright AllSeen Alliance. All rights reserved.
+ *
+ *    Permission to use, copy, modify, and/or distribute this software for any
+ *    purpose with or without fee is hereby granted, provided that the above
+ *    copyright notice and this permission notice appear in all copies.
+ *
+ *    THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ *    WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ *    ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ *    WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ *    ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ *    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ ******************************************************************************/
+
+
+#include <stdlib.h>
+#include <string.h>
+#include <ajtcl/cdm/interfaces/CdmInterfaceErrors.h>
+#include "../CdmControllee/CdmControlleeImpl.h"
+#include "CdmSensorHistoryImpl.h"
+
+#define INTERFACE_VERSION 1
+
+#define MAX_SENSOR_HISTORY_SENSORS 6
+#define NUMBER_OF_SENSOR_HISTORY_RESOLUTIONS (MAX_SENSOR_HISTORY_RESOLUTION + 1)
+#define MINUTE_MILLISECONDS 60000
+#define HOUR_MILLISECONDS 3600000
+
+const char* const intfDescSensorHistory[] = {
+    CDM_SENSOR_HISTORY_INTERFACE_NAME,
+    "@Version>q",
+    "?GetHistory interfaceName<s resolution<y now>u timestamps>au values>ad",
+    NULL
+};
+
+static const struct {
+    CdmInterfaceTypes intfType;
+    const char* intfName;
+} sensorInterfaces[MAX_SENSOR_HISTORY_SENSORS] = {
+    { CURRENT_TEMPERATURE_INTERFACE, "org.alljoyn.SmartSpaces.Environment.CurrentTemperature" },
+    { CURRENT_HUMIDITY_INTERFACE, "org.alljoyn.SmartSpaces.Environment.CurrentHumidity" },
+    { CURRENT_AIR_QUALITY_INTERFACE, "org.alljoyn.SmartSpaces.Environment.CurrentAirQuality" },
+    { CURRENT_AIR_QUALITY_LEVEL_INTERFACE, "org.alljoyn.SmartSpaces.Environment.CurrentAirQualityLevel" },
+    { CURRENT_POWER_INTERFACE, "org.alljoyn.SmartSpaces.Operation.CurrentPower" },
+    { WATER_LEVEL_INTERFACE, "org.alljoyn.SmartSpaces.Environment.WaterLevel" },
+};
+
+typedef struct {
+    uint32_t* timestamps; //2 * capacity entries, every sample is stored twice so that the window is always contiguous
+    double* values;
+    uint16_t capacity;
+    uint16_t head;
+    uint16_t count;
+} HistoryRing;
+
+typedef struct {
+    uint32_t bucket;
+    double sum;
+    uint32_t count;
+} HistoryAccumulator;
+
+typedef struct {
+    CdmInterfaceTypes intfType;
+    HistoryRing rings[NUMBER_OF_SENSOR_HISTORY_RESOLUTIONS];
+    HistoryAccumulator minute;
+    HistoryAccumulator hour;
+} SensorHistory;
+
+typedef struct {
+    uint16_t version;
+    SensorHistory sensors[MAX_SENSOR_HISTORY_SENSORS];
+} SensorHistoryProperties;
+
+static CdmInterfaceTypes sensorHistoryInterfaceType = UNDEFINED_INTERFACE;
+static AJ_Time sensorHistoryEpoch;
+
+static AJ_Status InitRing(HistoryRing* ring, uint16_t capacity)
+{
+    memset(ring, 0, sizeof(HistoryRing));
+    if (capacity == 0) {
+        return AJ_OK;
+    }
+
+    ring->timestamps = (uint32_t*)malloc(sizeof(uint32_t) * 2 * capacity);
+    ring->values = (double*)malloc(sizeof(double) * 2 * capacity);
+    if (!ring->timestamps || !ring->values) {
+        free(ring->timestamps);
+        free(ring->values);
+        memset(ring, 0, sizeof(HistoryRing));
+        return AJ_ERR_RESOURCES;
+    }
+    ring->capacity = capacity;
+
+    return AJ_OK;
+}
+
+static void FreeRing(HistoryRing* ring)
+{
+    if (ring->timestamps) {
+        free(ring->timestamps);
+    }
+    if (ring->values) {
+        free(ring->values);
+    }
+    memset(ring, 0, sizeof(HistoryRing));
+}
+
+static void PushRing(HistoryRing* ring, uint32_t timestamp, double value)
+{
+    uint16_t pos = 0;
+
+    if (ring->capacity == 0) {
+        return;
+    }
+
+    if (ring->count < ring->capacity) {
+        pos = (ring->head + ring->count) % ring->capacity;
+        ring->count++;
+    } else {
+        pos = ring->head;
+        ring->head = (ring->head + 1) % ring->capacity;
+    }
+    ring->timestamps[pos] = timestamp;
+    ring->timestamps[pos + ring->capacity] = timestamp;
+    ring->values[pos] = value;
+    ring->values[pos + ring->capacity] = value;
+}
+
+static void Accumulate(HistoryAccumulator* acc, HistoryRing* ring, uint32_t period, uint32_t timestamp, double value)
+{
+    uint32_t bucket = timestamp / period;
+
+    //a bucket is averaged into the ring once a sample of a later bucket arrives
+    if (acc->count && acc->bucket != bucket) {
+        PushRing(ring, acc->bucket * period, acc->sum / acc->count);
+        acc->sum = 0.0;
+        acc->count = 0;
+    }
+    acc->bucket = bucket;
+    acc->sum += value;
+    acc->count++;
+}
+
+static SensorHistory* FindSensorHistory(SensorHistoryProperties* props, CdmInterfaceTypes intfType)
+{
+    int i = 0;
+
+    for (i = 0; i < MAX_SENSOR_HISTORY_SENSORS; i++) {
+        if (props->sensors[i].intfType == intfType) {
+            return &props->sensors[i];
+        }
+    }
+
+    return NULL;
+}
+
+static bool IsSensorInterface(CdmInterfaceTypes intfType)
+{
+    int i = 0;
+
+    for (i = 0; i < MAX_SENSOR_HISTORY_SENSORS; i++) {
+        if (sensorInterfaces[i].intfType == intfType) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+static CdmInterfaceTypes GetSensorInterfaceType(const char* intfName)
+{
+    int i = 0;
+
+    for (i = 0; i < MAX_SENSOR_HISTORY_SENSORS; i++) {
+        if (!strcmp(sensorInterfaces[i].intfName, intfName)) {
+            return sensorInterfaces[i].intfType;
+        }
+    }
+
+    return UNDEFINED_INTERFACE;
+}
+
+static void FreeSensorHistory(SensorHistory* history)
+{
+    int i = 0;
+
+    for (i = 0; i < NUMBER_OF_SENSOR_HISTORY_RESOLUTIONS; i++) {
+        FreeRing(&history->rings[i]);
+    }
+    memset(history, 0, sizeof(SensorHistory));
+}
+
+static void SensorHistoryInterfaceRegistered(CdmInterfaceTypes intfType)
+{
+    sensorHistoryInterfaceType = intfType;
+    AJ_InitTimer(&sensorHistoryEpoch);
+}
+
+static AJ_Status CreateSensorHistoryInterface(void** properties)
+{
+    *properties = malloc(sizeof(SensorHistoryProperties));
+    if (!(*properties)) {
+        return AJ_ERR_RESOURCES;
+    }
+    memset(*properties, 0, sizeof(SensorHistoryProperties));
+
+    ((SensorHistoryProperties*)*properties)->version = (uint16_t)INTERFACE_VERSION;
+
+    return AJ_OK;
+}
+
+static void DestroySensorHistoryInterface(void* properties)
+{
+    if (properties) {
+        SensorHistoryProperties* props = (SensorHistoryProperties*)properties;
+        int i = 0;
+
+        for (i = 0; i < MAX_SENSOR_HISTORY_SENSORS; i++) {
+            FreeSensorHistory(&props->sensors[i]);
+        }
+        free(props);
+    }
+}
+
+static AJ_Status SensorHistoryInterfaceOnGetProperty(AJ_Message* replyMsg, const char* objPath, void* properties, uint8_t memberIndex, void* listener)
+{
+    AJ_Status status = AJ_OK;
+    SensorHistoryProperties* props = NULL;
+
+    if (!properties) {
+        return AJ_ERR_INVALID;
+    }
+
+    props = (SensorHistoryProperties*)properties;
+
+    switch (memberIndex) {
+    case 0 :
+        status = AJ_MarshalArgs(replyMsg, "q", props->version);
+        break;
+    default:
+        status = AJ_ERR_INVALID;
+    }
+
+    return status;
+}
+
+static AJ_Status SensorHistoryInterfaceOnMethodHandler(AJ_Message* msg, const char* objPath, uint8_t memberIndex, void* listener, CdmPropertiesChangedByMethod* propChangedByMethod)
+{
+    AJ_Status status = AJ_OK;
+    SensorHistoryProperties* props = NULL;
+
+    if (!propChangedByMethod) {
+        return AJ_ERR_INVALID;
+    }
+
+    props = (SensorHistoryProperties*)propChangedByMethod->properties;
+    if (!props) {
+        return AJ_ERR_INVALID;
+    }
+
+    switch (memberIndex) {
+    case 1 :
+        {
+            char* intfName;
+            uint8_t resolution;
+
+            status = AJ_UnmarshalArgs(msg, "sy", &intfName, &resolution);
+            if (status == AJ_OK) {
+                AJ_Message reply;
+                CdmInterfaceTypes intfType = GetSensorInterfaceType(intfName);
+                SensorHistory* history = (intfType != UNDEFINED_INTERFACE) ? FindSensorHistory(props, intfType) : NULL;
+
+                AJ_MarshalReplyMsg(msg, &reply);
+                if (!history || resolution > MAX_SENSOR_HISTORY_RESOLUTION) {
+                    AJ_MarshalErrorMsgWithInfo(msg, &reply, GetInterfaceErrorName(INVALID_VALUE), GetInterfaceErrorMessage(INVALID_VALUE));
+                } else {
+                    HistoryRing* ring = &history->rings[resolution];
+
+                    AJ_MarshalArgs(&reply, "u", AJ_GetElapsedTime(&sensorHistoryEpoch, TRUE));
+                    AJ_MarshalArgs(&reply, "au", ring->timestamps + ring->head, sizeof(uint32_t) * ring->count);
+                    AJ_MarshalArgs(&reply, "ad", ring->values + ring->head, sizeof(double) * ring->count);
+                }
+                status = AJ_DeliverMsg(&reply);
+            }
+        }
+        break;
+    default:
+        status = AJ_ERR_INVALID;
+    }
+
+    return status;
+}
+
+static VendorDefinedInterfaceHandler sensorHistoryInterfaceHandler = {
+    SensorHistoryInterfaceRegistered,
+    CreateSensorHistoryInterface,
+    DestroySensorHistoryInterface,
+    SensorHistoryInterfaceOnGetProperty,
+    NULL,
+    NULL,
+    SensorHistoryInterfaceOnMethodHandler
+};
+
+AJ_Status Cdm_SensorHistoryRegisterInterface(CdmInterfaceTypes* intfType)
+{
+    return Cdm_RegisterVendorDefinedInterface(CDM_SENSOR_HISTORY_INTERFACE_NAME, intfDescSensorHistory, &sensorHistoryInterfaceHandler, intfType);
+}
+
+AJ_Status Cdm_SensorHistoryEnable(const char* objPath, CdmInterfaceTypes intfType, const uint16_t rawCapacity,
+                                  const uint16_t minuteCapacity, const uint16_t hourCapacity)
+{
+    AJ_Status status = AJ_OK;
+    SensorHistoryProperties* props = NULL;
+    SensorHistory* history = NULL;
+
+    if (!IsSensorInterface(intfType)) {
+        return AJ_ERR_INVALID;
+    }
+
+    if (sensorHistoryInterfaceType == UNDEFINED_INTERFACE) {
+        return AJ_ERR_NULL;
+    }
+
+    props = (SensorHistoryProperties*)GetProperties(objPath, sensorHistoryInterfaceType);
+    if (!props) {
+        return AJ_ERR_NO_MATCH;
+    }
+
+    history = FindSensorHistory(props, intfType);
+    if (history) {
+        FreeSensorHistory(history);
+    } else {
+        history = FindSensorHistory(props, UNDEFINED_INTERFACE);
+    }
+
+    status = InitRing(&history->rings[SENSOR_HISTORY_RAW], rawCapacity);
+    if (status == AJ_OK) {
+        status = InitRing(&history->rings[SENSOR_HISTORY_MINUTE], minuteCapacity);
+    }
+    if (status == AJ_OK) {
+        status = InitRing(&history->rings[SENSOR_HISTORY_HOUR], hourCapacity);
+    }
+    if (status != AJ_OK) {
+        FreeSensorHistory(history);
+        return status;
+    }
+    history->intfType = intfType;
+
+    return AJ_OK;
+}
+
+AJ_Status Cdm_SensorHistoryDisable(const char* objPath, CdmInterfaceTypes intfType)
+{
+    SensorHistoryProperties* props = NULL;
+    SensorHistory* history = NULL;
+
+    if (!IsSensorInterface(intfType)) {
+        return AJ_ERR_INVALID;
+    }
+
+    if (sensorHistoryInterfaceType == UNDEFINED_INTERFACE) {
+        return AJ_ERR_NULL;
+    }
+
+    props = (SensorHistoryProperties*)GetProperties(objPath, sensorHistoryInterfaceType);
+    if (!props) {
+        return AJ_ERR_NO_MATCH;
+    }
+
+    history = FindSensorHistory(props, intfType);
+    if (history) {
+        FreeSensorHistory(history);
+    }
+
+    return AJ_OK;
+}
+
+void CdmSensorHistoryRecord(const char* objPath, CdmInterfaceTypes intfType, double value)
+{
+    SensorHistoryProperties* props = NULL;
+    SensorHistory* history = NULL;
+    uint32_t now = 0;
+
+    if (sensorHistoryInterfaceType == UNDEFINED_INTERFACE) {
+        return;
+    }
+
+    props = (SensorHistoryProperties*)GetProperties(objPath, sensorHistoryInterfaceType);
+    if (!props) {
+        return;
+    }
+
+    history = FindSensorHistory(props, intfType);
+    if (!history) {
+        return;
+    }
+
+    now = AJ_GetElapsedTime(&sensorHistoryEpoch, TRUE);
+    PushRing(&history->rings[SENSOR_HISTORY_RAW], now, value);
+    Accumulate(&history->minute, &history->rings[SENSOR_HISTORY_MINUTE], MINUTE_MILLISECONDS, now, value);
+    Accumulate(&history->hour, &history->rings[SENSOR_HISTORY_HOUR], HOUR_MILLISECONDS, now, value);
+}
@@ -0,0 +1,31 @@
+/******************************************************************************
+ * Copyright AllSeen Alliance. All rights reserved.
+ *
+ *    Permission to use, copy, modify, and/or distribute this software for any
+ *    purpose with or without fee is hereby granted, provided that the above
+ *    copyright notice and this permission notice appear in all copies.
+ *
+ *    THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ *    WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ *    ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ *    WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ *    ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ *    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ ******************************************************************************/
+
+
+#ifndef CDMSENSORHISTORYIMPL_H_
+#define CDMSENSORHISTORYIMPL_H_
+
+#include <ajtcl/cdm/interfaces/CdmSensorHistory.h>
+
+/**
+ * Record a sensor value to its history if the history is enabled
+ * @param[in] objPath the object path including the interface
+ * @param[in] intfType sensor interface type
+ * @param[in] value sensor value
+ */
+void CdmSensorHistoryRecord(const char* objPath, CdmInterfaceTypes intfType, double value);
+
+#endif /* CDMSENSORHISTORYIMPL_H_ */
@@ -0,0 +1,264 @@
+/******************************************************************************
+ * Copyright AllSeen Alliance. All rights reserved.
+ *
+ *    Permission to use, copy, modify, and/or distribute this software for any
+ *    purpose with or without fee is hereby granted, provided that the above
+ *    copyright notice and this permission notice appear in all copies.
+ *
+ *    THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ *    WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ *    ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ *    WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ *    ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ *    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ ******************************************************************************/
+
+
+#include <stdlib.h>
+#include <string.h>
+#include "../CdmControllee/CdmControlleeImpl.h"
+#include "CdmSignalTemplateImpl.h"
+
+static uint8_t GetValueSize(const char* signature)
+{
+    if (!signature || !signature[0] || signature[1]) {
+        return 0;
+    }
+
+    switch (signature[0]) {
+    case 'y':
+        return sizeof(uint8_t);
+
+    case 'n':
+    case 'q':
+        return sizeof(uint16_t);
+
+    case 'b':
+    case 'i':
+    case 'u':
+        return sizeof(uint32_t);
+
+    case 'x':
+    case 't':
+    case 'd':
+        return sizeof(uint64_t);
+
+    default:
+        return 0;
+    }
+}
+
+static uint32_t WritePadding(uint8_t* body, uint32_t offset, uint32_t alignment)
+{
+    uint32_t aligned = (offset + alignment - 1) & ~(alignment - 1);
+
+    if (body) {
+        memset(body + offset, 0, aligned - offset);
+    }
+
+    return aligned;
+}
+
+static uint32_t WriteString(uint8_t* body, uint32_t offset, const char* str)
+{
+    uint32_t len = (uint32_t)strlen(str);
+
+    offset = WritePadding(body, offset, 4);
+    if (body) {
+        memcpy(body + offset, &len, sizeof(uint32_t));
+        memcpy(body + offset + sizeof(uint32_t), str, len + 1);
+    }
+
+    return offset + sizeof(uint32_t) + len + 1;
+}
+
+//Writes sa{sv}as with one dictionary entry and an empty array in native byte order the way AJ_MarshalArgs would.
+//Returns the body size, body can be NULL to measure. The value itself is left for the caller to patch.
+static uint32_t WriteBody(const char* intfName, const char* propName, const char* signature, uint8_t valueSize,
+                          uint8_t* body, uint32_t* valueOffset)
+{
+    uint32_t offset = 0;
+    uint32_t arrayOffset = 0;
+    uint32_t start = 0;
+    uint32_t arrayLen = 0;
+
+    offset = WriteString(body, offset, intfName);
+    offset = WritePadding(body, offset, 4);
+    arrayOffset = offset;
+    offset += sizeof(uint32_t);
+    offset = WritePadding(body, offset, 8);
+    start = offset;
+
+    offset = WriteString(body, offset, propName);
+    if (body) {
+        body[offset] = 1;
+        body[offset + 1] = (uint8_t)signature[0];
+        body[offset + 2] = '\0';
+    }
+    offset += 3;
+    offset = WritePadding(body, offset, valueSize);
+    *valueOffset = offset;
+    offset += valueSize;
+
+    if (body) {
+        arrayLen = offset - start;
+        memcpy(body + arrayOffset, &arrayLen, sizeof(uint32_t));
+    }
+
+    offset = WritePadding(body, offset, 4);
+    if (body) {
+        memset(body + offset, 0, sizeof(uint32_t));
+    }
+
+    return offset + sizeof(uint32_t);
+}
+
+static AJ_Status BuildTemplate(const char* objPath, CdmSignalTemplate* tmpl, const char* intfName, const char* propName, const char* signature)
+{
+    AJ_Status status = AJ_OK;
+    uint8_t valueSize = GetValueSize(signature);
+
+    if (!valueSize) {
+        return AJ_ERR_SIGNATURE;
+    }
+
+    status = MakePropChangedId(objPath, &tmpl->msgId);
+    if (status != AJ_OK) {
+        return status;
+    }
+
+    tmpl->valueSize = valueSize;
+    tmpl->bodySize = WriteBody(intfName, propName, signature, valueSize, NULL, &tmpl->valueOffset);
+    tmpl->body = (uint8_t*)malloc(tmpl->bodySize);
+    if (!tmpl->body) {
+        return AJ_ERR_RESOURCES;
+    }
+    WriteBody(intfName, propName, signature, valueSize, tmpl->body, &tmpl->valueOffset);
+
+    return AJ_OK;
+}
+
+//Marshals the same signal by AJ_MarshalArgs, for encrypted signals which cannot be delivered in parts
+static AJ_Status MarshalBody(AJ_Message* msg, const char* intfName, const char* propName, const char* signature, const void* val)
+{
+    AJ_Status status = AJ_OK;
+    AJ_Arg array;
+    AJ_Arg entry;
+
+    status = AJ_MarshalArgs(msg, "s", intfName);
+    if (status == AJ_OK) {
+        status = AJ_MarshalContainer(msg, &array, AJ_ARG_ARRAY);
+    }
+    if (status == AJ_OK) {
+        status = AJ_MarshalContainer(msg, &entry, AJ_ARG_DICT_ENTRY);
+    }
+    if (status == AJ_OK) {
+        switch (signature[0]) {
+        case 'y':
+            status = AJ_MarshalArgs(msg, "sv", propName, signature, *(const uint8_t*)val);
+            break;
+
+        case 'n':
+        case 'q':
+            status = AJ_MarshalArgs(msg, "sv", propName, signature, *(const uint16_t*)val);
+            break;
+
+        case 'b':
+            status = AJ_MarshalArgs(msg, "sv", propName, signature, (uint32_t)(*(const bool*)val ? 1 : 0));
+            break;
+
+        case 'i':
+        case 'u':
+            status = AJ_MarshalArgs(msg, "sv", propName, signature, *(const uint32_t*)val);
+            break;
+
+        case 'x':
+        case 't':
+            status = AJ_MarshalArgs(msg, "sv", propName, signature, *(const uint64_t*)val);
+            break;
+
+        case 'd':
+            status = AJ_MarshalArgs(msg, "sv", propName, signature, *(const double*)val);
+            break;
+
+        default:
+            status = AJ_ERR_SIGNATURE;
+        }
+    }
+    if (status == AJ_OK) {
+        status = AJ_MarshalCloseContainer(msg, &entry);
+    }
+    if (status == AJ_OK) {
+        status = AJ_MarshalCloseContainer(msg, &array);
+    }
+    if (status == AJ_OK) {
+        status = AJ_MarshalContainer(msg, &array, AJ_ARG_ARRAY);
+    }
+    if (status == AJ_OK) {
+        status = AJ_MarshalCloseContainer(msg, &array);
+    }
+
+    return status;
+}
+
+AJ_Status CdmSignalTemplateEmit(AJ_BusAttachment* busAttachment, const char* objPath, CdmSignalTemplate* tmpl,
+                                const char* intfName, const char* propName, const char* signature, const void* val)
+{
+    AJ_Status status = AJ_OK;
+    CdmPropChangedTarget target = { 0, 0, 0 };
+    AJ_Message msg;
+
+    if (!busAttachment || !tmpl || !intfName || !propName || !signature || !val) {
+        return AJ_ERR_INVALID;
+    }
+
+    if (!tmpl->body) {
+        status = BuildTemplate(objPath, tmpl, intfName, propName, signature);
+        if (status != AJ_OK) {
+            return status;
+        }
+    }
+
+    if (signature[0] == 'b') {
+        uint32_t b = *(const bool*)val ? 1 : 0;
+        memcpy(tmpl->body + tmpl->valueOffset, &b, sizeof(uint32_t));
+    } else {
+        memcpy(tmpl->body + tmpl->valueOffset, val, tmpl->valueSize);
+    }
+
+    //a failed target does not stop the delivery to the others, the first error is returned
+    while (CdmNextPropChangedTarget(tmpl->msgId, &target)) {
+        AJ_Status targetStatus = AJ_MarshalSignal(busAttachment, &msg, tmpl->msgId, NULL, target.sessionId, target.flags, 0);
+
+        if (targetStatus == AJ_OK && (msg.hdr->flags & AJ_FLAG_ENCRYPTED)) {
+            //AJ_DeliverMsgPartial refuses encrypted messages
+            targetStatus = MarshalBody(&msg, intfName, propName, signature, val);
+        } else if (targetStatus == AJ_OK) {
+            targetStatus = AJ_DeliverMsgPartial(&msg, tmpl->bodySize);
+            if (targetStatus == AJ_OK) {
+                targetStatus = AJ_MarshalRaw(&msg, tmpl->body, tmpl->bodySize);
+            }
+        }
+        if (targetStatus == AJ_OK) {
+            targetStatus = AJ_DeliverMsg(&msg);
+        }
+        if (status == AJ_OK) {
+            status = targetStatus;
+        }
+    }
+
+    return status;
+}
+
+void CdmSignalTemplateClear(CdmSignalTemplate* tmpl)
+{
+    if (!tmpl) {
+        return;
+    }
+
+    if (tmpl->body) {
+        free(tmpl->body);
+    }
+    memset(tmpl, 0, sizeof(CdmSignalTemplate));
+}
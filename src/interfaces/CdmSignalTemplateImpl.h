@@ -0,0 +1,57 @@
+/******************************************************************************
+ * Copyright AllSeen Alliance. All rights reserved.
+ *
+ *    Permission to use, copy, modify, and/or distribute this software for any
+ *    purpose with or without fee is hereby granted, provided that the above
+ *    copyright notice and this permission notice appear in all copies.
+ *
+ *    THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ *    WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ *    ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ *    WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ *    ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ *    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ ******************************************************************************/
+
+#ifndef CDMSIGNALTEMPLATEIMPL_H_
+#define CDMSIGNALTEMPLATEIMPL_H_
+
+#include <ajtcl/alljoyn.h>
+#include <ajtcl/cdm/CdmControllee.h>
+
+/**
+ * Pre-marshalled PropertiesChanged body of one scalar property.
+ * The body sa{sv}as is built on the first emission and only the value is patched afterwards.
+ * The header is still marshalled per signal since the serial number and the session differ.
+ */
+typedef struct {
+    uint32_t msgId;
+    uint8_t* body;
+    uint32_t bodySize;
+    uint32_t valueOffset;
+    uint8_t valueSize;
+} CdmSignalTemplate;
+
+/**
+ * Emit PropertiesChanged signal of a scalar property using template.
+ * Encrypted signals are marshalled without the template, and a failed target does not stop the others.
+ * @param[in] busAttachment bus attachment
+ * @param[in] objPath object path
+ * @param[in,out] tmpl template, zero initialized before the first emission
+ * @param[in] intfName interface name
+ * @param[in] propName property name
+ * @param[in] signature property signature, one of y, b, n, q, i, u, x, t, d
+ * @param[in] val property value
+ * @return AJ_OK on success
+ */
+AJ_Status CdmSignalTemplateEmit(AJ_BusAttachment* busAttachment, const char* objPath, CdmSignalTemplate* tmpl,
+                                const char* intfName, const char* propName, const char* signature, const void* val);
+
+/**
+ * Release template
+ * @param[in] tmpl template
+ */
+void CdmSignalTemplateClear(CdmSignalTemplate* tmpl);
+
+#endif /* CDMSIGNALTEMPLATEIMPL_H_ */
@@ -0,0 +1,230 @@
+/******************************************************************************
+ * Copyright AllSeen Alliance. All rights reserved.
+ *
+ *    Permission to use, copy, modify, and/or distribute this software for any
+ *    purpose with or without fee is hereby granted, provided that the above
+ *    copyright notice and this permission notice appear in all copies.
+ *
+ *    THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ *    WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ *    ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ *    WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ *    ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ *    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ ******************************************************************************/
+
+
+#include <stdlib.h>
+#include <string.h>
+#include "CdmStringPropertyImpl.h"
+
+#define INTERNED_STRING_BUCKETS 32
+
+struct _CdmInternedString {
+    CdmInternedString* next;
+    uint32_t hash;
+    uint32_t refCount;
+    size_t length;
+    char str[1];
+};
+
+static CdmInternedString* internedStrings[INTERNED_STRING_BUCKETS] = { NULL, };
+
+static uint32_t GetStringHash(const char* str, size_t length)
+{
+    uint32_t hash = 2166136261u;
+    size_t i = 0;
+
+    for (i = 0; i < length; i++) {
+        hash = (hash ^ (uint8_t)str[i]) * 16777619u;
+    }
+
+    return hash;
+}
+
+static CdmInternedString* InternString(const char* str, size_t length)
+{
+    uint32_t hash = GetStringHash(str, length);
+    CdmInternedString** bucket = &internedStrings[hash % INTERNED_STRING_BUCKETS];
+    CdmInternedString* interned = NULL;
+
+    for (interned = *bucket; interned; interned = interned->next) {
+        if (interned->hash == hash && interned->length == length && !memcmp(interned->str, str, length)) {
+            interned->refCount++;
+            return interned;
+        }
+    }
+
+    interned = (CdmInternedString*)malloc(sizeof(CdmInternedString) + length);
+    if (!interned) {
+        return NULL;
+    }
+    interned->hash = hash;
+    interned->refCount = 1;
+    interned->length = length;
+    memcpy(interned->str, str, length);
+    interned->str[length] = '\0';
+    interned->next = *bucket;
+    *bucket = interned;
+
+    return interned;
+}
+
+static void ReleaseString(CdmInternedString* interned)
+{
+    CdmInternedString** link = NULL;
+
+    if (--interned->refCount > 0) {
+        return;
+    }
+
+    for (link = &internedStrings[interned->hash % INTERNED_STRING_BUCKETS]; *link; link = &(*link)->next) {
+        if (*link == interned) {
+            *link = interned->next;
+            break;
+        }
+    }
+    free(interned);
+}
+
+AJ_Status CdmStringPropertySet(CdmStringProperty* prop, const char* str, bool* changed)
+{
+    size_t length = 0;
+
+    if (!prop || !str) {
+        return AJ_ERR_INVALID;
+    }
+
+    if (changed) {
+        *changed = false;
+    }
+
+    length = strlen(str);
+    if (prop->isSet && prop->length == length && !memcmp(CdmStringPropertyGet(prop), str, length)) {
+        return AJ_OK;
+    }
+
+    if (length < CDM_STRING_INLINE_SIZE) {
+        char inlineStr[CDM_STRING_INLINE_SIZE];
+
+        //str may point into the storage being released
+        memcpy(inlineStr, str, length + 1);
+        CdmStringPropertyClear(prop);
+        memcpy(prop->value.inlineStr, inlineStr, length + 1);
+    } else {
+        CdmInternedString* interned = InternString(str, length);
+        if (!interned) {
+            return AJ_ERR_RESOURCES;
+        }
+        CdmStringPropertyClear(prop);
+        prop->value.interned = interned;
+    }
+    prop->length = length;
+    prop->isSet = true;
+
+    if (changed) {
+        *changed = true;
+    }
+
+    return AJ_OK;
+}
+
+const char* CdmStringPropertyGet(const CdmStringProperty* prop)
+{
+    if (!prop || !prop->isSet) {
+        return NULL;
+    }
+
+    if (prop->length < CDM_STRING_INLINE_SIZE) {
+        return prop->value.inlineStr;
+    }
+
+    return prop->value.interned->str;
+}
+
+AJ_Status CdmStringPropertyCopy(const CdmStringProperty* prop, char* str)
+{
+    if (!prop || !str) {
+        return AJ_ERR_INVALID;
+    }
+
+    if (!prop->isSet) {
+        return AJ_ERR_NULL;
+    }
+    memcpy(str, CdmStringPropertyGet(prop), prop->length + 1);
+
+    return AJ_OK;
+}
+
+AJ_Status CdmStringPropertyBorrow(const CdmStringProperty* prop, const char** str, size_t* length)
+{
+    if (!prop || !str) {
+        return AJ_ERR_INVALID;
+    }
+
+    if (!prop->isSet) {
+        return AJ_ERR_NULL;
+    }
+    *str = CdmStringPropertyGet(prop);
+    if (length) {
+        *length = prop->length;
+    }
+
+    return AJ_OK;
+}
+
+void CdmStringPropertyClear(CdmStringProperty* prop)
+{
+    if (!prop) {
+        return;
+    }
+
+    if (prop->isSet && prop->length >= CDM_STRING_INLINE_SIZE) {
+        ReleaseString(prop->value.interned);
+    }
+    prop->isSet = false;
+    prop->length = 0;
+}
+
+AJ_Status CdmStringPropertySave(const CdmStringProperty* prop, CdmSnapshotWriter* writer)
+{
+    AJ_Status status = AJ_OK;
+
+    if (!prop) {
+        return AJ_ERR_INVALID;
+    }
+
+    status = CdmSnapshotWrite(writer, &prop->isSet, sizeof(prop->isSet));
+    if (status == AJ_OK) {
+        status = CdmSnapshotWriteString(writer, CdmStringPropertyGet(prop));
+    }
+
+    return status;
+}
+
+AJ_Status CdmStringPropertyLoad(CdmStringProperty* prop, CdmSnapshotReader* reader)
+{
+    AJ_Status status = AJ_OK;
+    bool isSet = false;
+    char* str = NULL;
+
+    if (!prop) {
+        return AJ_ERR_INVALID;
+    }
+
+    CdmStringPropertyClear(prop);
+
+    status = CdmSnapshotRead(reader, &isSet, sizeof(isSet));
+    if (status == AJ_OK) {
+        status = CdmSnapshotReadString(reader, &str);
+    }
+    if (status == AJ_OK && isSet) {
+        status = CdmStringPropertySet(prop, str, NULL);
+    }
+    if (str) {
+        free(str);
+    }
+
+    return status;
+}
@@ -0,0 +1,97 @@
+/******************************************************************************
+ * Copyright AllSeen Alliance. All rights reserved.
+ *
+ *    Permission to use, copy, modify, and/or distribute this software for any
+ *    purpose with or without fee is hereby granted, provided that the above
+ *    copyright notice and this permission notice appear in all copies.
+ *
+ *    THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ *    WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ *    ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ *    WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ *    ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ *    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ ******************************************************************************/
+
+
+#ifndef CDMSTRINGPROPERTYIMPL_H_
+#define CDMSTRINGPROPERTYIMPL_H_
+
+#include <ajtcl/alljoyn.h>
+#include <ajtcl/cdm/CdmControllee.h>
+#include "../CdmControllee/CdmControlleeImpl.h"
+
+#define CDM_STRING_INLINE_SIZE 24
+
+typedef struct _CdmInternedString CdmInternedString;
+
+/**
+ * String property storage
+ * Strings shorter than CDM_STRING_INLINE_SIZE are kept inline, longer ones are shared through the interned string pool.
+ */
+typedef struct {
+    bool isSet;
+    size_t length;
+    union {
+        char inlineStr[CDM_STRING_INLINE_SIZE];
+        CdmInternedString* interned;
+    } value;
+} CdmStringProperty;
+
+/**
+ * Set string property
+ * @param[in] prop string property
+ * @param[in] str string
+ * @param[out] changed true if the value is changed, can be NULL
+ * @return AJ_OK on success
+ */
+AJ_Status CdmStringPropertySet(CdmStringProperty* prop, const char* str, bool* changed);
+
+/**
+ * Get string of string property
+ * @param[in] prop string property
+ * @return string, NULL if not set
+ */
+const char* CdmStringPropertyGet(const CdmStringProperty* prop);
+
+/**
+ * Copy string of string property
+ * @param[in] prop string property
+ * @param[out] str buffer of at least length + 1 bytes
+ * @return AJ_OK on success
+ */
+AJ_Status CdmStringPropertyCopy(const CdmStringProperty* prop, char* str);
+
+/**
+ * Borrow string of string property. It is valid until the next change of the property.
+ * @param[in] prop string property
+ * @param[out] str string
+ * @param[out] length string length, can be NULL
+ * @return AJ_OK on success
+ */
+AJ_Status CdmStringPropertyBorrow(const CdmStringProperty* prop, const char** str, size_t* length);
+
+/**
+ * Release string property
+ * @param[in] prop string property
+ */
+void CdmStringPropertyClear(CdmStringProperty* prop);
+
+/**
+ * Write string property to a snapshot image
+ * @param[in] prop string property
+ * @param[in] writer snapshot writer
+ * @return AJ_OK on success
+ */
+AJ_Status CdmStringPropertySave(const CdmStringProperty* prop, CdmSnapshotWriter* writer);
+
+/**
+ * Read string property written by CdmStringPropertySave
+ * @param[in] prop string property, cleared before reading
+ * @param[in] reader snapshot reader
+ * @return AJ_OK on success
+ */
+AJ_Status CdmStringPropertyLoad(CdmStringProperty* prop, CdmSnapshotReader* reader);
+
+#endif /* CDMSTRINGPROPERTYIMPL_H_ */
@@ -0,0 +1,354 @@
+/******************************************************************************
+ * Copyright AllSeen Alliance. All rights reserved.
+ *
+ *    Permission to use, copy, modify, and/or distribute this software for any
+ *    purpose with or without fee is hereby granted, provided that the above
+ *    copyright notice and this permission notice appear in all copies.
+ *
+ *    THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ *    WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ *    ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ *    WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ *    ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ *    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ ******************************************************************************/
+
+
+#include "CdmTimerWheelImpl.h"
+
+#define WHEEL_BITS 6
+#define WHEEL_SLOTS (1 << WHEEL_BITS)
+#define WHEEL_MASK (WHEEL_SLOTS - 1)
+#define WHEEL_LEVELS 4
+#define WHEEL_RESOLUTION 100 //ms per tick
+#define MAX_DELTA_TICKS ((1UL << (WHEEL_BITS * WHEEL_LEVELS)) - 1)
+
+//Each slot is the sentinel of a circular list. Level n slots cover 64^n ticks, and their timers are
+//moved to lower levels when the ticks of the slot are reached, as in the hierarchical wheel of Varghese and Lauck.
+static CdmTimer wheel[WHEEL_LEVELS][WHEEL_SLOTS];
+//Bit n is set when slot n of the level may hold timers. Bits of slots emptied by Unlink are cleared lazily.
+static uint64_t occupied[WHEEL_LEVELS];
+static bool timerWheelInit = false;
+static AJ_Time timerWheelEpoch;
+static uint32_t nextTick = 0; //the first tick which is not processed yet
+static uint32_t nextTickTime = 0; //the time when nextTick is reached, in ms
+static uint32_t numTimers = 0;
+
+static void InitTimerWheel()
+{
+    int level = 0;
+    int i = 0;
+
+    if (timerWheelInit) {
+        return;
+    }
+
+    for (level = 0; level < WHEEL_LEVELS; level++) {
+        for (i = 0; i < WHEEL_SLOTS; i++) {
+            wheel[level][i].next = &wheel[level][i];
+            wheel[level][i].prev = &wheel[level][i];
+        }
+        occupied[level] = 0;
+    }
+    AJ_InitTimer(&timerWheelEpoch);
+    nextTick = 0;
+    nextTickTime = 0;
+    numTimers = 0;
+    timerWheelInit = true;
+}
+
+//Ticks are counted from nextTick and not derived from the ms clock, which wraps every 49.7 days
+static uint32_t ExpiryTick(const CdmTimer* timer)
+{
+    int32_t delta = (int32_t)(timer->expiry - nextTickTime);
+
+    if (delta <= 0) {
+        return nextTick;
+    }
+    //rounded up so that a timer never expires early
+    return nextTick + (uint32_t)delta / WHEEL_RESOLUTION + (((uint32_t)delta % WHEEL_RESOLUTION) ? 1 : 0);
+}
+
+static void Unlink(CdmTimer* timer)
+{
+    timer->prev->next = timer->next;
+    timer->next->prev = timer->prev;
+    timer->next = NULL;
+    timer->prev = NULL;
+}
+
+static void Link(CdmTimer* head, CdmTimer* timer)
+{
+    timer->next = head;
+    timer->prev = head->prev;
+    head->prev->next = timer;
+    head->prev = timer;
+}
+
+static void Splice(CdmTimer* from, CdmTimer* to)
+{
+    to->next = to;
+    to->prev = to;
+    if (from->next != from) {
+        to->next = from->next;
+        to->prev = from->prev;
+        to->next->prev = to;
+        to->prev->next = to;
+        from->next = from;
+        from->prev = from;
+    }
+}
+
+static void Insert(CdmTimer* timer)
+{
+    uint32_t tick = ExpiryTick(timer);
+    uint32_t delta = 0;
+    uint32_t index = 0;
+    int level = 0;
+
+    if ((int32_t)(tick - nextTick) < 0) {
+        tick = nextTick;
+    }
+    delta = tick - nextTick;
+    if (delta > MAX_DELTA_TICKS) {
+        //parked at the end of the wheel and inserted again from there
+        delta = MAX_DELTA_TICKS;
+        tick = nextTick + MAX_DELTA_TICKS;
+    }
+    while (level < WHEEL_LEVELS - 1 && delta >= (1UL << (WHEEL_BITS * (level + 1)))) {
+        level++;
+    }
+    index = (tick >> (WHEEL_BITS * level)) & WHEEL_MASK;
+    Link(&wheel[level][index], timer);
+    occupied[level] |= (uint64_t)1 << index;
+}
+
+static void Add(CdmTimer* timer, uint32_t now)
+{
+    if (!numTimers) {
+        //nothing to process in the ticks passed while the wheel was empty
+        nextTickTime = now;
+    }
+    numTimers++;
+    Insert(timer);
+}
+
+//Move the timers of the slot reached by nextTick to lower levels
+static bool Cascade(int level)
+{
+    CdmTimer list;
+    uint32_t index = (nextTick >> (WHEEL_BITS * level)) & WHEEL_MASK;
+
+    Splice(&wheel[level][index], &list);
+    occupied[level] &= ~((uint64_t)1 << index);
+    while (list.next != &list) {
+        CdmTimer* timer = list.next;
+        Unlink(timer);
+        Insert(timer);
+    }
+
+    return (index == 0);
+}
+
+static int LowestBit(uint64_t bits)
+{
+    int bit = 0;
+    int shift = 32;
+
+    while (shift) {
+        if (!(bits & (((uint64_t)1 << shift) - 1))) {
+            bits >>= shift;
+            bit += shift;
+        }
+        shift >>= 1;
+    }
+
+    return bit;
+}
+
+//The tick when CdmTimerWheelRun next has to process the level: the expiry tick of the first occupied
+//slot for level 0, and the tick when the first occupied slot is cascaded for the upper levels
+static bool NextOccupiedTick(int level, uint32_t* tick)
+{
+    uint32_t shift = WHEEL_BITS * level;
+    uint32_t current = (nextTick >> shift) & WHEEL_MASK;
+    //once the current slot of an upper level was cascaded it holds the timers of the next wheel round
+    uint32_t first = (nextTick & ((1UL << shift) - 1)) ? 1 : 0;
+
+    while (occupied[level]) {
+        uint64_t bits = occupied[level];
+        uint32_t start = (current + first) & WHEEL_MASK;
+        uint32_t index = 0;
+        uint32_t ahead = 0;
+
+        if (start) {
+            bits = (bits >> start) | (bits << (WHEEL_SLOTS - start));
+        }
+        index = (start + LowestBit(bits)) & WHEEL_MASK;
+        if (wheel[level][index].next == &wheel[level][index]) {
+            occupied[level] &= ~((uint64_t)1 << index);
+            continue;
+        }
+        ahead = (index - current) & WHEEL_MASK;
+        if (!ahead && first) {
+            ahead = WHEEL_SLOTS;
+        }
+        *tick = ((nextTick >> shift) + ahead) << shift;
+        return true;
+    }
+
+    return false;
+}
+
+void Cdm_TimerWheelInitTimer(CdmTimer* timer, CdmTimerCallback callback, void* context)
+{
+    if (!timer) {
+        return;
+    }
+
+    timer->next = NULL;
+    timer->prev = NULL;
+    timer->expiring = false;
+    timer->expiry = 0;
+    timer->period = 0;
+    timer->callback = callback;
+    timer->context = context;
+}
+
+void Cdm_TimerWheelSchedule(CdmTimer* timer, uint32_t delay, uint32_t period)
+{
+    uint32_t now = 0;
+
+    if (!timer) {
+        return;
+    }
+
+    now = CdmTimerWheelNow();
+    timer->expiry = now + delay;
+    timer->period = period;
+    if (timer->next && !timer->expiring) {
+        Unlink(timer);
+        Insert(timer);
+    } else {
+        //a timer waiting for its callback in CdmTimerWheelRun is not counted in numTimers
+        if (timer->next) {
+            Unlink(timer);
+            timer->expiring = false;
+        }
+        Add(timer, now);
+    }
+}
+
+void Cdm_TimerWheelCancel(CdmTimer* timer)
+{
+    if (timer && timer->next) {
+        Unlink(timer);
+        if (timer->expiring) {
+            timer->expiring = false;
+        } else {
+            numTimers--;
+        }
+    }
+}
+
+bool Cdm_TimerWheelIsScheduled(const CdmTimer* timer)
+{
+    return (timer && timer->next);
+}
+
+uint32_t Cdm_TimerWheelGetTimeout(uint32_t maxTimeout)
+{
+    uint32_t now = 0;
+    uint32_t earliest = 0;
+    uint32_t deadline = 0;
+    int32_t timeout = 0;
+    bool found = false;
+    int level = 0;
+
+    if (!numTimers) {
+        return maxTimeout;
+    }
+
+    for (level = 0; level < WHEEL_LEVELS; level++) {
+        uint32_t tick = 0;
+
+        if (NextOccupiedTick(level, &tick) && (!found || (int32_t)(tick - earliest) < 0)) {
+            earliest = tick;
+            found = true;
+        }
+    }
+    if (!found) {
+        return maxTimeout;
+    }
+    deadline = nextTickTime + (earliest - nextTick) * WHEEL_RESOLUTION;
+
+    now = CdmTimerWheelNow();
+    timeout = (int32_t)(deadline - now);
+    if (timeout <= 0) {
+        return 0;
+    }
+
+    return ((uint32_t)timeout < maxTimeout) ? (uint32_t)timeout : maxTimeout;
+}
+
+uint32_t CdmTimerWheelNow()
+{
+    InitTimerWheel();
+
+    return AJ_GetElapsedTime(&timerWheelEpoch, TRUE);
+}
+
+void CdmTimerWheelRun(AJ_BusAttachment* busAttachment)
+{
+    CdmTimer expired;
+    CdmTimer list;
+    CdmTimer* timer = NULL;
+    uint32_t now = 0;
+
+    now = CdmTimerWheelNow();
+
+    //expired timers are moved out first so that callbacks can schedule and cancel any timer
+    expired.next = &expired;
+    expired.prev = &expired;
+    while (numTimers && (int32_t)(now - nextTickTime) >= 0) {
+        uint32_t tick = nextTick;
+        int level = 1;
+
+        if (!(tick & WHEEL_MASK)) {
+            while (level < WHEEL_LEVELS && Cascade(level)) {
+                level++;
+            }
+        }
+        Splice(&wheel[0][tick & WHEEL_MASK], &list);
+        occupied[0] &= ~((uint64_t)1 << (tick & WHEEL_MASK));
+        while (list.next != &list) {
+            timer = list.next;
+            Unlink(timer);
+            if ((int32_t)(ExpiryTick(timer) - tick) > 0) {
+                Insert(timer);
+            } else {
+                Link(&expired, timer);
+                timer->expiring = true;
+                numTimers--;
+            }
+        }
+        nextTick++;
+        nextTickTime += WHEEL_RESOLUTION;
+    }
+    while (expired.next != &expired) {
+        timer = expired.next;
+        Unlink(timer);
+        timer->expiring = false;
+        if (timer->period) {
+            timer->expiry += timer->period;
+            if ((int32_t)(timer->expiry - now) <= 0) {
+                timer->expiry = now + timer->period;
+            }
+            Add(timer, now);
+        }
+        if (timer->callback) {
+            timer->callback(busAttachment, timer, timer->context);
+        }
+    }
+}
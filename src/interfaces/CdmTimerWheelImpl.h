@@ -0,0 +1,36 @@
+/******************************************************************************
+ * Copyright AllSeen Alliance. All rights reserved.
+ *
+ *    Permission to use, copy, modify, and/or distribute this software for any
+ *    purpose with or without fee is hereby granted, provided that the above
+ *    copyright notice and this permission notice appear in all copies.
+ *
+ *    THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ *    WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ *    ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ *    WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ *    ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ *    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ ******************************************************************************/
+
+
+#ifndef CDMTIMERWHEELIMPL_H_
+#define CDMTIMERWHEELIMPL_H_
+
+#include <ajtcl/alljoyn.h>
+#include <ajtcl/cdm/interfaces/CdmTimerWheel.h>
+
+/**
+ * Get the time of the timer wheel clock
+ * @return time in ms
+ */
+uint32_t CdmTimerWheelNow();
+
+/**
+ * Call the callbacks of expired timers
+ * @param[in] busAttachment bus attachment passed to the callbacks
+ */
+void CdmTimerWheelRun(AJ_BusAttachment* busAttachment);
+
+#endif /* CDMTIMERWHEELIMPL_H_ */
@@ -0,0 +1,38 @@
+/******************************************************************************
+ * Copyright AllSeen Alliance. All rights reserved.
+ *
+ *    Permission to use, copy, modify, and/or distribute this software for any
+ *    purpose with or without fee is hereby granted, provided that the above
+ *    copyright notice and this permission notice appear in all copies.
+ *
+ *    THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ *    WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ *    ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ *    WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ *    ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ *    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ ******************************************************************************/
+
+
+#include <string.h>
+#include "CdmValueSetImpl.h"
+
+void CdmValueSetBuild(CdmValueSet* set, const uint8_t* values, size_t count)
+{
+    size_t i = 0;
+
+    memset(set->bits, 0, sizeof(set->bits));
+    if (!values) {
+        return;
+    }
+
+    for (i = 0; i < count; i++) {
+        set->bits[values[i] >> 5] |= ((uint32_t)1 << (values[i] & 0x1F));
+    }
+}
+
+bool CdmValueSetContains(const CdmValueSet* set, uint8_t value)
+{
+    return (set->bits[value >> 5] & ((uint32_t)1 << (value & 0x1F))) ? true : false;
+}
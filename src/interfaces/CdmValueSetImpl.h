@@ -0,0 +1,48 @@
+/******************************************************************************
+ * Copyright AllSeen Alliance. All rights reserved.
+ *
+ *    Permission to use, copy, modify, and/or distribute this software for any
+ *    purpose with or without fee is hereby granted, provided that the above
+ *    copyright notice and this permission notice appear in all copies.
+ *
+ *    THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ *    WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ *    ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ *    WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ *    ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ *    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ ******************************************************************************/
+
+
+#ifndef CDMVALUESETIMPL_H_
+#define CDMVALUESETIMPL_H_
+
+#include <ajtcl/alljoyn.h>
+#include <ajtcl/cdm/CdmControllee.h>
+
+/**
+ * Set of uint8_t values, used to validate a value against a supported or selectable list
+ * without scanning the list. The list itself is kept for marshalling.
+ */
+typedef struct {
+    uint32_t bits[256 / 32];
+} CdmValueSet;
+
+/**
+ * Rebuild value set from a list
+ * @param[in] set value set
+ * @param[in] values list of values, can be NULL if count is 0
+ * @param[in] count number of values
+ */
+void CdmValueSetBuild(CdmValueSet* set, const uint8_t* values, size_t count);
+
+/**
+ * Check if value set contains a value
+ * @param[in] set value set
+ * @param[in] value value
+ * @return true if the value is in the set
+ */
+bool CdmValueSetContains(const CdmValueSet* set, uint8_t value);
+
+#endif /* CDMVALUESETIMPL_H_ */
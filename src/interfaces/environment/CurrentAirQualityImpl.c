@@ -14,8 +14,11 @@
  *    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
  ******************************************************************************/
 
+#include <stddef.h>
 #include <ajtcl/cdm/interfaces/environment/CurrentAirQuality.h>
 #include "../../CdmControllee/CdmControlleeImpl.h"
+#include "../CdmSignalTemplateImpl.h"
+#include "../CdmSensorHistoryImpl.h"
 #include "CurrentAirQualityImpl.h"
 
 #define INTERFACE_VERSION 1
@@ -40,6 +43,7 @@ typedef struct {
     double minValue;
     double precision;
     uint16_t updateMinTime;
+    CdmSignalTemplate currentValueSignal;
 } CurrentAirQualityProperties;
 
 AJ_Status CreateCurrentAirQualityInterface(void** properties)
@@ -60,14 +64,30 @@ void DestroyCurrentAirQualityInterface(void* properties)
     if (properties) {
         CurrentAirQualityProperties* props = (CurrentAirQualityProperties*)properties;
 
+        CdmSignalTemplateClear(&props->currentValueSignal);
         free(props);
     }
 }
 
+AJ_Status CurrentAirQualityInterfaceSaveProperties(void* properties, CdmSnapshotWriter* writer)
+{
+    return CdmSnapshotWrite(writer, properties, offsetof(CurrentAirQualityProperties, currentValueSignal));
+}
+
+AJ_Status CurrentAirQualityInterfaceLoadProperties(void* properties, CdmSnapshotReader* reader)
+{
+    if (reader->size != offsetof(CurrentAirQualityProperties, currentValueSignal)) {
+        return AJ_ERR_INVALID;
+    }
+
+    return CdmSnapshotRead(reader, properties, offsetof(CurrentAirQualityProperties, currentValueSignal));
+}
+
 static AJ_Status EmitPropChanged(AJ_BusAttachment* busAttachment, const char* objPath, const char* propName, const char* signature, void* val)
 {
     AJ_Status status = AJ_OK;
     uint32_t msgId = 0;
+    CdmPropChangedTarget target = { 0, 0, 0 };
     AJ_Message msg;
     AJ_Arg array, strc;
 
@@ -76,8 +96,8 @@ static AJ_Status EmitPropChanged(AJ_BusAttachment* busAttachment, const char* ob
     }
 
     status = MakePropChangedId(objPath, &msgId);
-    if (status == AJ_OK) {
-        AJ_MarshalSignal(busAttachment, &msg, msgId, NULL, 0, AJ_FLAG_GLOBAL_BROADCAST, 0);
+    while (status == AJ_OK && CdmNextPropChangedTarget(msgId, &target)) {
+        AJ_MarshalSignal(busAttachment, &msg, msgId, NULL, target.sessionId, target.flags, 0);
         AJ_MarshalArgs(&msg, "s", intfDescEnvironmentCurrentAirQuality[0]+1); //To remove '$'
         AJ_MarshalContainer(&msg, &array, AJ_ARG_ARRAY);
         AJ_MarshalContainer(&msg, &strc, AJ_ARG_DICT_ENTRY);
@@ -124,7 +144,8 @@ AJ_Status CurrentAirQualityInterfaceOnGetProperty(AJ_Message* replyMsg, const ch
             uint8_t contaminantType;
             if (lt && lt->OnGetContaminantType) {
                 status = lt->OnGetContaminantType(objPath, &contaminantType);
-                if (status == AJ_OK) {
+                if (status == AJ_OK && !CdmIsReplyDeferred()) {
+                    CdmMarkValuePulled();
                     props->contaminantType = contaminantType;
                 }
             }
@@ -136,7 +157,8 @@ AJ_Status CurrentAirQualityInterfaceOnGetProperty(AJ_Message* replyMsg, const ch
             double currentValue;
             if (lt && lt->OnGetCurrentValue) {
                 status = lt->OnGetCurrentValue(objPath, &currentValue);
-                if (status == AJ_OK) {
+                if (status == AJ_OK && !CdmIsReplyDeferred()) {
+                    CdmMarkValuePulled();
                     props->currentValue = currentValue;
                 }
             }
@@ -148,7 +170,8 @@ AJ_Status CurrentAirQualityInterfaceOnGetProperty(AJ_Message* replyMsg, const ch
             double maxValue;
             if (lt && lt->OnGetMaxValue) {
                 status = lt->OnGetMaxValue(objPath, &maxValue);
-                if (status == AJ_OK) {
+                if (status == AJ_OK && !CdmIsReplyDeferred()) {
+                    CdmMarkValuePulled();
                     props->maxValue = maxValue;
                 }
             }
@@ -160,7 +183,8 @@ AJ_Status CurrentAirQualityInterfaceOnGetProperty(AJ_Message* replyMsg, const ch
             double minValue;
             if (lt && lt->OnGetMinValue) {
                 status = lt->OnGetMinValue(objPath, &minValue);
-                if (status == AJ_OK) {
+                if (status == AJ_OK && !CdmIsReplyDeferred()) {
+                    CdmMarkValuePulled();
                     props->minValue = minValue;
                 }
             }
@@ -172,7 +196,8 @@ AJ_Status CurrentAirQualityInterfaceOnGetProperty(AJ_Message* replyMsg, const ch
             double precision;
             if (lt && lt->OnGetPrecision) {
                 status = lt->OnGetPrecision(objPath, &precision);
-                if (status == AJ_OK) {
+                if (status == AJ_OK && !CdmIsReplyDeferred()) {
+                    CdmMarkValuePulled();
                     props->precision = precision;
                 }
             }
@@ -184,7 +209,8 @@ AJ_Status CurrentAirQualityInterfaceOnGetProperty(AJ_Message* replyMsg, const ch
             uint16_t updateMinTime;
             if (lt && lt->OnGetUpdateMinTime) {
                 status = lt->OnGetUpdateMinTime(objPath, &updateMinTime);
-                if (status == AJ_OK) {
+                if (status == AJ_OK && !CdmIsReplyDeferred()) {
+                    CdmMarkValuePulled();
                     props->updateMinTime = updateMinTime;
                 }
             }
@@ -270,10 +296,12 @@ AJ_Status Cdm_CurrentAirQualityInterfaceSetCurrentValue(AJ_BusAttachment* busAtt
 
     props = (CurrentAirQualityProperties*)GetProperties(objPath, CURRENT_AIR_QUALITY_INTERFACE);
     if (props) {
+        CdmSensorHistoryRecord(objPath, CURRENT_AIR_QUALITY_INTERFACE, currentValue);
+
         if (props->currentValue != currentValue) {
             props->currentValue = currentValue;
 
-            status = EmitPropChanged(busAttachment, objPath, "CurrentValue", "d", &(props->currentValue));
+            status = CdmSignalTemplateEmit(busAttachment, objPath, &props->currentValueSignal, intfDescEnvironmentCurrentAirQuality[0]+1, "CurrentValue", "d", &(props->currentValue));
         }
     } else {
         status = AJ_ERR_NO_MATCH;
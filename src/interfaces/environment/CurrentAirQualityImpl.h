@@ -23,6 +23,8 @@ const char* const intfDescEnvironmentCurrentAirQuality[9];
 
 AJ_Status CreateCurrentAirQualityInterface(void** properties);
 void DestroyCurrentAirQualityInterface(void* properties);
+AJ_Status CurrentAirQualityInterfaceSaveProperties(void* properties, CdmSnapshotWriter* writer);
+AJ_Status CurrentAirQualityInterfaceLoadProperties(void* properties, CdmSnapshotReader* reader);
 AJ_Status CurrentAirQualityInterfaceOnGetProperty(AJ_Message* replyMsg, const char* objPath, void* properties, uint8_t memberIndex, void* listener);
 
 #endif // CURRENTAIRQUALITYIMPL_H_
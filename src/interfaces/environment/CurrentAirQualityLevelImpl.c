@@ -14,8 +14,11 @@
  *    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
  ******************************************************************************/
 
+#include <stddef.h>
 #include <ajtcl/cdm/interfaces/environment/CurrentAirQualityLevel.h>
 #include "../../CdmControllee/CdmControlleeImpl.h"
+#include "../CdmSignalTemplateImpl.h"
+#include "../CdmSensorHistoryImpl.h"
 #include "CurrentAirQualityLevelImpl.h"
 
 #define INTERFACE_VERSION 1
@@ -34,6 +37,7 @@ typedef struct {
     uint8_t contaminantType;
     uint8_t currentLevel;
     uint8_t maxLevel;
+    CdmSignalTemplate currentLevelSignal;
 } CurrentAirQualityLevelProperties;
 
 AJ_Status CreateCurrentAirQualityLevelInterface(void** properties)
@@ -54,14 +58,30 @@ void DestroyCurrentAirQualityLevelInterface(void* properties)
     if (properties) {
         CurrentAirQualityLevelProperties* props = (CurrentAirQualityLevelProperties*)properties;
 
+        CdmSignalTemplateClear(&props->currentLevelSignal);
         free(props);
     }
 }
 
+AJ_Status CurrentAirQualityLevelInterfaceSaveProperties(void* properties, CdmSnapshotWriter* writer)
+{
+    return CdmSnapshotWrite(writer, properties, offsetof(CurrentAirQualityLevelProperties, currentLevelSignal));
+}
+
+AJ_Status CurrentAirQualityLevelInterfaceLoadProperties(void* properties, CdmSnapshotReader* reader)
+{
+    if (reader->size != offsetof(CurrentAirQualityLevelProperties, currentLevelSignal)) {
+        return AJ_ERR_INVALID;
+    }
+
+    return CdmSnapshotRead(reader, properties, offsetof(CurrentAirQualityLevelProperties, currentLevelSignal));
+}
+
 static AJ_Status EmitPropChanged(AJ_BusAttachment* busAttachment, const char* objPath, const char* propName, const char* signature, void* val)
 {
     AJ_Status status = AJ_OK;
     uint32_t msgId = 0;
+    CdmPropChangedTarget target = { 0, 0, 0 };
     AJ_Message msg;
     AJ_Arg array, strc;
 
@@ -70,8 +90,8 @@ static AJ_Status EmitPropChanged(AJ_BusAttachment* busAttachment, const char* ob
     }
 
     status = MakePropChangedId(objPath, &msgId);
-    if (status == AJ_OK) {
-        AJ_MarshalSignal(busAttachment, &msg, msgId, NULL, 0, AJ_FLAG_GLOBAL_BROADCAST, 0);
+    while (status == AJ_OK && CdmNextPropChangedTarget(msgId, &target)) {
+        AJ_MarshalSignal(busAttachment, &msg, msgId, NULL, target.sessionId, target.flags, 0);
         AJ_MarshalArgs(&msg, "s", intfDescEnvironmentCurrentAirQualityLevel[0]+1); //To remove '$'
         AJ_MarshalContainer(&msg, &array, AJ_ARG_ARRAY);
         AJ_MarshalContainer(&msg, &strc, AJ_ARG_DICT_ENTRY);
@@ -116,7 +136,8 @@ AJ_Status CurrentAirQualityLevelInterfaceOnGetProperty(AJ_Message* replyMsg, con
             uint8_t contaminantType;
             if (lt && lt->OnGetContaminantType) {
                 status = lt->OnGetContaminantType(objPath, &contaminantType);
-                if (status == AJ_OK) {
+                if (status == AJ_OK && !CdmIsReplyDeferred()) {
+                    CdmMarkValuePulled();
                     props->contaminantType = contaminantType;
                 }
             }
@@ -128,7 +149,8 @@ AJ_Status CurrentAirQualityLevelInterfaceOnGetProperty(AJ_Message* replyMsg, con
             uint8_t currentLevel;
             if (lt && lt->OnGetCurrentLevel) {
                 status = lt->OnGetCurrentLevel(objPath, &currentLevel);
-                if (status == AJ_OK) {
+                if (status == AJ_OK && !CdmIsReplyDeferred()) {
+                    CdmMarkValuePulled();
                     props->currentLevel = currentLevel;
                 }
             }
@@ -140,7 +162,8 @@ AJ_Status CurrentAirQualityLevelInterfaceOnGetProperty(AJ_Message* replyMsg, con
             uint8_t maxLevel;
             if (lt && lt->OnGetMaxLevel) {
                 status = lt->OnGetMaxLevel(objPath, &maxLevel);
-                if (status == AJ_OK) {
+                if (status == AJ_OK && !CdmIsReplyDeferred()) {
+                    CdmMarkValuePulled();
                     props->maxLevel = maxLevel;
                 }
             }
@@ -226,10 +249,12 @@ AJ_Status Cdm_CurrentAirQualityLevelInterfaceSetCurrentLevel(AJ_BusAttachment* b
 
     props = (CurrentAirQualityLevelProperties*)GetProperties(objPath, CURRENT_AIR_QUALITY_LEVEL_INTERFACE);
     if (props) {
+        CdmSensorHistoryRecord(objPath, CURRENT_AIR_QUALITY_LEVEL_INTERFACE, currentLevel);
+
         if (props->currentLevel != currentLevel) {
             props->currentLevel = currentLevel;
 
-            status = EmitPropChanged(busAttachment, objPath, "CurrentLevel", "y", &(props->currentLevel));
+            status = CdmSignalTemplateEmit(busAttachment, objPath, &props->currentLevelSignal, intfDescEnvironmentCurrentAirQualityLevel[0]+1, "CurrentLevel", "y", &(props->currentLevel));
         }
     } else {
         status = AJ_ERR_NO_MATCH;
@@ -23,6 +23,8 @@ const char* const intfDescEnvironmentCurrentAirQualityLevel[6];
 
 AJ_Status CreateCurrentAirQualityLevelInterface(void** properties);
 void DestroyCurrentAirQualityLevelInterface(void* properties);
+AJ_Status CurrentAirQualityLevelInterfaceSaveProperties(void* properties, CdmSnapshotWriter* writer);
+AJ_Status CurrentAirQualityLevelInterfaceLoadProperties(void* properties, CdmSnapshotReader* reader);
 AJ_Status CurrentAirQualityLevelInterfaceOnGetProperty(AJ_Message* replyMsg, const char* objPath, void* properties, uint8_t memberIndex, void* listener);
 
 #endif // CURRENTAIRQUALITYLEVELIMPL_H_
@@ -14,8 +14,11 @@
  *    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
  ******************************************************************************/
 
+#include <stddef.h>
 #include <ajtcl/cdm/interfaces/environment/CurrentHumidity.h>
 #include "../../CdmControllee/CdmControlleeImpl.h"
+#include "../CdmSignalTemplateImpl.h"
+#include "../CdmSensorHistoryImpl.h"
 #include "CurrentHumidityImpl.h"
 
 #define INTERFACE_VERSION 1
@@ -32,6 +35,7 @@ typedef struct {
     uint16_t version;
     uint8_t currentValue;
     uint8_t maxValue;
+    CdmSignalTemplate currentValueSignal;
 } CurrentHumidityProperties;
 
 AJ_Status CreateCurrentHumidityInterface(void** properties)
@@ -51,14 +55,30 @@ void DestroyCurrentHumidityInterface(void* properties)
     if (properties) {
         CurrentHumidityProperties* props = (CurrentHumidityProperties*)properties;
 
+        CdmSignalTemplateClear(&props->currentValueSignal);
         free(props);
     }
 }
 
+AJ_Status CurrentHumidityInterfaceSaveProperties(void* properties, CdmSnapshotWriter* writer)
+{
+    return CdmSnapshotWrite(writer, properties, offsetof(CurrentHumidityProperties, currentValueSignal));
+}
+
+AJ_Status CurrentHumidityInterfaceLoadProperties(void* properties, CdmSnapshotReader* reader)
+{
+    if (reader->size != offsetof(CurrentHumidityProperties, currentValueSignal)) {
+        return AJ_ERR_INVALID;
+    }
+
+    return CdmSnapshotRead(reader, properties, offsetof(CurrentHumidityProperties, currentValueSignal));
+}
+
 static AJ_Status EmitPropChanged(AJ_BusAttachment* busAttachment, const char* objPath, const char* propName, const char* signature, void* val)
 {
     AJ_Status status = AJ_OK;
     uint32_t msgId = 0;
+    CdmPropChangedTarget target = { 0, 0, 0 };
     AJ_Message msg;
     AJ_Arg array, strc;
 
@@ -67,8 +87,8 @@ static AJ_Status EmitPropChanged(AJ_BusAttachment* busAttachment, const char* ob
     }
 
     status = MakePropChangedId(objPath, &msgId);
-    if (status == AJ_OK) {
-        AJ_MarshalSignal(busAttachment, &msg, msgId, NULL, 0, AJ_FLAG_GLOBAL_BROADCAST, 0);
+    while (status == AJ_OK && CdmNextPropChangedTarget(msgId, &target)) {
+        AJ_MarshalSignal(busAttachment, &msg, msgId, NULL, target.sessionId, target.flags, 0);
         AJ_MarshalArgs(&msg, "s", intfDescEnvironmentCurrentHumidity[0]+1); //To remove '$'
         AJ_MarshalContainer(&msg, &array, AJ_ARG_ARRAY);
         AJ_MarshalContainer(&msg, &strc, AJ_ARG_DICT_ENTRY);
@@ -113,7 +133,8 @@ AJ_Status CurrentHumidityInterfaceOnGetProperty(AJ_Message* replyMsg, const char
             uint8_t currentValue;
             if (lt && lt->OnGetCurrentValue) {
                 status = lt->OnGetCurrentValue(objPath, &currentValue);
-                if (status == AJ_OK) {
+                if (status == AJ_OK && !CdmIsReplyDeferred()) {
+                    CdmMarkValuePulled();
                     props->currentValue = currentValue;
                 }
             }
@@ -125,7 +146,8 @@ AJ_Status CurrentHumidityInterfaceOnGetProperty(AJ_Message* replyMsg, const char
             uint8_t maxValue;
             if (lt && lt->OnGetMaxValue) {
                 status = lt->OnGetMaxValue(objPath, &maxValue);
-                if (status == AJ_OK) {
+                if (status == AJ_OK && !CdmIsReplyDeferred()) {
+                    CdmMarkValuePulled();
                     props->maxValue = maxValue;
                 }
             }
@@ -169,10 +191,12 @@ AJ_Status Cdm_CurrentHumidityInterfaceSetCurrentValue(AJ_BusAttachment* busAttac
 
     props = (CurrentHumidityProperties*)GetProperties(objPath, CURRENT_HUMIDITY_INTERFACE);
     if (props) {
+        CdmSensorHistoryRecord(objPath, CURRENT_HUMIDITY_INTERFACE, currentValue);
+
         if (props->currentValue != currentValue) {
             props->currentValue = currentValue;
 
-            status = EmitPropChanged(busAttachment, objPath, "CurrentValue", "y", &(props->currentValue));
+            status = CdmSignalTemplateEmit(busAttachment, objPath, &props->currentValueSignal, intfDescEnvironmentCurrentHumidity[0]+1, "CurrentValue", "y", &(props->currentValue));
         }
     } else {
         status = AJ_ERR_NO_MATCH;
@@ -23,6 +23,8 @@ const char* const intfDescEnvironmentCurrentHumidity[5];
 
 AJ_Status CreateCurrentHumidityInterface(void** properties);
 void DestroyCurrentHumidityInterface(void* properties);
+AJ_Status CurrentHumidityInterfaceSaveProperties(void* properties, CdmSnapshotWriter* writer);
+AJ_Status CurrentHumidityInterfaceLoadProperties(void* properties, CdmSnapshotReader* reader);
 AJ_Status CurrentHumidityInterfaceOnGetProperty(AJ_Message* replyMsg, const char* objPath, void* properties, uint8_t memberIndex, void* listener);
 
 #endif // CURRENTHUMIDITYIMPL_H_
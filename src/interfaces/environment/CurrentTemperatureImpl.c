@@ -14,8 +14,11 @@
  *    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
  ******************************************************************************/
 
+#include <stddef.h>
 #include <ajtcl/cdm/interfaces/environment/CurrentTemperature.h>
 #include "../../CdmControllee/CdmControlleeImpl.h"
+#include "../CdmSignalTemplateImpl.h"
+#include "../CdmSensorHistoryImpl.h"
 #include "CurrentTemperatureImpl.h"
 
 #define INTERFACE_VERSION 1
@@ -34,6 +37,7 @@ typedef struct {
     double currentValue;
     double precision;
     uint16_t updateMinTime;
+    CdmSignalTemplate currentValueSignal;
 } CurrentTemperatureProperties;
 
 AJ_Status CreateCurrentTemperatureInterface(void** properties)
@@ -53,14 +57,30 @@ void DestroyCurrentTemperatureInterface(void* properties)
     if (properties) {
         CurrentTemperatureProperties* props = (CurrentTemperatureProperties*)properties;
 
+        CdmSignalTemplateClear(&props->currentValueSignal);
         free(props);
     }
 }
 
+AJ_Status CurrentTemperatureInterfaceSaveProperties(void* properties, CdmSnapshotWriter* writer)
+{
+    return CdmSnapshotWrite(writer, properties, offsetof(CurrentTemperatureProperties, currentValueSignal));
+}
+
+AJ_Status CurrentTemperatureInterfaceLoadProperties(void* properties, CdmSnapshotReader* reader)
+{
+    if (reader->size != offsetof(CurrentTemperatureProperties, currentValueSignal)) {
+        return AJ_ERR_INVALID;
+    }
+
+    return CdmSnapshotRead(reader, properties, offsetof(CurrentTemperatureProperties, currentValueSignal));
+}
+
 static AJ_Status EmitPropChanged(AJ_BusAttachment* busAttachment, const char* objPath, const char* propName, const char* signature, void* val)
 {
     AJ_Status status = AJ_OK;
     uint32_t msgId = 0;
+    CdmPropChangedTarget target = { 0, 0, 0 };
     AJ_Message msg;
     AJ_Arg array, strc;
 
@@ -69,8 +89,8 @@ static AJ_Status EmitPropChanged(AJ_BusAttachment* busAttachment, const char* ob
     }
 
     status = MakePropChangedId(objPath, &msgId);
-    if (status == AJ_OK) {
-        AJ_MarshalSignal(busAttachment, &msg, msgId, NULL, 0, AJ_FLAG_GLOBAL_BROADCAST, 0);
+    while (status == AJ_OK && CdmNextPropChangedTarget(msgId, &target)) {
+        AJ_MarshalSignal(busAttachment, &msg, msgId, NULL, target.sessionId, target.flags, 0);
         AJ_MarshalArgs(&msg, "s", intfDescEnvironmentCurrentTemperature[0]+1); //To remove '$'
         AJ_MarshalContainer(&msg, &array, AJ_ARG_ARRAY);
         AJ_MarshalContainer(&msg, &strc, AJ_ARG_DICT_ENTRY);
@@ -115,7 +135,8 @@ AJ_Status CurrentTemperatureInterfaceOnGetProperty(AJ_Message* replyMsg, const c
             double currentValue;
             if (lt && lt->OnGetCurrentValue) {
                 status = lt->OnGetCurrentValue(objPath, &currentValue);
-                if (status == AJ_OK) {
+                if (status == AJ_OK && !CdmIsReplyDeferred()) {
+                    CdmMarkValuePulled();
                     props->currentValue = currentValue;
                 }
             }
@@ -127,7 +148,8 @@ AJ_Status CurrentTemperatureInterfaceOnGetProperty(AJ_Message* replyMsg, const c
             double precision;
             if (lt && lt->OnGetPrecision) {
                 status = lt->OnGetPrecision(objPath, &precision);
-                if (status == AJ_OK) {
+                if (status == AJ_OK && !CdmIsReplyDeferred()) {
+                    CdmMarkValuePulled();
                     props->precision = precision;
                 }
             }
@@ -139,7 +161,8 @@ AJ_Status CurrentTemperatureInterfaceOnGetProperty(AJ_Message* replyMsg, const c
             uint16_t updateMinTime;
             if (lt && lt->OnGetUpdateMinTime) {
                 status = lt->OnGetUpdateMinTime(objPath, &updateMinTime);
-                if (status == AJ_OK) {
+                if (status == AJ_OK && !CdmIsReplyDeferred()) {
+                    CdmMarkValuePulled();
                     props->updateMinTime = updateMinTime;
                 }
             }
@@ -183,10 +206,12 @@ AJ_Status Cdm_CurrentTemperatureInterfaceSetCurrentValue(AJ_BusAttachment* busAt
 
     props = (CurrentTemperatureProperties*)GetProperties(objPath, CURRENT_TEMPERATURE_INTERFACE);
     if (props) {
+        CdmSensorHistoryRecord(objPath, CURRENT_TEMPERATURE_INTERFACE, currentValue);
+
         if (props->currentValue != currentValue) {
             props->currentValue = currentValue;
 
-            status = EmitPropChanged(busAttachment, objPath, "CurrentValue", "d", &(props->currentValue));
+            status = CdmSignalTemplateEmit(busAttachment, objPath, &props->currentValueSignal, intfDescEnvironmentCurrentTemperature[0]+1, "CurrentValue", "d", &(props->currentValue));
         }
     } else {
         status = AJ_ERR_NO_MATCH;
@@ -23,6 +23,8 @@ const char* const intfDescEnvironmentCurrentTemperature[6];
 
 AJ_Status CreateCurrentTemperatureInterface(void** properties);
 void DestroyCurrentTemperatureInterface(void* properties);
+AJ_Status CurrentTemperatureInterfaceSaveProperties(void* properties, CdmSnapshotWriter* writer);
+AJ_Status CurrentTemperatureInterfaceLoadProperties(void* properties, CdmSnapshotReader* reader);
 AJ_Status CurrentTemperatureInterfaceOnGetProperty(AJ_Message* replyMsg, const char* objPath, void* properties, uint8_t memberIndex, void* listener);
 
 #endif // CURRENTTEMPERATUREIMPL_H_
@@ -14,9 +14,9 @@
  *    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
  ******************************************************************************/
 
-#include <math.h>
 #include <ajtcl/cdm/interfaces/environment/TargetHumidity.h>
 #include "../../CdmControllee/CdmControlleeImpl.h"
+#include "../CdmConstraintImpl.h"
 #include "TargetHumidityImpl.h"
 
 #define INTERFACE_VERSION 1
@@ -39,61 +39,19 @@ typedef struct {
     uint8_t maxValue;
     uint8_t stepValue;
     uint8_t* selectableHumidityLevels;
+    CdmValueSet selectableHumidityLevelsSet;
+    CdmConstraintPolicy constraintPolicy;
 } TargetHumidityProperties;
 static size_t selectableHumidityLevelsSize = 0;
 
-AJ_Status TargetHumidityTargetValueValidationCheck(const char* objPath, uint8_t targetValue)
+static void GetTargetValueConstraint(const TargetHumidityProperties* props, CdmConstraint* constraint)
 {
-    AJ_Status status = AJ_OK;
-    TargetHumidityProperties* props = NULL;
-
-    props = (TargetHumidityProperties*)GetProperties(objPath, TARGET_HUMIDITY_INTERFACE);
-    if (props) {
-        if (props->maxValue != props->minValue) {
-            if (targetValue < props->minValue || targetValue > props->maxValue) {
-                status = AJ_ERR_RANGE;
-            } else if (props->stepValue != 0 && (targetValue - props->minValue)%props->stepValue != 0) {
-                status = AJ_ERR_INVALID;
-            }
-        } else {
-            int i;
-            for (i = 0; i < selectableHumidityLevelsSize; ++i) {
-                if (props->selectableHumidityLevels[i] == targetValue)
-                    return AJ_OK;
-            }
-            status = AJ_ERR_NO_MATCH;
-        }
+    if (props->maxValue != props->minValue) {
+        CdmConstraintInit(constraint, props->minValue, props->maxValue, props->stepValue);
     } else {
-        status = AJ_ERR_NO_MATCH;
+        CdmConstraintInit(constraint, 0, UINT8_MAX, 0);
+        constraint->selectable = &props->selectableHumidityLevelsSet;
     }
-
-    return status;
-}
-
-AJ_Status TargetHumidityAdjustTargetValue(const char* objPath, uint8_t* targetValue)
-{
-    AJ_Status status = AJ_OK;
-    TargetHumidityProperties* props = NULL;
-
-    props = (TargetHumidityProperties*)GetProperties(objPath, TARGET_HUMIDITY_INTERFACE);
-    if (props) {
-        if (props->maxValue != props->minValue) {
-            if (props->stepValue == 0) {
-                return status;
-            } else {
-                uint8_t div = *targetValue / props->stepValue;
-                uint8_t value = div * props->stepValue;
-
-                *targetValue = (value < props->minValue) ? props->minValue : (value > props->maxValue ? props->maxValue : value);
-            }
-        } else {
-            return status;
-        }
-    } else {
-        status = AJ_ERR_NO_MATCH;
-    }
-
-    return status;
 }
 
 AJ_Status CreateTargetHumidityInterface(void** properties)
@@ -105,6 +63,7 @@ AJ_Status CreateTargetHumidityInterface(void** properties)
     memset(*properties, 0, sizeof(TargetHumidityProperties));
 
     ((TargetHumidityProperties*)*properties)->version = (uint16_t)INTERFACE_VERSION;
+    ((TargetHumidityProperties*)*properties)->constraintPolicy = CDM_CONSTRAINT_POLICY_SNAP;
 
     return AJ_OK;
 }
@@ -112,15 +71,89 @@ void DestroyTargetHumidityInterface(void* properties)
 {
     if (properties) {
         TargetHumidityProperties* props = (TargetHumidityProperties*)properties;
+        if (props->selectableHumidityLevels) {
+            free(props->selectableHumidityLevels);
+        }
 
         free(props);
     }
 }
 
+AJ_Status TargetHumidityInterfaceSaveProperties(void* properties, CdmSnapshotWriter* writer)
+{
+    AJ_Status status = AJ_OK;
+    TargetHumidityProperties* props = (TargetHumidityProperties*)properties;
+
+    status = CdmSnapshotWrite(writer, &props->targetValue, sizeof(props->targetValue));
+    if (status == AJ_OK) {
+        status = CdmSnapshotWrite(writer, &props->minValue, sizeof(props->minValue));
+    }
+    if (status == AJ_OK) {
+        status = CdmSnapshotWrite(writer, &props->maxValue, sizeof(props->maxValue));
+    }
+    if (status == AJ_OK) {
+        status = CdmSnapshotWrite(writer, &props->stepValue, sizeof(props->stepValue));
+    }
+    if (status == AJ_OK) {
+        status = CdmSnapshotWriteArray(writer, props->selectableHumidityLevels, sizeof(uint8_t), selectableHumidityLevelsSize);
+    }
+
+    return status;
+}
+
+AJ_Status TargetHumidityInterfaceLoadProperties(void* properties, CdmSnapshotReader* reader)
+{
+    AJ_Status status = AJ_OK;
+    TargetHumidityProperties* props = (TargetHumidityProperties*)properties;
+    uint8_t targetValue = 0;
+    uint8_t minValue = 0;
+    uint8_t maxValue = 0;
+    uint8_t stepValue = 0;
+    uint8_t* selectableHumidityLevels = NULL;
+    size_t selectableHumidityLevelsListSize = 0;
+
+    status = CdmSnapshotRead(reader, &targetValue, sizeof(targetValue));
+    if (status == AJ_OK) {
+        status = CdmSnapshotRead(reader, &minValue, sizeof(minValue));
+    }
+    if (status == AJ_OK) {
+        status = CdmSnapshotRead(reader, &maxValue, sizeof(maxValue));
+    }
+    if (status == AJ_OK) {
+        status = CdmSnapshotRead(reader, &stepValue, sizeof(stepValue));
+    }
+    if (status == AJ_OK) {
+        status = CdmSnapshotReadArray(reader, (void**)&selectableHumidityLevels, sizeof(uint8_t), &selectableHumidityLevelsListSize);
+    }
+    if (status != AJ_OK) {
+        free(selectableHumidityLevels);
+        return status;
+    }
+
+    props->targetValue = targetValue;
+    props->minValue = minValue;
+    props->maxValue = maxValue;
+    props->stepValue = stepValue;
+    if (props->selectableHumidityLevels) {
+        free(props->selectableHumidityLevels);
+    }
+    props->selectableHumidityLevels = selectableHumidityLevels;
+    selectableHumidityLevelsSize = selectableHumidityLevelsListSize;
+    CdmValueSetBuild(&props->selectableHumidityLevelsSet, props->selectableHumidityLevels, selectableHumidityLevelsSize);
+
+    return AJ_OK;
+}
+
+void TargetHumidityInterfaceSetConstraintPolicy(void* properties, CdmConstraintPolicy policy)
+{
+    ((TargetHumidityProperties*)properties)->constraintPolicy = policy;
+}
+
 static AJ_Status EmitPropChanged(AJ_BusAttachment* busAttachment, const char* objPath, const char* propName, const char* signature, void* val)
 {
     AJ_Status status = AJ_OK;
     uint32_t msgId = 0;
+    CdmPropChangedTarget target = { 0, 0, 0 };
     AJ_Message msg;
     AJ_Arg array, strc;
 
@@ -129,8 +162,8 @@ static AJ_Status EmitPropChanged(AJ_BusAttachment* busAttachment, const char* ob
     }
 
     status = MakePropChangedId(objPath, &msgId);
-    if (status == AJ_OK) {
-        AJ_MarshalSignal(busAttachment, &msg, msgId, NULL, 0, AJ_FLAG_GLOBAL_BROADCAST, 0);
+    while (status == AJ_OK && CdmNextPropChangedTarget(msgId, &target)) {
+        AJ_MarshalSignal(busAttachment, &msg, msgId, NULL, target.sessionId, target.flags, 0);
         AJ_MarshalArgs(&msg, "s", intfDescEnvironmentTargetHumidity[0]+1); //To remove '$'
         AJ_MarshalContainer(&msg, &array, AJ_ARG_ARRAY);
         AJ_MarshalContainer(&msg, &strc, AJ_ARG_DICT_ENTRY);
@@ -199,7 +232,8 @@ AJ_Status TargetHumidityInterfaceOnGetProperty(AJ_Message* replyMsg, const char*
             uint8_t targetValue;
             if (lt && lt->OnGetTargetValue) {
                 status = lt->OnGetTargetValue(objPath, &targetValue);
-                if (status == AJ_OK) {
+                if (status == AJ_OK && !CdmIsReplyDeferred()) {
+                    CdmMarkValuePulled();
                     props->targetValue = targetValue;
                 }
             }
@@ -211,7 +245,8 @@ AJ_Status TargetHumidityInterfaceOnGetProperty(AJ_Message* replyMsg, const char*
             uint8_t minValue;
             if (lt && lt->OnGetMinValue) {
                 status = lt->OnGetMinValue(objPath, &minValue);
-                if (status == AJ_OK) {
+                if (status == AJ_OK && !CdmIsReplyDeferred()) {
+                    CdmMarkValuePulled();
                     props->minValue = minValue;
                 }
             }
@@ -223,7 +258,8 @@ AJ_Status TargetHumidityInterfaceOnGetProperty(AJ_Message* replyMsg, const char*
             uint8_t maxValue;
             if (lt && lt->OnGetMaxValue) {
                 status = lt->OnGetMaxValue(objPath, &maxValue);
-                if (status == AJ_OK) {
+                if (status == AJ_OK && !CdmIsReplyDeferred()) {
+                    CdmMarkValuePulled();
                     props->maxValue = maxValue;
                 }
             }
@@ -235,7 +271,8 @@ AJ_Status TargetHumidityInterfaceOnGetProperty(AJ_Message* replyMsg, const char*
             uint8_t stepValue;
             if (lt && lt->OnGetStepValue) {
                 status = lt->OnGetStepValue(objPath, &stepValue);
-                if (status == AJ_OK) {
+                if (status == AJ_OK && !CdmIsReplyDeferred()) {
+                    CdmMarkValuePulled();
                     props->stepValue = stepValue;
                 }
             }
@@ -247,13 +284,15 @@ AJ_Status TargetHumidityInterfaceOnGetProperty(AJ_Message* replyMsg, const char*
             uint8_t* selectableHumidityLevels = (uint8_t*)malloc(sizeof(uint8_t) * selectableHumidityLevelsSize);
             if (lt && lt->OnGetSelectableHumidityLevels) {
                 status = lt->OnGetSelectableHumidityLevels(objPath, selectableHumidityLevels);
-                if (status == AJ_OK) {
+                if (status == AJ_OK && !CdmIsReplyDeferred()) {
+                    CdmMarkValuePulled();
                     if (props->selectableHumidityLevels) {
                         free(props->selectableHumidityLevels);
                     }
                     props->selectableHumidityLevels = (uint8_t*)malloc(sizeof(uint8_t) * selectableHumidityLevelsSize);
 
                     memcpy(props->selectableHumidityLevels, selectableHumidityLevels, sizeof(uint8_t) * selectableHumidityLevelsSize);
+                    CdmValueSetBuild(&props->selectableHumidityLevelsSet, props->selectableHumidityLevels, selectableHumidityLevelsSize);
                 }
             }
             if (!props->selectableHumidityLevels) {
@@ -299,11 +338,15 @@ AJ_Status TargetHumidityInterfaceOnSetProperty(AJ_Message* replyMsg, const char*
             status = AJ_UnmarshalArgs(replyMsg, "y", &targetValue);
 
             if (status == AJ_OK) {
-                TargetHumidityAdjustTargetValue(objPath, &targetValue);
-                status = TargetHumidityTargetValueValidationCheck(objPath, targetValue);
+                CdmConstraint constraint;
+                double value = targetValue;
+
+                GetTargetValueConstraint(props, &constraint);
+                status = CdmConstraintApply(&constraint, props->constraintPolicy, &value);
                 if (status != AJ_OK) {
                     return status;
                 }
+                targetValue = (uint8_t)value;
 
                 status = lt->OnSetTargetValue(objPath, targetValue);
 
@@ -358,13 +401,16 @@ AJ_Status Cdm_TargetHumidityInterfaceSetTargetValue(AJ_BusAttachment* busAttachm
         return AJ_ERR_INVALID;
     }
 
-    status = TargetHumidityTargetValueValidationCheck(objPath, targetValue);
-    if (status != AJ_OK) {
-        return status;
-    }
-
     props = (TargetHumidityProperties*)GetProperties(objPath, TARGET_HUMIDITY_INTERFACE);
     if (props) {
+        CdmConstraint constraint;
+
+        GetTargetValueConstraint(props, &constraint);
+        status = CdmConstraintCheck(&constraint, targetValue);
+        if (status != AJ_OK) {
+            return status;
+        }
+
         if (props->targetValue != targetValue) {
             props->targetValue = targetValue;
 
@@ -544,6 +590,7 @@ AJ_Status Cdm_TargetHumidityInterfaceSetSelectableHumidityLevels(AJ_BusAttachmen
         props->selectableHumidityLevels = (uint8_t*)malloc(sizeof(uint8_t) * humidityLevelsSize);
 
         memcpy(props->selectableHumidityLevels, humidityLevels, sizeof(uint8_t) * humidityLevelsSize);
+        CdmValueSetBuild(&props->selectableHumidityLevelsSet, props->selectableHumidityLevels, selectableHumidityLevelsSize);
 
         status = EmitPropChanged(busAttachment, objPath, "SelectableHumidityLevels", "ay", props->selectableHumidityLevels);
     } else {
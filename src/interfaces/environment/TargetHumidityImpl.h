@@ -23,6 +23,9 @@ const char* const intfDescEnvironmentTargetHumidity[8];
 
 AJ_Status CreateTargetHumidityInterface(void** properties);
 void DestroyTargetHumidityInterface(void* properties);
+AJ_Status TargetHumidityInterfaceSaveProperties(void* properties, CdmSnapshotWriter* writer);
+AJ_Status TargetHumidityInterfaceLoadProperties(void* properties, CdmSnapshotReader* reader);
+void TargetHumidityInterfaceSetConstraintPolicy(void* properties, CdmConstraintPolicy policy);
 AJ_Status TargetHumidityInterfaceOnGetProperty(AJ_Message* replyMsg, const char* objPath, void* properties, uint8_t memberIndex, void* listener);
 AJ_Status TargetHumidityInterfaceOnSetProperty(AJ_Message* replyMsg, const char* objPath, void* properties, uint8_t memberIndex, void* listener, bool* propChanged);
 AJ_Status TargetHumidityInterfaceEmitPropertiesChanged(AJ_BusAttachment* busAttachment, const char* objPath, void* properties, uint8_t memberIndex);
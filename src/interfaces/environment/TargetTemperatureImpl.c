@@ -14,9 +14,10 @@
  *    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
  ******************************************************************************/
 
-#include <math.h>
+#include <stddef.h>
 #include <ajtcl/cdm/interfaces/environment/TargetTemperature.h>
 #include "../../CdmControllee/CdmControlleeImpl.h"
+#include "../CdmConstraintImpl.h"
 #include "TargetTemperatureImpl.h"
 
 #define INTERFACE_VERSION 1
@@ -37,47 +38,12 @@ typedef struct {
     double minValue;
     double maxValue;
     double stepValue;
+    CdmConstraintPolicy constraintPolicy;
 } TargetTemperatureProperties;
 
-AJ_Status TargetTemperatureTargetValueValidationCheck(const char* objPath, double targetValue)
+static void GetTargetValueConstraint(const TargetTemperatureProperties* props, CdmConstraint* constraint)
 {
-    AJ_Status status = AJ_OK;
-    TargetTemperatureProperties* props = NULL;
-
-    props = (TargetTemperatureProperties*)GetProperties(objPath, TARGET_TEMPERATURE_INTERFACE);
-    if (props) {
-        if (targetValue < props->minValue || targetValue > props->maxValue) {
-            status = AJ_ERR_RANGE;
-        } else if (props->stepValue != 0 && fmod(targetValue - props->minValue, props->stepValue) != 0.0) {
-            status = AJ_ERR_INVALID;
-        }
-    } else {
-        status = AJ_ERR_NO_MATCH;
-    }
-
-    return status;
-}
-
-AJ_Status TargetTemperatureAdjustTargetValue(const char* objPath, double* targetValue)
-{
-    AJ_Status status = AJ_OK;
-    TargetTemperatureProperties* props = NULL;
-
-    props = (TargetTemperatureProperties*)GetProperties(objPath, TARGET_TEMPERATURE_INTERFACE);
-    if (props) {
-        if (props->stepValue == 0.0) {
-            return status;
-        } else {
-            double div = *targetValue / props->stepValue;
-            double value = floor(div + 0.5) * props->stepValue;
-
-            *targetValue = (value < props->minValue) ? props->minValue : (value > props->maxValue ? props->maxValue : value);
-        }
-    } else {
-        status = AJ_ERR_NO_MATCH;
-    }
-
-    return status;
+    CdmConstraintInit(constraint, props->minValue, props->maxValue, props->stepValue);
 }
 
 AJ_Status CreateTargetTemperatureInterface(void** properties)
@@ -89,6 +55,7 @@ AJ_Status CreateTargetTemperatureInterface(void** properties)
     memset(*properties, 0, sizeof(TargetTemperatureProperties));
 
     ((TargetTemperatureProperties*)*properties)->version = (uint16_t)INTERFACE_VERSION;
+    ((TargetTemperatureProperties*)*properties)->constraintPolicy = CDM_CONSTRAINT_POLICY_SNAP;
 
     return AJ_OK;
 }
@@ -101,10 +68,30 @@ void DestroyTargetTemperatureInterface(void* properties)
     }
 }
 
+AJ_Status TargetTemperatureInterfaceSaveProperties(void* properties, CdmSnapshotWriter* writer)
+{
+    return CdmSnapshotWrite(writer, properties, offsetof(TargetTemperatureProperties, constraintPolicy));
+}
+
+AJ_Status TargetTemperatureInterfaceLoadProperties(void* properties, CdmSnapshotReader* reader)
+{
+    if (reader->size != offsetof(TargetTemperatureProperties, constraintPolicy)) {
+        return AJ_ERR_INVALID;
+    }
+
+    return CdmSnapshotRead(reader, properties, offsetof(TargetTemperatureProperties, constraintPolicy));
+}
+
+void TargetTemperatureInterfaceSetConstraintPolicy(void* properties, CdmConstraintPolicy policy)
+{
+    ((TargetTemperatureProperties*)properties)->constraintPolicy = policy;
+}
+
 static AJ_Status EmitPropChanged(AJ_BusAttachment* busAttachment, const char* objPath, const char* propName, const char* signature, void* val)
 {
     AJ_Status status = AJ_OK;
     uint32_t msgId = 0;
+    CdmPropChangedTarget target = { 0, 0, 0 };
     AJ_Message msg;
     AJ_Arg array, strc;
 
@@ -113,8 +100,8 @@ static AJ_Status EmitPropChanged(AJ_BusAttachment* busAttachment, const char* ob
     }
 
     status = MakePropChangedId(objPath, &msgId);
-    if (status == AJ_OK) {
-        AJ_MarshalSignal(busAttachment, &msg, msgId, NULL, 0, AJ_FLAG_GLOBAL_BROADCAST, 0);
+    while (status == AJ_OK && CdmNextPropChangedTarget(msgId, &target)) {
+        AJ_MarshalSignal(busAttachment, &msg, msgId, NULL, target.sessionId, target.flags, 0);
         AJ_MarshalArgs(&msg, "s", intfDescEnvironmentTargetTemperature[0]+1); //To remove '$'
         AJ_MarshalContainer(&msg, &array, AJ_ARG_ARRAY);
         AJ_MarshalContainer(&msg, &strc, AJ_ARG_DICT_ENTRY);
@@ -179,7 +166,8 @@ AJ_Status TargetTemperatureInterfaceOnGetProperty(AJ_Message* replyMsg, const ch
             double targetValue;
             if (lt && lt->OnGetTargetValue) {
                 status = lt->OnGetTargetValue(objPath, &targetValue);
-                if (status == AJ_OK) {
+                if (status == AJ_OK && !CdmIsReplyDeferred()) {
+                    CdmMarkValuePulled();
                     props->targetValue = targetValue;
                 }
             }
@@ -191,7 +179,8 @@ AJ_Status TargetTemperatureInterfaceOnGetProperty(AJ_Message* replyMsg, const ch
             double minValue;
             if (lt && lt->OnGetMinValue) {
                 status = lt->OnGetMinValue(objPath, &minValue);
-                if (status == AJ_OK) {
+                if (status == AJ_OK && !CdmIsReplyDeferred()) {
+                    CdmMarkValuePulled();
                     props->minValue = minValue;
                 }
             }
@@ -203,7 +192,8 @@ AJ_Status TargetTemperatureInterfaceOnGetProperty(AJ_Message* replyMsg, const ch
             double maxValue;
             if (lt && lt->OnGetMaxValue) {
                 status = lt->OnGetMaxValue(objPath, &maxValue);
-                if (status == AJ_OK) {
+                if (status == AJ_OK && !CdmIsReplyDeferred()) {
+                    CdmMarkValuePulled();
                     props->maxValue = maxValue;
                 }
             }
@@ -215,7 +205,8 @@ AJ_Status TargetTemperatureInterfaceOnGetProperty(AJ_Message* replyMsg, const ch
             double stepValue;
             if (lt && lt->OnGetStepValue) {
                 status = lt->OnGetStepValue(objPath, &stepValue);
-                if (status == AJ_OK) {
+                if (status == AJ_OK && !CdmIsReplyDeferred()) {
+                    CdmMarkValuePulled();
                     props->stepValue = stepValue;
                 }
             }
@@ -256,9 +247,12 @@ AJ_Status TargetTemperatureInterfaceOnSetProperty(AJ_Message* replyMsg, const ch
             status = AJ_UnmarshalArgs(replyMsg, "d", &targetValue);
 
             if (status == AJ_OK) {
-                status = TargetTemperatureAdjustTargetValue(objPath, &targetValue);
+                CdmConstraint constraint;
+
+                GetTargetValueConstraint(props, &constraint);
+                status = CdmConstraintApply(&constraint, props->constraintPolicy, &targetValue);
                 if (status != AJ_OK) {
-                    return AJ_OK;
+                    return status;
                 }
 
                 status = lt->OnSetTargetValue(objPath, targetValue);
@@ -310,13 +304,16 @@ AJ_Status Cdm_TargetTemperatureInterfaceSetTargetValue(AJ_BusAttachment* busAtta
         return AJ_ERR_INVALID;
     }
 
-    status = TargetTemperatureTargetValueValidationCheck(objPath, targetValue);
-    if (status != AJ_OK) {
-        return status;
-    }
-
     props = (TargetTemperatureProperties*)GetProperties(objPath, TARGET_TEMPERATURE_INTERFACE);
     if (props) {
+        CdmConstraint constraint;
+
+        GetTargetValueConstraint(props, &constraint);
+        status = CdmConstraintCheck(&constraint, targetValue);
+        if (status != AJ_OK) {
+            return status;
+        }
+
         if (props->targetValue != targetValue) {
             props->targetValue = targetValue;
 
@@ -23,6 +23,9 @@ const char* const intfDescEnvironmentTargetTemperature[7];
 
 AJ_Status CreateTargetTemperatureInterface(void** properties);
 void DestroyTargetTemperatureInterface(void* properties);
+AJ_Status TargetTemperatureInterfaceSaveProperties(void* properties, CdmSnapshotWriter* writer);
+AJ_Status TargetTemperatureInterfaceLoadProperties(void* properties, CdmSnapshotReader* reader);
+void TargetTemperatureInterfaceSetConstraintPolicy(void* properties, CdmConstraintPolicy policy);
 AJ_Status TargetTemperatureInterfaceOnGetProperty(AJ_Message* replyMsg, const char* objPath, void* properties, uint8_t memberIndex, void* listener);
 AJ_Status TargetTemperatureInterfaceOnSetProperty(AJ_Message* replyMsg, const char* objPath, void* properties, uint8_t memberIndex, void* listener, bool* propChanged);
 AJ_Status TargetTemperatureInterfaceEmitPropertiesChanged(AJ_BusAttachment* busAttachment, const char* objPath, void* properties, uint8_t memberIndex);
@@ -14,9 +14,9 @@
  *    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
  ******************************************************************************/
 
-#include <math.h>
 #include <ajtcl/cdm/interfaces/environment/TargetTemperatureLevel.h>
 #include "../../CdmControllee/CdmControlleeImpl.h"
+#include "../CdmConstraintImpl.h"
 #include "TargetTemperatureLevelImpl.h"
 
 #define INTERFACE_VERSION 1
@@ -35,48 +35,15 @@ typedef struct {
     uint8_t targetLevel;
     uint8_t maxLevel;
     uint8_t* selectableTemperatureLevels;
+    CdmValueSet selectableTemperatureLevelsSet;
+    CdmConstraintPolicy constraintPolicy;
 } TargetTemperatureLevelProperties;
 static size_t selectableTemperatureLevelsSize = 0;
 
-AJ_Status TargetTemperatureLevelTargetLevelValidationCheck(const char* objPath, uint8_t targetLevel)
+static void GetTargetLevelConstraint(const TargetTemperatureLevelProperties* props, CdmConstraint* constraint)
 {
-    AJ_Status status = AJ_OK;
-    int i;
-    TargetTemperatureLevelProperties* props = NULL;
-
-    props = (TargetTemperatureLevelProperties*)GetProperties(objPath, TARGET_TEMPERATURE_LEVEL_INTERFACE);
-    if (props) {
-        if (targetLevel > props->maxLevel) {
-            status = AJ_ERR_RANGE;
-        } else {
-            status = AJ_ERR_DISALLOWED;
-            for (i = 0; i < selectableTemperatureLevelsSize; i++) {
-                if (props->selectableTemperatureLevels[i] == targetLevel) {
-                    status = AJ_OK;
-                    break;
-                }
-            }
-        }
-    } else {
-        status = AJ_ERR_NO_MATCH;
-    }
-
-    return status;
-}
-
-AJ_Status TargetTemperatureLevelAdjustTargetValue(const char* objPath, uint8_t* targetLevel)
-{
-    AJ_Status status = AJ_OK;
-    TargetTemperatureLevelProperties* props = NULL;
-
-    props = (TargetTemperatureLevelProperties*)GetProperties(objPath, TARGET_TEMPERATURE_LEVEL_INTERFACE);
-    if (props) {
-        *targetLevel = (*targetLevel > props->maxLevel ? props->maxLevel : *targetLevel);
-    } else {
-        status = AJ_ERR_NO_MATCH;
-    }
-
-    return status;
+    CdmConstraintInit(constraint, 0, props->maxLevel, 0);
+    constraint->selectable = &props->selectableTemperatureLevelsSet;
 }
 
 AJ_Status CreateTargetTemperatureLevelInterface(void** properties)
@@ -88,6 +55,7 @@ AJ_Status CreateTargetTemperatureLevelInterface(void** properties)
     memset(*properties, 0, sizeof(TargetTemperatureLevelProperties));
 
     ((TargetTemperatureLevelProperties*)*properties)->version = (uint16_t)INTERFACE_VERSION;
+    ((TargetTemperatureLevelProperties*)*properties)->constraintPolicy = CDM_CONSTRAINT_POLICY_SNAP;
 
     return AJ_OK;
 }
@@ -95,15 +63,73 @@ void DestroyTargetTemperatureLevelInterface(void* properties)
 {
     if (properties) {
         TargetTemperatureLevelProperties* props = (TargetTemperatureLevelProperties*)properties;
+        if (props->selectableTemperatureLevels) {
+            free(props->selectableTemperatureLevels);
+        }
 
         free(props);
     }
 }
 
+AJ_Status TargetTemperatureLevelInterfaceSaveProperties(void* properties, CdmSnapshotWriter* writer)
+{
+    AJ_Status status = AJ_OK;
+    TargetTemperatureLevelProperties* props = (TargetTemperatureLevelProperties*)properties;
+
+    status = CdmSnapshotWrite(writer, &props->targetLevel, sizeof(props->targetLevel));
+    if (status == AJ_OK) {
+        status = CdmSnapshotWrite(writer, &props->maxLevel, sizeof(props->maxLevel));
+    }
+    if (status == AJ_OK) {
+        status = CdmSnapshotWriteArray(writer, props->selectableTemperatureLevels, sizeof(uint8_t), selectableTemperatureLevelsSize);
+    }
+
+    return status;
+}
+
+AJ_Status TargetTemperatureLevelInterfaceLoadProperties(void* properties, CdmSnapshotReader* reader)
+{
+    AJ_Status status = AJ_OK;
+    TargetTemperatureLevelProperties* props = (TargetTemperatureLevelProperties*)properties;
+    uint8_t targetLevel = 0;
+    uint8_t maxLevel = 0;
+    uint8_t* selectableTemperatureLevels = NULL;
+    size_t selectableTemperatureLevelsListSize = 0;
+
+    status = CdmSnapshotRead(reader, &targetLevel, sizeof(targetLevel));
+    if (status == AJ_OK) {
+        status = CdmSnapshotRead(reader, &maxLevel, sizeof(maxLevel));
+    }
+    if (status == AJ_OK) {
+        status = CdmSnapshotReadArray(reader, (void**)&selectableTemperatureLevels, sizeof(uint8_t), &selectableTemperatureLevelsListSize);
+    }
+    if (status != AJ_OK) {
+        free(selectableTemperatureLevels);
+        return status;
+    }
+
+    props->targetLevel = targetLevel;
+    props->maxLevel = maxLevel;
+    if (props->selectableTemperatureLevels) {
+        free(props->selectableTemperatureLevels);
+    }
+    props->selectableTemperatureLevels = selectableTemperatureLevels;
+    selectableTemperatureLevelsSize = selectableTemperatureLevelsListSize;
+    CdmValueSetBuild(&props->selectableTemperatureLevelsSet, props->selectableTemperatureLevels, selectableTemperatureLevelsSize);
+
+    return AJ_OK;
+}
+
+void TargetTemperatureLevelInterfaceSetConstraintPolicy(void* properties, CdmConstraintPolicy policy)
+{
+    ((TargetTemperatureLevelProperties*)properties)->constraintPolicy = policy;
+}
+
 static AJ_Status EmitPropChanged(AJ_BusAttachment* busAttachment, const char* objPath, const char* propName, const char* signature, void* val)
 {
     AJ_Status status = AJ_OK;
     uint32_t msgId = 0;
+    CdmPropChangedTarget target = { 0, 0, 0 };
     AJ_Message msg;
     AJ_Arg array, strc;
 
@@ -112,8 +138,8 @@ static AJ_Status EmitPropChanged(AJ_BusAttachment* busAttachment, const char* ob
     }
 
     status = MakePropChangedId(objPath, &msgId);
-    if (status == AJ_OK) {
-        AJ_MarshalSignal(busAttachment, &msg, msgId, NULL, 0, AJ_FLAG_GLOBAL_BROADCAST, 0);
+    while (status == AJ_OK && CdmNextPropChangedTarget(msgId, &target)) {
+        AJ_MarshalSignal(busAttachment, &msg, msgId, NULL, target.sessionId, target.flags, 0);
         AJ_MarshalArgs(&msg, "s", intfDescEnvironmentTargetTemperatureLevel[0]+1); //To remove '$'
         AJ_MarshalContainer(&msg, &array, AJ_ARG_ARRAY);
         AJ_MarshalContainer(&msg, &strc, AJ_ARG_DICT_ENTRY);
@@ -182,7 +208,8 @@ AJ_Status TargetTemperatureLevelInterfaceOnGetProperty(AJ_Message* replyMsg, con
             uint8_t targetLevel;
             if (lt && lt->OnGetTargetLevel) {
                 status = lt->OnGetTargetLevel(objPath, &targetLevel);
-                if (status == AJ_OK) {
+                if (status == AJ_OK && !CdmIsReplyDeferred()) {
+                    CdmMarkValuePulled();
                     props->targetLevel = targetLevel;
                 }
             }
@@ -194,7 +221,8 @@ AJ_Status TargetTemperatureLevelInterfaceOnGetProperty(AJ_Message* replyMsg, con
             uint8_t maxLevel;
             if (lt && lt->OnGetMaxLevel) {
                 status = lt->OnGetMaxLevel(objPath, &maxLevel);
-                if (status == AJ_OK) {
+                if (status == AJ_OK && !CdmIsReplyDeferred()) {
+                    CdmMarkValuePulled();
                     props->maxLevel = maxLevel;
                 }
             }
@@ -206,13 +234,15 @@ AJ_Status TargetTemperatureLevelInterfaceOnGetProperty(AJ_Message* replyMsg, con
             uint8_t* selectableTemperatureLevels = (uint8_t*)malloc(sizeof(uint8_t) * selectableTemperatureLevelsSize);
             if (lt && lt->OnGetSelectableTemperatureLevels) {
                 status = lt->OnGetSelectableTemperatureLevels(objPath, selectableTemperatureLevels);
-                if (status == AJ_OK) {
+                if (status == AJ_OK && !CdmIsReplyDeferred()) {
+                    CdmMarkValuePulled();
                     if (props->selectableTemperatureLevels) {
                         free(props->selectableTemperatureLevels);
                     }
                     props->selectableTemperatureLevels = (uint8_t*)malloc(sizeof(uint8_t) * selectableTemperatureLevelsSize);
 
                     memcpy(props->selectableTemperatureLevels, selectableTemperatureLevels, sizeof(uint8_t) * selectableTemperatureLevelsSize);
+                    CdmValueSetBuild(&props->selectableTemperatureLevelsSet, props->selectableTemperatureLevels, selectableTemperatureLevelsSize);
                 }
             }
             if (!props->selectableTemperatureLevels) {
@@ -258,15 +288,15 @@ AJ_Status TargetTemperatureLevelInterfaceOnSetProperty(AJ_Message* replyMsg, con
             status = AJ_UnmarshalArgs(replyMsg, "y", &targetLevel);
 
             if (status == AJ_OK) {
-                status = TargetTemperatureLevelAdjustTargetValue(objPath, &targetLevel);
-                if (status != AJ_OK) {
-                    return status;
-                }
+                CdmConstraint constraint;
+                double value = targetLevel;
 
-                status = TargetTemperatureLevelTargetLevelValidationCheck(objPath, targetLevel);
+                GetTargetLevelConstraint(props, &constraint);
+                status = CdmConstraintApply(&constraint, props->constraintPolicy, &value);
                 if (status != AJ_OK) {
                     return status;
                 }
+                targetLevel = (uint8_t)value;
 
                 status = lt->OnSetTargetLevel(objPath, targetLevel);
 
@@ -318,13 +348,16 @@ AJ_Status Cdm_TargetTemperatureLevelInterfaceSetTargetLevel(AJ_BusAttachment* bu
         return AJ_ERR_INVALID;
     }
 
-    status = TargetTemperatureLevelTargetLevelValidationCheck(objPath, targetLevel);
-    if (status != AJ_OK) {
-        return status;
-    }
-
     props = (TargetTemperatureLevelProperties*)GetProperties(objPath, TARGET_TEMPERATURE_LEVEL_INTERFACE);
     if (props) {
+        CdmConstraint constraint;
+
+        GetTargetLevelConstraint(props, &constraint);
+        status = CdmConstraintCheck(&constraint, targetLevel);
+        if (status != AJ_OK) {
+            return status;
+        }
+
         if (props->targetLevel != targetLevel) {
             props->targetLevel = targetLevel;
 
@@ -420,6 +453,7 @@ AJ_Status Cdm_TargetTemperatureLevelInterfaceSetSelectableTemperatureLevels(AJ_B
         props->selectableTemperatureLevels = (uint8_t*)malloc(sizeof(uint8_t) * temperatureLevelsSize);
 
         memcpy(props->selectableTemperatureLevels, temperatureLevels, sizeof(uint8_t) * temperatureLevelsSize);
+        CdmValueSetBuild(&props->selectableTemperatureLevelsSet, props->selectableTemperatureLevels, selectableTemperatureLevelsSize);
 
         status = EmitPropChanged(busAttachment, objPath, "SelectableTemperatureLevels", "ay", props->selectableTemperatureLevels);
     } else {
@@ -23,6 +23,9 @@ const char* const intfDescEnvironmentTargetTemperatureLevel[6];
 
 AJ_Status CreateTargetTemperatureLevelInterface(void** properties);
 void DestroyTargetTemperatureLevelInterface(void* properties);
+AJ_Status TargetTemperatureLevelInterfaceSaveProperties(void* properties, CdmSnapshotWriter* writer);
+AJ_Status TargetTemperatureLevelInterfaceLoadProperties(void* properties, CdmSnapshotReader* reader);
+void TargetTemperatureLevelInterfaceSetConstraintPolicy(void* properties, CdmConstraintPolicy policy);
 AJ_Status TargetTemperatureLevelInterfaceOnGetProperty(AJ_Message* replyMsg, const char* objPath, void* properties, uint8_t memberIndex, void* listener);
 AJ_Status TargetTemperatureLevelInterfaceOnSetProperty(AJ_Message* replyMsg, const char* objPath, void* properties, uint8_t memberIndex, void* listener, bool* propChanged);
 AJ_Status TargetTemperatureLevelInterfaceEmitPropertiesChanged(AJ_BusAttachment* busAttachment, const char* objPath, void* properties, uint8_t memberIndex);
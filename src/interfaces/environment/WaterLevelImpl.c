@@ -14,9 +14,12 @@
  *    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
  ******************************************************************************/
 
+#include <stddef.h>
 #include <string.h>
 #include <ajtcl/cdm/interfaces/environment/WaterLevel.h>
 #include "../../CdmControllee/CdmControlleeImpl.h"
+#include "../CdmSignalTemplateImpl.h"
+#include "../CdmSensorHistoryImpl.h"
 #include "WaterLevelImpl.h"
 
 #define INTERFACE_VERSION 1
@@ -35,6 +38,7 @@ typedef struct {
     uint8_t supplySource;
     uint8_t currentLevel;
     uint8_t maxLevel;
+    CdmSignalTemplate currentLevelSignal;
 } WaterLevelProperties;
 
 AJ_Status CurrentLevelValidationCheck(const char* objPath, uint8_t currentLevel)
@@ -72,14 +76,31 @@ void DestroyWaterLevelInterface(void* properties)
 {
     if (properties) {
         WaterLevelProperties* props = (WaterLevelProperties*)properties;
+
+        CdmSignalTemplateClear(&props->currentLevelSignal);
         free(props);
     }
 }
 
+AJ_Status WaterLevelInterfaceSaveProperties(void* properties, CdmSnapshotWriter* writer)
+{
+    return CdmSnapshotWrite(writer, properties, offsetof(WaterLevelProperties, currentLevelSignal));
+}
+
+AJ_Status WaterLevelInterfaceLoadProperties(void* properties, CdmSnapshotReader* reader)
+{
+    if (reader->size != offsetof(WaterLevelProperties, currentLevelSignal)) {
+        return AJ_ERR_INVALID;
+    }
+
+    return CdmSnapshotRead(reader, properties, offsetof(WaterLevelProperties, currentLevelSignal));
+}
+
 static AJ_Status EmitPropChanged(AJ_BusAttachment* busAttachment, const char* objPath, const char* propName, const char* signature, void* val)
 {
     AJ_Status status = AJ_OK;
     uint32_t msgId = 0;
+    CdmPropChangedTarget target = { 0, 0, 0 };
     AJ_Message msg;
     AJ_Arg array, strc;
 
@@ -88,8 +109,8 @@ static AJ_Status EmitPropChanged(AJ_BusAttachment* busAttachment, const char* ob
     }
 
     status = MakePropChangedId(objPath, &msgId);
-    if (status == AJ_OK) {
-        AJ_MarshalSignal(busAttachment, &msg, msgId, NULL, 0, AJ_FLAG_GLOBAL_BROADCAST, 0);
+    while (status == AJ_OK && CdmNextPropChangedTarget(msgId, &target)) {
+        AJ_MarshalSignal(busAttachment, &msg, msgId, NULL, target.sessionId, target.flags, 0);
         AJ_MarshalArgs(&msg, "s", intfDescEnvironmentWaterLevel[0]+1); //To remove '$'
         AJ_MarshalContainer(&msg, &array, AJ_ARG_ARRAY);
         AJ_MarshalContainer(&msg, &strc, AJ_ARG_DICT_ENTRY);
@@ -132,7 +153,8 @@ AJ_Status WaterLevelInterfaceOnGetProperty(AJ_Message* replyMsg, const char* obj
             uint8_t supplySource;
             if (lt && lt->OnGetSupplySource) {
                 status = lt->OnGetSupplySource(objPath, &supplySource);
-                if (status == AJ_OK) {
+                if (status == AJ_OK && !CdmIsReplyDeferred()) {
+                    CdmMarkValuePulled();
                     props->supplySource = supplySource;
                 }
             }
@@ -144,7 +166,8 @@ AJ_Status WaterLevelInterfaceOnGetProperty(AJ_Message* replyMsg, const char* obj
             uint8_t currentLevel;
             if (lt && lt->OnGetCurrentLevel) {
                 status = lt->OnGetCurrentLevel(objPath, &currentLevel);
-                 if (status == AJ_OK) {
+                 if (status == AJ_OK && !CdmIsReplyDeferred()) {
+                     CdmMarkValuePulled();
                       props->currentLevel = currentLevel;
                  }
             }
@@ -156,7 +179,8 @@ AJ_Status WaterLevelInterfaceOnGetProperty(AJ_Message* replyMsg, const char* obj
             uint8_t maxLevel;
             if (lt && lt->OnGetMaxLevel) {
                 status = lt->OnGetMaxLevel(objPath, &maxLevel);
-                if (status == AJ_OK) {
+                if (status == AJ_OK && !CdmIsReplyDeferred()) {
+                    CdmMarkValuePulled();
                     props->maxLevel = maxLevel;
                 }
             }
@@ -247,10 +271,12 @@ AJ_Status Cdm_WaterLevelInterfaceSetCurrentLevel(AJ_BusAttachment* busAttachment
 
     props = (WaterLevelProperties*)GetProperties(objPath, WATER_LEVEL_INTERFACE);
     if (props) {
+        CdmSensorHistoryRecord(objPath, WATER_LEVEL_INTERFACE, currentLevel);
+
         if (props->currentLevel != currentLevel) {
             props->currentLevel = currentLevel;
 
-            status = EmitPropChanged(busAttachment, objPath, "CurrentLevel", "y", &(props->currentLevel));
+            status = CdmSignalTemplateEmit(busAttachment, objPath, &props->currentLevelSignal, intfDescEnvironmentWaterLevel[0]+1, "CurrentLevel", "y", &(props->currentLevel));
         }
     } else {
         status = AJ_ERR_NO_MATCH;
@@ -23,6 +23,8 @@ const char* const intfDescEnvironmentWaterLevel[6];
 
 AJ_Status CreateWaterLevelInterface(void** properties);
 void DestroyWaterLevelInterface(void* properties);
+AJ_Status WaterLevelInterfaceSaveProperties(void* properties, CdmSnapshotWriter* writer);
+AJ_Status WaterLevelInterfaceLoadProperties(void* properties, CdmSnapshotReader* reader);
 AJ_Status WaterLevelInterfaceOnGetProperty(AJ_Message* replyMsg, const char* objPath, void* properties, uint8_t memberIndex, void* listener);
 
 #endif /* WATERLEVELIMPL_H_ */
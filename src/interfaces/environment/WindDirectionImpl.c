@@ -14,8 +14,10 @@
  *    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
  ******************************************************************************/
 
+#include <stddef.h>
 #include <ajtcl/cdm/interfaces/environment/WindDirection.h>
 #include "../../CdmControllee/CdmControlleeImpl.h"
+#include "../CdmConstraintImpl.h"
 #include "WindDirectionImpl.h"
 
 #define INTERFACE_VERSION 1
@@ -44,112 +46,28 @@ typedef struct {
     uint16_t verticalDirection;
     uint16_t verticalMax;
     uint8_t verticalAutoMode;
+    CdmConstraintPolicy constraintPolicy;
 } WindDirectionProperties;
 
-AJ_Status WindDirectionAdjustHorizontalDirection(const char* objPath, uint16_t* horizontalDirection)
+static void GetHorizontalDirectionConstraint(const WindDirectionProperties* props, CdmConstraint* constraint)
 {
-    AJ_Status status = AJ_OK;
-    WindDirectionProperties* props = NULL;
-
-    props = (WindDirectionProperties*)GetProperties(objPath, WIND_DIRECTION_INTERFACE);
-    if (props) {
-        if (*horizontalDirection > props->horizontalMax) {
-            *horizontalDirection = props->horizontalMax;
-        }
-    } else {
-        status = AJ_ERR_NO_MATCH;
-    }
-
-    return status;
-}
-
-AJ_Status WindDirectionHorizontalDirectionValidationCheck(const char* objPath, uint16_t horizontalDirection)
-{
-    AJ_Status status = AJ_OK;
-    WindDirectionProperties* props = NULL;
-
-    props = (WindDirectionProperties*)GetProperties(objPath, WIND_DIRECTION_INTERFACE);
-    if (props) {
-        if (horizontalDirection < 0 || horizontalDirection > props->horizontalMax) {
-            status = AJ_ERR_RANGE;
-        }
-    } else {
-        status = AJ_ERR_NO_MATCH;
-    }
-
-    return status;
-}
-
-AJ_Status WindDirectionHorizontalAutoModeValidationCheck(const char* objPath, uint8_t horizontalAutoMode)
-{
-    AJ_Status status = AJ_OK;
-    WindDirectionProperties* props = NULL;
-
-    props = (WindDirectionProperties*)GetProperties(objPath, WIND_DIRECTION_INTERFACE);
-    if (props) {
-        if (props->horizontalAutoMode == AUTO_MODE_NOT_SUPPORTED) {
-            status = AJ_ERR_INVALID;
-        } else if (horizontalAutoMode != AUTO_MODE_OFF && horizontalAutoMode != AUTO_MODE_ON) {
-            status = AJ_ERR_INVALID;
-        }
-    } else {
-        status = AJ_ERR_NO_MATCH;
-    }
-
-    return status;
-}
-
-AJ_Status WindDirectionAdjustVerticalDirection(const char* objPath, uint16_t* verticalDirection)
-{
-    AJ_Status status = AJ_OK;
-    WindDirectionProperties* props = NULL;
-
-    props = (WindDirectionProperties*)GetProperties(objPath, WIND_DIRECTION_INTERFACE);
-    if (props) {
-        if (*verticalDirection > props->verticalMax) {
-            *verticalDirection = props->verticalMax;
-        }
-    } else {
-        status = AJ_ERR_NO_MATCH;
-    }
-
-    return status;
+    CdmConstraintInit(constraint, 0, props->horizontalMax, 0);
 }
 
-AJ_Status WindDirectionVerticalDirectionValidationCheck(const char* objPath, uint16_t verticalDirection)
+static void GetVerticalDirectionConstraint(const WindDirectionProperties* props, CdmConstraint* constraint)
 {
-    AJ_Status status = AJ_OK;
-    WindDirectionProperties* props = NULL;
-
-    props = (WindDirectionProperties*)GetProperties(objPath, WIND_DIRECTION_INTERFACE);
-    if (props) {
-        if (verticalDirection < 0 || verticalDirection > props->verticalMax) {
-            status = AJ_ERR_RANGE;
-        }
-    } else {
-        status = AJ_ERR_NO_MATCH;
-    }
-
-    return status;
+    CdmConstraintInit(constraint, 0, props->verticalMax, 0);
 }
 
-AJ_Status WindDirectionVerticalAutoModeValidationCheck(const char* objPath, uint8_t verticalAutoMode)
+static AJ_Status AutoModeValidationCheck(uint8_t currentAutoMode, uint8_t autoMode)
 {
-    AJ_Status status = AJ_OK;
-    WindDirectionProperties* props = NULL;
-
-    props = (WindDirectionProperties*)GetProperties(objPath, WIND_DIRECTION_INTERFACE);
-    if (props) {
-        if (props->verticalAutoMode == AUTO_MODE_NOT_SUPPORTED) {
-            status = AJ_ERR_INVALID;
-        } else if (verticalAutoMode != AUTO_MODE_OFF && verticalAutoMode != AUTO_MODE_ON) {
-            status = AJ_ERR_INVALID;
-        }
-    } else {
-        status = AJ_ERR_NO_MATCH;
+    if (currentAutoMode == AUTO_MODE_NOT_SUPPORTED) {
+        return AJ_ERR_INVALID;
+    } else if (autoMode != AUTO_MODE_OFF && autoMode != AUTO_MODE_ON) {
+        return AJ_ERR_INVALID;
     }
 
-    return status;
+    return AJ_OK;
 }
 
 AJ_Status CreateWindDirectionInterface(void** properties)
@@ -161,6 +79,7 @@ AJ_Status CreateWindDirectionInterface(void** properties)
     memset(*properties, 0, sizeof(WindDirectionProperties));
 
     ((WindDirectionProperties*)*properties)->version = (uint16_t)INTERFACE_VERSION;
+    ((WindDirectionProperties*)*properties)->constraintPolicy = CDM_CONSTRAINT_POLICY_SNAP;
 
     return AJ_OK;
 }
@@ -173,10 +92,30 @@ void DestroyWindDirectionInterface(void* properties)
     }
 }
 
+AJ_Status WindDirectionInterfaceSaveProperties(void* properties, CdmSnapshotWriter* writer)
+{
+    return CdmSnapshotWrite(writer, properties, offsetof(WindDirectionProperties, constraintPolicy));
+}
+
+AJ_Status WindDirectionInterfaceLoadProperties(void* properties, CdmSnapshotReader* reader)
+{
+    if (reader->size != offsetof(WindDirectionProperties, constraintPolicy)) {
+        return AJ_ERR_INVALID;
+    }
+
+    return CdmSnapshotRead(reader, properties, offsetof(WindDirectionProperties, constraintPolicy));
+}
+
+void WindDirectionInterfaceSetConstraintPolicy(void* properties, CdmConstraintPolicy policy)
+{
+    ((WindDirectionProperties*)properties)->constraintPolicy = policy;
+}
+
 static AJ_Status EmitPropChanged(AJ_BusAttachment* busAttachment, const char* objPath, const char* propName, const char* signature, void* val)
 {
     AJ_Status status = AJ_OK;
     uint32_t msgId = 0;
+    CdmPropChangedTarget target = { 0, 0, 0 };
     AJ_Message msg;
     AJ_Arg array, strc;
 
@@ -185,8 +124,8 @@ static AJ_Status EmitPropChanged(AJ_BusAttachment* busAttachment, const char* ob
     }
 
     status = MakePropChangedId(objPath, &msgId);
-    if (status == AJ_OK) {
-        AJ_MarshalSignal(busAttachment, &msg, msgId, NULL, 0, AJ_FLAG_GLOBAL_BROADCAST, 0);
+    while (status == AJ_OK && CdmNextPropChangedTarget(msgId, &target)) {
+        AJ_MarshalSignal(busAttachment, &msg, msgId, NULL, target.sessionId, target.flags, 0);
         AJ_MarshalArgs(&msg, "s", intfDescEnvironmentWindDirection[0]+1); //To remove '$'
         AJ_MarshalContainer(&msg, &array, AJ_ARG_ARRAY);
         AJ_MarshalContainer(&msg, &strc, AJ_ARG_DICT_ENTRY);
@@ -262,7 +201,8 @@ AJ_Status WindDirectionInterfaceOnGetProperty(AJ_Message* replyMsg, const char*
             uint16_t horizontalDirection;
             if (lt && lt->OnGetHorizontalDirection) {
                 status = lt->OnGetHorizontalDirection(objPath, &horizontalDirection);
-                if (status == AJ_OK) {
+                if (status == AJ_OK && !CdmIsReplyDeferred()) {
+                    CdmMarkValuePulled();
                     props->horizontalDirection = horizontalDirection;
                 }
             }
@@ -274,7 +214,8 @@ AJ_Status WindDirectionInterfaceOnGetProperty(AJ_Message* replyMsg, const char*
             uint16_t horizontalMax;
             if (lt && lt->OnGetHorizontalMax) {
                 status = lt->OnGetHorizontalMax(objPath, &horizontalMax);
-                if (status == AJ_OK) {
+                if (status == AJ_OK && !CdmIsReplyDeferred()) {
+                    CdmMarkValuePulled();
                     props->horizontalMax = horizontalMax;
                 }
             }
@@ -286,7 +227,8 @@ AJ_Status WindDirectionInterfaceOnGetProperty(AJ_Message* replyMsg, const char*
             uint8_t horizontalAutoMode;
             if (lt && lt->OnGetHorizontalAutoMode) {
                 status = lt->OnGetHorizontalAutoMode(objPath, &horizontalAutoMode);
-                if (status == AJ_OK) {
+                if (status == AJ_OK && !CdmIsReplyDeferred()) {
+                    CdmMarkValuePulled();
                     props->horizontalAutoMode = horizontalAutoMode;
                 }
             }
@@ -298,7 +240,8 @@ AJ_Status WindDirectionInterfaceOnGetProperty(AJ_Message* replyMsg, const char*
             uint16_t verticalDirection;
             if (lt && lt->OnGetVerticalDirection) {
                 status = lt->OnGetVerticalDirection(objPath, &verticalDirection);
-                if (status == AJ_OK) {
+                if (status == AJ_OK && !CdmIsReplyDeferred()) {
+                    CdmMarkValuePulled();
                     props->verticalDirection = verticalDirection;
                 }
             }
@@ -310,7 +253,8 @@ AJ_Status WindDirectionInterfaceOnGetProperty(AJ_Message* replyMsg, const char*
             uint16_t verticalMax;
             if (lt && lt->OnGetVerticalMax) {
                 status = lt->OnGetVerticalMax(objPath, &verticalMax);
-                if (status == AJ_OK) {
+                if (status == AJ_OK && !CdmIsReplyDeferred()) {
+                    CdmMarkValuePulled();
                     props->verticalMax = verticalMax;
                 }
             }
@@ -322,7 +266,8 @@ AJ_Status WindDirectionInterfaceOnGetProperty(AJ_Message* replyMsg, const char*
             uint8_t verticalAutoMode;
             if (lt && lt->OnGetVerticalAutoMode) {
                 status = lt->OnGetVerticalAutoMode(objPath, &verticalAutoMode);
-                if (status == AJ_OK) {
+                if (status == AJ_OK && !CdmIsReplyDeferred()) {
+                    CdmMarkValuePulled();
                     props->verticalAutoMode = verticalAutoMode;
                 }
             }
@@ -363,10 +308,15 @@ AJ_Status WindDirectionInterfaceOnSetProperty(AJ_Message* replyMsg, const char*
             status = AJ_UnmarshalArgs(replyMsg, "q", &horizontalDirection);
 
             if (status == AJ_OK) {
-                status = WindDirectionAdjustHorizontalDirection(objPath, &horizontalDirection);
+                CdmConstraint constraint;
+                double value = horizontalDirection;
+
+                GetHorizontalDirectionConstraint(props, &constraint);
+                status = CdmConstraintApply(&constraint, props->constraintPolicy, &value);
                 if (status != AJ_OK) {
                     return status;
                 }
+                horizontalDirection = (uint16_t)value;
 
                 status = lt->OnSetHorizontalDirection(objPath, horizontalDirection);
                 if (status == AJ_OK) {
@@ -386,7 +336,7 @@ AJ_Status WindDirectionInterfaceOnSetProperty(AJ_Message* replyMsg, const char*
             status = AJ_UnmarshalArgs(replyMsg, "y", &horizontalAutoMode);
 
             if (status == AJ_OK) {
-                status = WindDirectionHorizontalAutoModeValidationCheck(objPath, horizontalAutoMode);
+                status = AutoModeValidationCheck(props->horizontalAutoMode, horizontalAutoMode);
                 if (status != AJ_OK) {
                     return status;
                 }
@@ -409,10 +359,15 @@ AJ_Status WindDirectionInterfaceOnSetProperty(AJ_Message* replyMsg, const char*
             status = AJ_UnmarshalArgs(replyMsg, "q", &verticalDirection);
 
             if (status == AJ_OK) {
-                status = WindDirectionAdjustVerticalDirection(objPath, &verticalDirection);
+                CdmConstraint constraint;
+                double value = verticalDirection;
+
+                GetVerticalDirectionConstraint(props, &constraint);
+                status = CdmConstraintApply(&constraint, props->constraintPolicy, &value);
                 if (status != AJ_OK) {
                     return status;
                 }
+                verticalDirection = (uint16_t)value;
 
                 status = lt->OnSetVerticalDirection(objPath, verticalDirection);
                 if (status == AJ_OK) {
@@ -432,7 +387,7 @@ AJ_Status WindDirectionInterfaceOnSetProperty(AJ_Message* replyMsg, const char*
             status = AJ_UnmarshalArgs(replyMsg, "y", &verticalAutoMode);
 
             if (status == AJ_OK) {
-                status = WindDirectionVerticalAutoModeValidationCheck(objPath, verticalAutoMode);
+                status = AutoModeValidationCheck(props->verticalAutoMode, verticalAutoMode);
                 if (status != AJ_OK) {
                     return status;
                 }
@@ -482,13 +437,16 @@ AJ_Status Cdm_WindDirectionInterfaceSetHorizontalDirection(AJ_BusAttachment* bus
         return AJ_ERR_INVALID;
     }
 
-    status = WindDirectionHorizontalDirectionValidationCheck(objPath, horizontalDirection);
-    if (status != AJ_OK) {
-        return status;
-    }
-
     props = (WindDirectionProperties*)GetProperties(objPath, WIND_DIRECTION_INTERFACE);
     if (props) {
+        CdmConstraint constraint;
+
+        GetHorizontalDirectionConstraint(props, &constraint);
+        status = CdmConstraintCheck(&constraint, horizontalDirection);
+        if (status != AJ_OK) {
+            return status;
+        }
+
         if (props->horizontalDirection != horizontalDirection) {
             props->horizontalDirection = horizontalDirection;
 
@@ -622,13 +580,16 @@ AJ_Status Cdm_WindDirectionInterfaceSetVerticalDirection(AJ_BusAttachment* busAt
         return AJ_ERR_INVALID;
     }
 
-    status = WindDirectionVerticalDirectionValidationCheck(objPath, verticalDirection);
-    if (status != AJ_OK) {
-        return status;
-    }
-
     props = (WindDirectionProperties*)GetProperties(objPath, WIND_DIRECTION_INTERFACE);
     if (props) {
+        CdmConstraint constraint;
+
+        GetVerticalDirectionConstraint(props, &constraint);
+        status = CdmConstraintCheck(&constraint, verticalDirection);
+        if (status != AJ_OK) {
+            return status;
+        }
+
         if (props->verticalDirection != verticalDirection) {
             props->verticalDirection = verticalDirection;
 
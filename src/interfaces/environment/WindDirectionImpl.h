@@ -23,6 +23,9 @@ const char* const intfDescEnvironmentWindDirection[9];
 
 AJ_Status CreateWindDirectionInterface(void** properties);
 void DestroyWindDirectionInterface(void* properties);
+AJ_Status WindDirectionInterfaceSaveProperties(void* properties, CdmSnapshotWriter* writer);
+AJ_Status WindDirectionInterfaceLoadProperties(void* properties, CdmSnapshotReader* reader);
+void WindDirectionInterfaceSetConstraintPolicy(void* properties, CdmConstraintPolicy policy);
 AJ_Status WindDirectionInterfaceOnGetProperty(AJ_Message* replyMsg, const char* objPath, void* properties, uint8_t memberIndex, void* listener);
 AJ_Status WindDirectionInterfaceOnSetProperty(AJ_Message* replyMsg, const char* objPath, void* properties, uint8_t memberIndex, void* listener, bool* propChanged);
 AJ_Status WindDirectionInterfaceEmitPropertiesChanged(AJ_BusAttachment* busAttachment, const char* objPath, void* properties, uint8_t memberIndex);
@@ -16,6 +16,7 @@
 
 #include <ajtcl/cdm/interfaces/input/Hid.h>
 #include "../../CdmControllee/CdmControlleeImpl.h"
+#include "../CdmArrayBufferImpl.h"
 #include "HidImpl.h"
 
 #define INTERFACE_VERSION 1
@@ -28,12 +29,199 @@ const char* const intfDescInputHid[] = {
     NULL
 };
 
+#define SUPPORTED_EVENT_INDEX_MIN_BITS 3
+#define INPUT_EVENTS_INITIAL_CAPACITY 8
+
 typedef struct {
     uint16_t version;
     SupportedInputEvent* supportedEvents;
+    size_t supportedEventsSize;
+    size_t supportedEventsCapacity;
+    uint32_t supportedEventsRevision; //changed whenever supportedEvents are changed, to tell if a borrowed list is stale
+    uint8_t coalescingOptions;
+    uint16_t* supportedEventIndex; //open addressing table of (supportedEvents index + 1), 0 is empty slot
+    uint8_t supportedEventIndexBits;
 } HidProperties;
 
-static size_t supportedEventsSize = 0;
+typedef struct {
+    size_t relativeRunStart;
+    size_t lastKeyIndex;
+    bool hasKey;
+} HidCoalescingState;
+
+static uint32_t GetSupportedEventSlot(uint16_t type, uint16_t code, uint8_t bits)
+{
+    uint32_t key = ((uint32_t)type << 16) | code;
+
+    return (uint32_t)(key * 2654435761u) >> (32 - bits);
+}
+
+static void FreeSupportedEventIndex(HidProperties* props)
+{
+    if (props->supportedEventIndex) {
+        free(props->supportedEventIndex);
+    }
+    props->supportedEventIndex = NULL;
+    props->supportedEventIndexBits = 0;
+}
+
+static AJ_Status BuildSupportedEventIndex(HidProperties* props)
+{
+    uint8_t bits = SUPPORTED_EVENT_INDEX_MIN_BITS;
+    uint32_t mask = 0;
+    uint32_t slot = 0;
+    size_t i = 0;
+
+    if (!props->supportedEvents || props->supportedEventsSize == 0) {
+        FreeSupportedEventIndex(props);
+        return AJ_OK;
+    }
+
+    if (props->supportedEventsSize >= 0x8000) {
+        FreeSupportedEventIndex(props);
+        return AJ_ERR_RANGE;
+    }
+
+    while (((size_t)1 << bits) < props->supportedEventsSize * 2) {
+        bits++;
+    }
+    mask = ((uint32_t)1 << bits) - 1;
+
+    //a table of the same size is cleared and reused
+    if (!props->supportedEventIndex || props->supportedEventIndexBits != bits) {
+        FreeSupportedEventIndex(props);
+        props->supportedEventIndex = (uint16_t*)malloc(sizeof(uint16_t) * ((size_t)1 << bits));
+        if (!props->supportedEventIndex) {
+            return AJ_ERR_RESOURCES;
+        }
+    }
+    memset(props->supportedEventIndex, 0, sizeof(uint16_t) * ((size_t)1 << bits));
+    props->supportedEventIndexBits = bits;
+
+    for (i = 0; i < props->supportedEventsSize; i++) {
+        const SupportedInputEvent* event = &props->supportedEvents[i];
+
+        slot = GetSupportedEventSlot(event->type, event->code, bits);
+        while (props->supportedEventIndex[slot]) {
+            const SupportedInputEvent* entry = &props->supportedEvents[props->supportedEventIndex[slot] - 1];
+            if (entry->type == event->type && entry->code == event->code) {
+                break; //the first record of a duplicated (type, code) wins
+            }
+            slot = (slot + 1) & mask;
+        }
+        if (!props->supportedEventIndex[slot]) {
+            props->supportedEventIndex[slot] = (uint16_t)(i + 1);
+        }
+    }
+
+    return AJ_OK;
+}
+
+static const SupportedInputEvent* FindSupportedEvent(const HidProperties* props, uint16_t type, uint16_t code)
+{
+    uint32_t mask = 0;
+    uint32_t slot = 0;
+
+    if (!props->supportedEventIndex) {
+        return NULL;
+    }
+
+    mask = ((uint32_t)1 << props->supportedEventIndexBits) - 1;
+    slot = GetSupportedEventSlot(type, code, props->supportedEventIndexBits);
+    while (props->supportedEventIndex[slot]) {
+        const SupportedInputEvent* entry = &props->supportedEvents[props->supportedEventIndex[slot] - 1];
+        if (entry->type == type && entry->code == code) {
+            return entry;
+        }
+        slot = (slot + 1) & mask;
+    }
+
+    return NULL;
+}
+
+static int32_t AddSaturated(int32_t a, int32_t b)
+{
+    int64_t sum = (int64_t)a + (int64_t)b;
+
+    if (sum > INT32_MAX) {
+        return INT32_MAX;
+    } else if (sum < INT32_MIN) {
+        return INT32_MIN;
+    }
+
+    return (int32_t)sum;
+}
+
+/*
+ * Returns true if the event is absorbed by the events already collected,
+ * i.e. merged into a previous relative-axis event or dropped.
+ */
+static bool CoalesceInputEvent(InputEvent* events, size_t size, HidCoalescingState* state, uint8_t options, const InputEvent* event)
+{
+    size_t i = 0;
+
+    if (options & HID_COALESCE_MERGE_RELATIVE) {
+        if (event->type == HID_EVENT_TYPE_REL) {
+            for (i = state->relativeRunStart; i < size; i++) {
+                if (events[i].type == HID_EVENT_TYPE_REL && events[i].code == event->code) {
+                    events[i].value = AddSaturated(events[i].value, event->value);
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        if (event->type == HID_EVENT_TYPE_SYN) {
+            if (size > 0 && events[size - 1].type == HID_EVENT_TYPE_SYN && events[size - 1].code == event->code) {
+                return true;
+            }
+            return false;
+        }
+    }
+
+    if ((options & HID_COALESCE_DROP_KEY_REPEATS) && event->type == HID_EVENT_TYPE_KEY && event->value == HID_KEY_VALUE_REPEAT) {
+        if (state->hasKey && events[state->lastKeyIndex].code == event->code && events[state->lastKeyIndex].value == HID_KEY_VALUE_REPEAT) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+static void UpdateCoalescingState(const InputEvent* events, size_t size, HidCoalescingState* state)
+{
+    const InputEvent* last = &events[size - 1];
+
+    if (last->type == HID_EVENT_TYPE_KEY) {
+        state->lastKeyIndex = size - 1;
+        state->hasKey = true;
+    }
+    if (last->type != HID_EVENT_TYPE_REL && last->type != HID_EVENT_TYPE_SYN) {
+        state->relativeRunStart = size; //relative events are not merged across key or absolute events
+    }
+}
+
+static void ClampInputEvents(const HidProperties* props, InputEvent* events, size_t size)
+{
+    size_t i = 0;
+
+    for (i = 0; i < size; i++) {
+        const SupportedInputEvent* supported = NULL;
+
+        if (events[i].type == HID_EVENT_TYPE_SYN) {
+            continue;
+        }
+
+        supported = FindSupportedEvent(props, events[i].type, events[i].code);
+        if (supported && supported->min <= supported->max) {
+            if (events[i].value < supported->min) {
+                events[i].value = supported->min;
+            } else if (events[i].value > supported->max) {
+                events[i].value = supported->max;
+            }
+        }
+    }
+}
 
 AJ_Status CreateHidInterface(void** properties)
 {
@@ -56,15 +244,59 @@ void DestroyHidInterface(void* properties)
         if (props->supportedEvents) {
             free(props->supportedEvents);
         }
+        FreeSupportedEventIndex(props);
 
         free(props);
     }
 }
 
+AJ_Status HidInterfaceSaveProperties(void* properties, CdmSnapshotWriter* writer)
+{
+    AJ_Status status = AJ_OK;
+    HidProperties* props = (HidProperties*)properties;
+
+    status = CdmSnapshotWrite(writer, &props->coalescingOptions, sizeof(props->coalescingOptions));
+    if (status == AJ_OK) {
+        status = CdmSnapshotWriteArray(writer, props->supportedEvents, sizeof(SupportedInputEvent), props->supportedEventsSize);
+    }
+
+    return status;
+}
+
+AJ_Status HidInterfaceLoadProperties(void* properties, CdmSnapshotReader* reader)
+{
+    AJ_Status status = AJ_OK;
+    HidProperties* props = (HidProperties*)properties;
+    uint8_t coalescingOptions = 0;
+    SupportedInputEvent* supportedEvents = NULL;
+    size_t supportedEventListSize = 0;
+    bool changed = false;
+
+    status = CdmSnapshotRead(reader, &coalescingOptions, sizeof(coalescingOptions));
+    if (status == AJ_OK) {
+        status = CdmSnapshotReadArray(reader, (void**)&supportedEvents, sizeof(SupportedInputEvent), &supportedEventListSize);
+    }
+    if (status != AJ_OK) {
+        return status;
+    }
+
+    props->coalescingOptions = coalescingOptions;
+    status = CdmArrayBufferAssign((void**)&props->supportedEvents, &props->supportedEventsSize, &props->supportedEventsCapacity,
+                                  sizeof(SupportedInputEvent), supportedEvents, supportedEventListSize, &changed);
+    free(supportedEvents);
+    if (status == AJ_OK && changed) {
+        props->supportedEventsRevision++;
+        status = BuildSupportedEventIndex(props);
+    }
+
+    return status;
+}
+
 static AJ_Status EmitPropChanged(AJ_BusAttachment* busAttachment, const char* objPath, const char* propName, const char* signature, void* val)
 {
     AJ_Status status = AJ_OK;
     uint32_t msgId = 0;
+    CdmPropChangedTarget target = { 0, 0, 0 };
     AJ_Message msg;
     AJ_Arg array, strc;
 
@@ -73,20 +305,21 @@ static AJ_Status EmitPropChanged(AJ_BusAttachment* busAttachment, const char* ob
     }
 
     status = MakePropChangedId(objPath, &msgId);
-    if (status == AJ_OK) {
-        AJ_MarshalSignal(busAttachment, &msg, msgId, NULL, 0, AJ_FLAG_GLOBAL_BROADCAST, 0);
+    while (status == AJ_OK && CdmNextPropChangedTarget(msgId, &target)) {
+        AJ_MarshalSignal(busAttachment, &msg, msgId, NULL, target.sessionId, target.flags, 0);
         AJ_MarshalArgs(&msg, "s", intfDescInputHid[0]+1); //To remove '$'
         AJ_MarshalContainer(&msg, &array, AJ_ARG_ARRAY);
         AJ_MarshalContainer(&msg, &strc, AJ_ARG_DICT_ENTRY);
         if (!strcmp(signature, "a(qqii)")) {
-            SupportedInputEvent* supportedEvents = (SupportedInputEvent*)val;
+            HidProperties* props = (HidProperties*)val;
+            SupportedInputEvent* supportedEvents = props->supportedEvents;
             AJ_Arg array2, strc2;
             int i = 0;
 
             AJ_MarshalArgs(&msg, "s", propName);
             AJ_MarshalVariant(&msg, signature);
             AJ_MarshalContainer(&msg, &array2, AJ_ARG_ARRAY);
-            for (i = 0; i < supportedEventsSize; i++) {
+            for (i = 0; i < props->supportedEventsSize; i++) {
                 AJ_MarshalContainer(&msg, &strc2, AJ_ARG_STRUCT);
                 AJ_MarshalArgs(&msg, "qqii", supportedEvents[i].type, supportedEvents[i].code,
                                supportedEvents[i].min, supportedEvents[i].max);
@@ -127,27 +360,31 @@ AJ_Status HidInterfaceOnGetProperty(AJ_Message* replyMsg, const char* objPath, v
         break;
     case 1 :
         {
+            bool changed = false;
 
-            SupportedInputEvent* supportedEvents = (SupportedInputEvent*)malloc(sizeof(SupportedInputEvent) * supportedEventsSize);
+            if (!props->supportedEvents) {
+                return AJ_ERR_NULL;
+            }
             if (lt && lt->OnGetSupportedEvents) {
+                SupportedInputEvent* supportedEvents = (SupportedInputEvent*)CdmArrayBufferScratch(sizeof(SupportedInputEvent), props->supportedEventsSize);
+                if (!supportedEvents) {
+                    return AJ_ERR_RESOURCES;
+                }
                 status = lt->OnGetSupportedEvents(objPath, supportedEvents);
-                if (status == AJ_OK) {
-                    if (props->supportedEvents) {
-                        free(props->supportedEvents);
-                    }
-                    props->supportedEvents = (SupportedInputEvent*)malloc(sizeof(SupportedInputEvent) * supportedEventsSize);
-                    memcpy(props->supportedEvents, supportedEvents, sizeof(SupportedInputEvent) * supportedEventsSize);
-                    free(supportedEvents);
+                if (status == AJ_OK && !CdmIsReplyDeferred()) {
+                    CdmMarkValuePulled();
+                    CdmArrayBufferAssign((void**)&props->supportedEvents, &props->supportedEventsSize, &props->supportedEventsCapacity,
+                                         sizeof(SupportedInputEvent), supportedEvents, props->supportedEventsSize, &changed);
+                }
+                if (changed) {
+                    props->supportedEventsRevision++;
+                    BuildSupportedEventIndex(props);
                 }
-            }
-            if (!props->supportedEvents) {
-                free(supportedEvents);
-                return AJ_ERR_NULL;
             }
             int i = 0;
             AJ_Arg array, strc;
             AJ_MarshalContainer(replyMsg, &array, AJ_ARG_ARRAY);
-            for (i = 0; i < supportedEventsSize; i++) {
+            for (i = 0; i < props->supportedEventsSize; i++) {
                 AJ_MarshalContainer(replyMsg, &strc, AJ_ARG_STRUCT);
                 status = AJ_MarshalArgs(replyMsg, "qqii", (props->supportedEvents)[i].type,
                                                           (props->supportedEvents)[i].code,
@@ -168,6 +405,7 @@ AJ_Status HidInterfaceOnGetProperty(AJ_Message* replyMsg, const char* objPath, v
 AJ_Status HidInterfaceOnMethodHandler(AJ_Message* msg, const char* objPath, uint8_t memberIndex, void* listener, CdmPropertiesChangedByMethod* propChangedByMethod)
 {
     AJ_Status status = AJ_OK;
+    HidProperties* props = NULL;
 
     if (!listener) {
         return AJ_ERR_INVALID;
@@ -178,6 +416,7 @@ AJ_Status HidInterfaceOnMethodHandler(AJ_Message* msg, const char* objPath, uint
     }
 
     HidListener* lt = (HidListener*)listener;
+    props = (HidProperties*)propChangedByMethod->properties;
 
     switch (memberIndex) {
     case 2 :
@@ -185,20 +424,34 @@ AJ_Status HidInterfaceOnMethodHandler(AJ_Message* msg, const char* objPath, uint
             status = AJ_ERR_NULL;
         } else {
             AJ_Arg array;
-            InputEvent* inputEvent = (InputEvent*)malloc(sizeof(InputEvent) * 1);
+            uint8_t options = props ? props->coalescingOptions : HID_COALESCE_NONE;
+            HidCoalescingState state = { 0, 0, false };
+            size_t capacity = INPUT_EVENTS_INITIAL_CAPACITY;
+            size_t size = 0;
+            InputEvent* inputEvent = (InputEvent*)malloc(sizeof(InputEvent) * capacity);
             if (inputEvent) {
                 status = AJ_UnmarshalContainer(msg, &array, AJ_ARG_ARRAY);
-                size_t size = 0;
                 while (status == AJ_OK) {
-                    status = AJ_UnmarshalArgs(msg, "(qqi)", &inputEvent[size].type, &inputEvent[size].code, &inputEvent[size].value);
-                    if (status == AJ_OK) {
-                        size++;
-                        InputEvent* tempInputEvent = (InputEvent*)malloc(sizeof(InputEvent) * size);
-                        memcpy(tempInputEvent, inputEvent, sizeof(InputEvent) * size);
-                        free(inputEvent);
-                        inputEvent = (InputEvent*)malloc(sizeof(InputEvent) * (size + 1));
-                        memcpy(inputEvent, tempInputEvent, sizeof(InputEvent) * size);
-                        free(tempInputEvent);
+                    InputEvent event;
+                    status = AJ_UnmarshalArgs(msg, "(qqi)", &event.type, &event.code, &event.value);
+                    if (status != AJ_OK) {
+                        break;
+                    }
+                    if (options && CoalesceInputEvent(inputEvent, size, &state, options, &event)) {
+                        continue;
+                    }
+                    if (size == capacity) {
+                        InputEvent* tempInputEvent = (InputEvent*)realloc(inputEvent, sizeof(InputEvent) * capacity * 2);
+                        if (!tempInputEvent) {
+                            status = AJ_ERR_RESOURCES;
+                            break;
+                        }
+                        inputEvent = tempInputEvent;
+                        capacity *= 2;
+                    }
+                    inputEvent[size++] = event;
+                    if (options) {
+                        UpdateCoalescingState(inputEvent, size, &state);
                     }
                 }
                 AJ_UnmarshalCloseContainer(msg, &array);
@@ -208,9 +461,14 @@ AJ_Status HidInterfaceOnMethodHandler(AJ_Message* msg, const char* objPath, uint
                 }
 
                 if (status == AJ_OK) {
+                    if (options & HID_COALESCE_CLAMP_TO_SUPPORTED) {
+                        ClampInputEvents(props, inputEvent, size);
+                    }
                     status = lt->OnInjectEvents(objPath, inputEvent, size);
                 }
                 free(inputEvent);
+            } else {
+                status = AJ_ERR_RESOURCES;
             }
         }
         break;
@@ -236,7 +494,7 @@ AJ_Status Cdm_HidInterfaceGetSupportedEvents(const char* objPath, SupportedInput
             return AJ_ERR_NULL;
         }
 
-        memcpy(supportedEvents, props->supportedEvents, sizeof(SupportedInputEvent) * supportedEventsSize);
+        memcpy(supportedEvents, props->supportedEvents, sizeof(SupportedInputEvent) * props->supportedEventsSize);
     } else {
         status = AJ_ERR_NO_MATCH;
     }
@@ -244,6 +502,31 @@ AJ_Status Cdm_HidInterfaceGetSupportedEvents(const char* objPath, SupportedInput
     return status;
 }
 
+AJ_Status Cdm_HidInterfaceBorrowSupportedEvents(const char* objPath, const SupportedInputEvent** supportedEvents, size_t* supportedEventListSize, uint32_t* revision)
+{
+    HidProperties* props = NULL;
+
+    if (!supportedEvents || !supportedEventListSize) {
+        return AJ_ERR_INVALID;
+    }
+
+    props = (HidProperties*)GetProperties(objPath, HID_INTERFACE);
+    if (!props) {
+        return AJ_ERR_NO_MATCH;
+    }
+
+    if (!props->supportedEvents) {
+        return AJ_ERR_NULL;
+    }
+    *supportedEvents = props->supportedEvents;
+    *supportedEventListSize = props->supportedEventsSize;
+    if (revision) {
+        *revision = props->supportedEventsRevision;
+    }
+
+    return AJ_OK;
+}
+
 AJ_Status Cdm_HidInterfaceSetSupportedEvents(AJ_BusAttachment* busAttachment, const char* objPath, const SupportedInputEvent* supportedEvents, const size_t supportedEventListSize)
 {
     AJ_Status status = AJ_OK;
@@ -260,14 +543,36 @@ AJ_Status Cdm_HidInterfaceSetSupportedEvents(AJ_BusAttachment* busAttachment, co
     props = (HidProperties*)GetProperties(objPath, HID_INTERFACE);
 
     if (props) {
-        if (props->supportedEvents) {
-            free(props->supportedEvents);
+        bool changed = false;
+
+        status = CdmArrayBufferAssign((void**)&props->supportedEvents, &props->supportedEventsSize, &props->supportedEventsCapacity,
+                                      sizeof(SupportedInputEvent), supportedEvents, supportedEventListSize, &changed);
+        if (status == AJ_OK && changed) {
+            props->supportedEventsRevision++;
+            status = BuildSupportedEventIndex(props);
+            if (status == AJ_OK) {
+                status = EmitPropChanged(busAttachment, objPath, "SupportedEvents", "a(qqii)", props);
+            }
         }
-        supportedEventsSize = supportedEventListSize;
-        props->supportedEvents = (SupportedInputEvent*)malloc(sizeof(SupportedInputEvent) * supportedEventsSize);
+    } else {
+        status = AJ_ERR_NO_MATCH;
+    }
 
-        memcpy(props->supportedEvents, supportedEvents, sizeof(SupportedInputEvent) * supportedEventsSize);
-        status = EmitPropChanged(busAttachment, objPath, "SupportedEvents", "a(qqii)", props->supportedEvents);
+    return status;
+}
+
+AJ_Status Cdm_HidInterfaceSetEventCoalescing(const char* objPath, const uint8_t options)
+{
+    AJ_Status status = AJ_OK;
+    HidProperties* props = NULL;
+
+    if (options & ~HID_COALESCE_ALL) {
+        return AJ_ERR_INVALID;
+    }
+
+    props = (HidProperties*)GetProperties(objPath, HID_INTERFACE);
+    if (props) {
+        props->coalescingOptions = options;
     } else {
         status = AJ_ERR_NO_MATCH;
     }
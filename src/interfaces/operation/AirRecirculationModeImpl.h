@@ -23,6 +23,8 @@ const char* const intfDescOperationAirRecirculationMode[4];
 
 AJ_Status CreateAirRecirculationModeInterface(void** properties);
 void DestroyAirRecirculationModeInterface(void* properties);
+AJ_Status AirRecirculationModeInterfaceSaveProperties(void* properties, CdmSnapshotWriter* writer);
+AJ_Status AirRecirculationModeInterfaceLoadProperties(void* properties, CdmSnapshotReader* reader);
 AJ_Status AirRecirculationModeInterfaceOnGetProperty(AJ_Message* replyMsg, const char* objPath, void* properties, uint8_t memberIndex, void* listener);
 AJ_Status AirRecirculationModeInterfaceOnSetProperty(AJ_Message* replyMsg, const char* objPath, void* properties, uint8_t memberIndex, void* listener, bool* propChanged);
 AJ_Status AirRecirculationModeInterfaceEmitPropertiesChanged(AJ_BusAttachment* busAttachment, const char* objPath, void* properties, uint8_t memberIndex);
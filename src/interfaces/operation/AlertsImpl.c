@@ -18,10 +18,16 @@
 #include <ajtcl/cdm/interfaces/operation/Alerts.h>
 #include <ajtcl/cdm/interfaces/CdmInterfaceErrors.h>
 #include "../../CdmControllee/CdmControlleeImpl.h"
+#include "../CdmArrayBufferImpl.h"
+#include "../CdmDescriptionCatalogImpl.h"
 #include "AlertsImpl.h"
 
 #define INTERFACE_VERSION 1
 
+#define ALERT_INDEX_MIN_BITS 3
+#define ALERTS_INITIAL_CAPACITY 4
+#define MAX_ALERTS_SIZE 0x8000
+
 const char* const intfDescOperationAlerts[] = {
     "$org.alljoyn.SmartSpaces.Operation.Alerts",
     "@Version>q",
@@ -35,9 +41,150 @@ const char* const intfDescOperationAlerts[] = {
 typedef struct {
     uint16_t version;
     AlertRecord* alerts;
+    size_t alertsSize;
+    size_t alertsCapacity;
+    uint16_t* alertIndex; //open addressing table of (alerts index + 1) keyed by alertCode, 0 is empty slot
+    uint8_t alertIndexBits;
+    uint32_t alertsRevision; //changed whenever alerts are changed, to tell if a borrowed list is stale
+    CdmDescriptionCatalog alertCodesDescriptionCatalog;
 } AlertsProperties;
 
-static size_t alertsSize = 0;
+static uint32_t GetAlertSlot(uint16_t alertCode, uint8_t bits)
+{
+    return (uint32_t)((uint32_t)alertCode * 2654435761u) >> (32 - bits);
+}
+
+static bool IsSameAlert(const AlertRecord* a, const AlertRecord* b)
+{
+    return (a->severity == b->severity && a->alertCode == b->alertCode &&
+            (a->needAcknowledgement ? true : false) == (b->needAcknowledgement ? true : false)) ? true : false;
+}
+
+static uint32_t FindAlertSlot(const AlertsProperties* props, uint16_t alertCode)
+{
+    uint32_t mask = ((uint32_t)1 << props->alertIndexBits) - 1;
+    uint32_t slot = GetAlertSlot(alertCode, props->alertIndexBits);
+
+    while (props->alertIndex[slot]) {
+        if (props->alerts[props->alertIndex[slot] - 1].alertCode == alertCode) {
+            break;
+        }
+        slot = (slot + 1) & mask;
+    }
+
+    return slot;
+}
+
+static AlertRecord* FindAlert(const AlertsProperties* props, uint16_t alertCode)
+{
+    uint32_t slot = 0;
+
+    if (!props->alertIndex) {
+        return NULL;
+    }
+
+    slot = FindAlertSlot(props, alertCode);
+    if (!props->alertIndex[slot]) {
+        return NULL;
+    }
+
+    return &props->alerts[props->alertIndex[slot] - 1];
+}
+
+static AJ_Status RebuildAlertIndex(AlertsProperties* props)
+{
+    uint8_t bits = ALERT_INDEX_MIN_BITS;
+    size_t i = 0;
+    size_t write = 0;
+
+    while (((size_t)1 << bits) < props->alertsCapacity * 2) {
+        bits++;
+    }
+
+    if (!props->alertIndex || bits != props->alertIndexBits) {
+        uint16_t* alertIndex = (uint16_t*)malloc(sizeof(uint16_t) * ((size_t)1 << bits));
+        if (!alertIndex) {
+            return AJ_ERR_RESOURCES;
+        }
+        if (props->alertIndex) {
+            free(props->alertIndex);
+        }
+        props->alertIndex = alertIndex;
+        props->alertIndexBits = bits;
+    }
+    memset(props->alertIndex, 0, sizeof(uint16_t) * ((size_t)1 << bits));
+
+    //a later record with an already indexed alertCode is dropped
+    for (i = 0; i < props->alertsSize; i++) {
+        uint32_t slot = FindAlertSlot(props, props->alerts[i].alertCode);
+        if (!props->alertIndex[slot]) {
+            if (write != i) {
+                props->alerts[write] = props->alerts[i];
+            }
+            props->alertIndex[slot] = (uint16_t)(write + 1);
+            write++;
+        }
+    }
+    props->alertsSize = write;
+
+    return AJ_OK;
+}
+
+static AJ_Status ReserveAlerts(AlertsProperties* props, size_t size)
+{
+    size_t capacity = props->alertsCapacity ? props->alertsCapacity : ALERTS_INITIAL_CAPACITY;
+    AlertRecord* alerts = NULL;
+
+    if (size > MAX_ALERTS_SIZE) {
+        return AJ_ERR_RESOURCES;
+    }
+
+    if (props->alerts && size <= props->alertsCapacity) {
+        return AJ_OK;
+    }
+
+    while (capacity < size) {
+        capacity *= 2;
+    }
+
+    alerts = (AlertRecord*)realloc(props->alerts, sizeof(AlertRecord) * capacity);
+    if (!alerts) {
+        return AJ_ERR_RESOURCES;
+    }
+    props->alerts = alerts;
+    props->alertsCapacity = capacity;
+
+    return RebuildAlertIndex(props);
+}
+
+static void RemoveAlertAt(AlertsProperties* props, uint32_t slot)
+{
+    uint32_t mask = ((uint32_t)1 << props->alertIndexBits) - 1;
+    size_t pos = props->alertIndex[slot] - 1;
+    size_t last = props->alertsSize - 1;
+    uint32_t next = 0;
+
+    //move the last record into the hole and re-point its index slot
+    if (pos != last) {
+        uint32_t lastSlot = FindAlertSlot(props, props->alerts[last].alertCode);
+        props->alerts[pos] = props->alerts[last];
+        props->alertIndex[lastSlot] = (uint16_t)(pos + 1);
+    }
+    props->alertsSize--;
+
+    //backward shift deletion keeps the probe sequences intact without tombstones
+    props->alertIndex[slot] = 0;
+    next = (slot + 1) & mask;
+    while (props->alertIndex[next]) {
+        uint32_t home = GetAlertSlot(props->alerts[props->alertIndex[next] - 1].alertCode, props->alertIndexBits);
+        if (((next - home) & mask) >= ((next - slot) & mask)) {
+            props->alertIndex[slot] = props->alertIndex[next];
+            props->alertIndex[next] = 0;
+            slot = next;
+        }
+        next = (next + 1) & mask;
+    }
+}
 
 AJ_Status CreateAlertsInterface(void** properties)
 {
@@ -60,15 +207,51 @@ void DestroyAlertsInterface(void* properties)
 
         if (props->alerts) {
             free(props->alerts);
-        } 
+        }
+        if (props->alertIndex) {
+            free(props->alertIndex);
+        }
+        CdmDescriptionCatalogClear(&props->alertCodesDescriptionCatalog);
         free(props);
     }
 }
 
+AJ_Status AlertsInterfaceSaveProperties(void* properties, CdmSnapshotWriter* writer)
+{
+    AlertsProperties* props = (AlertsProperties*)properties;
+
+    return CdmSnapshotWriteArray(writer, props->alerts, sizeof(AlertRecord), props->alertsSize);
+}
+
+AJ_Status AlertsInterfaceLoadProperties(void* properties, CdmSnapshotReader* reader)
+{
+    AJ_Status status = AJ_OK;
+    AlertsProperties* props = (AlertsProperties*)properties;
+    AlertRecord* alerts = NULL;
+    size_t alertsSize = 0;
+
+    status = CdmSnapshotReadArray(reader, (void**)&alerts, sizeof(AlertRecord), &alertsSize);
+    if (status == AJ_OK) {
+        status = ReserveAlerts(props, alertsSize);
+    }
+    if (status == AJ_OK) {
+        if (alertsSize) {
+            memcpy(props->alerts, alerts, sizeof(AlertRecord) * alertsSize);
+        }
+        props->alertsSize = alertsSize;
+        props->alertsRevision++;
+        status = RebuildAlertIndex(props);
+    }
+    free(alerts);
+
+    return status;
+}
+
 static AJ_Status EmitPropChanged(AJ_BusAttachment* busAttachment, const char* objPath, const char* propName, const char* signature, void* val)
 {
     AJ_Status status = AJ_OK;
     uint32_t msgId = 0;
+    CdmPropChangedTarget target = { 0, 0, 0 };
     AJ_Message msg;
     AJ_Arg array, strc;
 
@@ -77,27 +260,27 @@ static AJ_Status EmitPropChanged(AJ_BusAttachment* busAttachment, const char* ob
     }
 
     status = MakePropChangedId(objPath, &msgId);
-    if (status == AJ_OK) {
-        AJ_MarshalSignal(busAttachment, &msg, msgId, NULL, 0, AJ_FLAG_GLOBAL_BROADCAST, 0);
+    while (status == AJ_OK && CdmNextPropChangedTarget(msgId, &target)) {
+        AJ_MarshalSignal(busAttachment, &msg, msgId, NULL, target.sessionId, target.flags, 0);
         AJ_MarshalArgs(&msg, "s", intfDescOperationAlerts[0]+1); //To remove '$'
         AJ_MarshalContainer(&msg, &array, AJ_ARG_ARRAY);
         AJ_MarshalContainer(&msg, &strc, AJ_ARG_DICT_ENTRY);
         if (!strcmp(signature, "q")) {
             AJ_MarshalArgs(&msg, "sv", propName, signature, *(uint16_t*)val);
         } else if (!strcmp(signature, "a(yqb)")) {
-            AlertRecord* alerts = (AlertRecord*)val;
+            AlertsProperties* props = (AlertsProperties*)val;
             AJ_Arg array2, strc2;
             int i = 0;
 
             AJ_MarshalArgs(&msg, "s", propName);
             AJ_MarshalVariant(&msg, signature);
             AJ_MarshalContainer(&msg, &array2, AJ_ARG_ARRAY);
-            for (i = 0; i < alertsSize; i++) {
+            for (i = 0; i < props->alertsSize; i++) {
                 AJ_MarshalContainer(&msg, &strc2, AJ_ARG_STRUCT);
                 AJ_MarshalArgs(&msg, "yqb",
-                    alerts[i].severity,
-                    alerts[i].alertCode,
-                    alerts[i].needAcknowledgement);
+                    props->alerts[i].severity,
+                    props->alerts[i].alertCode,
+                    props->alerts[i].needAcknowledgement);
                 AJ_MarshalCloseContainer(&msg, &strc2);
             }
             AJ_MarshalCloseContainer(&msg, &array2);
@@ -114,6 +297,25 @@ static AJ_Status EmitPropChanged(AJ_BusAttachment* busAttachment, const char* ob
     return status;
 }
 
+AJ_Status AlertsInterfaceEmitPropertiesChanged(AJ_BusAttachment* busAttachment, const char* objPath, void* properties, uint8_t memberIndex)
+{
+    AJ_Status status = AJ_OK;
+
+    if (!properties) {
+        return AJ_ERR_INVALID;
+    }
+
+    switch (memberIndex) {
+    case 1:
+        status = EmitPropChanged(busAttachment, objPath, "Alerts", "a(yqb)", properties);
+        break;
+    default:
+        status = AJ_ERR_INVALID;
+    }
+
+    return status;
+}
+
 AJ_Status AlertsInterfaceOnGetProperty(AJ_Message* replyMsg, const char* objPath, void* properties, uint8_t memberIndex, void* listener)
 {
     AJ_Status status = AJ_OK;
@@ -136,29 +338,36 @@ AJ_Status AlertsInterfaceOnGetProperty(AJ_Message* replyMsg, const char* objPath
 
         case 1:
             {
-                AlertRecord* alerts = (AlertRecord*)malloc(sizeof(AlertRecord) * alertsSize);
-                memset(alerts, 0, sizeof(AlertRecord) * alertsSize);
+                if (lt && lt->OnGetAlerts && props->alertsSize > 0) {
+                    AlertRecord* alerts = (AlertRecord*)CdmArrayBufferScratch(sizeof(AlertRecord), props->alertsSize);
+                    size_t i = 0;
+
+                    if (!alerts) {
+                        return AJ_ERR_RESOURCES;
+                    }
+                    memset(alerts, 0, sizeof(AlertRecord) * props->alertsSize);
 
-                if (lt && lt->OnGetAlerts) {
                     status = lt->OnGetAlerts(objPath, alerts);
-                    if (status == AJ_OK) {
-                        if (props->alerts) {
-                            free(props->alerts);
+                    if (status == AJ_OK && !CdmIsReplyDeferred()) {
+                        CdmMarkValuePulled();
+                        while (i < props->alertsSize && IsSameAlert(&props->alerts[i], &alerts[i])) {
+                            i++;
+                        }
+                        if (i < props->alertsSize) {
+                            memcpy(props->alerts, alerts, sizeof(AlertRecord) * props->alertsSize);
+                            props->alertsRevision++;
+                            status = RebuildAlertIndex(props);
                         }
-                        props->alerts = (AlertRecord*)malloc(sizeof(AlertRecord) * alertsSize);
-                        memcpy(props->alerts, alerts, sizeof(AlertRecord) * alertsSize);
-                        free(alerts);
                     }
                 }
                 if (!props->alerts) {
-                    free(alerts);
                     return AJ_ERR_NULL;
                 }
 
                 int i = 0;
                 AJ_Arg array, strc;
                 AJ_MarshalContainer(replyMsg, &array, AJ_ARG_ARRAY);
-                for (i = 0; i < alertsSize; i++) {
+                for (i = 0; i < props->alertsSize; i++) {
                     AJ_MarshalContainer(replyMsg, &strc, AJ_ARG_STRUCT);
                     status = AJ_MarshalArgs(replyMsg, "yqb",
                         (props->alerts)[i].severity,
@@ -167,7 +376,6 @@ AJ_Status AlertsInterfaceOnGetProperty(AJ_Message* replyMsg, const char* objPath
                     AJ_MarshalCloseContainer(replyMsg, &strc);
                 }
                 AJ_MarshalCloseContainer(replyMsg, &array);
-                free(alerts);
             }
             break;
 
@@ -176,7 +384,7 @@ AJ_Status AlertsInterfaceOnGetProperty(AJ_Message* replyMsg, const char* objPath
             break;
     }
 
- 
+
     return status;
 }
 
@@ -193,9 +401,22 @@ AJ_Status AlertsInterfaceOnMethodHandler(AJ_Message* msg, const char* objPath, u
     }
 
     AlertsListener* lt = (AlertsListener*)listener;
+    AlertsProperties* props = (AlertsProperties*)propChangedByMethod->properties;
+
+    if (!props) {
+        return AJ_ERR_INVALID;
+    }
+
     switch (memberIndex) {
         case 2:
-            if (!lt->OnGetAlertCodesDescription) {
+            if (CdmDescriptionCatalogIsSet(&props->alertCodesDescriptionCatalog)) {
+                char* languageTag;
+
+                status = AJ_UnmarshalArgs(msg, "s", &languageTag);
+                if (status == AJ_OK) {
+                    status = CdmDescriptionCatalogReply(&props->alertCodesDescriptionCatalog, msg, languageTag);
+                }
+            } else if (!lt->OnGetAlertCodesDescription) {
                 status = AJ_ERR_NULL;
             } else {
                char* languageTag;
@@ -232,18 +453,33 @@ AJ_Status AlertsInterfaceOnMethodHandler(AJ_Message* msg, const char* objPath, u
             break;
 
         case 3:
-            if (!lt->OnAcknowledgeAlert) {
-                status = AJ_ERR_NULL;
-            } else {
+            {
                 uint16_t alertCode;
 
                 status = AJ_UnmarshalArgs(msg, "q", &alertCode);
                 if (status == AJ_OK) {
                     ErrorCode errorCode = NOT_ERROR;
                     AJ_Message reply;
-                    status = lt->OnAcknowledgeAlert(objPath, alertCode, &errorCode);
+                    AlertRecord* alert = FindAlert(props, alertCode);
+
+                    if (!alert) {
+                        errorCode = INVALID_VALUE;
+                        status = AJ_ERR_NO_MATCH;
+                    } else if (lt->OnAcknowledgeAlert) {
+                        status = lt->OnAcknowledgeAlert(objPath, alertCode, &errorCode);
+                        if (CdmIsReplyDeferred()) {
+                            break;
+                        }
+                        //the listener can clear or raise alerts, which moves the records
+                        alert = FindAlert(props, alertCode);
+                    }
 
                     if (status == AJ_OK) {
+                        if (alert && alert->needAcknowledgement) {
+                            alert->needAcknowledgement = false;
+                            props->alertsRevision++;
+                            propChangedByMethod->member_index_mask |= (1 << 1);
+                        }
                         AJ_MarshalReplyMsg(msg, &reply);
                     } else {
                         AJ_MarshalReplyMsg(msg, &reply);
@@ -255,14 +491,26 @@ AJ_Status AlertsInterfaceOnMethodHandler(AJ_Message* msg, const char* objPath, u
             break;
 
         case 4:
-            if (!lt->OnAcknowledgeAllAlerts) {
-                status = AJ_ERR_NULL;
-            } else {
+            {
                 ErrorCode errorCode = NOT_ERROR;
                 AJ_Message reply;
-                status = lt->OnAcknowledgeAllAlerts(objPath, &errorCode);
+
+                if (lt->OnAcknowledgeAllAlerts) {
+                    status = lt->OnAcknowledgeAllAlerts(objPath, &errorCode);
+                    if (CdmIsReplyDeferred()) {
+                        break;
+                    }
+                }
 
                 if (status == AJ_OK) {
+                    size_t i = 0;
+                    for (i = 0; i < props->alertsSize; i++) {
+                        if (props->alerts[i].needAcknowledgement) {
+                            props->alerts[i].needAcknowledgement = false;
+                            props->alertsRevision++;
+                            propChangedByMethod->member_index_mask |= (1 << 1);
+                        }
+                    }
                     AJ_MarshalReplyMsg(msg, &reply);
                 } else {
                     AJ_MarshalReplyMsg(msg, &reply);
@@ -295,7 +543,7 @@ AJ_Status Cdm_AlertsInterfaceGetAlerts(const char* objPath, AlertRecord* alerts)
         if (!props->alerts) {
             return AJ_ERR_NULL;
         }
-        memcpy(alerts, props->alerts, sizeof(AlertRecord) * alertsSize);
+        memcpy(alerts, props->alerts, sizeof(AlertRecord) * props->alertsSize);
     } else {
         status = AJ_ERR_NO_MATCH;
     }
@@ -303,6 +551,31 @@ AJ_Status Cdm_AlertsInterfaceGetAlerts(const char* objPath, AlertRecord* alerts)
     return status;
 }
 
+AJ_Status Cdm_AlertsInterfaceBorrowAlerts(const char* objPath, const AlertRecord** alerts, size_t* alertsNumber, uint32_t* revision)
+{
+    AlertsProperties* props = NULL;
+
+    if (!alerts || !alertsNumber) {
+        return AJ_ERR_INVALID;
+    }
+
+    props = (AlertsProperties*)GetProperties(objPath, ALERTS_INTERFACE);
+    if (!props) {
+        return AJ_ERR_NO_MATCH;
+    }
+
+    if (!props->alerts) {
+        return AJ_ERR_NULL;
+    }
+    *alerts = props->alerts;
+    *alertsNumber = props->alertsSize;
+    if (revision) {
+        *revision = props->alertsRevision;
+    }
+
+    return AJ_OK;
+}
+
 AJ_Status Cdm_AlertsInterfaceSetAlerts(AJ_BusAttachment* busAttachment, const char* objPath, const AlertRecord* alerts, const size_t alertsNumber)
 {
     AJ_Status status = AJ_OK;
@@ -320,20 +593,170 @@ AJ_Status Cdm_AlertsInterfaceSetAlerts(AJ_BusAttachment* busAttachment, const ch
     props = (AlertsProperties*)GetProperties(objPath, ALERTS_INTERFACE);
 
     if (props) {
-        if (props->alerts) {
-            free(props->alerts);
-        }
+        size_t i = 0;
 
-        alertsSize = alertsNumber;
-        props->alerts = (AlertRecord*)malloc(sizeof(AlertRecord) * alertsSize);
+        if (props->alerts && props->alertsSize == alertsNumber) {
+            for (i = 0; i < alertsNumber; i++) {
+                if (!IsSameAlert(&props->alerts[i], &alerts[i])) {
+                    break;
+                }
+            }
+            if (i == alertsNumber) {
+                return AJ_OK;
+            }
+        }
 
-        memcpy(props->alerts, alerts, sizeof(AlertRecord) * alertsSize);
+        status = ReserveAlerts(props, alertsNumber);
+        if (status != AJ_OK) {
+            return status;
+        }
 
-        status = EmitPropChanged(busAttachment, objPath, "Alerts", "a(yqb)", props->alerts);
+        if (alertsNumber > 0) {
+            memcpy(props->alerts, alerts, sizeof(AlertRecord) * alertsNumber);
+        }
+        props->alertsSize = alertsNumber;
+        props->alertsRevision++;
+        status = RebuildAlertIndex(props);
+        if (status == AJ_OK) {
+            status = EmitPropChanged(busAttachment, objPath, "Alerts", "a(yqb)", props);
+        }
     } else {
         status = AJ_ERR_NO_MATCH;
     }
 
 
+    return status;
+}
+
+AJ_Status Cdm_AlertsInterfaceRaiseAlert(AJ_BusAttachment* busAttachment, const char* objPath, const AlertRecord* alert)
+{
+    AJ_Status status = AJ_OK;
+    AlertsProperties* props = NULL;
+    AlertRecord* pending = NULL;
+
+    if (!busAttachment) {
+        return AJ_ERR_INVALID;
+    }
+
+    if (!alert) {
+        return AJ_ERR_INVALID;
+    }
+
+    props = (AlertsProperties*)GetProperties(objPath, ALERTS_INTERFACE);
+    if (!props) {
+        return AJ_ERR_NO_MATCH;
+    }
+
+    pending = FindAlert(props, alert->alertCode);
+    if (pending) {
+        if (IsSameAlert(pending, alert)) {
+            return AJ_OK;
+        }
+        *pending = *alert;
+    } else {
+        status = ReserveAlerts(props, props->alertsSize + 1);
+        if (status != AJ_OK) {
+            return status;
+        }
+        props->alerts[props->alertsSize] = *alert;
+        props->alertIndex[FindAlertSlot(props, alert->alertCode)] = (uint16_t)(props->alertsSize + 1);
+        props->alertsSize++;
+    }
+    props->alertsRevision++;
+
+    return EmitPropChanged(busAttachment, objPath, "Alerts", "a(yqb)", props);
+}
+
+AJ_Status Cdm_AlertsInterfaceClearAlert(AJ_BusAttachment* busAttachment, const char* objPath, const uint16_t alertCode)
+{
+    AlertsProperties* props = NULL;
+    uint32_t slot = 0;
+
+    if (!busAttachment) {
+        return AJ_ERR_INVALID;
+    }
+
+    props = (AlertsProperties*)GetProperties(objPath, ALERTS_INTERFACE);
+    if (!props) {
+        return AJ_ERR_NO_MATCH;
+    }
+
+    if (!props->alertIndex) {
+        return AJ_OK;
+    }
+
+    slot = FindAlertSlot(props, alertCode);
+    if (!props->alertIndex[slot]) {
+        return AJ_OK;
+    }
+    RemoveAlertAt(props, slot);
+    props->alertsRevision++;
+
+    return EmitPropChanged(busAttachment, objPath, "Alerts", "a(yqb)", props);
+}
+
+AJ_Status Cdm_AlertsInterfaceClearAllAlerts(AJ_BusAttachment* busAttachment, const char* objPath)
+{
+    AlertsProperties* props = NULL;
+
+    if (!busAttachment) {
+        return AJ_ERR_INVALID;
+    }
+
+    props = (AlertsProperties*)GetProperties(objPath, ALERTS_INTERFACE);
+    if (!props) {
+        return AJ_ERR_NO_MATCH;
+    }
+
+    if (props->alertsSize == 0) {
+        return AJ_OK;
+    }
+    props->alertsSize = 0;
+    props->alertsRevision++;
+    memset(props->alertIndex, 0, sizeof(uint16_t) * ((size_t)1 << props->alertIndexBits));
+
+    return EmitPropChanged(busAttachment, objPath, "Alerts", "a(yqb)", props);
+}
+
+AJ_Status Cdm_AlertsInterfaceAcknowledgeAlert(AJ_BusAttachment* busAttachment, const char* objPath, const uint16_t alertCode)
+{
+    AlertsProperties* props = NULL;
+    AlertRecord* alert = NULL;
+
+    if (!busAttachment) {
+        return AJ_ERR_INVALID;
+    }
+
+    props = (AlertsProperties*)GetProperties(objPath, ALERTS_INTERFACE);
+    if (!props) {
+        return AJ_ERR_NO_MATCH;
+    }
+
+    alert = FindAlert(props, alertCode);
+    if (!alert) {
+        return AJ_ERR_NO_MATCH;
+    }
+
+    if (!alert->needAcknowledgement) {
+        return AJ_OK;
+    }
+    alert->needAcknowledgement = false;
+    props->alertsRevision++;
+
+    return EmitPropChanged(busAttachment, objPath, "Alerts", "a(yqb)", props);
+}
+
+AJ_Status Cdm_AlertsInterfaceSetAlertCodesDescriptionCatalog(const char* objPath, const CdmDescriptionRecord* records, const uint16_t numRecords)
+{
+    AJ_Status status = AJ_OK;
+    AlertsProperties* props = NULL;
+
+    props = (AlertsProperties*)GetProperties(objPath, ALERTS_INTERFACE);
+    if (props) {
+        status = CdmDescriptionCatalogSet(&props->alertCodesDescriptionCatalog, records, numRecords, false);
+    } else {
+        status = AJ_ERR_NO_MATCH;
+    }
+
     return status;
 }
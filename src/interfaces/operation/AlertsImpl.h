@@ -23,6 +23,9 @@ const char* const intfDescOperationAlerts[7];
 
 AJ_Status CreateAlertsInterface(void** properties);
 void DestroyAlertsInterface(void* properties);
+AJ_Status AlertsInterfaceSaveProperties(void* properties, CdmSnapshotWriter* writer);
+AJ_Status AlertsInterfaceLoadProperties(void* properties, CdmSnapshotReader* reader);
+AJ_Status AlertsInterfaceEmitPropertiesChanged(AJ_BusAttachment* busAttachment, const char* objPath, void* properties, uint8_t memberIndex);
 AJ_Status AlertsInterfaceOnGetProperty(AJ_Message* replyMsg, const char* objPath, void* properties, uint8_t memberIndex, void* listener);
 AJ_Status AlertsInterfaceOnMethodHandler(AJ_Message* msg, const char* objPath, uint8_t memberIndex, void* listener, CdmPropertiesChangedByMethod* propChangedByMethod);
 
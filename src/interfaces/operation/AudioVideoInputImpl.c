@@ -14,6 +14,7 @@
  *    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
  ******************************************************************************/
 
+#include <stdlib.h>
 #include <string.h>
 #include <ajtcl/cdm/interfaces/operation/AudioVideoInput.h>
 #include "../../CdmControllee/CdmControlleeImpl.h"
@@ -33,10 +34,68 @@ typedef struct {
     uint16_t version;
     uint16_t inputSourceId;
     InputSource* supportedInputSources;
+    uint16_t* sortedSourceIds; //ids of supportedInputSources in ascending order
 } AudioVideoInputProperties;
 
 static size_t suppotedInputSourcesSize = 0;
 
+static int CompareSourceIds(const void* a, const void* b)
+{
+    return (int)*(const uint16_t*)a - (int)*(const uint16_t*)b;
+}
+
+//Input source ids are 16 bit, so they are validated by binary search instead of a bitset
+static void BuildSourceIdIndex(AudioVideoInputProperties* props)
+{
+    size_t i = 0;
+
+    free(props->sortedSourceIds);
+    props->sortedSourceIds = NULL;
+    if (!props->supportedInputSources || !suppotedInputSourcesSize) {
+        return;
+    }
+
+    props->sortedSourceIds = (uint16_t*)malloc(sizeof(uint16_t) * suppotedInputSourcesSize);
+    if (!props->sortedSourceIds) {
+        return;
+    }
+    for (i = 0; i < suppotedInputSourcesSize; i++) {
+        props->sortedSourceIds[i] = props->supportedInputSources[i].id;
+    }
+    qsort(props->sortedSourceIds, suppotedInputSourcesSize, sizeof(uint16_t), CompareSourceIds);
+}
+
+static bool HasSourceId(const AudioVideoInputProperties* props, uint16_t inputSourceId)
+{
+    size_t low = 0;
+    size_t high = 0;
+
+    if (!props->sortedSourceIds) {
+        //the index could not be allocated
+        for (low = 0; props->supportedInputSources && low < suppotedInputSourcesSize; low++) {
+            if (props->supportedInputSources[low].id == inputSourceId) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    high = suppotedInputSourcesSize;
+    while (low < high) {
+        size_t mid = low + (high - low) / 2;
+
+        if (props->sortedSourceIds[mid] == inputSourceId) {
+            return true;
+        } else if (props->sortedSourceIds[mid] < inputSourceId) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+
+    return false;
+}
+
 AJ_Status InputSourceIdValidationCheck(const char* objPath, uint16_t inputSourceId)
 {
     AJ_Status status = AJ_OK;
@@ -44,16 +103,7 @@ AJ_Status InputSourceIdValidationCheck(const char* objPath, uint16_t inputSource
     props = (AudioVideoInputProperties*)GetProperties(objPath, AUDIO_VIDEO_INPUT_INTERFACE);
 
     if (props) {
-        int i = 0;
-        bool check = false;
-        for (i = 0; i < suppotedInputSourcesSize; i++) {
-            if ((props->supportedInputSources)[i].id == inputSourceId) {
-                check = true;
-                break;
-            }
-        }
-
-        if (!check) {
+        if (!HasSourceId(props, inputSourceId)) {
             return AJ_ERR_RANGE;
         }
     } else {
@@ -88,15 +138,96 @@ void DestroyAudioVideoInputInterface(void* properties)
             }
             free(props->supportedInputSources);
         }
+        free(props->sortedSourceIds);
 
         free(props);
     }
 }
 
+AJ_Status AudioVideoInputInterfaceSaveProperties(void* properties, CdmSnapshotWriter* writer)
+{
+    AJ_Status status = AJ_OK;
+    AudioVideoInputProperties* props = (AudioVideoInputProperties*)properties;
+    uint32_t num = props->supportedInputSources ? (uint32_t)suppotedInputSourcesSize : 0;
+    uint32_t i = 0;
+
+    status = CdmSnapshotWrite(writer, &props->inputSourceId, sizeof(props->inputSourceId));
+    if (status == AJ_OK) {
+        status = CdmSnapshotWrite(writer, &num, sizeof(num));
+    }
+    for (i = 0; status == AJ_OK && i < num; i++) {
+        status = CdmSnapshotWrite(writer, &props->supportedInputSources[i], sizeof(InputSource));
+        if (status == AJ_OK) {
+            status = CdmSnapshotWriteString(writer, props->supportedInputSources[i].friendlyName);
+        }
+    }
+
+    return status;
+}
+
+AJ_Status AudioVideoInputInterfaceLoadProperties(void* properties, CdmSnapshotReader* reader)
+{
+    AJ_Status status = AJ_OK;
+    AudioVideoInputProperties* props = (AudioVideoInputProperties*)properties;
+    uint16_t inputSourceId = 0;
+    uint32_t num = 0;
+    uint32_t i = 0;
+    InputSource* supportedInputSources = NULL;
+
+    status = CdmSnapshotRead(reader, &inputSourceId, sizeof(inputSourceId));
+    if (status == AJ_OK) {
+        status = CdmSnapshotRead(reader, &num, sizeof(num));
+    }
+    if (status != AJ_OK) {
+        return status;
+    }
+    if (num > (reader->size - reader->offset) / sizeof(InputSource)) {
+        return AJ_ERR_END_OF_DATA;
+    }
+
+    if (num) {
+        supportedInputSources = (InputSource*)malloc(sizeof(InputSource) * num);
+        if (!supportedInputSources) {
+            return AJ_ERR_RESOURCES;
+        }
+    }
+    for (i = 0; i < num; i++) {
+        status = CdmSnapshotRead(reader, &supportedInputSources[i], sizeof(InputSource));
+        if (status == AJ_OK) {
+            status = CdmSnapshotReadString(reader, &supportedInputSources[i].friendlyName);
+        }
+        if (status != AJ_OK) {
+            break;
+        }
+    }
+    if (status != AJ_OK) {
+        while (i > 0) {
+            i--;
+            free(supportedInputSources[i].friendlyName);
+        }
+        free(supportedInputSources);
+        return status;
+    }
+
+    if (props->supportedInputSources) {
+        for (i = 0; i < suppotedInputSourcesSize; i++) {
+            free((props->supportedInputSources)[i].friendlyName);
+        }
+        free(props->supportedInputSources);
+    }
+    props->inputSourceId = inputSourceId;
+    props->supportedInputSources = supportedInputSources;
+    suppotedInputSourcesSize = num;
+    BuildSourceIdIndex(props);
+
+    return AJ_OK;
+}
+
 static AJ_Status EmitPropChanged(AJ_BusAttachment* busAttachment, const char* objPath, const char* propName, const char* signature, void* val)
 {
     AJ_Status status = AJ_OK;
     uint32_t msgId = 0;
+    CdmPropChangedTarget target = { 0, 0, 0 };
     AJ_Message msg;
     AJ_Arg array, strc;
 
@@ -105,8 +236,8 @@ static AJ_Status EmitPropChanged(AJ_BusAttachment* busAttachment, const char* ob
     }
 
     status = MakePropChangedId(objPath, &msgId);
-    if (status == AJ_OK) {
-        AJ_MarshalSignal(busAttachment, &msg, msgId, NULL, 0, AJ_FLAG_GLOBAL_BROADCAST, 0);
+    while (status == AJ_OK && CdmNextPropChangedTarget(msgId, &target)) {
+        AJ_MarshalSignal(busAttachment, &msg, msgId, NULL, target.sessionId, target.flags, 0);
         AJ_MarshalArgs(&msg, "s", intfDescOperationAudioVideoInput[0]+1); //To remove '$'
         AJ_MarshalContainer(&msg, &array, AJ_ARG_ARRAY);
         AJ_MarshalContainer(&msg, &strc, AJ_ARG_DICT_ENTRY);
@@ -188,7 +319,8 @@ AJ_Status AudioVideoInputInterfaceOnGetProperty(AJ_Message* replyMsg, const char
 
             if (lt && lt->OnGetInputSourceId) {
                 status = lt->OnGetInputSourceId(objPath, &inputSourceId);
-                if (status == AJ_OK) {
+                if (status == AJ_OK && !CdmIsReplyDeferred()) {
+                    CdmMarkValuePulled();
                     props->inputSourceId = inputSourceId;
                 }
             }
@@ -201,7 +333,8 @@ AJ_Status AudioVideoInputInterfaceOnGetProperty(AJ_Message* replyMsg, const char
             int i = 0;
             if (lt && lt->OnGetSupportedInputSources) {
                 status = lt->OnGetSupportedInputSources(objPath, supportedInputSources);
-                if (status == AJ_OK) {
+                if (status == AJ_OK && !CdmIsReplyDeferred()) {
+                    CdmMarkValuePulled();
                     if (props->supportedInputSources) {
                         for (i = 0; i < suppotedInputSourcesSize; i++) {
                             free((props->supportedInputSources)[i].friendlyName);
@@ -217,6 +350,7 @@ AJ_Status AudioVideoInputInterfaceOnGetProperty(AJ_Message* replyMsg, const char
                         strncpy((props->supportedInputSources)[i].friendlyName, supportedInputSources[i].friendlyName, strlen(supportedInputSources[i].friendlyName));
                         ((props->supportedInputSources)[i].friendlyName)[strlen(supportedInputSources[i].friendlyName)] = '\0';
                     }
+                    BuildSourceIdIndex(props);
                  }
             }
             if (!props->supportedInputSources) {
@@ -404,6 +538,7 @@ AJ_Status Cdm_AudioVideoInputInterfaceSetSupportedInputSources(AJ_BusAttachment*
             strncpy((props->supportedInputSources)[i].friendlyName, supportedInputSources[i].friendlyName, strlen(supportedInputSources[i].friendlyName));
             ((props->supportedInputSources)[i].friendlyName)[strlen(supportedInputSources[i].friendlyName)] = '\0';
         }
+        BuildSourceIdIndex(props);
         status = EmitPropChanged(busAttachment, objPath, "SupportedInputSources", "a(qqyqs)", props->supportedInputSources);
     } else {
         status = AJ_ERR_NO_MATCH;
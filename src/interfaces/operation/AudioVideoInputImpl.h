@@ -23,6 +23,8 @@ const char* const intfDescOperationAudioVideoInput[5];
 
 AJ_Status CreateAudioVideoInputInterface(void** properties);
 void DestroyAudioVideoInputInterface(void* properties);
+AJ_Status AudioVideoInputInterfaceSaveProperties(void* properties, CdmSnapshotWriter* writer);
+AJ_Status AudioVideoInputInterfaceLoadProperties(void* properties, CdmSnapshotReader* reader);
 AJ_Status AudioVideoInputInterfaceOnGetProperty(AJ_Message* replyMsg, const char* objPath, void* properties, uint8_t memberIndex, void* listener);
 AJ_Status AudioVideoInputInterfaceOnSetProperty(AJ_Message* replyMsg, const char* objPath, void* properties, uint8_t memberIndex, void* listener, bool* propChanged);
 AJ_Status AudioVideoInputInterfaceEmitPropertiesChanged(AJ_BusAttachment* busAttachment, const char* objPath, void* properties, uint8_t memberIndex);
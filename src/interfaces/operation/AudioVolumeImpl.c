@@ -88,10 +88,25 @@ void DestroyAudioVolumeInterface(void* properties)
     }
 }
 
+AJ_Status AudioVolumeInterfaceSaveProperties(void* properties, CdmSnapshotWriter* writer)
+{
+    return CdmSnapshotWrite(writer, properties, sizeof(AudioVolumeProperties));
+}
+
+AJ_Status AudioVolumeInterfaceLoadProperties(void* properties, CdmSnapshotReader* reader)
+{
+    if (reader->size != sizeof(AudioVolumeProperties)) {
+        return AJ_ERR_INVALID;
+    }
+
+    return CdmSnapshotRead(reader, properties, sizeof(AudioVolumeProperties));
+}
+
 static AJ_Status EmitPropChanged(AJ_BusAttachment* busAttachment, const char* objPath, const char* propName, const char* signature, void* val)
 {
     AJ_Status status = AJ_OK;
     uint32_t msgId = 0;
+    CdmPropChangedTarget target = { 0, 0, 0 };
     AJ_Message msg;
     AJ_Arg array, strc;
 
@@ -100,8 +115,8 @@ static AJ_Status EmitPropChanged(AJ_BusAttachment* busAttachment, const char* ob
     }
 
     status = MakePropChangedId(objPath, &msgId);
-    if (status == AJ_OK) {
-        AJ_MarshalSignal(busAttachment, &msg, msgId, NULL, 0, AJ_FLAG_GLOBAL_BROADCAST, 0);
+    while (status == AJ_OK && CdmNextPropChangedTarget(msgId, &target)) {
+        AJ_MarshalSignal(busAttachment, &msg, msgId, NULL, target.sessionId, target.flags, 0);
         AJ_MarshalArgs(&msg, "s", intfDescOperationAudioVolume[0]+1); //To remove '$'
         AJ_MarshalContainer(&msg, &array, AJ_ARG_ARRAY);
         AJ_MarshalContainer(&msg, &strc, AJ_ARG_DICT_ENTRY);
@@ -171,7 +186,8 @@ AJ_Status AudioVolumeInterfaceOnGetProperty(AJ_Message* replyMsg, const char* ob
             uint8_t volume;
             if (lt && lt->OnGetVolume) {
                 status = lt->OnGetVolume(objPath, &volume);
-                if (status == AJ_OK) {
+                if (status == AJ_OK && !CdmIsReplyDeferred()) {
+                    CdmMarkValuePulled();
                     props->volume = volume;
                 }
             }
@@ -183,7 +199,8 @@ AJ_Status AudioVolumeInterfaceOnGetProperty(AJ_Message* replyMsg, const char* ob
             uint8_t maxVolume;
             if (lt && lt->OnGetMaxVolume) {
                 status = lt->OnGetMaxVolume(objPath, &maxVolume);
-                if (status == AJ_OK) {
+                if (status == AJ_OK && !CdmIsReplyDeferred()) {
+                    CdmMarkValuePulled();
                     props->maxVolume = maxVolume;
                 }
             }
@@ -195,7 +212,8 @@ AJ_Status AudioVolumeInterfaceOnGetProperty(AJ_Message* replyMsg, const char* ob
             bool mute;
             if (lt && lt->OnGetMute) {
                 status = lt->OnGetMute(objPath, &mute);
-                if (status == AJ_OK) {
+                if (status == AJ_OK && !CdmIsReplyDeferred()) {
+                    CdmMarkValuePulled();
                     props->mute = mute;
                 }
             }
@@ -23,6 +23,8 @@ const char* const intfDescOperationAudioVolume[6];
 
 AJ_Status CreateAudioVolumeInterface(void** properties);
 void DestroyAudioVolumeInterface(void* properties);
+AJ_Status AudioVolumeInterfaceSaveProperties(void* properties, CdmSnapshotWriter* writer);
+AJ_Status AudioVolumeInterfaceLoadProperties(void* properties, CdmSnapshotReader* reader);
 AJ_Status AudioVolumeInterfaceOnGetProperty(AJ_Message* replyMsg, const char* objPath, void* properties, uint8_t memberIndex, void* listener);
 AJ_Status AudioVolumeInterfaceOnSetProperty(AJ_Message* replyMsg, const char* objPath, void* properties, uint8_t memberIndex, void* listener, bool* propChanged);
 AJ_Status AudioVolumeInterfaceEmitPropertiesChanged(AJ_BusAttachment* busAttachment, const char* objPath, void* properties, uint8_t memberIndex);
@@ -56,10 +56,25 @@ void DestroyBatteryStatusInterface(void* properties)
     }
 }
 
+AJ_Status BatteryStatusInterfaceSaveProperties(void* properties, CdmSnapshotWriter* writer)
+{
+    return CdmSnapshotWrite(writer, properties, sizeof(BatteryStatusProperties));
+}
+
+AJ_Status BatteryStatusInterfaceLoadProperties(void* properties, CdmSnapshotReader* reader)
+{
+    if (reader->size != sizeof(BatteryStatusProperties)) {
+        return AJ_ERR_INVALID;
+    }
+
+    return CdmSnapshotRead(reader, properties, sizeof(BatteryStatusProperties));
+}
+
 static AJ_Status EmitPropChanged(AJ_BusAttachment* busAttachment, const char* objPath, const char* propName, const char* signature, void* val)
 {
     AJ_Status status = AJ_OK;
     uint32_t msgId = 0;
+    CdmPropChangedTarget target = { 0, 0, 0 };
     AJ_Message msg;
     AJ_Arg array, strc;
 
@@ -68,8 +83,8 @@ static AJ_Status EmitPropChanged(AJ_BusAttachment* busAttachment, const char* ob
     }
 
     status = MakePropChangedId(objPath, &msgId);
-    if (status == AJ_OK) {
-        AJ_MarshalSignal(busAttachment, &msg, msgId, NULL, 0, AJ_FLAG_GLOBAL_BROADCAST, 0);
+    while (status == AJ_OK && CdmNextPropChangedTarget(msgId, &target)) {
+        AJ_MarshalSignal(busAttachment, &msg, msgId, NULL, target.sessionId, target.flags, 0);
         AJ_MarshalArgs(&msg, "s", intfDescOperationBatteryStatus[0]+1); //To remove '$'
         AJ_MarshalContainer(&msg, &array, AJ_ARG_ARRAY);
         AJ_MarshalContainer(&msg, &strc, AJ_ARG_DICT_ENTRY);
@@ -114,7 +129,8 @@ AJ_Status BatteryStatusInterfaceOnGetProperty(AJ_Message* replyMsg, const char*
             uint8_t currentValue;
             if (lt && lt->OnGetCurrentValue) {
                 status = lt->OnGetCurrentValue(objPath, &currentValue);
-                if (status == AJ_OK) {
+                if (status == AJ_OK && !CdmIsReplyDeferred()) {
+                    CdmMarkValuePulled();
                     props->currentValue = currentValue;
                 }
             }
@@ -126,7 +142,8 @@ AJ_Status BatteryStatusInterfaceOnGetProperty(AJ_Message* replyMsg, const char*
             bool isCharging;
             if (lt && lt->OnGetIsCharging) {
                 status = lt->OnGetIsCharging(objPath, &isCharging);
-                if (status == AJ_OK) {
+                if (status == AJ_OK && !CdmIsReplyDeferred()) {
+                    CdmMarkValuePulled();
                     props->isCharging = isCharging;
                 }
             }
@@ -23,6 +23,8 @@ const char* const intfDescOperationBatteryStatus[5];
 
 AJ_Status CreateBatteryStatusInterface(void** properties);
 void DestroyBatteryStatusInterface(void* properties);
+AJ_Status BatteryStatusInterfaceSaveProperties(void* properties, CdmSnapshotWriter* writer);
+AJ_Status BatteryStatusInterfaceLoadProperties(void* properties, CdmSnapshotReader* reader);
 AJ_Status BatteryStatusInterfaceOnGetProperty(AJ_Message* replyMsg, const char* objPath, void* properties, uint8_t memberIndex, void* listener);
 
 #endif /* BATTERYSTATUSIMPL_H_ */
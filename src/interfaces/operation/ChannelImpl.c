@@ -17,6 +17,7 @@
 #include <string.h>
 #include <ajtcl/cdm/interfaces/operation/Channel.h>
 #include "../../CdmControllee/CdmControlleeImpl.h"
+#include "../CdmStringPropertyImpl.h"
 #include "ChannelImpl.h"
 
 #define INTERFACE_VERSION 1
@@ -31,12 +32,118 @@ const char* const intfDescOperationChannel[] = {
     NULL
 };
 
+#define CHANNEL_TABLE_FIELDS 3
+
 typedef struct {
     uint16_t version;
-    char* channelId;
+    CdmStringProperty channelId;
     uint16_t totalNumberOfChannels;
+    uint8_t* channelTable; //(channelId, channelNumber, channelName) offsets of each channel followed by the string arena
+    size_t channelTableSize;
+    uint16_t channelTableCount;
+    uint32_t channelTableHash;
 } ChannelProperties;
 
+static uint32_t HashChannelTable(const uint8_t* table, size_t size)
+{
+    uint32_t hash = 2166136261u;
+    size_t i = 0;
+
+    for (i = 0; i < size; i++) {
+        hash ^= table[i];
+        hash *= 16777619u;
+    }
+
+    return hash;
+}
+
+static AJ_Status BuildChannelTable(const ChannelInfoRecord* channels, uint16_t numChannels, uint8_t** table, size_t* tableSize)
+{
+    size_t offsetsSize = sizeof(uint32_t) * CHANNEL_TABLE_FIELDS * numChannels;
+    size_t size = offsetsSize;
+    uint32_t* offsets = NULL;
+    char* arena = NULL;
+    uint16_t i = 0;
+    uint8_t j = 0;
+
+    for (i = 0; i < numChannels; i++) {
+        const char* fields[CHANNEL_TABLE_FIELDS] = { channels[i].channelId, channels[i].channelNumber, channels[i].channelName };
+        for (j = 0; j < CHANNEL_TABLE_FIELDS; j++) {
+            size += (fields[j] ? strlen(fields[j]) : 0) + 1;
+        }
+    }
+
+    if (size > UINT32_MAX) {
+        return AJ_ERR_RANGE;
+    }
+
+    *table = (uint8_t*)malloc(size ? size : 1);
+    if (!(*table)) {
+        return AJ_ERR_RESOURCES;
+    }
+    *tableSize = size;
+
+    offsets = (uint32_t*)*table;
+    arena = (char*)*table;
+    size = offsetsSize;
+    for (i = 0; i < numChannels; i++) {
+        const char* fields[CHANNEL_TABLE_FIELDS] = { channels[i].channelId, channels[i].channelNumber, channels[i].channelName };
+        for (j = 0; j < CHANNEL_TABLE_FIELDS; j++) {
+            size_t len = fields[j] ? strlen(fields[j]) : 0;
+            offsets[i * CHANNEL_TABLE_FIELDS + j] = (uint32_t)size;
+            if (len) {
+                memcpy(arena + size, fields[j], len);
+            }
+            arena[size + len] = '\0';
+            size += len + 1;
+        }
+    }
+
+    return AJ_OK;
+}
+
+static const char* GetChannelTableString(const ChannelProperties* props, uint16_t record, uint8_t field)
+{
+    const uint32_t* offsets = (const uint32_t*)props->channelTable;
+
+    return (const char*)props->channelTable + offsets[record * CHANNEL_TABLE_FIELDS + field];
+}
+
+static AJ_Status ReplyChannelListFromTable(AJ_Message* msg, const ChannelProperties* props)
+{
+    AJ_Status status = AJ_OK;
+    uint16_t startingRecord, numOfRecords;
+    AJ_Message reply;
+
+    status = AJ_UnmarshalArgs(msg, "qq", &startingRecord, &numOfRecords);
+    if (status != AJ_OK) {
+        return status;
+    }
+
+    AJ_MarshalReplyMsg(msg, &reply);
+    if (startingRecord >= props->channelTableCount) {
+        AJ_MarshalErrorMsgWithInfo(msg, &reply, GetInterfaceErrorName(INVALID_VALUE), GetInterfaceErrorMessage(INVALID_VALUE));
+    } else {
+        AJ_Arg array, strc;
+        uint16_t end = props->channelTableCount;
+        uint16_t i = 0;
+
+        if (numOfRecords < props->channelTableCount - startingRecord) {
+            end = startingRecord + numOfRecords;
+        }
+
+        AJ_MarshalContainer(&reply, &array, AJ_ARG_ARRAY);
+        for (i = startingRecord; i < end; i++) {
+            AJ_MarshalContainer(&reply, &strc, AJ_ARG_STRUCT);
+            AJ_MarshalArgs(&reply, "sss", GetChannelTableString(props, i, 0), GetChannelTableString(props, i, 1), GetChannelTableString(props, i, 2));
+            AJ_MarshalCloseContainer(&reply, &strc);
+        }
+        AJ_MarshalCloseContainer(&reply, &array);
+    }
+
+    return AJ_DeliverMsg(&reply);
+}
+
 AJ_Status CreateChannelInterface(void** properties)
 {
     *properties = malloc(sizeof(ChannelProperties));
@@ -54,18 +161,82 @@ void DestroyChannelInterface(void* properties)
 {
     if (properties) {
         ChannelProperties* props = (ChannelProperties*) properties;
-        if (props->channelId) {
-            free(props->channelId);
+        CdmStringPropertyClear(&props->channelId);
+        if (props->channelTable) {
+            free(props->channelTable);
         }
 
         free(props);
     }
 }
 
+AJ_Status ChannelInterfaceSaveProperties(void* properties, CdmSnapshotWriter* writer)
+{
+    AJ_Status status = AJ_OK;
+    ChannelProperties* props = (ChannelProperties*)properties;
+
+    status = CdmStringPropertySave(&props->channelId, writer);
+    if (status == AJ_OK) {
+        status = CdmSnapshotWrite(writer, &props->totalNumberOfChannels, sizeof(props->totalNumberOfChannels));
+    }
+    if (status == AJ_OK) {
+        status = CdmSnapshotWrite(writer, &props->channelTableCount, sizeof(props->channelTableCount));
+    }
+    if (status == AJ_OK) {
+        status = CdmSnapshotWriteArray(writer, props->channelTable, sizeof(uint8_t), props->channelTableSize);
+    }
+
+    return status;
+}
+
+AJ_Status ChannelInterfaceLoadProperties(void* properties, CdmSnapshotReader* reader)
+{
+    AJ_Status status = AJ_OK;
+    ChannelProperties* props = (ChannelProperties*)properties;
+    CdmStringProperty channelId = { false, 0 };
+    uint16_t totalNumberOfChannels = 0;
+    uint16_t channelTableCount = 0;
+    uint8_t* channelTable = NULL;
+    size_t channelTableSize = 0;
+
+    status = CdmStringPropertyLoad(&channelId, reader);
+    if (status == AJ_OK) {
+        status = CdmSnapshotRead(reader, &totalNumberOfChannels, sizeof(totalNumberOfChannels));
+    }
+    if (status == AJ_OK) {
+        status = CdmSnapshotRead(reader, &channelTableCount, sizeof(channelTableCount));
+    }
+    if (status == AJ_OK) {
+        status = CdmSnapshotReadArray(reader, (void**)&channelTable, sizeof(uint8_t), &channelTableSize);
+    }
+    if (status == AJ_OK && sizeof(uint32_t) * CHANNEL_TABLE_FIELDS * channelTableCount > channelTableSize) {
+        status = AJ_ERR_INVALID;
+    }
+    if (status != AJ_OK) {
+        CdmStringPropertyClear(&channelId);
+        free(channelTable);
+        return status;
+    }
+
+    CdmStringPropertyClear(&props->channelId);
+    props->channelId = channelId;
+    props->totalNumberOfChannels = totalNumberOfChannels;
+    if (props->channelTable) {
+        free(props->channelTable);
+    }
+    props->channelTable = channelTable;
+    props->channelTableSize = channelTableSize;
+    props->channelTableCount = channelTableCount;
+    props->channelTableHash = HashChannelTable(channelTable, channelTableSize);
+
+    return AJ_OK;
+}
+
 static AJ_Status EmitPropChanged(AJ_BusAttachment* busAttachment, const char* objPath, const char* propName, const char* signature, void* val)
 {
     AJ_Status status = AJ_OK;
     uint32_t msgId = 0;
+    CdmPropChangedTarget target = { 0, 0, 0 };
     AJ_Message msg;
     AJ_Arg array, strc;
 
@@ -74,8 +245,8 @@ static AJ_Status EmitPropChanged(AJ_BusAttachment* busAttachment, const char* ob
     }
 
     status = MakePropChangedId(objPath, &msgId);
-    if (status == AJ_OK) {
-        AJ_MarshalSignal(busAttachment, &msg, msgId, NULL, 0, AJ_FLAG_GLOBAL_BROADCAST, 0);
+    while (status == AJ_OK && CdmNextPropChangedTarget(msgId, &target)) {
+        AJ_MarshalSignal(busAttachment, &msg, msgId, NULL, target.sessionId, target.flags, 0);
         AJ_MarshalArgs(&msg, "s", intfDescOperationChannel[0] + 1);  //To remove '$'
         AJ_MarshalContainer(&msg, &array, AJ_ARG_ARRAY);
         AJ_MarshalContainer(&msg, &strc, AJ_ARG_DICT_ENTRY);
@@ -109,7 +280,7 @@ AJ_Status ChannelInterfaceEmitPropertiesChanged(AJ_BusAttachment* busAttachment,
 
     switch (memberIndex) {
     case 1:
-        status = EmitPropChanged(busAttachment, objPath, "ChannelId", "s", props->channelId);
+        status = EmitPropChanged(busAttachment, objPath, "ChannelId", "s", (void*)CdmStringPropertyGet(&props->channelId));
         break;
     default:
         status = AJ_ERR_INVALID;
@@ -141,29 +312,26 @@ AJ_Status ChannelInterfaceOnGetProperty(AJ_Message* replyMsg, const char* objPat
         char channelId[128];  //?? how estimate proper buffer size when the listener is exist
         if (lt && lt->OnGetChannelId) {
             status = lt->OnGetChannelId(objPath, channelId);
-            if (status == AJ_OK) {
-                if (props->channelId) {
-                    free(props->channelId);
-                }
-                props->channelId = (char*) malloc(strlen(channelId) + 1);
-                if (!props->channelId) {
-                    return AJ_ERR_RESOURCES;
+            if (status == AJ_OK && !CdmIsReplyDeferred()) {
+                CdmMarkValuePulled();
+                status = CdmStringPropertySet(&props->channelId, channelId, NULL);
+                if (status != AJ_OK) {
+                    return status;
                 }
-                strncpy(props->channelId, channelId, strlen(channelId));
-                props->channelId[strlen(channelId)] = '\0';
             }
         }
-        if (!props->channelId) {
+        if (!CdmStringPropertyGet(&props->channelId)) {
             return AJ_ERR_NULL;
         }
-        status = AJ_MarshalArgs(replyMsg, "s", props->channelId);
+        status = AJ_MarshalArgs(replyMsg, "s", CdmStringPropertyGet(&props->channelId));
     }
         break;
     case 2: {
         uint16_t totalNumberOfChannels;
         if (lt && lt->OnGetTotalNumberOfChannels) {
             status = lt->OnGetTotalNumberOfChannels(objPath, &totalNumberOfChannels);
-            if (status == AJ_OK) {
+            if (status == AJ_OK && !CdmIsReplyDeferred()) {
+                CdmMarkValuePulled();
                 props->totalNumberOfChannels = totalNumberOfChannels;
             }
         }
@@ -207,19 +375,7 @@ AJ_Status ChannelInterfaceOnSetProperty(AJ_Message* replyMsg, const char* objPat
                 status = lt->OnSetChannelId(objPath, channelId);
 
                 if (status == AJ_OK) {
-                    if (strcmp(props->channelId, channelId)) {
-                        if (props->channelId) {
-                            free(props->channelId);
-                        }
-                        props->channelId = (char*) malloc(strlen(channelId) + 1);
-                        if (!props->channelId) {
-                            status = AJ_ERR_RESOURCES;
-                        } else {
-                            strncpy(props->channelId, channelId, strlen(channelId));
-                            props->channelId[strlen(channelId)] = '\0';
-                            *propChanged = true;
-                        }
-                    }
+                    status = CdmStringPropertySet(&props->channelId, channelId, propChanged);
                 }
             }
         }
@@ -247,10 +403,13 @@ AJ_Status ChannelInterfaceOnMethodHandler(AJ_Message* msg, const char* objPath,
     }
 
     ChannelListener* lt = (ChannelListener*)listener;
+    ChannelProperties* props = (ChannelProperties*)propChangedByMethod->properties;
 
     switch (memberIndex) {
     case 3:
-        if (!lt->OnGetChannelList) {
+        if (props && props->channelTable) {
+            status = ReplyChannelListFromTable(msg, props);
+        } else if (!lt->OnGetChannelList) {
             status = AJ_ERR_NULL;
         } else {
             uint16_t startingRecord, numOfRecords;
@@ -304,11 +463,7 @@ AJ_Status Cdm_ChannelInterfaceGetChannelId(const char* objPath, char* channelId)
 
     props = (ChannelProperties*) GetProperties(objPath, CHANNEL_INTERFACE);
     if (props) {
-        if (!props->channelId) {
-            return AJ_ERR_NULL;
-        }
-        strncpy(channelId, props->channelId, strlen(props->channelId));
-        channelId[strlen(props->channelId)] = '\0';
+        status = CdmStringPropertyCopy(&props->channelId, channelId);
     } else {
         status = AJ_ERR_NO_MATCH;
     }
@@ -331,17 +486,11 @@ AJ_Status Cdm_ChannelInterfaceSetChannelId(AJ_BusAttachment* busAttachment, cons
 
     props = (ChannelProperties*) GetProperties(objPath, CHANNEL_INTERFACE);
     if (props) {
-        if (props->channelId) {
-            free(props->channelId);
-        }
-        props->channelId = (char*) malloc(strlen(channelId) + 1);
-        if (!props->channelId) {
-            status = AJ_ERR_RESOURCES;
-        } else {
-            strncpy(props->channelId, channelId, strlen(channelId));
-            props->channelId[strlen(channelId)] = '\0';
+        bool changed = false;
 
-            status = EmitPropChanged(busAttachment, objPath, "ChannelId", "s", props->channelId);
+        status = CdmStringPropertySet(&props->channelId, channelId, &changed);
+        if (status == AJ_OK && changed) {
+            status = EmitPropChanged(busAttachment, objPath, "ChannelId", "s", (void*)CdmStringPropertyGet(&props->channelId));
         }
     } else {
         status = AJ_ERR_NO_MATCH;
@@ -350,6 +499,25 @@ AJ_Status Cdm_ChannelInterfaceSetChannelId(AJ_BusAttachment* busAttachment, cons
     return status;
 }
 
+AJ_Status Cdm_ChannelInterfaceBorrowChannelId(const char* objPath, const char** channelId, size_t* length)
+{
+    AJ_Status status = AJ_OK;
+    ChannelProperties* props = NULL;
+
+    if (!channelId) {
+        return AJ_ERR_INVALID;
+    }
+
+    props = (ChannelProperties*) GetProperties(objPath, CHANNEL_INTERFACE);
+    if (props) {
+        status = CdmStringPropertyBorrow(&props->channelId, channelId, length);
+    } else {
+        status = AJ_ERR_NO_MATCH;
+    }
+
+    return status;
+}
+
 AJ_Status Cdm_ChannelInterfaceGetTotalNumberOfChannels(const char* objPath, uint16_t* totalNumberOfChannels)
 {
     AJ_Status status = AJ_OK;
@@ -405,3 +573,56 @@ AJ_Status Cdm_ChannelInterfaceEmitChannelListChanged(AJ_BusAttachment* busAttach
 
     return AJ_DeliverMsg(&msg);
 }
+
+AJ_Status Cdm_ChannelInterfaceLoadChannelList(AJ_BusAttachment* busAttachment, const char* objPath, const ChannelInfoRecord* channels, const uint16_t numChannels)
+{
+    AJ_Status status = AJ_OK;
+    ChannelProperties* props = NULL;
+    uint8_t* table = NULL;
+    size_t tableSize = 0;
+    uint32_t hash = 0;
+
+    if (!busAttachment) {
+        return AJ_ERR_INVALID;
+    }
+
+    if (!channels && numChannels > 0) {
+        return AJ_ERR_INVALID;
+    }
+
+    props = (ChannelProperties*) GetProperties(objPath, CHANNEL_INTERFACE);
+    if (!props) {
+        return AJ_ERR_NO_MATCH;
+    }
+
+    status = BuildChannelTable(channels, numChannels, &table, &tableSize);
+    if (status != AJ_OK) {
+        return status;
+    }
+    hash = HashChannelTable(table, tableSize);
+
+    if (props->channelTable && props->channelTableHash == hash && props->channelTableSize == tableSize &&
+        !memcmp(props->channelTable, table, tableSize)) {
+        free(table);
+        return AJ_OK;
+    }
+
+    if (props->channelTable) {
+        free(props->channelTable);
+    }
+    props->channelTable = table;
+    props->channelTableSize = tableSize;
+    props->channelTableCount = numChannels;
+    props->channelTableHash = hash;
+
+    if (props->totalNumberOfChannels != numChannels) {
+        props->totalNumberOfChannels = numChannels;
+        status = EmitPropChanged(busAttachment, objPath, "TotalNumberOfChannels", "q", &(props->totalNumberOfChannels));
+    }
+
+    if (status == AJ_OK) {
+        status = Cdm_ChannelInterfaceEmitChannelListChanged(busAttachment, objPath, 0);
+    }
+
+    return status;
+}
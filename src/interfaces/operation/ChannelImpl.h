@@ -23,6 +23,8 @@ const char* const intfDescOperationChannel[7];
 
 AJ_Status CreateChannelInterface(void** properties);
 void DestroyChannelInterface(void* properties);
+AJ_Status ChannelInterfaceSaveProperties(void* properties, CdmSnapshotWriter* writer);
+AJ_Status ChannelInterfaceLoadProperties(void* properties, CdmSnapshotReader* reader);
 AJ_Status ChannelInterfaceOnGetProperty(AJ_Message* replyMsg, const char* objPath, void* properties, uint8_t memberIndex, void* listener);
 AJ_Status ChannelInterfaceOnSetProperty(AJ_Message* replyMsg, const char* objPath, void* properties, uint8_t memberIndex, void* listener, bool* propChanged);
 AJ_Status ChannelInterfaceEmitPropertiesChanged(AJ_BusAttachment* busAttachment, const char* objPath, void* properties, uint8_t memberIndex);
@@ -92,10 +92,59 @@ void DestroyClimateControlModeInterface(void* properties)
     }
 }
 
+AJ_Status ClimateControlModeInterfaceSaveProperties(void* properties, CdmSnapshotWriter* writer)
+{
+    AJ_Status status = AJ_OK;
+    ClimateControlModeProperties* props = (ClimateControlModeProperties*)properties;
+
+    status = CdmSnapshotWrite(writer, &props->mode, sizeof(props->mode));
+    if (status == AJ_OK) {
+        status = CdmSnapshotWrite(writer, &props->operationalState, sizeof(props->operationalState));
+    }
+    if (status == AJ_OK) {
+        status = CdmSnapshotWriteArray(writer, props->supportedModes, sizeof(uint16_t), listSize);
+    }
+
+    return status;
+}
+
+AJ_Status ClimateControlModeInterfaceLoadProperties(void* properties, CdmSnapshotReader* reader)
+{
+    AJ_Status status = AJ_OK;
+    ClimateControlModeProperties* props = (ClimateControlModeProperties*)properties;
+    uint16_t mode = 0;
+    uint16_t operationalState = 0;
+    uint16_t* supportedModes = NULL;
+    size_t supportedModesListSize = 0;
+
+    status = CdmSnapshotRead(reader, &mode, sizeof(mode));
+    if (status == AJ_OK) {
+        status = CdmSnapshotRead(reader, &operationalState, sizeof(operationalState));
+    }
+    if (status == AJ_OK) {
+        status = CdmSnapshotReadArray(reader, (void**)&supportedModes, sizeof(uint16_t), &supportedModesListSize);
+    }
+    if (status != AJ_OK) {
+        free(supportedModes);
+        return status;
+    }
+
+    props->mode = mode;
+    props->operationalState = operationalState;
+    if (props->supportedModes) {
+        free(props->supportedModes);
+    }
+    props->supportedModes = supportedModes;
+    listSize = supportedModesListSize;
+
+    return AJ_OK;
+}
+
 static AJ_Status EmitPropChanged(AJ_BusAttachment* busAttachment, const char* objPath, const char* propName, const char* signature, void* val)
 {
     AJ_Status status = AJ_OK;
     uint32_t msgId = 0;
+    CdmPropChangedTarget target = { 0, 0, 0 };
     AJ_Message msg;
     AJ_Arg array, strc;
 
@@ -104,8 +153,8 @@ static AJ_Status EmitPropChanged(AJ_BusAttachment* busAttachment, const char* ob
     }
 
     status = MakePropChangedId(objPath, &msgId);
-    if (status == AJ_OK) {
-        AJ_MarshalSignal(busAttachment, &msg, msgId, NULL, 0, AJ_FLAG_GLOBAL_BROADCAST, 0);
+    while (status == AJ_OK && CdmNextPropChangedTarget(msgId, &target)) {
+        AJ_MarshalSignal(busAttachment, &msg, msgId, NULL, target.sessionId, target.flags, 0);
         AJ_MarshalArgs(&msg, "s", intfDescOperationClimateControlMode[0]+1); //To remove '$'
         AJ_MarshalContainer(&msg, &array, AJ_ARG_ARRAY);
         AJ_MarshalContainer(&msg, &strc, AJ_ARG_DICT_ENTRY);
@@ -172,7 +221,8 @@ AJ_Status ClimateControlModeInterfaceOnGetProperty(AJ_Message* replyMsg, const c
             uint16_t mode;
             if (lt && lt->OnGetMode) {
                 status = lt->OnGetMode(objPath, &mode);
-                if (status == AJ_OK) {
+                if (status == AJ_OK && !CdmIsReplyDeferred()) {
+                    CdmMarkValuePulled();
                     props->mode = mode;
                 }
             }
@@ -184,7 +234,8 @@ AJ_Status ClimateControlModeInterfaceOnGetProperty(AJ_Message* replyMsg, const c
             uint16_t* supportedModes = (uint16_t*)malloc(sizeof(uint16_t) * listSize);
             if (lt && lt->OnGetSupportedModes) {
                 status = lt->OnGetSupportedModes(objPath, supportedModes);
-                if (status == AJ_OK) {
+                if (status == AJ_OK && !CdmIsReplyDeferred()) {
+                    CdmMarkValuePulled();
                     if (props->supportedModes) {
                         free(props->supportedModes);
                     }
@@ -207,7 +258,8 @@ AJ_Status ClimateControlModeInterfaceOnGetProperty(AJ_Message* replyMsg, const c
             uint16_t operationalState;
             if (lt && lt->OnGetOperationalState) {
                 status = lt->OnGetOperationalState(objPath, &operationalState);
-                if (status == AJ_OK) {
+                if (status == AJ_OK && !CdmIsReplyDeferred()) {
+                    CdmMarkValuePulled();
                     props->operationalState = operationalState;
                 }
             }
@@ -23,6 +23,8 @@ const char* const intfDescOperationClimateControlMode[6];
 
 AJ_Status CreateClimateControlModeInterface(void** properties);
 void DestroyClimateControlModeInterface(void* properties);
+AJ_Status ClimateControlModeInterfaceSaveProperties(void* properties, CdmSnapshotWriter* writer);
+AJ_Status ClimateControlModeInterfaceLoadProperties(void* properties, CdmSnapshotReader* reader);
 AJ_Status ClimateControlModeInterfaceOnGetProperty(AJ_Message* replyMsg, const char* objPath, void* properties, uint8_t memberIndex, void* listener);
 AJ_Status ClimateControlModeInterfaceOnSetProperty(AJ_Message* replyMsg, const char* objPath, void* properties, uint8_t memberIndex, void* listener, bool* propChanged);
 AJ_Status ClimateControlModeInterfaceEmitPropertiesChanged(AJ_BusAttachment* busAttachment, const char* objPath, void* properties, uint8_t memberIndex);
@@ -54,10 +54,25 @@ void DestroyClosedStatusInterface(void* properties)
     }
 }
 
+AJ_Status ClosedStatusInterfaceSaveProperties(void* properties, CdmSnapshotWriter* writer)
+{
+    return CdmSnapshotWrite(writer, properties, sizeof(ClosedStatusProperties));
+}
+
+AJ_Status ClosedStatusInterfaceLoadProperties(void* properties, CdmSnapshotReader* reader)
+{
+    if (reader->size != sizeof(ClosedStatusProperties)) {
+        return AJ_ERR_INVALID;
+    }
+
+    return CdmSnapshotRead(reader, properties, sizeof(ClosedStatusProperties));
+}
+
 static AJ_Status EmitPropChanged(AJ_BusAttachment* busAttachment, const char* objPath, const char* propName, const char* signature, void* val)
 {
     AJ_Status status = AJ_OK;
     uint32_t msgId = 0;
+    CdmPropChangedTarget target = { 0, 0, 0 };
     AJ_Message msg;
     AJ_Arg array, strc;
 
@@ -66,8 +81,8 @@ static AJ_Status EmitPropChanged(AJ_BusAttachment* busAttachment, const char* ob
     }
 
     status = MakePropChangedId(objPath, &msgId);
-    if (status == AJ_OK) {
-        AJ_MarshalSignal(busAttachment, &msg, msgId, NULL, 0, AJ_FLAG_GLOBAL_BROADCAST, 0);
+    while (status == AJ_OK && CdmNextPropChangedTarget(msgId, &target)) {
+        AJ_MarshalSignal(busAttachment, &msg, msgId, NULL, target.sessionId, target.flags, 0);
         AJ_MarshalArgs(&msg, "s", intfDescOperationClosedStatus[0]+1); //To remove '$'
         AJ_MarshalContainer(&msg, &array, AJ_ARG_ARRAY);
         AJ_MarshalContainer(&msg, &strc, AJ_ARG_DICT_ENTRY);
@@ -110,7 +125,8 @@ AJ_Status ClosedStatusInterfaceOnGetProperty(AJ_Message* replyMsg, const char* o
             bool isClosed;
             if (lt && lt->OnGetIsClosed) {
                 status = lt->OnGetIsClosed(objPath, &isClosed);
-                if (status == AJ_OK) {
+                if (status == AJ_OK && !CdmIsReplyDeferred()) {
+                    CdmMarkValuePulled();
                     props->isClosed = isClosed;
                 }
             }
@@ -23,6 +23,8 @@ const char* const intfDescOperationClosedStatus[4];
 
 AJ_Status CreateClosedStatusInterface(void** properties);
 void DestroyClosedStatusInterface(void* properties);
+AJ_Status ClosedStatusInterfaceSaveProperties(void* properties, CdmSnapshotWriter* writer);
+AJ_Status ClosedStatusInterfaceLoadProperties(void* properties, CdmSnapshotReader* reader);
 AJ_Status ClosedStatusInterfaceOnGetProperty(AJ_Message* replyMsg, const char* objPath, void* properties, uint8_t memberIndex, void* listener);
 
 #endif // CLOSEDSTATUSIMPL_H_
@@ -14,8 +14,11 @@
  *    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
  ******************************************************************************/
 
+#include <stddef.h>
 #include <ajtcl/cdm/interfaces/operation/CurrentPower.h>
 #include "../../CdmControllee/CdmControlleeImpl.h"
+#include "../CdmSignalTemplateImpl.h"
+#include "../CdmSensorHistoryImpl.h"
 #include "CurrentPowerImpl.h"
 
 #define INTERFACE_VERSION 1
@@ -34,6 +37,7 @@ typedef struct {
     double currentPower;
     double precision;
     uint16_t updateMinTime;
+    CdmSignalTemplate currentPowerSignal;
 } CurrentPowerProperties;
 
 AJ_Status CreateCurrentPowerInterface(void** properties)
@@ -54,14 +58,30 @@ void DestroyCurrentPowerInterface(void* properties)
     if (properties) {
         CurrentPowerProperties* props = (CurrentPowerProperties*)properties;
 
+        CdmSignalTemplateClear(&props->currentPowerSignal);
         free(props);
     }
 }
 
+AJ_Status CurrentPowerInterfaceSaveProperties(void* properties, CdmSnapshotWriter* writer)
+{
+    return CdmSnapshotWrite(writer, properties, offsetof(CurrentPowerProperties, currentPowerSignal));
+}
+
+AJ_Status CurrentPowerInterfaceLoadProperties(void* properties, CdmSnapshotReader* reader)
+{
+    if (reader->size != offsetof(CurrentPowerProperties, currentPowerSignal)) {
+        return AJ_ERR_INVALID;
+    }
+
+    return CdmSnapshotRead(reader, properties, offsetof(CurrentPowerProperties, currentPowerSignal));
+}
+
 static AJ_Status EmitPropChanged(AJ_BusAttachment* busAttachment, const char* objPath, const char* propName, const char* signature, void* val)
 {
     AJ_Status status = AJ_OK;
     uint32_t msgId = 0;
+    CdmPropChangedTarget target = { 0, 0, 0 };
     AJ_Message msg;
     AJ_Arg array, strc;
 
@@ -70,8 +90,8 @@ static AJ_Status EmitPropChanged(AJ_BusAttachment* busAttachment, const char* ob
     }
 
     status = MakePropChangedId(objPath, &msgId);
-    if (status == AJ_OK) {
-        AJ_MarshalSignal(busAttachment, &msg, msgId, NULL, 0, AJ_FLAG_GLOBAL_BROADCAST, 0);
+    while (status == AJ_OK && CdmNextPropChangedTarget(msgId, &target)) {
+        AJ_MarshalSignal(busAttachment, &msg, msgId, NULL, target.sessionId, target.flags, 0);
         AJ_MarshalArgs(&msg, "s", intfDescOperationCurrentPower[0]+1); //To remove '$'
         AJ_MarshalContainer(&msg, &array, AJ_ARG_ARRAY);
         AJ_MarshalContainer(&msg, &strc, AJ_ARG_DICT_ENTRY);
@@ -117,7 +137,8 @@ AJ_Status CurrentPowerInterfaceOnGetProperty(AJ_Message* replyMsg, const char* o
 
             if (lt && lt->OnGetCurrentPower) {
                 status = lt->OnGetCurrentPower(objPath, &currentPower);
-                if (status == AJ_OK) {
+                if (status == AJ_OK && !CdmIsReplyDeferred()) {
+                    CdmMarkValuePulled();
                     props->currentPower = currentPower;
                 }
             }
@@ -131,7 +152,8 @@ AJ_Status CurrentPowerInterfaceOnGetProperty(AJ_Message* replyMsg, const char* o
 
             if (lt && lt->OnGetPrecision) {
                 status = lt->OnGetPrecision(objPath, &precision);
-                if (status == AJ_OK) {
+                if (status == AJ_OK && !CdmIsReplyDeferred()) {
+                    CdmMarkValuePulled();
                     props->precision = precision;
                 }
             }
@@ -145,7 +167,8 @@ AJ_Status CurrentPowerInterfaceOnGetProperty(AJ_Message* replyMsg, const char* o
 
             if (lt && lt->OnGetUpdateMinTime) {
                 status = lt->OnGetUpdateMinTime(objPath, &updateMinTime);
-                if (status == AJ_OK) {
+                if (status == AJ_OK && !CdmIsReplyDeferred()) {
+                    CdmMarkValuePulled();
                     props->updateMinTime = updateMinTime;
                 }
             }
@@ -191,9 +214,11 @@ AJ_Status Cdm_CurrentPowerInterfaceSetCurrentPower(AJ_BusAttachment* busAttachme
 
     props = (CurrentPowerProperties*)GetProperties(objPath, CURRENT_POWER_INTERFACE);
     if (props) {
+        CdmSensorHistoryRecord(objPath, CURRENT_POWER_INTERFACE, currentPower);
+
         props->currentPower = currentPower;
 
-        status = EmitPropChanged(busAttachment, objPath, "CurrentPower", "d", &(props->currentPower));
+        status = CdmSignalTemplateEmit(busAttachment, objPath, &props->currentPowerSignal, intfDescOperationCurrentPower[0]+1, "CurrentPower", "d", &(props->currentPower));
     } else {
         status = AJ_ERR_NO_MATCH;
     }
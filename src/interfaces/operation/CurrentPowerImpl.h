@@ -23,6 +23,8 @@ const char* const intfDescOperationCurrentPower[6];
 
 AJ_Status CreateCurrentPowerInterface(void** properties);
 void DestroyCurrentPowerInterface(void* properties);
+AJ_Status CurrentPowerInterfaceSaveProperties(void* properties, CdmSnapshotWriter* writer);
+AJ_Status CurrentPowerInterfaceLoadProperties(void* properties, CdmSnapshotReader* reader);
 AJ_Status CurrentPowerInterfaceOnGetProperty(AJ_Message* replyMsg, const char* objPath, void* properties, uint8_t memberIndex, void* listener);
 
 #endif /* CURRENTPOWERIMPL_H_ */
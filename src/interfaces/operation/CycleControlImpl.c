@@ -17,6 +17,8 @@
 #include <string.h>
 #include <ajtcl/cdm/interfaces/operation/CycleControl.h>
 #include "../../CdmControllee/CdmControlleeImpl.h"
+#include "../CdmArrayBufferImpl.h"
+#include "../CdmValueSetImpl.h"
 #include "CycleControlImpl.h"
 
 #define INTERFACE_VERSION 1
@@ -39,11 +41,15 @@ typedef struct {
     uint8_t operationalState;
     uint8_t* supportedOperationalStates;
     uint8_t* supportedOperationalCommands;
+    CdmValueSet supportedOperationalStatesSet;
+    CdmValueSet supportedOperationalCommandsSet;
+    size_t statesListSize;
+    size_t statesCapacity;
+    size_t commandsListSize;
+    size_t commandsCapacity;
+    uint32_t statesRevision; //changed whenever supportedOperationalStates are changed, to tell if a borrowed list is stale
 } CycleControlProperties;
 
-static size_t statesListSize = 0;
-static size_t commandsListSize = 0;
-
 AJ_Status CycleControlOperationalStateValidationCheck(const char* objPath, uint8_t operationalState)
 {
     AJ_Status status = AJ_OK;
@@ -51,16 +57,7 @@ AJ_Status CycleControlOperationalStateValidationCheck(const char* objPath, uint8
     props = (CycleControlProperties*)GetProperties(objPath, CYCLE_CONTROL_INTERFACE);
 
     if (props) {
-        int i = 0;
-        bool check = false;
-
-        for (i = 0; i < statesListSize; i++) {
-            if (props->supportedOperationalStates[i] == operationalState) {
-                check = true;
-                break;
-            }
-        }
-        if (!check) {
+        if (!CdmValueSetContains(&props->supportedOperationalStatesSet, operationalState)) {
             status = AJ_ERR_RANGE;
         }
     } else {
@@ -99,10 +96,71 @@ void DestroyCycleControlInterface(void* properties)
     }
 }
 
+AJ_Status CycleControlInterfaceSaveProperties(void* properties, CdmSnapshotWriter* writer)
+{
+    AJ_Status status = AJ_OK;
+    CycleControlProperties* props = (CycleControlProperties*)properties;
+
+    status = CdmSnapshotWrite(writer, &props->operationalState, sizeof(props->operationalState));
+    if (status == AJ_OK) {
+        status = CdmSnapshotWriteArray(writer, props->supportedOperationalStates, sizeof(uint8_t), props->statesListSize);
+    }
+    if (status == AJ_OK) {
+        status = CdmSnapshotWriteArray(writer, props->supportedOperationalCommands, sizeof(uint8_t), props->commandsListSize);
+    }
+
+    return status;
+}
+
+AJ_Status CycleControlInterfaceLoadProperties(void* properties, CdmSnapshotReader* reader)
+{
+    AJ_Status status = AJ_OK;
+    CycleControlProperties* props = (CycleControlProperties*)properties;
+    uint8_t operationalState = 0;
+    uint8_t* supportedOperationalStates = NULL;
+    size_t supportedOperationalStatesListSize = 0;
+    uint8_t* supportedOperationalCommands = NULL;
+    size_t supportedOperationalCommandsListSize = 0;
+    bool changed = false;
+
+    status = CdmSnapshotRead(reader, &operationalState, sizeof(operationalState));
+    if (status == AJ_OK) {
+        status = CdmSnapshotReadArray(reader, (void**)&supportedOperationalStates, sizeof(uint8_t), &supportedOperationalStatesListSize);
+    }
+    if (status == AJ_OK) {
+        status = CdmSnapshotReadArray(reader, (void**)&supportedOperationalCommands, sizeof(uint8_t), &supportedOperationalCommandsListSize);
+    }
+    if (status != AJ_OK) {
+        free(supportedOperationalStates);
+        free(supportedOperationalCommands);
+        return status;
+    }
+
+    props->operationalState = operationalState;
+    status = CdmArrayBufferAssign((void**)&props->supportedOperationalStates, &props->statesListSize, &props->statesCapacity, sizeof(uint8_t),
+                                  supportedOperationalStates, supportedOperationalStatesListSize, &changed);
+    if (status == AJ_OK && changed) {
+        props->statesRevision++;
+        CdmValueSetBuild(&props->supportedOperationalStatesSet, props->supportedOperationalStates, props->statesListSize);
+    }
+    if (status == AJ_OK) {
+        status = CdmArrayBufferAssign((void**)&props->supportedOperationalCommands, &props->commandsListSize, &props->commandsCapacity, sizeof(uint8_t),
+                                      supportedOperationalCommands, supportedOperationalCommandsListSize, &changed);
+    }
+    if (status == AJ_OK && changed) {
+        CdmValueSetBuild(&props->supportedOperationalCommandsSet, props->supportedOperationalCommands, props->commandsListSize);
+    }
+    free(supportedOperationalStates);
+    free(supportedOperationalCommands);
+
+    return status;
+}
+
 static AJ_Status EmitPropChanged(AJ_BusAttachment* busAttachment, const char* objPath, const char* propName, const char* signature, void* val)
 {
     AJ_Status status = AJ_OK;
     uint32_t msgId = 0;
+    CdmPropChangedTarget target = { 0, 0, 0 };
     AJ_Message msg;
     AJ_Arg array, strc;
 
@@ -111,19 +169,21 @@ static AJ_Status EmitPropChanged(AJ_BusAttachment* busAttachment, const char* ob
     }
 
     status = MakePropChangedId(objPath, &msgId);
-    if (status == AJ_OK) {
-        AJ_MarshalSignal(busAttachment, &msg, msgId, NULL, 0, AJ_FLAG_GLOBAL_BROADCAST, 0);
+    while (status == AJ_OK && CdmNextPropChangedTarget(msgId, &target)) {
+        AJ_MarshalSignal(busAttachment, &msg, msgId, NULL, target.sessionId, target.flags, 0);
         AJ_MarshalArgs(&msg, "s", intfDescOperationCycleControl[0]+1); //To remove '$'
         AJ_MarshalContainer(&msg, &array, AJ_ARG_ARRAY);
         AJ_MarshalContainer(&msg, &strc, AJ_ARG_DICT_ENTRY);
         if (!strcmp(signature, "y")) {
             AJ_MarshalArgs(&msg, "sv", propName, signature, *(uint8_t*)val);
         } else if (!strcmp(signature, "ay")) {
+            CycleControlProperties* props = (CycleControlProperties*)val;
+
             if (!strcmp(propName, "SupportedOperationalStates")) {
-                AJ_MarshalArgs(&msg, "sv", propName, signature, (uint8_t*)val, statesListSize);
+                AJ_MarshalArgs(&msg, "sv", propName, signature, props->supportedOperationalStates, props->statesListSize);
             }
             else if (!strcmp(propName, "SupportedOperationalCommands")) {
-                AJ_MarshalArgs(&msg, "sv", propName, signature, (uint8_t*)val, commandsListSize);
+                AJ_MarshalArgs(&msg, "sv", propName, signature, props->supportedOperationalCommands, props->commandsListSize);
             } else {
                 return AJ_ERR_INVALID;
             }
@@ -164,7 +224,8 @@ AJ_Status CycleControlInterfaceOnGetProperty(AJ_Message* replyMsg, const char* o
             uint8_t operationalState;
             if (lt && lt->OnGetOperationalState) {
                 status = lt->OnGetOperationalState(objPath, &operationalState);
-                if (status == AJ_OK) {
+                if (status == AJ_OK && !CdmIsReplyDeferred()) {
+                    CdmMarkValuePulled();
                     props->operationalState = operationalState;
                 }
             }
@@ -173,48 +234,57 @@ AJ_Status CycleControlInterfaceOnGetProperty(AJ_Message* replyMsg, const char* o
         break;
     case 2 :
         {
-            uint8_t* supportedOperationalStates = (uint8_t*)malloc(sizeof(uint8_t) * statesListSize);
-            if (lt && lt->OnGetSupportedOperationalStates) {
-                status = lt->OnGetSupportedOperationalStates(objPath, supportedOperationalStates);
-                if (status == AJ_OK) {
-                    if (props->supportedOperationalStates) {
-                        free(props->supportedOperationalStates);
-                    }
-                    props->supportedOperationalStates = (uint8_t*)malloc(sizeof(uint8_t) * statesListSize);
+            bool changed = false;
 
-                    memcpy(props->supportedOperationalStates, supportedOperationalStates, sizeof(uint8_t) * statesListSize);
-                }
-            }
             if (!props->supportedOperationalStates) {
-                free(supportedOperationalStates);
                 return AJ_ERR_NULL;
             }
+            if (lt && lt->OnGetSupportedOperationalStates) {
+                //the listener fills as many states as are stored
+                uint8_t* supportedOperationalStates = (uint8_t*)CdmArrayBufferScratch(sizeof(uint8_t), props->statesListSize);
+                if (!supportedOperationalStates) {
+                    return AJ_ERR_RESOURCES;
+                }
+                status = lt->OnGetSupportedOperationalStates(objPath, supportedOperationalStates);
+                if (status == AJ_OK && !CdmIsReplyDeferred()) {
+                    CdmMarkValuePulled();
+                    CdmArrayBufferAssign((void**)&props->supportedOperationalStates, &props->statesListSize, &props->statesCapacity, sizeof(uint8_t),
+                                         supportedOperationalStates, props->statesListSize, &changed);
+                }
+                if (changed) {
+                    props->statesRevision++;
+                    CdmValueSetBuild(&props->supportedOperationalStatesSet, props->supportedOperationalStates, props->statesListSize);
+                }
+            }
 
-            status = AJ_MarshalArgs(replyMsg, "ay", props->supportedOperationalStates, sizeof(uint8_t) * statesListSize);
-            free(supportedOperationalStates);
+            status = AJ_MarshalArgs(replyMsg, "ay", props->supportedOperationalStates, sizeof(uint8_t) * props->statesListSize);
         }
         break;
     case 3 :
         {
-            uint8_t* supportedOperationalCommands = (uint8_t*)malloc(sizeof(uint8_t) * commandsListSize);
-            if (lt && lt->OnGetSupportedOperationalCommands) {
-                status = lt->OnGetSupportedOperationalCommands(objPath, supportedOperationalCommands);
-                if (status == AJ_OK) {
-                    if (props->supportedOperationalCommands) {
-                        free(props->supportedOperationalCommands);
-                    }
-                    props->supportedOperationalCommands = (uint8_t*)malloc(sizeof(uint8_t) * commandsListSize);
+            bool changed = false;
 
-                    memcpy(props->supportedOperationalCommands, supportedOperationalCommands, sizeof(uint8_t) * commandsListSize);
-                }
-            }
             if (!props->supportedOperationalCommands) {
-                free(supportedOperationalCommands);
                 return AJ_ERR_NULL;
             }
+            if (lt && lt->OnGetSupportedOperationalCommands) {
+                //the listener fills as many commands as are stored
+                uint8_t* supportedOperationalCommands = (uint8_t*)CdmArrayBufferScratch(sizeof(uint8_t), props->commandsListSize);
+                if (!supportedOperationalCommands) {
+                    return AJ_ERR_RESOURCES;
+                }
+                status = lt->OnGetSupportedOperationalCommands(objPath, supportedOperationalCommands);
+                if (status == AJ_OK && !CdmIsReplyDeferred()) {
+                    CdmMarkValuePulled();
+                    CdmArrayBufferAssign((void**)&props->supportedOperationalCommands, &props->commandsListSize, &props->commandsCapacity, sizeof(uint8_t),
+                                         supportedOperationalCommands, props->commandsListSize, &changed);
+                }
+                if (changed) {
+                    CdmValueSetBuild(&props->supportedOperationalCommandsSet, props->supportedOperationalCommands, props->commandsListSize);
+                }
+            }
 
-            status = AJ_MarshalArgs(replyMsg, "ay", props->supportedOperationalCommands, sizeof(uint8_t) * commandsListSize);
-            free(supportedOperationalCommands);
+            status = AJ_MarshalArgs(replyMsg, "ay", props->supportedOperationalCommands, sizeof(uint8_t) * props->commandsListSize);
         }
         break;
     default:
@@ -237,6 +307,7 @@ AJ_Status CycleControlInterfaceOnMethodHandler(AJ_Message* msg, const char* objP
     }
 
     CycleControlListener* lt = (CycleControlListener*)listener;
+    CycleControlProperties* props = (CycleControlProperties*)propChangedByMethod->properties;
 
     switch (memberIndex) {
     case 4 :
@@ -249,7 +320,18 @@ AJ_Status CycleControlInterfaceOnMethodHandler(AJ_Message* msg, const char* objP
             if (status == AJ_OK) {
                 ErrorCode errorCode = NOT_ERROR;
                 AJ_Message reply;
-                status = lt->OnExecuteOperationalCommand(objPath, command, &errorCode);
+
+                //Commands are checked once the application has set the supported commands
+                if (props && props->supportedOperationalCommands &&
+                    !CdmValueSetContains(&props->supportedOperationalCommandsSet, command)) {
+                    errorCode = INVALID_VALUE;
+                    status = AJ_ERR_RANGE;
+                } else {
+                    status = lt->OnExecuteOperationalCommand(objPath, command, &errorCode);
+                    if (CdmIsReplyDeferred()) {
+                        break;
+                    }
+                }
 
                 if (status == AJ_OK) {
                     AJ_MarshalReplyMsg(msg, &reply);
@@ -331,7 +413,7 @@ AJ_Status Cdm_CycleControlInterfaceGetSupportedOperationalStates(const char* obj
         if (!props->supportedOperationalStates) {
             return AJ_ERR_NULL;
         }
-        memcpy(supportedOperationalStates, props->supportedOperationalStates, sizeof(uint8_t) * statesListSize);
+        memcpy(supportedOperationalStates, props->supportedOperationalStates, sizeof(uint8_t) * props->statesListSize);
     } else {
         status = AJ_ERR_NO_MATCH;
     }
@@ -339,6 +421,31 @@ AJ_Status Cdm_CycleControlInterfaceGetSupportedOperationalStates(const char* obj
     return status;
 }
 
+AJ_Status Cdm_CycleControlInterfaceBorrowSupportedOperationalStates(const char* objPath, const uint8_t** supportedOperationalStates, size_t* supportedModeSize, uint32_t* revision)
+{
+    CycleControlProperties* props = NULL;
+
+    if (!supportedOperationalStates || !supportedModeSize) {
+        return AJ_ERR_INVALID;
+    }
+
+    props = (CycleControlProperties*)GetProperties(objPath, CYCLE_CONTROL_INTERFACE);
+    if (!props) {
+        return AJ_ERR_NO_MATCH;
+    }
+
+    if (!props->supportedOperationalStates) {
+        return AJ_ERR_NULL;
+    }
+    *supportedOperationalStates = props->supportedOperationalStates;
+    *supportedModeSize = props->statesListSize;
+    if (revision) {
+        *revision = props->statesRevision;
+    }
+
+    return AJ_OK;
+}
+
 AJ_Status Cdm_CycleControlInterfaceSetSupportedOperationalStates(AJ_BusAttachment* busAttachment, const char* objPath, const uint8_t* supportedOperationalStates, const size_t supportedModeSize)
 {
     AJ_Status status = AJ_OK;
@@ -358,16 +465,16 @@ AJ_Status Cdm_CycleControlInterfaceSetSupportedOperationalStates(AJ_BusAttachmen
 
     props = (CycleControlProperties*)GetProperties(objPath, CYCLE_CONTROL_INTERFACE);
     if (props) {
-        if (props->supportedOperationalStates) {
-            free(props->supportedOperationalStates);
-        }
-        statesListSize = supportedModeSize;
-
-        props->supportedOperationalStates = (uint8_t*)malloc(sizeof(uint8_t) * statesListSize);
+        bool changed = false;
 
-        memcpy(props->supportedOperationalStates, supportedOperationalStates, sizeof(uint8_t) * statesListSize);
+        status = CdmArrayBufferAssign((void**)&props->supportedOperationalStates, &props->statesListSize, &props->statesCapacity, sizeof(uint8_t),
+                                      supportedOperationalStates, supportedModeSize, &changed);
+        if (status == AJ_OK && changed) {
+            CdmValueSetBuild(&props->supportedOperationalStatesSet, props->supportedOperationalStates, props->statesListSize);
+            props->statesRevision++;
 
-        status = EmitPropChanged(busAttachment, objPath, "SupportedOperationalStates", "ay", props->supportedOperationalStates);
+            status = EmitPropChanged(busAttachment, objPath, "SupportedOperationalStates", "ay", props);
+        }
     } else {
         status = AJ_ERR_NO_MATCH;
     }
@@ -389,7 +496,7 @@ AJ_Status Cdm_CycleControlInterfaceGetSupportedOperationalCommands(const char* o
         if (!props->supportedOperationalCommands) {
             return AJ_ERR_NULL;
         }
-        memcpy(supportedOperationalCommands, props->supportedOperationalCommands, sizeof(uint8_t) * commandsListSize);
+        memcpy(supportedOperationalCommands, props->supportedOperationalCommands, sizeof(uint8_t) * props->commandsListSize);
     } else {
         status = AJ_ERR_NO_MATCH;
     }
@@ -416,16 +523,15 @@ AJ_Status Cdm_CycleControlInterfaceSetSupportedOperationalCommands(AJ_BusAttachm
 
     props = (CycleControlProperties*)GetProperties(objPath, CYCLE_CONTROL_INTERFACE);
     if (props) {
-        if (props->supportedOperationalCommands) {
-            free(props->supportedOperationalCommands);
-        }
-        commandsListSize = supportedModeSize;
+        bool changed = false;
 
-        props->supportedOperationalCommands = (uint8_t*)malloc(sizeof(uint8_t) * commandsListSize);
+        status = CdmArrayBufferAssign((void**)&props->supportedOperationalCommands, &props->commandsListSize, &props->commandsCapacity, sizeof(uint8_t),
+                                      supportedOperationalCommands, supportedModeSize, &changed);
+        if (status == AJ_OK && changed) {
+            CdmValueSetBuild(&props->supportedOperationalCommandsSet, props->supportedOperationalCommands, props->commandsListSize);
 
-        memcpy(props->supportedOperationalCommands, supportedOperationalCommands, sizeof(uint8_t) * commandsListSize);
-
-        status = EmitPropChanged(busAttachment, objPath, "SupportedOperationalCommands", "ay", props->supportedOperationalCommands);
+            status = EmitPropChanged(busAttachment, objPath, "SupportedOperationalCommands", "ay", props);
+        }
     } else {
         status = AJ_ERR_NO_MATCH;
     }
@@ -23,6 +23,8 @@ const char* const intfDescOperationCycleControl[7];
 
 AJ_Status CreateCycleControlInterface(void** properties);
 void DestroyCycleControlInterface(void* properties);
+AJ_Status CycleControlInterfaceSaveProperties(void* properties, CdmSnapshotWriter* writer);
+AJ_Status CycleControlInterfaceLoadProperties(void* properties, CdmSnapshotReader* reader);
 AJ_Status CycleControlInterfaceOnGetProperty(AJ_Message* replyMsg, const char* objPath, void* properties, uint8_t memberIndex, void* listener);
 AJ_Status CycleControlInterfaceOnMethodHandler(AJ_Message* msg, const char* objPath, uint8_t memberIndex, void* listener, CdmPropertiesChangedByMethod* propChangedByMethod);
 
@@ -23,6 +23,8 @@ const char* const intfDescOperationDishWashingCyclePhase[6];
 
 AJ_Status CreateDishWashingCyclePhaseInterface(void** properties);
 void DestroyDishWashingCyclePhaseInterface(void* properties);
+AJ_Status DishWashingCyclePhaseInterfaceSaveProperties(void* properties, CdmSnapshotWriter* writer);
+AJ_Status DishWashingCyclePhaseInterfaceLoadProperties(void* properties, CdmSnapshotReader* reader);
 AJ_Status DishWashingCyclePhaseInterfaceOnGetProperty(AJ_Message* replyMsg, const char* objPath, void* properties, uint8_t memberIndex, void* listener);
 AJ_Status DishWashingCyclePhaseInterfaceOnMethodHandler(AJ_Message* msg, const char* objPath, uint8_t memberIndex, void* listener, CdmPropertiesChangedByMethod* propChangedByMethod);
 
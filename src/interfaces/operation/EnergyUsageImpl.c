@@ -14,14 +14,20 @@
  *    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
  ******************************************************************************/
 
+#include <stddef.h>
+#include <math.h>
 #include <string.h>
 #include <ajtcl/cdm/interfaces/operation/EnergyUsage.h>
+#include <ajtcl/cdm/interfaces/operation/CurrentPower.h>
 #include <ajtcl/cdm/interfaces/CdmInterfaceErrors.h>
 #include "../../CdmControllee/CdmControlleeImpl.h"
+#include "../CdmSignalTemplateImpl.h"
 #include "EnergyUsageImpl.h"
 
 #define INTERFACE_VERSION 1
 
+#define WATT_MILLISECONDS_PER_KWH 3600000000.0
+
 const char* const intfDescOperationEnergyUsage[] = {
     "$org.alljoyn.SmartSpaces.Operation.EnergyUsage",
     "@Version>q",
@@ -37,8 +43,37 @@ typedef struct {
     double cumulativeEnergy;
     double precision;
     uint16_t updateMinTime;
+    bool accountingEnabled;
+    bool hasLastSample;
+    uint32_t lastSampleTime;
+    double lastSamplePower;
+    double energySum; //integrated energy is energySum + energyCompensation (Neumaier summation)
+    double energyCompensation;
+    bool energyPublished;
+    uint32_t energyPublishTime;
+    bool powerPublished;
+    uint32_t powerPublishTime;
+    CdmSignalTemplate cumulativeEnergySignal;
 } EnergyUsageProperties;
 
+static void AddEnergy(EnergyUsageProperties* props, double energy)
+{
+    double sum = props->energySum + energy;
+
+    if (fabs(props->energySum) >= fabs(energy)) {
+        props->energyCompensation += (props->energySum - sum) + energy;
+    } else {
+        props->energyCompensation += (energy - sum) + props->energySum;
+    }
+    props->energySum = sum;
+}
+
+static void ResetEnergy(EnergyUsageProperties* props, double energy)
+{
+    props->energySum = energy;
+    props->energyCompensation = 0.0;
+}
+
 AJ_Status CreateEnergyUsageInterface(void** properties)
 {
     *properties = malloc(sizeof(EnergyUsageProperties));
@@ -57,14 +92,41 @@ void DestroyEnergyUsageInterface(void* properties)
     if (properties) {
         EnergyUsageProperties* props = (EnergyUsageProperties*)properties;
 
+        CdmSignalTemplateClear(&props->cumulativeEnergySignal);
         free(props);
     }
 }
 
+AJ_Status EnergyUsageInterfaceSaveProperties(void* properties, CdmSnapshotWriter* writer)
+{
+    return CdmSnapshotWrite(writer, properties, offsetof(EnergyUsageProperties, cumulativeEnergySignal));
+}
+
+AJ_Status EnergyUsageInterfaceLoadProperties(void* properties, CdmSnapshotReader* reader)
+{
+    AJ_Status status = AJ_OK;
+    EnergyUsageProperties* props = (EnergyUsageProperties*)properties;
+
+    if (reader->size != offsetof(EnergyUsageProperties, cumulativeEnergySignal)) {
+        return AJ_ERR_INVALID;
+    }
+
+    status = CdmSnapshotRead(reader, props, offsetof(EnergyUsageProperties, cumulativeEnergySignal));
+    if (status == AJ_OK) {
+        //sample and publish times of the previous run are meaningless after a restart
+        props->hasLastSample = false;
+        props->energyPublished = false;
+        props->powerPublished = false;
+    }
+
+    return status;
+}
+
 static AJ_Status EmitPropChanged(AJ_BusAttachment* busAttachment, const char* objPath, const char* propName, const char* signature, void* val)
 {
     AJ_Status status = AJ_OK;
     uint32_t msgId = 0;
+    CdmPropChangedTarget target = { 0, 0, 0 };
     AJ_Message msg;
     AJ_Arg array, strc;
 
@@ -81,8 +143,8 @@ static AJ_Status EmitPropChanged(AJ_BusAttachment* busAttachment, const char* ob
 
 
     status = MakePropChangedId(objPath, &msgId);
-    if (status == AJ_OK) {
-        AJ_MarshalSignal(busAttachment, &msg, msgId, NULL, 0, AJ_FLAG_GLOBAL_BROADCAST, 0);
+    while (status == AJ_OK && CdmNextPropChangedTarget(msgId, &target)) {
+        AJ_MarshalSignal(busAttachment, &msg, msgId, NULL, target.sessionId, target.flags, 0);
         AJ_MarshalArgs(&msg, "s", intfDescOperationEnergyUsage[0]+1); //To remove '$'
         AJ_MarshalContainer(&msg, &array, AJ_ARG_ARRAY);
         AJ_MarshalContainer(&msg, &strc, AJ_ARG_DICT_ENTRY);
@@ -116,7 +178,7 @@ AJ_Status EnergyUsageInterfaceEmitPropertiesChanged(AJ_BusAttachment* busAttachm
 
     switch (memberIndex) {
     case 1 :
-        status = EmitPropChanged(busAttachment, objPath, "CumulativeEnergy", "d", &(props->cumulativeEnergy));
+        status = CdmSignalTemplateEmit(busAttachment, objPath, &props->cumulativeEnergySignal, intfDescOperationEnergyUsage[0]+1, "CumulativeEnergy", "d", &(props->cumulativeEnergy));
         break;
     default:
         status = AJ_ERR_INVALID;
@@ -150,7 +212,8 @@ AJ_Status EnergyUsageInterfaceOnGetProperty(AJ_Message* replyMsg, const char* ob
 
             if (lt && lt->OnGetCumulativeEnergy) {
                 status = lt->OnGetCumulativeEnergy(objPath, &cumulativeEnergy);
-                 if (status == AJ_OK) {
+                 if (status == AJ_OK && !CdmIsReplyDeferred()) {
+                     CdmMarkValuePulled();
                       props->cumulativeEnergy = cumulativeEnergy;
                  }
             }
@@ -164,7 +227,8 @@ AJ_Status EnergyUsageInterfaceOnGetProperty(AJ_Message* replyMsg, const char* ob
 
             if (lt && lt->OnGetPrecision) {
                 status = lt->OnGetPrecision(objPath, &precision);
-                 if (status == AJ_OK) {
+                 if (status == AJ_OK && !CdmIsReplyDeferred()) {
+                     CdmMarkValuePulled();
                       props->precision = precision;
                  }
             }
@@ -178,7 +242,8 @@ AJ_Status EnergyUsageInterfaceOnGetProperty(AJ_Message* replyMsg, const char* ob
 
             if (lt && lt->OnGetUpdateMinTime) {
                 status = lt->OnGetUpdateMinTime(objPath, &updateMinTime);
-                 if (status == AJ_OK) {
+                 if (status == AJ_OK && !CdmIsReplyDeferred()) {
+                     CdmMarkValuePulled();
                       props->updateMinTime = updateMinTime;
                  }
             }
@@ -207,20 +272,28 @@ AJ_Status EnergyUsageInterfaceOnMethodHandler(AJ_Message* msg, const char* objPa
     }
 
     EnergyUsageListener* lt = (EnergyUsageListener*)listener;
+    EnergyUsageProperties* props = (EnergyUsageProperties*)(propChangedByMethod->properties);
 
     switch (memberIndex) {
     case 4 :
-        if (!lt->OnResetCumulativeEnergy) {
+        if (!lt->OnResetCumulativeEnergy && !(props && props->accountingEnabled)) {
             status = AJ_ERR_NULL;
         } else {
             ErrorCode errorCode = NOT_ERROR;
             AJ_Message reply;
-            status = lt->OnResetCumulativeEnergy(objPath, &errorCode);
+
+            if (lt->OnResetCumulativeEnergy) {
+                status = lt->OnResetCumulativeEnergy(objPath, &errorCode);
+                if (CdmIsReplyDeferred()) {
+                    break;
+                }
+            }
 
             if (status == AJ_OK) {
-                EnergyUsageProperties* props = (EnergyUsageProperties*)(propChangedByMethod->properties);
                 if (props) {
+                    //the published value and the integrated energy are reset together, nothing ingested before is carried over
                     props->cumulativeEnergy = 0.0;
+                    ResetEnergy(props, 0.0);
                     propChangedByMethod->member_index_mask |= (1 << 1); //mask bit 1(member index of CumulativeEnergy property)
                 }
             }
@@ -265,10 +338,13 @@ AJ_Status Cdm_EnergyUsageInterfaceSetCumulativeEnergy(AJ_BusAttachment* busAttac
 
     props = (EnergyUsageProperties*)GetProperties(objPath, ENERGY_USAGE_INTERFACE);
     if (props) {
+        if (props->accountingEnabled) {
+            ResetEnergy(props, cumulativeEnergy);
+        }
         if (props->cumulativeEnergy != cumulativeEnergy) {
             props->cumulativeEnergy = cumulativeEnergy;
 
-            status = EmitPropChanged(busAttachment, objPath, "CumulativeEnergy", "d", &(props->cumulativeEnergy));
+            status = CdmSignalTemplateEmit(busAttachment, objPath, &props->cumulativeEnergySignal, intfDescOperationEnergyUsage[0]+1, "CumulativeEnergy", "d", &(props->cumulativeEnergy));
         }
     } else {
         status = AJ_ERR_NO_MATCH;
@@ -352,3 +428,100 @@ AJ_Status Cdm_EnergyUsageInterfaceSetUpdateMinTime(AJ_BusAttachment* busAttachme
 
     return status;
 }
+
+AJ_Status Cdm_EnergyUsageInterfaceSetEnergyAccounting(const char* objPath, const bool enable)
+{
+    AJ_Status status = AJ_OK;
+    EnergyUsageProperties* props = NULL;
+
+    props = (EnergyUsageProperties*)GetProperties(objPath, ENERGY_USAGE_INTERFACE);
+    if (props) {
+        if (enable && !props->accountingEnabled) {
+            ResetEnergy(props, props->cumulativeEnergy);
+            props->hasLastSample = false;
+            props->energyPublished = false;
+            props->powerPublished = false;
+        }
+        props->accountingEnabled = enable;
+    } else {
+        status = AJ_ERR_NO_MATCH;
+    }
+
+    return status;
+}
+
+AJ_Status Cdm_EnergyUsageInterfaceIngestPowerSamples(AJ_BusAttachment* busAttachment, const char* objPath, const EnergyUsagePowerSample* samples, const size_t numSamples)
+{
+    AJ_Status status = AJ_OK;
+    EnergyUsageProperties* props = NULL;
+    double energy = 0.0;
+    size_t i = 0;
+
+    if (!busAttachment) {
+        return AJ_ERR_INVALID;
+    }
+
+    if (!samples && numSamples) {
+        return AJ_ERR_INVALID;
+    }
+
+    props = (EnergyUsageProperties*)GetProperties(objPath, ENERGY_USAGE_INTERFACE);
+    if (!props) {
+        return AJ_ERR_NO_MATCH;
+    }
+
+    if (!props->accountingEnabled) {
+        return AJ_ERR_DISALLOWED;
+    }
+
+    if (numSamples == 0) {
+        return AJ_OK;
+    }
+
+    //trapezoidal integration, a sample that does not move time forward only replaces the last power
+    for (i = 0; i < numSamples; i++) {
+        if (props->hasLastSample) {
+            int32_t elapsed = (int32_t)(samples[i].timestamp - props->lastSampleTime);
+            if (elapsed > 0) {
+                AddEnergy(props, (props->lastSamplePower + samples[i].power) * 0.5 * elapsed / WATT_MILLISECONDS_PER_KWH);
+            }
+        }
+        props->lastSampleTime = samples[i].timestamp;
+        props->lastSamplePower = samples[i].power;
+        props->hasLastSample = true;
+    }
+
+    energy = props->energySum + props->energyCompensation;
+    if (energy != props->cumulativeEnergy && fabs(energy - props->cumulativeEnergy) >= props->precision &&
+        (!props->energyPublished || (uint32_t)(props->lastSampleTime - props->energyPublishTime) >= props->updateMinTime)) {
+        props->cumulativeEnergy = energy;
+        props->energyPublished = true;
+        props->energyPublishTime = props->lastSampleTime;
+
+        status = CdmSignalTemplateEmit(busAttachment, objPath, &props->cumulativeEnergySignal, intfDescOperationEnergyUsage[0]+1, "CumulativeEnergy", "d", &(props->cumulativeEnergy));
+        if (status != AJ_OK) {
+            return status;
+        }
+    }
+
+    //CurrentPower of the same object follows the last sample with its own Precision and UpdateMinTime
+    {
+        double currentPower = 0.0;
+        double powerPrecision = 0.0;
+        uint16_t powerUpdateMinTime = 0;
+
+        if (Cdm_CurrentPowerInterfaceGetCurrentPower(objPath, &currentPower) == AJ_OK &&
+            Cdm_CurrentPowerInterfaceGetPrecision(objPath, &powerPrecision) == AJ_OK &&
+            Cdm_CurrentPowerInterfaceGetUpdateMinTime(objPath, &powerUpdateMinTime) == AJ_OK) {
+            if (props->lastSamplePower != currentPower && fabs(props->lastSamplePower - currentPower) >= powerPrecision &&
+                (!props->powerPublished || (uint32_t)(props->lastSampleTime - props->powerPublishTime) >= powerUpdateMinTime)) {
+                props->powerPublished = true;
+                props->powerPublishTime = props->lastSampleTime;
+
+                status = Cdm_CurrentPowerInterfaceSetCurrentPower(busAttachment, objPath, props->lastSamplePower);
+            }
+        }
+    }
+
+    return status;
+}
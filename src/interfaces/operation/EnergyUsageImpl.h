@@ -23,6 +23,8 @@ const char* const intfDescOperationEnergyUsage[7];
 
 AJ_Status CreateEnergyUsageInterface(void** properties);
 void DestroyEnergyUsageInterface(void* properties);
+AJ_Status EnergyUsageInterfaceSaveProperties(void* properties, CdmSnapshotWriter* writer);
+AJ_Status EnergyUsageInterfaceLoadProperties(void* properties, CdmSnapshotReader* reader);
 AJ_Status EnergyUsageInterfaceOnGetProperty(AJ_Message* replyMsg, const char* objPath, void* properties, uint8_t memberIndex, void* listener);
 AJ_Status EnergyUsageInterfaceOnMethodHandler(AJ_Message* msg, const char* objPath, uint8_t memberIndex, void* listener, CdmPropertiesChangedByMethod* propChangedByMethod);
 AJ_Status EnergyUsageInterfaceEmitPropertiesChanged(AJ_BusAttachment* busAttachment, const char* objPath, void* properties, uint8_t memberIndex);
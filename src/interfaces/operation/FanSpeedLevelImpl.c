@@ -14,9 +14,11 @@
  *    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
  ******************************************************************************/
 
+#include <stddef.h>
 #include <string.h>
 #include <ajtcl/cdm/interfaces/operation/FanSpeedLevel.h>
 #include "../../CdmControllee/CdmControlleeImpl.h"
+#include "../CdmConstraintImpl.h"
 #include "FanSpeedLevelImpl.h"
 
 #define INTERFACE_VERSION 1
@@ -39,29 +41,15 @@ typedef struct {
     uint8_t fanSpeedLevel;
     uint8_t maxFanSpeedLevel;
     uint8_t autoMode;
+    CdmConstraintPolicy constraintPolicy;
 } FanSpeedLevelProperties;
 
-AJ_Status FanSpeedLevelValidationCheck(const char* objPath, uint8_t fanSpeedLevel)
+static void GetFanSpeedLevelConstraint(const FanSpeedLevelProperties* props, CdmConstraint* constraint)
 {
-    AJ_Status status = AJ_OK;
-    FanSpeedLevelProperties* props = NULL;
-
-    props = (FanSpeedLevelProperties*)GetProperties(objPath, FAN_SPEED_LEVEL_INTERFACE);
-    if (props) {
-        if (fanSpeedLevel == FAN_TURNED_OFF) {
-            status = AJ_ERR_RANGE;
-        }
-        else if (fanSpeedLevel > props->maxFanSpeedLevel) {
-            status = AJ_ERR_RANGE;
-        }
-    } else {
-        status = AJ_ERR_NO_MATCH;
-    }
-
-    return status;
+    CdmConstraintInit(constraint, FAN_TURNED_OFF + 1, props->maxFanSpeedLevel, 0);
 }
 
-AJ_Status AutoModeValidationCheck(uint8_t autoMode)
+static AJ_Status AutoModeValidationCheck(uint8_t autoMode)
 {
     AJ_Status status = AJ_OK;
     if (autoMode != AUTO_MODE_OFF && autoMode != AUTO_MODE_ON) {
@@ -79,6 +67,7 @@ AJ_Status CreateFanSpeedLevelInterface(void** properties)
     memset(*properties, 0, sizeof(FanSpeedLevelProperties));
 
     ((FanSpeedLevelProperties*)*properties)->version = (uint16_t)INTERFACE_VERSION;
+    ((FanSpeedLevelProperties*)*properties)->constraintPolicy = CDM_CONSTRAINT_POLICY_REJECT;
 
     return AJ_OK;
 }
@@ -91,10 +80,30 @@ void DestroyFanSpeedLevelInterface(void* properties)
     }
 }
 
+AJ_Status FanSpeedLevelInterfaceSaveProperties(void* properties, CdmSnapshotWriter* writer)
+{
+    return CdmSnapshotWrite(writer, properties, offsetof(FanSpeedLevelProperties, constraintPolicy));
+}
+
+AJ_Status FanSpeedLevelInterfaceLoadProperties(void* properties, CdmSnapshotReader* reader)
+{
+    if (reader->size != offsetof(FanSpeedLevelProperties, constraintPolicy)) {
+        return AJ_ERR_INVALID;
+    }
+
+    return CdmSnapshotRead(reader, properties, offsetof(FanSpeedLevelProperties, constraintPolicy));
+}
+
+void FanSpeedLevelInterfaceSetConstraintPolicy(void* properties, CdmConstraintPolicy policy)
+{
+    ((FanSpeedLevelProperties*)properties)->constraintPolicy = policy;
+}
+
 static AJ_Status EmitPropChanged(AJ_BusAttachment* busAttachment, const char* objPath, const char* propName, const char* signature, void* val)
 {
     AJ_Status status = AJ_OK;
     uint32_t msgId = 0;
+    CdmPropChangedTarget target = { 0, 0, 0 };
     AJ_Message msg;
     AJ_Arg array, strc;
 
@@ -103,8 +112,8 @@ static AJ_Status EmitPropChanged(AJ_BusAttachment* busAttachment, const char* ob
     }
 
     status = MakePropChangedId(objPath, &msgId);
-    if (status == AJ_OK) {
-        AJ_MarshalSignal(busAttachment, &msg, msgId, NULL, 0, AJ_FLAG_GLOBAL_BROADCAST, 0);
+    while (status == AJ_OK && CdmNextPropChangedTarget(msgId, &target)) {
+        AJ_MarshalSignal(busAttachment, &msg, msgId, NULL, target.sessionId, target.flags, 0);
         AJ_MarshalArgs(&msg, "s", intfDescOperationFanSpeedLevel[0]+1); //To remove '$'
         AJ_MarshalContainer(&msg, &array, AJ_ARG_ARRAY);
         AJ_MarshalContainer(&msg, &strc, AJ_ARG_DICT_ENTRY);
@@ -172,7 +181,8 @@ AJ_Status FanSpeedLevelInterfaceOnGetProperty(AJ_Message* replyMsg, const char*
             uint8_t fanSpeedLevel;
             if (lt && lt->OnGetFanSpeedLevel) {
                 status = lt->OnGetFanSpeedLevel(objPath, &fanSpeedLevel);
-                if (status == AJ_OK) {
+                if (status == AJ_OK && !CdmIsReplyDeferred()) {
+                    CdmMarkValuePulled();
                     props->fanSpeedLevel = fanSpeedLevel;
                 }
             }
@@ -185,7 +195,8 @@ AJ_Status FanSpeedLevelInterfaceOnGetProperty(AJ_Message* replyMsg, const char*
 
             if (lt && lt->OnGetMaxFanSpeedLevel) {
                 status = lt->OnGetMaxFanSpeedLevel(objPath, &maxFanSpeedLevel);
-                 if (status == AJ_OK) {
+                 if (status == AJ_OK && !CdmIsReplyDeferred()) {
+                     CdmMarkValuePulled();
                       props->maxFanSpeedLevel = maxFanSpeedLevel;
                  }
             }
@@ -198,7 +209,8 @@ AJ_Status FanSpeedLevelInterfaceOnGetProperty(AJ_Message* replyMsg, const char*
 
             if (lt && lt->OnGetAutoMode) {
                 status = lt->OnGetAutoMode(objPath, &autoMode);
-                if (status == AJ_OK) {
+                if (status == AJ_OK && !CdmIsReplyDeferred()) {
+                    CdmMarkValuePulled();
                     props->autoMode = autoMode;
                 }
             }
@@ -239,10 +251,15 @@ AJ_Status FanSpeedLevelInterfaceOnSetProperty(AJ_Message* replyMsg, const char*
             status = AJ_UnmarshalArgs(replyMsg, "y", &fanSpeedLevel);
 
             if (status == AJ_OK) {
-                status = FanSpeedLevelValidationCheck(objPath, fanSpeedLevel);
+                CdmConstraint constraint;
+                double value = fanSpeedLevel;
+
+                GetFanSpeedLevelConstraint(props, &constraint);
+                status = CdmConstraintApply(&constraint, props->constraintPolicy, &value);
                 if (status != AJ_OK) {
                     return status;
                 }
+                fanSpeedLevel = (uint8_t)value;
 
                 status = lt->OnSetFanSpeedLevel(objPath, fanSpeedLevel);
 
@@ -316,13 +333,16 @@ AJ_Status Cdm_FanSpeedLevelInterfaceSetFanSpeedLevel(AJ_BusAttachment* busAttach
         return AJ_ERR_INVALID;
     }
 
-    status = FanSpeedLevelValidationCheck(objPath, fanSpeedLevel);
-    if (status != AJ_OK) {
-        return status;
-    }
-
     props = (FanSpeedLevelProperties*)GetProperties(objPath, FAN_SPEED_LEVEL_INTERFACE);
     if (props) {
+        CdmConstraint constraint;
+
+        GetFanSpeedLevelConstraint(props, &constraint);
+        status = CdmConstraintCheck(&constraint, fanSpeedLevel);
+        if (status != AJ_OK) {
+            return status;
+        }
+
         if (props->fanSpeedLevel != fanSpeedLevel) {
             props->fanSpeedLevel = fanSpeedLevel;
 
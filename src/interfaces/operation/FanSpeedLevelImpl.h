@@ -23,6 +23,9 @@ const char* const intfDescOperationFanSpeedLevel[6];
 
 AJ_Status CreateFanSpeedLevelInterface(void** properties);
 void DestroyFanSpeedLevelInterface(void* properties);
+AJ_Status FanSpeedLevelInterfaceSaveProperties(void* properties, CdmSnapshotWriter* writer);
+AJ_Status FanSpeedLevelInterfaceLoadProperties(void* properties, CdmSnapshotReader* reader);
+void FanSpeedLevelInterfaceSetConstraintPolicy(void* properties, CdmConstraintPolicy policy);
 AJ_Status FanSpeedLevelInterfaceOnGetProperty(AJ_Message* replyMsg, const char* objPath, void* properties, uint8_t memberIndex, void* listener);
 AJ_Status FanSpeedLevelInterfaceOnSetProperty(AJ_Message* replyMsg, const char* objPath, void* properties, uint8_t memberIndex, void* listener, bool* propChanged);
 AJ_Status FanSpeedLevelInterfaceEmitPropertiesChanged(AJ_BusAttachment* busAttachment, const char* objPath, void* properties, uint8_t memberIndex);
@@ -17,9 +17,13 @@
 #include <string.h>
 #include <ajtcl/cdm/interfaces/operation/FilterStatus.h>
 #include "../../CdmControllee/CdmControlleeImpl.h"
+#include "../CdmStringPropertyImpl.h"
+#include "../CdmTimerWheelImpl.h"
 #include "FilterStatusImpl.h"
 
 #define INTERFACE_VERSION 1
+#define LIFE_TRACKING_PERIOD (60 * 1000) //one minute
+#define MINUTES_PER_DAY (24 * 60)
 
 const char* const intfDescOperationFilterStatus[] = {
     "$org.alljoyn.SmartSpaces.Operation.FilterStatus",
@@ -39,15 +43,33 @@ typedef struct {
     uint16_t expectedLifeInDays;
     bool isCleanable;
     uint8_t orderPercentage;
-    char* manufacturer;
-    char* partNumber;
-    char* url;
+    CdmStringProperty manufacturer;
+    CdmStringProperty partNumber;
+    CdmStringProperty url;
     uint8_t lifeRemaining;
     bool manufacturerInit;
     bool partNumberInit;
     bool urlInit;
+    //life tracking state, which is restored from LifeRemaining
+    bool lifeTracking;
+    const char* objPath;
+    uint32_t usedMinutes;
+    CdmTimer lifeTimer;
 } FilterStatusProperties;
 
+static uint32_t LifeInMinutes(const FilterStatusProperties* props)
+{
+    return (uint32_t)props->expectedLifeInDays * MINUTES_PER_DAY;
+}
+
+//Derive the used time from LifeRemaining when the tracking starts or the values are changed by the application
+static void ResetUsedMinutes(FilterStatusProperties* props)
+{
+    uint8_t lifeRemaining = (props->lifeRemaining > 100) ? 100 : props->lifeRemaining;
+
+    props->usedMinutes = (uint32_t)((uint64_t)LifeInMinutes(props) * (100 - lifeRemaining) / 100);
+}
+
 AJ_Status CreateFilterStatusInterface(void** properties)
 {
     *properties = malloc(sizeof(FilterStatusProperties));
@@ -68,24 +90,124 @@ void DestroyFilterStatusInterface(void* properties)
 {
     if (properties) {
         FilterStatusProperties* props = (FilterStatusProperties*)properties;
-        if (props->manufacturer) {
-            free(props->manufacturer);
-        }
-        if (props->partNumber) {
-            free(props->partNumber);
-        }
-        if (props->url) {
-            free(props->url);
-        }
+        CdmStringPropertyClear(&props->manufacturer);
+        CdmStringPropertyClear(&props->partNumber);
+        CdmStringPropertyClear(&props->url);
 
+        Cdm_TimerWheelCancel(&props->lifeTimer);
         free(props);
     }
 }
 
+AJ_Status FilterStatusInterfaceSaveProperties(void* properties, CdmSnapshotWriter* writer)
+{
+    AJ_Status status = AJ_OK;
+    FilterStatusProperties* props = (FilterStatusProperties*)properties;
+
+    status = CdmSnapshotWrite(writer, &props->expectedLifeInDays, sizeof(props->expectedLifeInDays));
+    if (status == AJ_OK) {
+        status = CdmSnapshotWrite(writer, &props->isCleanable, sizeof(props->isCleanable));
+    }
+    if (status == AJ_OK) {
+        status = CdmSnapshotWrite(writer, &props->orderPercentage, sizeof(props->orderPercentage));
+    }
+    if (status == AJ_OK) {
+        status = CdmSnapshotWrite(writer, &props->lifeRemaining, sizeof(props->lifeRemaining));
+    }
+    if (status == AJ_OK) {
+        status = CdmSnapshotWrite(writer, &props->manufacturerInit, sizeof(props->manufacturerInit));
+    }
+    if (status == AJ_OK) {
+        status = CdmSnapshotWrite(writer, &props->partNumberInit, sizeof(props->partNumberInit));
+    }
+    if (status == AJ_OK) {
+        status = CdmSnapshotWrite(writer, &props->urlInit, sizeof(props->urlInit));
+    }
+    if (status == AJ_OK) {
+        status = CdmStringPropertySave(&props->manufacturer, writer);
+    }
+    if (status == AJ_OK) {
+        status = CdmStringPropertySave(&props->partNumber, writer);
+    }
+    if (status == AJ_OK) {
+        status = CdmStringPropertySave(&props->url, writer);
+    }
+
+    return status;
+}
+
+AJ_Status FilterStatusInterfaceLoadProperties(void* properties, CdmSnapshotReader* reader)
+{
+    AJ_Status status = AJ_OK;
+    FilterStatusProperties* props = (FilterStatusProperties*)properties;
+    uint16_t expectedLifeInDays = 0;
+    bool isCleanable = false;
+    uint8_t orderPercentage = 0;
+    uint8_t lifeRemaining = 0;
+    bool manufacturerInit = false;
+    bool partNumberInit = false;
+    bool urlInit = false;
+    CdmStringProperty manufacturer = { false, 0 };
+    CdmStringProperty partNumber = { false, 0 };
+    CdmStringProperty url = { false, 0 };
+
+    status = CdmSnapshotRead(reader, &expectedLifeInDays, sizeof(expectedLifeInDays));
+    if (status == AJ_OK) {
+        status = CdmSnapshotRead(reader, &isCleanable, sizeof(isCleanable));
+    }
+    if (status == AJ_OK) {
+        status = CdmSnapshotRead(reader, &orderPercentage, sizeof(orderPercentage));
+    }
+    if (status == AJ_OK) {
+        status = CdmSnapshotRead(reader, &lifeRemaining, sizeof(lifeRemaining));
+    }
+    if (status == AJ_OK) {
+        status = CdmSnapshotRead(reader, &manufacturerInit, sizeof(manufacturerInit));
+    }
+    if (status == AJ_OK) {
+        status = CdmSnapshotRead(reader, &partNumberInit, sizeof(partNumberInit));
+    }
+    if (status == AJ_OK) {
+        status = CdmSnapshotRead(reader, &urlInit, sizeof(urlInit));
+    }
+    if (status == AJ_OK) {
+        status = CdmStringPropertyLoad(&manufacturer, reader);
+    }
+    if (status == AJ_OK) {
+        status = CdmStringPropertyLoad(&partNumber, reader);
+    }
+    if (status == AJ_OK) {
+        status = CdmStringPropertyLoad(&url, reader);
+    }
+    if (status != AJ_OK) {
+        CdmStringPropertyClear(&manufacturer);
+        CdmStringPropertyClear(&partNumber);
+        CdmStringPropertyClear(&url);
+        return status;
+    }
+
+    props->expectedLifeInDays = expectedLifeInDays;
+    props->isCleanable = isCleanable;
+    props->orderPercentage = orderPercentage;
+    props->lifeRemaining = lifeRemaining;
+    props->manufacturerInit = manufacturerInit;
+    props->partNumberInit = partNumberInit;
+    props->urlInit = urlInit;
+    CdmStringPropertyClear(&props->manufacturer);
+    CdmStringPropertyClear(&props->partNumber);
+    CdmStringPropertyClear(&props->url);
+    props->manufacturer = manufacturer;
+    props->partNumber = partNumber;
+    props->url = url;
+
+    return AJ_OK;
+}
+
 static AJ_Status EmitPropChanged(AJ_BusAttachment* busAttachment, const char* objPath, const char* propName, const char* signature, void* val)
 {
     AJ_Status status = AJ_OK;
     uint32_t msgId = 0;
+    CdmPropChangedTarget target = { 0, 0, 0 };
     AJ_Message msg;
     AJ_Arg array, strc;
 
@@ -94,8 +216,8 @@ static AJ_Status EmitPropChanged(AJ_BusAttachment* busAttachment, const char* ob
     }
 
     status = MakePropChangedId(objPath, &msgId);
-    if (status == AJ_OK) {
-        AJ_MarshalSignal(busAttachment, &msg, msgId, NULL, 0, AJ_FLAG_GLOBAL_BROADCAST, 0);
+    while (status == AJ_OK && CdmNextPropChangedTarget(msgId, &target)) {
+        AJ_MarshalSignal(busAttachment, &msg, msgId, NULL, target.sessionId, target.flags, 0);
         AJ_MarshalArgs(&msg, "s", intfDescOperationFilterStatus[0]+1); //To remove '$'
         AJ_MarshalContainer(&msg, &array, AJ_ARG_ARRAY);
         AJ_MarshalContainer(&msg, &strc, AJ_ARG_DICT_ENTRY);
@@ -118,6 +240,26 @@ static AJ_Status EmitPropChanged(AJ_BusAttachment* busAttachment, const char* ob
     return status;
 }
 
+static void LifeTimerExpired(AJ_BusAttachment* busAttachment, CdmTimer* timer, void* context)
+{
+    FilterStatusProperties* props = (FilterStatusProperties*)context;
+    uint32_t lifeInMinutes = LifeInMinutes(props);
+    uint8_t lifeRemaining = 0;
+
+    props->usedMinutes++;
+    if (lifeInMinutes > props->usedMinutes) {
+        lifeRemaining = (uint8_t)(100 - (uint64_t)props->usedMinutes * 100 / lifeInMinutes);
+    }
+
+    if (props->lifeRemaining != lifeRemaining) {
+        props->lifeRemaining = lifeRemaining;
+        EmitPropChanged(busAttachment, props->objPath, "LifeRemaining", "y", &(props->lifeRemaining));
+    }
+    if (!lifeRemaining) {
+        Cdm_TimerWheelCancel(timer);
+    }
+}
+
 AJ_Status FilterStatusInterfaceOnGetProperty(AJ_Message* replyMsg, const char* objPath, void* properties, uint8_t memberIndex, void* listener)
 {
     AJ_Status status = AJ_OK;
@@ -142,7 +284,8 @@ AJ_Status FilterStatusInterfaceOnGetProperty(AJ_Message* replyMsg, const char* o
             uint16_t expectedLifeInDays;
             if (lt && lt->OnGetExpectedLifeInDays) {
                 status = lt->OnGetExpectedLifeInDays(objPath, &expectedLifeInDays);
-                if (status == AJ_OK) {
+                if (status == AJ_OK && !CdmIsReplyDeferred()) {
+                    CdmMarkValuePulled();
                      props->expectedLifeInDays = expectedLifeInDays;
                 }
             }
@@ -154,7 +297,8 @@ AJ_Status FilterStatusInterfaceOnGetProperty(AJ_Message* replyMsg, const char* o
             bool isCleanable;
             if (lt && lt->OnGetIsCleanable) {
                 status = lt->OnGetIsCleanable(objPath, &isCleanable);
-                if (status == AJ_OK) {
+                if (status == AJ_OK && !CdmIsReplyDeferred()) {
+                    CdmMarkValuePulled();
                      props->isCleanable = isCleanable;
                 }
             }
@@ -166,7 +310,8 @@ AJ_Status FilterStatusInterfaceOnGetProperty(AJ_Message* replyMsg, const char* o
             uint8_t orderPercentage;
             if (lt && lt->OnGetOrderPercentage) {
                 status = lt->OnGetOrderPercentage(objPath, &orderPercentage);
-                if (status == AJ_OK) {
+                if (status == AJ_OK && !CdmIsReplyDeferred()) {
+                    CdmMarkValuePulled();
                      props->orderPercentage = orderPercentage;
                 }
             }
@@ -178,22 +323,18 @@ AJ_Status FilterStatusInterfaceOnGetProperty(AJ_Message* replyMsg, const char* o
             char manufacturer[128];  //?? how estimate proper buffer size when the listener is exist
             if (lt && lt->OnGetManufacturer) {
                 status = lt->OnGetManufacturer(objPath, manufacturer);
-                if (status == AJ_OK) {
-                    if (props->manufacturer) {
-                        free(props->manufacturer);
+                if (status == AJ_OK && !CdmIsReplyDeferred()) {
+                    CdmMarkValuePulled();
+                    status = CdmStringPropertySet(&props->manufacturer, manufacturer, NULL);
+                    if (status != AJ_OK) {
+                        return status;
                     }
-                    props->manufacturer = (char*) malloc(strlen(manufacturer) + 1);
-                    if (!props->manufacturer) {
-                        return AJ_ERR_RESOURCES;
-                    }
-                    strncpy(props->manufacturer, manufacturer, strlen(manufacturer));
-                    props->manufacturer[strlen(manufacturer)] = '\0';
                 }
             }
-            if (!props->manufacturer) {
+            if (!CdmStringPropertyGet(&props->manufacturer)) {
                 return AJ_ERR_NULL;
             }
-            status = AJ_MarshalArgs(replyMsg, "s", props->manufacturer);
+            status = AJ_MarshalArgs(replyMsg, "s", CdmStringPropertyGet(&props->manufacturer));
         }
         break;
     case 5 :
@@ -201,22 +342,18 @@ AJ_Status FilterStatusInterfaceOnGetProperty(AJ_Message* replyMsg, const char* o
             char partNumber[128];  //?? how estimate proper buffer size when the listener is exist
             if (lt && lt->OnGetPartNumber) {
                 status = lt->OnGetPartNumber(objPath, partNumber);
-                if (status == AJ_OK) {
-                    if (props->partNumber) {
-                        free(props->partNumber);
-                    }
-                    props->partNumber = (char*) malloc(strlen(partNumber) + 1);
-                    if (!props->partNumber) {
-                        return AJ_ERR_RESOURCES;
+                if (status == AJ_OK && !CdmIsReplyDeferred()) {
+                    CdmMarkValuePulled();
+                    status = CdmStringPropertySet(&props->partNumber, partNumber, NULL);
+                    if (status != AJ_OK) {
+                        return status;
                     }
-                    strncpy(props->partNumber, partNumber, strlen(partNumber));
-                    props->partNumber[strlen(partNumber)] = '\0';
                 }
             }
-            if (!props->partNumber) {
+            if (!CdmStringPropertyGet(&props->partNumber)) {
                 return AJ_ERR_NULL;
             }
-            status = AJ_MarshalArgs(replyMsg, "s", props->partNumber);
+            status = AJ_MarshalArgs(replyMsg, "s", CdmStringPropertyGet(&props->partNumber));
         }
         break;
     case 6 :
@@ -224,22 +361,18 @@ AJ_Status FilterStatusInterfaceOnGetProperty(AJ_Message* replyMsg, const char* o
             char url[128];  //?? how estimate proper buffer size when the listener is exist
             if (lt && lt->OnGetUrl) {
                 status = lt->OnGetUrl(objPath, url);
-                if (status == AJ_OK) {
-                    if (props->url) {
-                        free(props->url);
-                    }
-                    props->url = (char*) malloc(strlen(url) + 1);
-                    if (!props->url) {
-                        return AJ_ERR_RESOURCES;
+                if (status == AJ_OK && !CdmIsReplyDeferred()) {
+                    CdmMarkValuePulled();
+                    status = CdmStringPropertySet(&props->url, url, NULL);
+                    if (status != AJ_OK) {
+                        return status;
                     }
-                    strncpy(props->url, url, strlen(url));
-                    props->url[strlen(url)] = '\0';
                 }
             }
-            if (!props->url) {
+            if (!CdmStringPropertyGet(&props->url)) {
                 return AJ_ERR_NULL;
             }
-            status = AJ_MarshalArgs(replyMsg, "s", props->url);
+            status = AJ_MarshalArgs(replyMsg, "s", CdmStringPropertyGet(&props->url));
         }
         break;
     case 7 :
@@ -247,7 +380,8 @@ AJ_Status FilterStatusInterfaceOnGetProperty(AJ_Message* replyMsg, const char* o
             uint8_t lifeRemaining;
             if (lt && lt->OnGetLifeRemaining) {
                 status = lt->OnGetLifeRemaining(objPath, &lifeRemaining);
-                if (status == AJ_OK) {
+                if (status == AJ_OK && !CdmIsReplyDeferred()) {
+                    CdmMarkValuePulled();
                      props->lifeRemaining = lifeRemaining;
                 }
             }
@@ -292,6 +426,9 @@ AJ_Status Cdm_FilterStatusInterfaceSetExpectedLifeInDays(AJ_BusAttachment* busAt
     props = (FilterStatusProperties*)GetProperties(objPath, FILTER_STATUS_INTERFACE);
     if (props) {
         props->expectedLifeInDays = value;
+        if (props->lifeTracking) {
+            ResetUsedMinutes(props);
+        }
         status = EmitPropChanged(busAttachment, objPath, "ExpectedLifeInDays", "q", &(props->expectedLifeInDays));
     } else {
         status = AJ_ERR_NO_MATCH;
@@ -393,11 +530,7 @@ AJ_Status Cdm_FilterStatusInterfaceGetManufacturer(const char* objPath, char* ma
 
     props = (FilterStatusProperties*) GetProperties(objPath, FILTER_STATUS_INTERFACE);
     if (props) {
-        if (!props->manufacturer) {
-            return AJ_ERR_NULL;
-        }
-        strncpy(manufacturer, props->manufacturer, strlen(props->manufacturer));
-        manufacturer[strlen(props->manufacturer)] = '\0';
+        status = CdmStringPropertyCopy(&props->manufacturer, manufacturer);
     } else {
         status = AJ_ERR_NO_MATCH;
     }
@@ -423,12 +556,8 @@ AJ_Status Cdm_FilterStatusInterfaceSetManufacturer(AJ_BusAttachment* busAttachme
         if (props->manufacturerInit) { //const
             return AJ_ERR_FAILURE;
         } else {
-            props->manufacturer = (char*) malloc(strlen(manufacturer) + 1);
-            if (!props->manufacturer) {
-                status = AJ_ERR_RESOURCES;
-            } else {
-                strncpy(props->manufacturer, manufacturer, strlen(manufacturer));
-                props->manufacturer[strlen(manufacturer)] = '\0';
+            status = CdmStringPropertySet(&props->manufacturer, manufacturer, NULL);
+            if (status == AJ_OK) {
                 props->manufacturerInit = true;
             }
         }
@@ -450,11 +579,7 @@ AJ_Status Cdm_FilterStatusInterfaceGetPartNumber(const char* objPath, char* part
 
     props = (FilterStatusProperties*) GetProperties(objPath, FILTER_STATUS_INTERFACE);
     if (props) {
-        if (!props->partNumber) {
-            return AJ_ERR_NULL;
-        }
-        strncpy(partNumber, props->partNumber, strlen(props->partNumber));
-        partNumber[strlen(props->partNumber)] = '\0';
+        status = CdmStringPropertyCopy(&props->partNumber, partNumber);
     } else {
         status = AJ_ERR_NO_MATCH;
     }
@@ -480,12 +605,8 @@ AJ_Status Cdm_FilterStatusInterfaceSetPartNumber(AJ_BusAttachment* busAttachment
         if (props->partNumberInit) { //const
             return AJ_ERR_FAILURE;
         } else {
-            props->partNumber = (char*) malloc(strlen(partNumber) + 1);
-            if (!props->partNumber) {
-                status = AJ_ERR_RESOURCES;
-            } else {
-                strncpy(props->partNumber, partNumber, strlen(partNumber));
-                props->partNumber[strlen(partNumber)] = '\0';
+            status = CdmStringPropertySet(&props->partNumber, partNumber, NULL);
+            if (status == AJ_OK) {
                 props->partNumberInit = true;
             }
         }
@@ -507,11 +628,7 @@ AJ_Status Cdm_FilterStatusInterfaceGetUrl(const char* objPath, char* url)
 
     props = (FilterStatusProperties*) GetProperties(objPath, FILTER_STATUS_INTERFACE);
     if (props) {
-        if (!props->url) {
-            return AJ_ERR_NULL;
-        }
-        strncpy(url, props->url, strlen(props->url));
-        url[strlen(props->url)] = '\0';
+        status = CdmStringPropertyCopy(&props->url, url);
     } else {
         status = AJ_ERR_NO_MATCH;
     }
@@ -537,12 +654,8 @@ AJ_Status Cdm_FilterStatusInterfaceSetUrl(AJ_BusAttachment* busAttachment, const
         if (props->urlInit) { //const
             return AJ_ERR_FAILURE;
         } else {
-            props->url = (char*) malloc(strlen(url) + 1);
-            if (!props->url) {
-                status = AJ_ERR_RESOURCES;
-            } else {
-                strncpy(props->url, url, strlen(url));
-                props->url[strlen(url)] = '\0';
+            status = CdmStringPropertySet(&props->url, url, NULL);
+            if (status == AJ_OK) {
                 props->urlInit = true;
             }
         }
@@ -588,6 +701,12 @@ AJ_Status Cdm_FilterStatusInterfaceSetLifeRemaining(AJ_BusAttachment* busAttachm
     props = (FilterStatusProperties*)GetProperties(objPath, FILTER_STATUS_INTERFACE);
     if (props) {
         props->lifeRemaining = value;
+        if (props->lifeTracking) {
+            ResetUsedMinutes(props);
+            if (value && !Cdm_TimerWheelIsScheduled(&props->lifeTimer)) {
+                Cdm_TimerWheelSchedule(&props->lifeTimer, LIFE_TRACKING_PERIOD, LIFE_TRACKING_PERIOD);
+            }
+        }
         status = EmitPropChanged(busAttachment, objPath, "LifeRemaining", "y", &(props->lifeRemaining));
     } else {
         status = AJ_ERR_NO_MATCH;
@@ -595,3 +714,101 @@ AJ_Status Cdm_FilterStatusInterfaceSetLifeRemaining(AJ_BusAttachment* busAttachm
 
     return status;
 }
+
+AJ_Status Cdm_FilterStatusInterfaceBorrowManufacturer(const char* objPath, const char** manufacturer, size_t* length)
+{
+    AJ_Status status = AJ_OK;
+    FilterStatusProperties* props = NULL;
+
+    if (!manufacturer) {
+        return AJ_ERR_INVALID;
+    }
+
+    props = (FilterStatusProperties*) GetProperties(objPath, FILTER_STATUS_INTERFACE);
+    if (props) {
+        status = CdmStringPropertyBorrow(&props->manufacturer, manufacturer, length);
+    } else {
+        status = AJ_ERR_NO_MATCH;
+    }
+
+    return status;
+}
+
+AJ_Status Cdm_FilterStatusInterfaceBorrowPartNumber(const char* objPath, const char** partNumber, size_t* length)
+{
+    AJ_Status status = AJ_OK;
+    FilterStatusProperties* props = NULL;
+
+    if (!partNumber) {
+        return AJ_ERR_INVALID;
+    }
+
+    props = (FilterStatusProperties*) GetProperties(objPath, FILTER_STATUS_INTERFACE);
+    if (props) {
+        status = CdmStringPropertyBorrow(&props->partNumber, partNumber, length);
+    } else {
+        status = AJ_ERR_NO_MATCH;
+    }
+
+    return status;
+}
+
+AJ_Status Cdm_FilterStatusInterfaceBorrowUrl(const char* objPath, const char** url, size_t* length)
+{
+    AJ_Status status = AJ_OK;
+    FilterStatusProperties* props = NULL;
+
+    if (!url) {
+        return AJ_ERR_INVALID;
+    }
+
+    props = (FilterStatusProperties*) GetProperties(objPath, FILTER_STATUS_INTERFACE);
+    if (props) {
+        status = CdmStringPropertyBorrow(&props->url, url, length);
+    } else {
+        status = AJ_ERR_NO_MATCH;
+    }
+
+    return status;
+}
+
+AJ_Status Cdm_FilterStatusInterfaceStartLifeTracking(const char* objPath)
+{
+    FilterStatusProperties* props = NULL;
+
+    props = (FilterStatusProperties*)GetProperties(objPath, FILTER_STATUS_INTERFACE);
+    if (!props) {
+        return AJ_ERR_NO_MATCH;
+    }
+
+    if (!props->expectedLifeInDays) {
+        return AJ_ERR_INVALID;
+    }
+
+    if (!props->lifeTracking) {
+        props->lifeTracking = true;
+        props->objPath = objPath;
+        ResetUsedMinutes(props);
+        Cdm_TimerWheelInitTimer(&props->lifeTimer, LifeTimerExpired, props);
+        if (props->lifeRemaining) {
+            Cdm_TimerWheelSchedule(&props->lifeTimer, LIFE_TRACKING_PERIOD, LIFE_TRACKING_PERIOD);
+        }
+    }
+
+    return AJ_OK;
+}
+
+AJ_Status Cdm_FilterStatusInterfaceStopLifeTracking(const char* objPath)
+{
+    FilterStatusProperties* props = NULL;
+
+    props = (FilterStatusProperties*)GetProperties(objPath, FILTER_STATUS_INTERFACE);
+    if (!props) {
+        return AJ_ERR_NO_MATCH;
+    }
+
+    props->lifeTracking = false;
+    Cdm_TimerWheelCancel(&props->lifeTimer);
+
+    return AJ_OK;
+}
@@ -23,6 +23,8 @@ const char* const intfDescOperationFilterStatus[10];
 
 AJ_Status CreateFilterStatusInterface(void** properties);
 void DestroyFilterStatusInterface(void* properties);
+AJ_Status FilterStatusInterfaceSaveProperties(void* properties, CdmSnapshotWriter* writer);
+AJ_Status FilterStatusInterfaceLoadProperties(void* properties, CdmSnapshotReader* reader);
 AJ_Status FilterStatusInterfaceOnGetProperty(AJ_Message* replyMsg, const char* objPath, void* properties, uint8_t memberIndex, void* listener);
 
 #endif /* FILTERSTATUSIMPL_H_ */
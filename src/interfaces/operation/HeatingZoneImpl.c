@@ -36,11 +36,11 @@ typedef struct {
     uint8_t numberOfHeatingZones;
     uint8_t* maxHeatingLevels;
     uint8_t* heatingLevels;
+    size_t maxListSize;
+    size_t listSize;
+    uint32_t heatingLevelsRevision; //changed whenever heatingLevels are changed, to tell if a borrowed list is stale
 } HeatingZoneProperties;
 
-static size_t listSize = 0;
-static size_t maxListSize = 0;
-
 AJ_Status HeatingZoneHeatingLevelsValidationCheck(const char* objPath, uint8_t* heatingLevels)
 {
     AJ_Status status = AJ_OK;
@@ -50,7 +50,7 @@ AJ_Status HeatingZoneHeatingLevelsValidationCheck(const char* objPath, uint8_t*
     if (props) {
         int i = 0;
 
-        for (i = 0; i < listSize; i++) {
+        for (i = 0; i < props->listSize; i++) {
             if ( heatingLevels > props->maxHeatingLevels) {
                 status = AJ_ERR_RANGE;
             }
@@ -91,10 +91,66 @@ void DestroyHeatingZoneInterface(void* properties)
     }
 }
 
+AJ_Status HeatingZoneInterfaceSaveProperties(void* properties, CdmSnapshotWriter* writer)
+{
+    AJ_Status status = AJ_OK;
+    HeatingZoneProperties* props = (HeatingZoneProperties*)properties;
+
+    status = CdmSnapshotWrite(writer, &props->numberOfHeatingZones, sizeof(props->numberOfHeatingZones));
+    if (status == AJ_OK) {
+        status = CdmSnapshotWriteArray(writer, props->maxHeatingLevels, sizeof(uint8_t), props->maxListSize);
+    }
+    if (status == AJ_OK) {
+        status = CdmSnapshotWriteArray(writer, props->heatingLevels, sizeof(uint8_t), props->listSize);
+    }
+
+    return status;
+}
+
+AJ_Status HeatingZoneInterfaceLoadProperties(void* properties, CdmSnapshotReader* reader)
+{
+    AJ_Status status = AJ_OK;
+    HeatingZoneProperties* props = (HeatingZoneProperties*)properties;
+    uint8_t numberOfHeatingZones = 0;
+    uint8_t* maxHeatingLevels = NULL;
+    size_t maxHeatingLevelsListSize = 0;
+    uint8_t* heatingLevels = NULL;
+    size_t heatingLevelsListSize = 0;
+
+    status = CdmSnapshotRead(reader, &numberOfHeatingZones, sizeof(numberOfHeatingZones));
+    if (status == AJ_OK) {
+        status = CdmSnapshotReadArray(reader, (void**)&maxHeatingLevels, sizeof(uint8_t), &maxHeatingLevelsListSize);
+    }
+    if (status == AJ_OK) {
+        status = CdmSnapshotReadArray(reader, (void**)&heatingLevels, sizeof(uint8_t), &heatingLevelsListSize);
+    }
+    if (status != AJ_OK) {
+        free(maxHeatingLevels);
+        free(heatingLevels);
+        return status;
+    }
+
+    props->numberOfHeatingZones = numberOfHeatingZones;
+    if (props->maxHeatingLevels) {
+        free(props->maxHeatingLevels);
+    }
+    props->maxHeatingLevels = maxHeatingLevels;
+    props->maxListSize = maxHeatingLevelsListSize;
+    if (props->heatingLevels) {
+        free(props->heatingLevels);
+    }
+    props->heatingLevels = heatingLevels;
+    props->listSize = heatingLevelsListSize;
+    props->heatingLevelsRevision++;
+
+    return AJ_OK;
+}
+
 static AJ_Status EmitPropChanged(AJ_BusAttachment* busAttachment, const char* objPath, const char* propName, const char* signature, void* val)
 {
     AJ_Status status = AJ_OK;
     uint32_t msgId = 0;
+    CdmPropChangedTarget target = { 0, 0, 0 };
     AJ_Message msg;
     AJ_Arg array, strc;
 
@@ -103,18 +159,20 @@ static AJ_Status EmitPropChanged(AJ_BusAttachment* busAttachment, const char* ob
     }
 
     status = MakePropChangedId(objPath, &msgId);
-    if (status == AJ_OK) {
-        AJ_MarshalSignal(busAttachment, &msg, msgId, NULL, 0, AJ_FLAG_GLOBAL_BROADCAST, 0);
+    while (status == AJ_OK && CdmNextPropChangedTarget(msgId, &target)) {
+        AJ_MarshalSignal(busAttachment, &msg, msgId, NULL, target.sessionId, target.flags, 0);
         AJ_MarshalArgs(&msg, "s", intfDescOperationHeatingZone[0]+1); //To remove '$'
         AJ_MarshalContainer(&msg, &array, AJ_ARG_ARRAY);
         AJ_MarshalContainer(&msg, &strc, AJ_ARG_DICT_ENTRY);
         if (!strcmp(signature, "y")) {
             AJ_MarshalArgs(&msg, "sv", propName, signature, *(uint8_t*)val);
         } else if (!strcmp(signature, "ay")) {
+            HeatingZoneProperties* props = (HeatingZoneProperties*)val;
+
             if (!strcmp(propName, "MaxHeatingLevels")) {
-                AJ_MarshalArgs(&msg, "sv", propName, signature, (uint8_t*)val, maxListSize);
+                AJ_MarshalArgs(&msg, "sv", propName, signature, props->maxHeatingLevels, props->maxListSize);
             } else if (!strcmp(propName, "HeatingLevels")) {
-                AJ_MarshalArgs(&msg, "sv", propName, signature, (uint8_t*)val, listSize);
+                AJ_MarshalArgs(&msg, "sv", propName, signature, props->heatingLevels, props->listSize);
             } else {
                 return AJ_ERR_INVALID;
             }
@@ -155,7 +213,8 @@ AJ_Status HeatingZoneInterfaceOnGetProperty(AJ_Message* replyMsg, const char* ob
             uint8_t numberOfHeatingZones;
             if (lt && lt->OnGetNumberOfHeatingZones) {
                 status = lt->OnGetNumberOfHeatingZones(objPath, &numberOfHeatingZones);
-                if (status == AJ_OK) {
+                if (status == AJ_OK && !CdmIsReplyDeferred()) {
+                    CdmMarkValuePulled();
                     props->numberOfHeatingZones = numberOfHeatingZones;
                 }
             }
@@ -164,16 +223,17 @@ AJ_Status HeatingZoneInterfaceOnGetProperty(AJ_Message* replyMsg, const char* ob
         break;
     case 2 :
         {
-            uint8_t* maxHeatingLevels = (uint8_t*)malloc(sizeof(uint8_t) * maxListSize);
+            uint8_t* maxHeatingLevels = (uint8_t*)malloc(sizeof(uint8_t) * props->maxListSize);
             if (lt && lt->OnGetMaxHeatingLevels) {
                 status = lt->OnGetMaxHeatingLevels(objPath, maxHeatingLevels);
-                if (status == AJ_OK) {
+                if (status == AJ_OK && !CdmIsReplyDeferred()) {
+                    CdmMarkValuePulled();
                     if (props->maxHeatingLevels) {
                         free(props->maxHeatingLevels);
                     }
-                    props->maxHeatingLevels = (uint8_t*)malloc(sizeof(uint8_t) * maxListSize);
+                    props->maxHeatingLevels = (uint8_t*)malloc(sizeof(uint8_t) * props->maxListSize);
 
-                    memcpy(props->maxHeatingLevels, maxHeatingLevels, sizeof(uint8_t) * maxListSize);
+                    memcpy(props->maxHeatingLevels, maxHeatingLevels, sizeof(uint8_t) * props->maxListSize);
                 }
             }
             if (!props->maxHeatingLevels) {
@@ -181,22 +241,24 @@ AJ_Status HeatingZoneInterfaceOnGetProperty(AJ_Message* replyMsg, const char* ob
                 return AJ_ERR_NULL;
             }
 
-            status = AJ_MarshalArgs(replyMsg, "ay", props->maxHeatingLevels, sizeof(uint8_t) * maxListSize);
+            status = AJ_MarshalArgs(replyMsg, "ay", props->maxHeatingLevels, sizeof(uint8_t) * props->maxListSize);
             free(maxHeatingLevels);
         }
         break;
     case 3:
         {
-            uint8_t* heatingLevels = (uint8_t*)malloc(sizeof(uint8_t) * listSize);
+            uint8_t* heatingLevels = (uint8_t*)malloc(sizeof(uint8_t) * props->listSize);
             if (lt && lt->OnGetHeatingLevels) {
                 status = lt->OnGetHeatingLevels(objPath, heatingLevels);
-                if (status == AJ_OK) {
+                if (status == AJ_OK && !CdmIsReplyDeferred()) {
+                    CdmMarkValuePulled();
                     if (props->heatingLevels) {
                         free(props->heatingLevels);
                     }
-                    props->heatingLevels = (uint8_t*)malloc(sizeof(uint8_t) * listSize);
+                    props->heatingLevels = (uint8_t*)malloc(sizeof(uint8_t) * props->listSize);
 
-                    memcpy(props->heatingLevels, heatingLevels, sizeof(uint8_t) * listSize);
+                    memcpy(props->heatingLevels, heatingLevels, sizeof(uint8_t) * props->listSize);
+                    props->heatingLevelsRevision++;
                 }
             }
             if (!props->heatingLevels) {
@@ -204,7 +266,7 @@ AJ_Status HeatingZoneInterfaceOnGetProperty(AJ_Message* replyMsg, const char* ob
                 return AJ_ERR_NULL;
             }
 
-            status = AJ_MarshalArgs(replyMsg, "ay", props->heatingLevels, sizeof(uint8_t) * listSize);
+            status = AJ_MarshalArgs(replyMsg, "ay", props->heatingLevels, sizeof(uint8_t) * props->listSize);
             free(heatingLevels);
         }
         break;
@@ -271,7 +333,7 @@ AJ_Status Cdm_HeatingZoneInterfaceGetMaxHeatingLevels(const char* objPath, uint8
         if (!props->maxHeatingLevels) {
             return AJ_ERR_NULL;
         }
-        memcpy(maxHeatingLevels, props->maxHeatingLevels, sizeof(uint8_t) * maxListSize);
+        memcpy(maxHeatingLevels, props->maxHeatingLevels, sizeof(uint8_t) * props->maxListSize);
     } else {
         status = AJ_ERR_NO_MATCH;
     }
@@ -301,13 +363,13 @@ AJ_Status Cdm_HeatingZoneInterfaceSetMaxHeatingLevels(AJ_BusAttachment* busAttac
         if (props->maxHeatingLevels) {
             free(props->maxHeatingLevels);
         }
-        maxListSize = supportedModeSize;
+        props->maxListSize = supportedModeSize;
 
-        props->maxHeatingLevels = (uint8_t*)malloc(sizeof(uint8_t) * maxListSize);
+        props->maxHeatingLevels = (uint8_t*)malloc(sizeof(uint8_t) * props->maxListSize);
 
-        memcpy(props->maxHeatingLevels, maxHeatingLevels, sizeof(uint8_t) * maxListSize);
+        memcpy(props->maxHeatingLevels, maxHeatingLevels, sizeof(uint8_t) * props->maxListSize);
 
-        status = EmitPropChanged(busAttachment, objPath, "MaxHeatingLevels", "ay", props->maxHeatingLevels);
+        status = EmitPropChanged(busAttachment, objPath, "MaxHeatingLevels", "ay", props);
     } else {
         status = AJ_ERR_NO_MATCH;
     }
@@ -329,7 +391,7 @@ AJ_Status Cdm_HeatingZoneInterfaceGetHeatingLevels(const char* objPath, uint8_t*
         if (!props->heatingLevels) {
             return AJ_ERR_NULL;
         }
-        memcpy(heatingLevels, props->heatingLevels, sizeof(uint8_t) * listSize);
+        memcpy(heatingLevels, props->heatingLevels, sizeof(uint8_t) * props->listSize);
     } else {
         status = AJ_ERR_NO_MATCH;
     }
@@ -337,6 +399,31 @@ AJ_Status Cdm_HeatingZoneInterfaceGetHeatingLevels(const char* objPath, uint8_t*
     return status;
 }
 
+AJ_Status Cdm_HeatingZoneInterfaceBorrowHeatingLevels(const char* objPath, const uint8_t** heatingLevels, size_t* heatingLevelsSize, uint32_t* revision)
+{
+    HeatingZoneProperties* props = NULL;
+
+    if (!heatingLevels || !heatingLevelsSize) {
+        return AJ_ERR_INVALID;
+    }
+
+    props = (HeatingZoneProperties*)GetProperties(objPath, HEATING_ZONE_INTERFACE);
+    if (!props) {
+        return AJ_ERR_NO_MATCH;
+    }
+
+    if (!props->heatingLevels) {
+        return AJ_ERR_NULL;
+    }
+    *heatingLevels = props->heatingLevels;
+    *heatingLevelsSize = props->listSize;
+    if (revision) {
+        *revision = props->heatingLevelsRevision;
+    }
+
+    return AJ_OK;
+}
+
 AJ_Status Cdm_HeatingZoneInterfaceSetHeatingLevels(AJ_BusAttachment* busAttachment, const char* objPath, const uint8_t* heatingLevels, const size_t supportedModeSize)
 {
     AJ_Status status = AJ_OK;
@@ -359,13 +446,14 @@ AJ_Status Cdm_HeatingZoneInterfaceSetHeatingLevels(AJ_BusAttachment* busAttachme
         if (props->heatingLevels) {
             free(props->heatingLevels);
         }
-        listSize = supportedModeSize;
+        props->listSize = supportedModeSize;
 
-        props->heatingLevels = (uint8_t*)malloc(sizeof(uint8_t) * listSize);
+        props->heatingLevels = (uint8_t*)malloc(sizeof(uint8_t) * props->listSize);
 
-        memcpy(props->heatingLevels, heatingLevels, sizeof(uint8_t) * listSize);
+        memcpy(props->heatingLevels, heatingLevels, sizeof(uint8_t) * props->listSize);
+        props->heatingLevelsRevision++;
 
-        status = EmitPropChanged(busAttachment, objPath, "HeatingLevels", "ay", props->heatingLevels);
+        status = EmitPropChanged(busAttachment, objPath, "HeatingLevels", "ay", props);
     } else {
         status = AJ_ERR_NO_MATCH;
     }
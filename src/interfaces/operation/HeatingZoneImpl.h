@@ -23,6 +23,8 @@ const char* const intfDescOperationHeatingZone[6];
 
 AJ_Status CreateHeatingZoneInterface(void** properties);
 void DestroyHeatingZoneInterface(void* properties);
+AJ_Status HeatingZoneInterfaceSaveProperties(void* properties, CdmSnapshotWriter* writer);
+AJ_Status HeatingZoneInterfaceLoadProperties(void* properties, CdmSnapshotReader* reader);
 AJ_Status HeatingZoneInterfaceOnGetProperty(AJ_Message* replyMsg, const char* objPath, void* properties, uint8_t memberIndex, void* listener);
 
 #endif /* HEATINGZONEIMPL_H_ */
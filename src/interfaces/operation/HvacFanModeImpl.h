@@ -23,6 +23,8 @@ const char* const intfDescOperationHvacFanMode[5];
 
 AJ_Status CreateHvacFanModeInterface(void** properties);
 void DestroyHvacFanModeInterface(void* properties);
+AJ_Status HvacFanModeInterfaceSaveProperties(void* properties, CdmSnapshotWriter* writer);
+AJ_Status HvacFanModeInterfaceLoadProperties(void* properties, CdmSnapshotReader* reader);
 AJ_Status HvacFanModeInterfaceOnGetProperty(AJ_Message* replyMsg, const char* objPath, void* properties, uint8_t memberIndex, void* listener);
 AJ_Status HvacFanModeInterfaceOnSetProperty(AJ_Message* replyMsg, const char* objPath, void* properties, uint8_t memberIndex, void* listener, bool* propChanged);
 AJ_Status HvacFanModeInterfaceEmitPropertiesChanged(AJ_BusAttachment* busAttachment, const char* objPath, void* properties, uint8_t memberIndex);
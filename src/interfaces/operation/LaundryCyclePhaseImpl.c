@@ -17,6 +17,9 @@
 #include <string.h>
 #include <ajtcl/cdm/interfaces/operation/LaundryCyclePhase.h>
 #include "../../CdmControllee/CdmControlleeImpl.h"
+#include "../CdmDescriptionCatalogImpl.h"
+#include "../CdmArrayBufferImpl.h"
+#include "../CdmValueSetImpl.h"
 #include "LaundryCyclePhaseImpl.h"
 
 #define INTERFACE_VERSION 1
@@ -34,10 +37,12 @@ typedef struct {
     uint16_t version;
     uint8_t cyclePhase;
     uint8_t* supportedCyclePhases;
+    size_t supportedCyclePhasesSize;
+    size_t supportedCyclePhasesCapacity;
+    CdmDescriptionCatalog vendorPhasesDescriptionCatalog;
+    CdmValueSet supportedCyclePhasesSet;
 } LaundryCyclePhaseProperties;
 
-static size_t supportedCyclePhasesSize = 0;
-
 AJ_Status LaundryCyclePhaseValidationCheck(const char* objPath, uint8_t cyclePhase)
 {
     AJ_Status status = AJ_OK;
@@ -45,16 +50,7 @@ AJ_Status LaundryCyclePhaseValidationCheck(const char* objPath, uint8_t cyclePha
     props = (LaundryCyclePhaseProperties*)GetProperties(objPath, LAUNDRY_CYCLE_PHASE_INTERFACE);
 
     if (props) {
-        int i = 0;
-        bool check = false;
-        for (i = 0; i < supportedCyclePhasesSize; i++) {
-            if (props->supportedCyclePhases[i] == cyclePhase) {
-                check = true;
-                break;
-            }
-        }
-
-        if (!check) {
+        if (!CdmValueSetContains(&props->supportedCyclePhasesSet, cyclePhase)) {
             return AJ_ERR_RANGE;
         }
     } else {
@@ -85,14 +81,58 @@ void DestroyLaundryCyclePhaseInterface(void* properties)
         if (props->supportedCyclePhases) {
             free(props->supportedCyclePhases);
         }
+        CdmDescriptionCatalogClear(&props->vendorPhasesDescriptionCatalog);
         free(props);
     }
 }
 
+AJ_Status LaundryCyclePhaseInterfaceSaveProperties(void* properties, CdmSnapshotWriter* writer)
+{
+    AJ_Status status = AJ_OK;
+    LaundryCyclePhaseProperties* props = (LaundryCyclePhaseProperties*)properties;
+
+    status = CdmSnapshotWrite(writer, &props->cyclePhase, sizeof(props->cyclePhase));
+    if (status == AJ_OK) {
+        status = CdmSnapshotWriteArray(writer, props->supportedCyclePhases, sizeof(uint8_t), props->supportedCyclePhasesSize);
+    }
+
+    return status;
+}
+
+AJ_Status LaundryCyclePhaseInterfaceLoadProperties(void* properties, CdmSnapshotReader* reader)
+{
+    AJ_Status status = AJ_OK;
+    LaundryCyclePhaseProperties* props = (LaundryCyclePhaseProperties*)properties;
+    uint8_t cyclePhase = 0;
+    uint8_t* supportedCyclePhases = NULL;
+    size_t supportedCyclePhasesListSize = 0;
+    bool changed = false;
+
+    status = CdmSnapshotRead(reader, &cyclePhase, sizeof(cyclePhase));
+    if (status == AJ_OK) {
+        status = CdmSnapshotReadArray(reader, (void**)&supportedCyclePhases, sizeof(uint8_t), &supportedCyclePhasesListSize);
+    }
+    if (status != AJ_OK) {
+        free(supportedCyclePhases);
+        return status;
+    }
+
+    props->cyclePhase = cyclePhase;
+    status = CdmArrayBufferAssign((void**)&props->supportedCyclePhases, &props->supportedCyclePhasesSize, &props->supportedCyclePhasesCapacity,
+                                  sizeof(uint8_t), supportedCyclePhases, supportedCyclePhasesListSize, &changed);
+    if (status == AJ_OK && changed) {
+        CdmValueSetBuild(&props->supportedCyclePhasesSet, props->supportedCyclePhases, props->supportedCyclePhasesSize);
+    }
+    free(supportedCyclePhases);
+
+    return status;
+}
+
 static AJ_Status EmitPropChanged(AJ_BusAttachment* busAttachment, const char* objPath, const char* propName, const char* signature, void* val)
 {
     AJ_Status status = AJ_OK;
     uint32_t msgId = 0;
+    CdmPropChangedTarget target = { 0, 0, 0 };
     AJ_Message msg;
     AJ_Arg array, strc;
 
@@ -101,15 +141,17 @@ static AJ_Status EmitPropChanged(AJ_BusAttachment* busAttachment, const char* ob
     }
 
     status = MakePropChangedId(objPath, &msgId);
-    if (status == AJ_OK) {
-        AJ_MarshalSignal(busAttachment, &msg, msgId, NULL, 0, AJ_FLAG_GLOBAL_BROADCAST, 0);
+    while (status == AJ_OK && CdmNextPropChangedTarget(msgId, &target)) {
+        AJ_MarshalSignal(busAttachment, &msg, msgId, NULL, target.sessionId, target.flags, 0);
         AJ_MarshalArgs(&msg, "s", intfDescOperationLaundryCyclePhase[0]+1); //To remove '$'
         AJ_MarshalContainer(&msg, &array, AJ_ARG_ARRAY);
         AJ_MarshalContainer(&msg, &strc, AJ_ARG_DICT_ENTRY);
         if (!strcmp(signature, "y")) {
             AJ_MarshalArgs(&msg, "sv", propName, signature, *(uint8_t*)val);
         } else if (!strcmp(signature, "ay")) {
-            AJ_MarshalArgs(&msg, "sv", propName, signature, (uint8_t*)val, sizeof(uint8_t) * supportedCyclePhasesSize);
+            LaundryCyclePhaseProperties* props = (LaundryCyclePhaseProperties*)val;
+
+            AJ_MarshalArgs(&msg, "sv", propName, signature, props->supportedCyclePhases, sizeof(uint8_t) * props->supportedCyclePhasesSize);
 
         } else {
             return AJ_ERR_SIGNATURE;
@@ -148,7 +190,8 @@ AJ_Status LaundryCyclePhaseInterfaceOnGetProperty(AJ_Message* replyMsg, const ch
             uint8_t cyclePhase;
             if (lt && lt->OnGetCyclePhase) {
                 status = lt->OnGetCyclePhase(objPath, &cyclePhase);
-                if (status == AJ_OK) {
+                if (status == AJ_OK && !CdmIsReplyDeferred()) {
+                    CdmMarkValuePulled();
                     props->cyclePhase = cyclePhase;
                 }
             }
@@ -157,23 +200,28 @@ AJ_Status LaundryCyclePhaseInterfaceOnGetProperty(AJ_Message* replyMsg, const ch
         break;
     case 2 :
         {
-            uint8_t* supportedCyclePhases = (uint8_t*)malloc(sizeof(uint8_t) * supportedCyclePhasesSize);
+            bool changed = false;
 
+            if (!props->supportedCyclePhases) {
+                return AJ_ERR_NULL;
+            }
             if (lt && lt->OnGetSupportedCyclePhases) {
+                //the listener fills as many phases as are stored
+                uint8_t* supportedCyclePhases = (uint8_t*)CdmArrayBufferScratch(sizeof(uint8_t), props->supportedCyclePhasesSize);
+                if (!supportedCyclePhases) {
+                    return AJ_ERR_RESOURCES;
+                }
                 status = lt->OnGetSupportedCyclePhases(objPath, supportedCyclePhases);
-                if (status == AJ_OK) {
-                    if (props->supportedCyclePhases) {
-                        free(props->supportedCyclePhases);
-                    }
-                    props->supportedCyclePhases = (uint8_t*)malloc(sizeof(uint8_t) * supportedCyclePhasesSize);
-                    memcpy(props->supportedCyclePhases, supportedCyclePhases, sizeof(uint8_t) * supportedCyclePhasesSize);
+                if (status == AJ_OK && !CdmIsReplyDeferred()) {
+                    CdmMarkValuePulled();
+                    CdmArrayBufferAssign((void**)&props->supportedCyclePhases, &props->supportedCyclePhasesSize, &props->supportedCyclePhasesCapacity,
+                                         sizeof(uint8_t), supportedCyclePhases, props->supportedCyclePhasesSize, &changed);
+                }
+                if (changed) {
+                    CdmValueSetBuild(&props->supportedCyclePhasesSet, props->supportedCyclePhases, props->supportedCyclePhasesSize);
                 }
             }
-            if (!props->supportedCyclePhases) {
-                free(supportedCyclePhases);
-                return AJ_ERR_NULL;
-            }
-            status = AJ_MarshalArgs(replyMsg, "ay", props->supportedCyclePhases, sizeof(uint8_t) * supportedCyclePhasesSize);
+            status = AJ_MarshalArgs(replyMsg, "ay", props->supportedCyclePhases, sizeof(uint8_t) * props->supportedCyclePhasesSize);
         }
         break;
     default:
@@ -196,10 +244,22 @@ AJ_Status LaundryCyclePhaseInterfaceOnMethodHandler(AJ_Message* msg, const char*
     }
 
     LaundryCyclePhaseListener* lt = (LaundryCyclePhaseListener*)listener;
+    LaundryCyclePhaseProperties* props = (LaundryCyclePhaseProperties*)propChangedByMethod->properties;
+
+    if (!props) {
+        return AJ_ERR_INVALID;
+    }
 
     switch (memberIndex) {
     case 3 :
-        if (!lt->OnGetVendorPhasesDescription) {
+        if (CdmDescriptionCatalogIsSet(&props->vendorPhasesDescriptionCatalog)) {
+            char* languageTag;
+
+            status = AJ_UnmarshalArgs(msg, "s", &languageTag);
+            if (status == AJ_OK) {
+                status = CdmDescriptionCatalogReply(&props->vendorPhasesDescriptionCatalog, msg, languageTag);
+            }
+        } else if (!lt->OnGetVendorPhasesDescription) {
             status = AJ_ERR_NULL;
         } else {
             char* languageTag;
@@ -303,7 +363,7 @@ AJ_Status Cdm_LaundryCyclePhaseInterfaceGetSupportedCyclePhases(const char* objP
         if (!props->supportedCyclePhases) {
             return AJ_ERR_NULL;
         }
-        memcpy(supportedCyclePhases, props->supportedCyclePhases, sizeof(uint8_t) * supportedCyclePhasesSize);
+        memcpy(supportedCyclePhases, props->supportedCyclePhases, sizeof(uint8_t) * props->supportedCyclePhasesSize);
 
     } else {
         status = AJ_ERR_NO_MATCH;
@@ -327,17 +387,30 @@ AJ_Status Cdm_LaundryCyclePhaseInterfaceSetSupportedCyclePhases(AJ_BusAttachment
 
     props = (LaundryCyclePhaseProperties*)GetProperties(objPath, LAUNDRY_CYCLE_PHASE_INTERFACE);
     if (props) {
-        if (props->supportedCyclePhases) {
-            free(props->supportedCyclePhases);
-        }
+        bool changed = false;
 
-        supportedCyclePhasesSize = supportedCyclePhasesListSize;
+        status = CdmArrayBufferAssign((void**)&props->supportedCyclePhases, &props->supportedCyclePhasesSize, &props->supportedCyclePhasesCapacity,
+                                      sizeof(uint8_t), supportedCyclePhases, supportedCyclePhasesListSize, &changed);
+        if (status == AJ_OK && changed) {
+            CdmValueSetBuild(&props->supportedCyclePhasesSet, props->supportedCyclePhases, props->supportedCyclePhasesSize);
 
-        props->supportedCyclePhases = (uint8_t*)malloc(sizeof(uint8_t) * supportedCyclePhasesSize);
+            status = EmitPropChanged(busAttachment, objPath, "SupportedCyclePhases", "ay", props);
+        }
+    } else {
+        status = AJ_ERR_NO_MATCH;
+    }
 
-        memcpy(props->supportedCyclePhases, supportedCyclePhases, sizeof(uint8_t) * supportedCyclePhasesSize);
+    return status;
+}
 
-        status = EmitPropChanged(busAttachment, objPath, "SupportedCyclePhases", "ay", props->supportedCyclePhases);
+AJ_Status Cdm_LaundryCyclePhaseInterfaceSetVendorPhasesDescriptionCatalog(const char* objPath, const CdmDescriptionRecord* records, const uint16_t numRecords)
+{
+    AJ_Status status = AJ_OK;
+    LaundryCyclePhaseProperties* props = NULL;
+
+    props = (LaundryCyclePhaseProperties*)GetProperties(objPath, LAUNDRY_CYCLE_PHASE_INTERFACE);
+    if (props) {
+        status = CdmDescriptionCatalogSet(&props->vendorPhasesDescriptionCatalog, records, numRecords, true);
     } else {
         status = AJ_ERR_NO_MATCH;
     }
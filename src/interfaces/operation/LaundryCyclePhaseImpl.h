@@ -23,6 +23,8 @@ const char* const intfDescOperationLaundryCyclePhase[6];
 
 AJ_Status CreateLaundryCyclePhaseInterface(void** properties);
 void DestroyLaundryCyclePhaseInterface(void* properties);
+AJ_Status LaundryCyclePhaseInterfaceSaveProperties(void* properties, CdmSnapshotWriter* writer);
+AJ_Status LaundryCyclePhaseInterfaceLoadProperties(void* properties, CdmSnapshotReader* reader);
 AJ_Status LaundryCyclePhaseInterfaceOnGetProperty(AJ_Message* replyMsg, const char* objPath, void* properties, uint8_t memberIndex, void* listener);
 AJ_Status LaundryCyclePhaseInterfaceOnMethodHandler(AJ_Message* msg, const char* objPath, uint8_t memberIndex, void* listener, CdmPropertiesChangedByMethod* propChangedByMethod);
 
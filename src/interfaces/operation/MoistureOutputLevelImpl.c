@@ -14,8 +14,10 @@
  *    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
  ******************************************************************************/
 
+#include <stddef.h>
 #include <ajtcl/cdm/interfaces/operation/MoistureOutputLevel.h>
 #include "../../CdmControllee/CdmControlleeImpl.h"
+#include "../CdmConstraintImpl.h"
 #include "MoistureOutputLevelImpl.h"
 
 #define INTERFACE_VERSION 1
@@ -38,42 +40,23 @@ typedef struct {
     uint8_t moistureOutputLevel;
     uint8_t maxMoistureOutputLevel;
     uint8_t autoMode;
+    CdmConstraintPolicy constraintPolicy;
 } MoistureOutputLevelProperties;
 
-AJ_Status MoistureOutputLevelMoistureOutputLevelValidationCheck(const char* objPath, uint8_t value)
+static void GetMoistureOutputLevelConstraint(const MoistureOutputLevelProperties* props, CdmConstraint* constraint)
 {
-    AJ_Status status = AJ_OK;
-    MoistureOutputLevelProperties* props = NULL;
-
-    props = (MoistureOutputLevelProperties*)GetProperties(objPath, MOISTURE_OUTPUT_LEVEL_INTERFACE);
-    if (props) {
-        if (value > props->maxMoistureOutputLevel) {
-            status = AJ_ERR_RANGE;
-        }
-    } else {
-        status = AJ_ERR_NO_MATCH;
-    }
-
-    return status;
+    CdmConstraintInit(constraint, 0, props->maxMoistureOutputLevel, 0);
 }
 
-AJ_Status MoistureOutputLevelAutoModeValidationCheck(const char* objPath, uint8_t autoMode)
+static AJ_Status AutoModeValidationCheck(uint8_t currentAutoMode, uint8_t autoMode)
 {
-    AJ_Status status = AJ_OK;
-    MoistureOutputLevelProperties* props = NULL;
-
-    props = (MoistureOutputLevelProperties*)GetProperties(objPath, MOISTURE_OUTPUT_LEVEL_INTERFACE);
-    if (props) {
-        if (props->autoMode == AUTO_MODE_NOT_SUPPORTED) {
-            status = AJ_ERR_INVALID;
-        } else if (autoMode != AUTO_MODE_OFF && autoMode != AUTO_MODE_ON) {
-            status = AJ_ERR_INVALID;
-        }
-    } else {
-        status = AJ_ERR_NO_MATCH;
+    if (currentAutoMode == AUTO_MODE_NOT_SUPPORTED) {
+        return AJ_ERR_INVALID;
+    } else if (autoMode != AUTO_MODE_OFF && autoMode != AUTO_MODE_ON) {
+        return AJ_ERR_INVALID;
     }
 
-    return status;
+    return AJ_OK;
 }
 
 AJ_Status CreateMoistureOutputLevelInterface(void** properties)
@@ -85,6 +68,7 @@ AJ_Status CreateMoistureOutputLevelInterface(void** properties)
     memset(*properties, 0, sizeof(MoistureOutputLevelProperties));
 
     ((MoistureOutputLevelProperties*)*properties)->version = (uint16_t)INTERFACE_VERSION;
+    ((MoistureOutputLevelProperties*)*properties)->constraintPolicy = CDM_CONSTRAINT_POLICY_REJECT;
 
     return AJ_OK;
 }
@@ -98,10 +82,30 @@ void DestroyMoistureOutputLevelInterface(void* properties)
     }
 }
 
+AJ_Status MoistureOutputLevelInterfaceSaveProperties(void* properties, CdmSnapshotWriter* writer)
+{
+    return CdmSnapshotWrite(writer, properties, offsetof(MoistureOutputLevelProperties, constraintPolicy));
+}
+
+AJ_Status MoistureOutputLevelInterfaceLoadProperties(void* properties, CdmSnapshotReader* reader)
+{
+    if (reader->size != offsetof(MoistureOutputLevelProperties, constraintPolicy)) {
+        return AJ_ERR_INVALID;
+    }
+
+    return CdmSnapshotRead(reader, properties, offsetof(MoistureOutputLevelProperties, constraintPolicy));
+}
+
+void MoistureOutputLevelInterfaceSetConstraintPolicy(void* properties, CdmConstraintPolicy policy)
+{
+    ((MoistureOutputLevelProperties*)properties)->constraintPolicy = policy;
+}
+
 static AJ_Status EmitPropChanged(AJ_BusAttachment* busAttachment, const char* objPath, const char* propName, const char* signature, void* val)
 {
     AJ_Status status = AJ_OK;
     uint32_t msgId = 0;
+    CdmPropChangedTarget target = { 0, 0, 0 };
     AJ_Message msg;
     AJ_Arg array, strc;
 
@@ -110,8 +114,8 @@ static AJ_Status EmitPropChanged(AJ_BusAttachment* busAttachment, const char* ob
     }
 
     status = MakePropChangedId(objPath, &msgId);
-    if (status == AJ_OK) {
-        AJ_MarshalSignal(busAttachment, &msg, msgId, NULL, 0, AJ_FLAG_GLOBAL_BROADCAST, 0);
+    while (status == AJ_OK && CdmNextPropChangedTarget(msgId, &target)) {
+        AJ_MarshalSignal(busAttachment, &msg, msgId, NULL, target.sessionId, target.flags, 0);
         AJ_MarshalArgs(&msg, "s", intfDescOperationMoistureOutputLevel[0]+1); //To remove '$'
         AJ_MarshalContainer(&msg, &array, AJ_ARG_ARRAY);
         AJ_MarshalContainer(&msg, &strc, AJ_ARG_DICT_ENTRY);
@@ -179,7 +183,8 @@ AJ_Status MoistureOutputLevelInterfaceOnGetProperty(AJ_Message* replyMsg, const
             uint8_t value;
             if (lt && lt->OnGetMoistureOutputLevel) {
                 status = lt->OnGetMoistureOutputLevel(objPath, &value);
-                if (status == AJ_OK) {
+                if (status == AJ_OK && !CdmIsReplyDeferred()) {
+                    CdmMarkValuePulled();
                     props->moistureOutputLevel = value;
                 }
             }
@@ -191,7 +196,8 @@ AJ_Status MoistureOutputLevelInterfaceOnGetProperty(AJ_Message* replyMsg, const
             uint8_t value;
             if (lt && lt->OnGetMaxMoistureOutputLevel) {
                 status = lt->OnGetMaxMoistureOutputLevel(objPath, &value);
-                if (status == AJ_OK) {
+                if (status == AJ_OK && !CdmIsReplyDeferred()) {
+                    CdmMarkValuePulled();
                     props->maxMoistureOutputLevel = value;
                 }
             }
@@ -203,7 +209,8 @@ AJ_Status MoistureOutputLevelInterfaceOnGetProperty(AJ_Message* replyMsg, const
             uint8_t autoMode;
             if (lt && lt->OnGetAutoMode) {
                 status = lt->OnGetAutoMode(objPath, &autoMode);
-                if (status == AJ_OK) {
+                if (status == AJ_OK && !CdmIsReplyDeferred()) {
+                    CdmMarkValuePulled();
                     props->autoMode = autoMode;
                 }
             }
@@ -244,10 +251,15 @@ AJ_Status MoistureOutputLevelInterfaceOnSetProperty(AJ_Message* replyMsg, const
             status = AJ_UnmarshalArgs(replyMsg, "y", &value);
 
             if (status == AJ_OK) {
-                status = MoistureOutputLevelMoistureOutputLevelValidationCheck(objPath, value);
+                CdmConstraint constraint;
+                double constrained = value;
+
+                GetMoistureOutputLevelConstraint(props, &constraint);
+                status = CdmConstraintApply(&constraint, props->constraintPolicy, &constrained);
                 if (status != AJ_OK) {
                     return status;
                 }
+                value = (uint8_t)constrained;
 
                 status = lt->OnSetMoistureOutputLevel(objPath, value);
                 if (status == AJ_OK) {
@@ -270,7 +282,7 @@ AJ_Status MoistureOutputLevelInterfaceOnSetProperty(AJ_Message* replyMsg, const
             status = AJ_UnmarshalArgs(replyMsg, "y", &autoMode);
 
             if (status == AJ_OK) {
-                status = MoistureOutputLevelAutoModeValidationCheck(objPath, autoMode);
+                status = AutoModeValidationCheck(props->autoMode, autoMode);
                 if (status != AJ_OK) {
                     return status;
                 }
@@ -320,13 +332,16 @@ AJ_Status Cdm_MoistureOutputLevelInterfaceSetMoistureOutputLevel(AJ_BusAttachmen
         return AJ_ERR_INVALID;
     }
 
-    status = MoistureOutputLevelMoistureOutputLevelValidationCheck(objPath, value);
-    if (status != AJ_OK) {
-        return status;
-    }
-
     props = (MoistureOutputLevelProperties*)GetProperties(objPath, MOISTURE_OUTPUT_LEVEL_INTERFACE);
     if (props) {
+        CdmConstraint constraint;
+
+        GetMoistureOutputLevelConstraint(props, &constraint);
+        status = CdmConstraintCheck(&constraint, value);
+        if (status != AJ_OK) {
+            return status;
+        }
+
         if (props->moistureOutputLevel != value) {
             props->moistureOutputLevel = value;
 
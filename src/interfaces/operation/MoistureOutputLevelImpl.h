@@ -23,6 +23,9 @@ const char* const intfDescOperationMoistureOutputLevel[6];
 
 AJ_Status CreateMoistureOutputLevelInterface(void** properties);
 void DestroyMoistureOutputLevelInterface(void* properties);
+AJ_Status MoistureOutputLevelInterfaceSaveProperties(void* properties, CdmSnapshotWriter* writer);
+AJ_Status MoistureOutputLevelInterfaceLoadProperties(void* properties, CdmSnapshotReader* reader);
+void MoistureOutputLevelInterfaceSetConstraintPolicy(void* properties, CdmConstraintPolicy policy);
 AJ_Status MoistureOutputLevelInterfaceOnGetProperty(AJ_Message* replyMsg, const char* objPath, void* properties, uint8_t memberIndex, void* listener);
 AJ_Status MoistureOutputLevelInterfaceOnSetProperty(AJ_Message* replyMsg, const char* objPath, void* properties, uint8_t memberIndex, void* listener, bool* propChanged);
 AJ_Status MoistureOutputLevelInterfaceEmitPropertiesChanged(AJ_BusAttachment* busAttachment, const char* objPath, void* properties, uint8_t memberIndex);
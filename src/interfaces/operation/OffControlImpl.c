@@ -54,6 +54,20 @@ void DestroyOffControlInterface(void* properties)
     }
 }
 
+AJ_Status OffControlInterfaceSaveProperties(void* properties, CdmSnapshotWriter* writer)
+{
+    return CdmSnapshotWrite(writer, properties, sizeof(OffControlProperties));
+}
+
+AJ_Status OffControlInterfaceLoadProperties(void* properties, CdmSnapshotReader* reader)
+{
+    if (reader->size != sizeof(OffControlProperties)) {
+        return AJ_ERR_INVALID;
+    }
+
+    return CdmSnapshotRead(reader, properties, sizeof(OffControlProperties));
+}
+
 AJ_Status OffControlInterfaceOnMethodHandler(AJ_Message* msg, const char* objPath, uint8_t memberIndex, void* listener, CdmPropertiesChangedByMethod* propChangedByMethod)
 {
     AJ_Status status = AJ_OK;
@@ -76,6 +90,9 @@ AJ_Status OffControlInterfaceOnMethodHandler(AJ_Message* msg, const char* objPat
             ErrorCode errorCode = NOT_ERROR;
             AJ_Message reply;
             status = lt->OnSwitchOff(objPath, &errorCode);
+            if (CdmIsReplyDeferred()) {
+                break;
+            }
 
             AJ_MarshalReplyMsg(msg, &reply);
             if (status != AJ_OK) {
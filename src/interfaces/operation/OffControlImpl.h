@@ -23,6 +23,8 @@ const char* const intfDescOperationOffControl[4];
 
 AJ_Status CreateOffControlInterface(void** properties);
 void DestroyOffControlInterface(void* properties);
+AJ_Status OffControlInterfaceSaveProperties(void* properties, CdmSnapshotWriter* writer);
+AJ_Status OffControlInterfaceLoadProperties(void* properties, CdmSnapshotReader* reader);
 AJ_Status OffControlInterfaceOnMethodHandler(AJ_Message* msg, const char* objPath, uint8_t memberIndex, void* listener, CdmPropertiesChangedByMethod* propChangedByMethod);
 
 #endif /* OFFCONTROLIMPL_H_ */
@@ -54,6 +54,20 @@ void DestroyOnControlInterface(void* properties)
     }
 }
 
+AJ_Status OnControlInterfaceSaveProperties(void* properties, CdmSnapshotWriter* writer)
+{
+    return CdmSnapshotWrite(writer, properties, sizeof(OnControlProperties));
+}
+
+AJ_Status OnControlInterfaceLoadProperties(void* properties, CdmSnapshotReader* reader)
+{
+    if (reader->size != sizeof(OnControlProperties)) {
+        return AJ_ERR_INVALID;
+    }
+
+    return CdmSnapshotRead(reader, properties, sizeof(OnControlProperties));
+}
+
 AJ_Status OnControlInterfaceOnMethodHandler(AJ_Message* msg, const char* objPath, uint8_t memberIndex, void* listener, CdmPropertiesChangedByMethod* propChangedByMethod)
 {
     AJ_Status status = AJ_OK;
@@ -76,6 +90,9 @@ AJ_Status OnControlInterfaceOnMethodHandler(AJ_Message* msg, const char* objPath
             ErrorCode errorCode = NOT_ERROR;
             AJ_Message reply;
             status = lt->OnSwitchOn(objPath, &errorCode);
+            if (CdmIsReplyDeferred()) {
+                break;
+            }
 
             if (status == AJ_OK) {
                 AJ_MarshalReplyMsg(msg, &reply);
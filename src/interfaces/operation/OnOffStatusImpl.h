@@ -23,6 +23,8 @@ const char* const intfDescOperationOnOffStatus[4];
 
 AJ_Status CreateOnOffStatusInterface(void** properties);
 void DestroyOnOffStatusInterface(void* properties);
+AJ_Status OnOffStatusInterfaceSaveProperties(void* properties, CdmSnapshotWriter* writer);
+AJ_Status OnOffStatusInterfaceLoadProperties(void* properties, CdmSnapshotReader* reader);
 AJ_Status OnOffStatusInterfaceOnGetProperty(AJ_Message* replyMsg, const char* objPath, void* properties, uint8_t memberIndex, void* listener);
 
 #endif /* ONOFFSTATUSLIMPL_H_ */
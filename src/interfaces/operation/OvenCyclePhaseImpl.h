@@ -23,6 +23,8 @@ const char* const intfDescOperationOvenCyclePhase[6];
 
 AJ_Status CreateOvenCyclePhaseInterface(void** properties);
 void DestroyOvenCyclePhaseInterface(void* properties);
+AJ_Status OvenCyclePhaseInterfaceSaveProperties(void* properties, CdmSnapshotWriter* writer);
+AJ_Status OvenCyclePhaseInterfaceLoadProperties(void* properties, CdmSnapshotReader* reader);
 AJ_Status OvenCyclePhaseInterfaceOnGetProperty(AJ_Message* replyMsg, const char* objPath, void* properties, uint8_t memberIndex, void* listener);
 AJ_Status OvenCyclePhaseInterfaceOnMethodHandler(AJ_Message* msg, const char* objPath, uint8_t memberIndex, void* listener, CdmPropertiesChangedByMethod* propChangedByMethod);
 
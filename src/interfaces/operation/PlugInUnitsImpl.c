@@ -17,6 +17,7 @@
 #include <string.h>
 #include <ajtcl/cdm/interfaces/operation/PlugInUnits.h>
 #include "../../CdmControllee/CdmControlleeImpl.h"
+#include "../CdmArrayBufferImpl.h"
 #include "PlugInUnitsImpl.h"
 
 #define INTERFACE_VERSION 1
@@ -31,9 +32,77 @@ const char* const intfDescOperationPlugInUnits[4] = {
 typedef struct {
     uint16_t version;
     PlugInInfo* units;
+    size_t plugInUnitsSize;
+    size_t unitsCapacity;
+    uint32_t unitsRevision; //changed whenever units are changed, to tell if a borrowed list is stale
 } PlugInUnitsProperties;
 
-static size_t plugInUnitsSize = 0;
+static bool IsSameUnit(const PlugInInfo* unit, const PlugInInfo* other)
+{
+    return unit->deviceId == other->deviceId && !unit->pluggedIn == !other->pluggedIn &&
+           !strcmp(unit->objectPath, other->objectPath);
+}
+
+/*
+ * PlugInInfo holds an object path pointer, so units are compared one by one rather than with memcmp.
+ * The stored object path strings are kept where they are unchanged.
+ */
+static AJ_Status AssignUnits(PlugInUnitsProperties* props, const PlugInInfo* units, size_t num, bool* changed)
+{
+    AJ_Status status = AJ_OK;
+    size_t kept = 0;
+    size_t i = 0;
+    size_t j = 0;
+
+    *changed = false;
+
+    if (props->units && props->plugInUnitsSize == num) {
+        while (i < num && IsSameUnit(&props->units[i], &units[i])) {
+            i++;
+        }
+        if (i == num) {
+            return AJ_OK;
+        }
+    }
+
+    status = CdmArrayBufferReserve((void**)&props->units, &props->unitsCapacity, sizeof(PlugInInfo), num);
+    if (status != AJ_OK) {
+        return status;
+    }
+
+    for (i = num; i < props->plugInUnitsSize; i++) {
+        free(props->units[i].objectPath);
+    }
+    kept = (props->plugInUnitsSize < num) ? props->plugInUnitsSize : num;
+    *changed = true;
+
+    for (i = 0; i < num; i++) {
+        char* objectPath = (i < kept) ? props->units[i].objectPath : NULL;
+
+        if (!objectPath || strcmp(objectPath, units[i].objectPath)) {
+            size_t len = strlen(units[i].objectPath);
+
+            free(objectPath);
+            objectPath = (char*)malloc(len + 1);
+            if (!objectPath) {
+                for (j = i + 1; j < kept; j++) {
+                    free(props->units[j].objectPath);
+                }
+                props->plugInUnitsSize = i;
+                props->unitsRevision++;
+                return AJ_ERR_RESOURCES;
+            }
+            memcpy(objectPath, units[i].objectPath, len + 1);
+        }
+        props->units[i].objectPath = objectPath;
+        props->units[i].deviceId = units[i].deviceId;
+        props->units[i].pluggedIn = units[i].pluggedIn;
+    }
+    props->plugInUnitsSize = num;
+    props->unitsRevision++;
+
+    return AJ_OK;
+}
 
 AJ_Status CreatePlugInUnitsInterface(void** properties)
 {
@@ -55,7 +124,7 @@ void DestroyPlugInUnitsInterface(void* properties)
         PlugInUnitsProperties* props = (PlugInUnitsProperties*)properties;
         if (props->units) {
             int i = 0;
-            for (i = 0; i < plugInUnitsSize; i++) {
+            for (i = 0; i < props->plugInUnitsSize; i++) {
                 free((props->units)[i].objectPath);
             }
             free(props->units);
@@ -64,10 +133,86 @@ void DestroyPlugInUnitsInterface(void* properties)
     }
 }
 
+AJ_Status PlugInUnitsInterfaceSaveProperties(void* properties, CdmSnapshotWriter* writer)
+{
+    AJ_Status status = AJ_OK;
+    PlugInUnitsProperties* props = (PlugInUnitsProperties*)properties;
+    uint32_t num = props->units ? (uint32_t)props->plugInUnitsSize : 0;
+    uint32_t i = 0;
+
+    status = CdmSnapshotWrite(writer, &num, sizeof(num));
+    for (i = 0; status == AJ_OK && i < num; i++) {
+        status = CdmSnapshotWrite(writer, &props->units[i].deviceId, sizeof(props->units[i].deviceId));
+        if (status == AJ_OK) {
+            status = CdmSnapshotWrite(writer, &props->units[i].pluggedIn, sizeof(props->units[i].pluggedIn));
+        }
+        if (status == AJ_OK) {
+            status = CdmSnapshotWriteString(writer, props->units[i].objectPath);
+        }
+    }
+
+    return status;
+}
+
+AJ_Status PlugInUnitsInterfaceLoadProperties(void* properties, CdmSnapshotReader* reader)
+{
+    AJ_Status status = AJ_OK;
+    PlugInUnitsProperties* props = (PlugInUnitsProperties*)properties;
+    uint32_t num = 0;
+    uint32_t i = 0;
+    PlugInInfo* units = NULL;
+    bool changed = false;
+
+    status = CdmSnapshotRead(reader, &num, sizeof(num));
+    if (status != AJ_OK) {
+        return status;
+    }
+    // Each record is at least a deviceId, a pluggedIn flag and a string length
+    if (num > (reader->size - reader->offset) / (sizeof(uint32_t) + sizeof(bool) + sizeof(uint32_t))) {
+        return AJ_ERR_END_OF_DATA;
+    }
+
+    if (num) {
+        units = (PlugInInfo*)malloc(sizeof(PlugInInfo) * num);
+        if (!units) {
+            return AJ_ERR_RESOURCES;
+        }
+    }
+    for (i = 0; i < num; i++) {
+        status = CdmSnapshotRead(reader, &units[i].deviceId, sizeof(units[i].deviceId));
+        if (status == AJ_OK) {
+            status = CdmSnapshotRead(reader, &units[i].pluggedIn, sizeof(units[i].pluggedIn));
+        }
+        if (status == AJ_OK) {
+            status = CdmSnapshotReadString(reader, &units[i].objectPath);
+        }
+        if (status != AJ_OK) {
+            break;
+        }
+    }
+    if (status != AJ_OK) {
+        while (i > 0) {
+            i--;
+            free(units[i].objectPath);
+        }
+        free(units);
+        return status;
+    }
+
+    status = AssignUnits(props, units, num, &changed);
+    for (i = 0; i < num; i++) {
+        free(units[i].objectPath);
+    }
+    free(units);
+
+    return status;
+}
+
 static AJ_Status EmitPropChanged(AJ_BusAttachment* busAttachment, const char* objPath, const char* propName, const char* signature, void* val)
 {
     AJ_Status status = AJ_OK;
     uint32_t msgId = 0;
+    CdmPropChangedTarget target = { 0, 0, 0 };
     AJ_Message msg;
     AJ_Arg array, strc;
 
@@ -76,22 +221,23 @@ static AJ_Status EmitPropChanged(AJ_BusAttachment* busAttachment, const char* ob
     }
 
     status = MakePropChangedId(objPath, &msgId);
-    if (status == AJ_OK) {
-        AJ_MarshalSignal(busAttachment, &msg, msgId, NULL, 0, AJ_FLAG_GLOBAL_BROADCAST, 0);
+    while (status == AJ_OK && CdmNextPropChangedTarget(msgId, &target)) {
+        AJ_MarshalSignal(busAttachment, &msg, msgId, NULL, target.sessionId, target.flags, 0);
         AJ_MarshalArgs(&msg, "s", intfDescOperationPlugInUnits[0]+1); //To remove '$'
         AJ_MarshalContainer(&msg, &array, AJ_ARG_ARRAY);
         AJ_MarshalContainer(&msg, &strc, AJ_ARG_DICT_ENTRY);
         if (!strcmp(signature, "y")) {
             AJ_MarshalArgs(&msg, "sv", propName, signature, *(uint8_t*)val);
         } else if (!strcmp(signature, "a(oub)")) {
-            PlugInInfo* plugInInfo = (PlugInInfo*)val;
+            PlugInUnitsProperties* props = (PlugInUnitsProperties*)val;
+            PlugInInfo* plugInInfo = props->units;
             AJ_Arg array2, strc2;
             int i = 0;
 
             AJ_MarshalArgs(&msg, "s", propName);
             AJ_MarshalVariant(&msg, signature);
             AJ_MarshalContainer(&msg, &array2, AJ_ARG_ARRAY);
-            for (i = 0; i < plugInUnitsSize; i++) {
+            for (i = 0; i < props->plugInUnitsSize; i++) {
                 AJ_MarshalContainer(&msg, &strc2, AJ_ARG_STRUCT);
                 AJ_MarshalArgs(&msg, "oub", plugInInfo[i].objectPath,
                                             plugInInfo[i].deviceId,
@@ -133,36 +279,26 @@ AJ_Status PlugInUnitsInterfaceOnGetProperty(AJ_Message* replyMsg, const char* ob
         break;
     case 1 :
         {
-            PlugInInfo* units = (PlugInInfo*)malloc(sizeof(PlugInInfo) * plugInUnitsSize);
+            bool changed = false;
 
+            if (!props->units) {
+                return AJ_ERR_NULL;
+            }
             if (lt && lt->OnGetPlugInUnits) {
+                PlugInInfo* units = (PlugInInfo*)CdmArrayBufferScratch(sizeof(PlugInInfo), props->plugInUnitsSize);
+                if (!units) {
+                    return AJ_ERR_RESOURCES;
+                }
                 status = lt->OnGetPlugInUnits(objPath, units);
-                if (status == AJ_OK) {
-                    if (props->units) {
-                        int i = 0;
-                        for (i = 0; i < plugInUnitsSize; i++) {
-                            free((props->units)[i].objectPath);
-                        }
-                        free(props->units);
-                    }
-                    props->units = (PlugInInfo*)malloc(sizeof(PlugInInfo) * plugInUnitsSize);
-                    memcpy(props->units, units, sizeof(PlugInInfo) * plugInUnitsSize);
-                    int i = 0;
-                    for (i = 0; i < plugInUnitsSize; i++) {
-                        (props->units)[i].objectPath= (char*)malloc(strlen(units[i].objectPath) + 1);
-                        strncpy((props->units)[i].objectPath, units[i].objectPath, strlen(units[i].objectPath));
-                        ((props->units)[i].objectPath)[strlen(units[i].objectPath)] = '\0';
-                    }
+                if (status == AJ_OK && !CdmIsReplyDeferred()) {
+                    CdmMarkValuePulled();
+                    AssignUnits(props, units, props->plugInUnitsSize, &changed);
                 }
             }
-            if (!props->units) {
-                free(units);
-                return AJ_ERR_NULL;
-            }
             AJ_Arg array, strc;
             AJ_MarshalContainer(replyMsg, &array, AJ_ARG_ARRAY);
             int i = 0;
-            for (i = 0; i < plugInUnitsSize; i++) {
+            for (i = 0; i < props->plugInUnitsSize; i++) {
                 AJ_MarshalContainer(replyMsg, &strc, AJ_ARG_STRUCT);
                 status = AJ_MarshalArgs(replyMsg, "oub",  (props->units)[i].objectPath,
                                                             (props->units)[i].deviceId,
@@ -170,9 +306,6 @@ AJ_Status PlugInUnitsInterfaceOnGetProperty(AJ_Message* replyMsg, const char* ob
                 AJ_MarshalCloseContainer(replyMsg, &strc);
             }
             AJ_MarshalCloseContainer(replyMsg, &array);
-
-            free(units);
-
         }
         break;
     default:
@@ -198,7 +331,7 @@ AJ_Status Cdm_PlugInUnitsInterfaceGetPlugInUnits(const char* objPath, PlugInInfo
             return AJ_ERR_NULL;
         }
 
-        memcpy(units, props->units, sizeof(PlugInInfo) * plugInUnitsSize);
+        memcpy(units, props->units, sizeof(PlugInInfo) * props->plugInUnitsSize);
 
     } else {
         status = AJ_ERR_NO_MATCH;
@@ -207,6 +340,31 @@ AJ_Status Cdm_PlugInUnitsInterfaceGetPlugInUnits(const char* objPath, PlugInInfo
     return status;
 }
 
+AJ_Status Cdm_PlugInUnitsInterfaceBorrowPlugInUnits(const char* objPath, const PlugInInfo** units, size_t* plugInInfoSize, uint32_t* revision)
+{
+    PlugInUnitsProperties* props = NULL;
+
+    if (!units || !plugInInfoSize) {
+        return AJ_ERR_INVALID;
+    }
+
+    props = (PlugInUnitsProperties*)GetProperties(objPath, PLUG_IN_UNITS_INTERFACE);
+    if (!props) {
+        return AJ_ERR_NO_MATCH;
+    }
+
+    if (!props->units) {
+        return AJ_ERR_NULL;
+    }
+    *units = props->units;
+    *plugInInfoSize = props->plugInUnitsSize;
+    if (revision) {
+        *revision = props->unitsRevision;
+    }
+
+    return AJ_OK;
+}
+
 AJ_Status Cdm_PlugInUnitsInterfaceSetPlugInUnits(AJ_BusAttachment* busAttachment, const char* objPath, const PlugInInfo* units, const size_t plugInInfoSize)
 {
     AJ_Status status = AJ_OK;
@@ -222,25 +380,12 @@ AJ_Status Cdm_PlugInUnitsInterfaceSetPlugInUnits(AJ_BusAttachment* busAttachment
 
     props = (PlugInUnitsProperties*)GetProperties(objPath, PLUG_IN_UNITS_INTERFACE);
     if (props) {
-        if (props->units) {
-            int i = 0;
-            for (i = 0; i < plugInUnitsSize; i++) {
-                free((props->units)[i].objectPath);
-            }
-            free(props->units);
-        }
-        plugInUnitsSize = plugInInfoSize;
-        props->units = (PlugInInfo*)malloc(sizeof(PlugInInfo) * plugInUnitsSize);
-
-        memcpy(props->units, units, sizeof(PlugInInfo) * plugInUnitsSize);
-        int i = 0;
-        for (i = 0; i < plugInUnitsSize; i++) {
-            (props->units)[i].objectPath= (char*)malloc(strlen(units[i].objectPath) + 1);
-            strncpy((props->units)[i].objectPath, units[i].objectPath, strlen(units[i].objectPath));
-            ((props->units)[i].objectPath)[strlen(units[i].objectPath)] = '\0';
-        }
+        bool changed = false;
 
-        status = EmitPropChanged(busAttachment, objPath, "PlugInUnits", "a(oub)", props->units);
+        status = AssignUnits(props, units, plugInInfoSize, &changed);
+        if (status == AJ_OK && changed) {
+            status = EmitPropChanged(busAttachment, objPath, "PlugInUnits", "a(oub)", props);
+        }
     } else {
         status = AJ_ERR_NO_MATCH;
     }
@@ -23,5 +23,7 @@ const char* const intfDescOperationPlugInUnits[4];
 
 AJ_Status CreatePlugInUnitsInterface(void** properties);
 void DestroyPlugInUnitsInterface(void* properties);
+AJ_Status PlugInUnitsInterfaceSaveProperties(void* properties, CdmSnapshotWriter* writer);
+AJ_Status PlugInUnitsInterfaceLoadProperties(void* properties, CdmSnapshotReader* reader);
 AJ_Status PlugInUnitsInterfaceOnGetProperty(AJ_Message* replyMsg, const char* objPath, void* properties, uint8_t memberIndex, void* listener);
 #endif /* PLUGINUNITSIMPL_H_ */
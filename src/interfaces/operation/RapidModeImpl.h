@@ -23,6 +23,8 @@ const char* const intfDescOperationRapidMode[4];
 
 AJ_Status CreateRapidModeInterface(void** properties);
 void DestroyRapidModeInterface(void* properties);
+AJ_Status RapidModeInterfaceSaveProperties(void* properties, CdmSnapshotWriter* writer);
+AJ_Status RapidModeInterfaceLoadProperties(void* properties, CdmSnapshotReader* reader);
 AJ_Status RapidModeInterfaceOnGetProperty(AJ_Message* replyMsg, const char* objPath, void* properties, uint8_t memberIndex, void* listener);
 AJ_Status RapidModeInterfaceOnSetProperty(AJ_Message* replyMsg, const char* objPath, void* properties, uint8_t memberIndex, void* listener, bool* propChanged);
 AJ_Status RapidModeInterfaceEmitPropertiesChanged(AJ_BusAttachment* busAttachment, const char* objPath, void* properties, uint8_t memberIndex);
@@ -14,11 +14,14 @@
  *    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
  ******************************************************************************/
 
+#include <stddef.h>
 #include <ajtcl/cdm/interfaces/operation/RapidModeTimed.h>
 #include "../../CdmControllee/CdmControlleeImpl.h"
+#include "../CdmTimerWheelImpl.h"
 #include "RapidModeTimedImpl.h"
 
 #define INTERFACE_VERSION 1
+#define COUNTDOWN_PERIOD (60 * 1000)
 
 const char* const intfDescOperationRapidModeTimed[] = {
     "$org.alljoyn.SmartSpaces.Operation.RapidModeTimed",
@@ -33,8 +36,26 @@ typedef struct {
     uint16_t rapidModeMinutesRemaining;
     uint16_t maxSetMinutes;
     bool maxSetMinutesInit;
+    //countdown state, which is not saved to snapshots
+    bool countdownEnabled;
+    const char* objPath;
+    RapidModeTimedExpiredHandler handler;
+    CdmTimer countdownTimer;
 } RapidModeTimedProperties;
 
+static void UpdateCountdown(RapidModeTimedProperties* props)
+{
+    if (!props->countdownEnabled) {
+        return;
+    }
+
+    if (props->rapidModeMinutesRemaining) {
+        Cdm_TimerWheelSchedule(&props->countdownTimer, COUNTDOWN_PERIOD, COUNTDOWN_PERIOD);
+    } else {
+        Cdm_TimerWheelCancel(&props->countdownTimer);
+    }
+}
+
 AJ_Status RapidModeTimedCheckRapidModeMinutesRemainingForValidation(const char* objPath, uint16_t value)
 {
     AJ_Status status = AJ_OK;
@@ -71,14 +92,30 @@ void DestroyRapidModeTimedInterface(void* properties)
     if (properties) {
         RapidModeTimedProperties* props = (RapidModeTimedProperties*)properties;
 
+        Cdm_TimerWheelCancel(&props->countdownTimer);
         free(props);
     }
 }
 
+AJ_Status RapidModeTimedInterfaceSaveProperties(void* properties, CdmSnapshotWriter* writer)
+{
+    return CdmSnapshotWrite(writer, properties, offsetof(RapidModeTimedProperties, countdownEnabled));
+}
+
+AJ_Status RapidModeTimedInterfaceLoadProperties(void* properties, CdmSnapshotReader* reader)
+{
+    if (reader->size != offsetof(RapidModeTimedProperties, countdownEnabled)) {
+        return AJ_ERR_INVALID;
+    }
+
+    return CdmSnapshotRead(reader, properties, offsetof(RapidModeTimedProperties, countdownEnabled));
+}
+
 static AJ_Status EmitPropChanged(AJ_BusAttachment* busAttachment, const char* objPath, const char* propName, const char* signature, void* val)
 {
     AJ_Status status = AJ_OK;
     uint32_t msgId = 0;
+    CdmPropChangedTarget target = { 0, 0, 0 };
     AJ_Message msg;
     AJ_Arg array, strc;
 
@@ -87,8 +124,8 @@ static AJ_Status EmitPropChanged(AJ_BusAttachment* busAttachment, const char* ob
     }
 
     status = MakePropChangedId(objPath, &msgId);
-    if (status == AJ_OK) {
-        AJ_MarshalSignal(busAttachment, &msg, msgId, NULL, 0, AJ_FLAG_GLOBAL_BROADCAST, 0);
+    while (status == AJ_OK && CdmNextPropChangedTarget(msgId, &target)) {
+        AJ_MarshalSignal(busAttachment, &msg, msgId, NULL, target.sessionId, target.flags, 0);
         AJ_MarshalArgs(&msg, "s", intfDescOperationRapidModeTimed[0]+1); //To remove '$'
         AJ_MarshalContainer(&msg, &array, AJ_ARG_ARRAY);
         AJ_MarshalContainer(&msg, &strc, AJ_ARG_DICT_ENTRY);
@@ -107,6 +144,23 @@ static AJ_Status EmitPropChanged(AJ_BusAttachment* busAttachment, const char* ob
     return status;
 }
 
+static void CountdownTimerExpired(AJ_BusAttachment* busAttachment, CdmTimer* timer, void* context)
+{
+    RapidModeTimedProperties* props = (RapidModeTimedProperties*)context;
+
+    if (props->rapidModeMinutesRemaining) {
+        props->rapidModeMinutesRemaining--;
+        EmitPropChanged(busAttachment, props->objPath, "RapidModeMinutesRemaining", "q", &(props->rapidModeMinutesRemaining));
+    }
+
+    if (!props->rapidModeMinutesRemaining) {
+        Cdm_TimerWheelCancel(timer);
+        if (props->handler) {
+            props->handler(busAttachment, props->objPath);
+        }
+    }
+}
+
 AJ_Status RapidModeTimedInterfaceEmitPropertiesChanged(AJ_BusAttachment* busAttachment, const char* objPath, void* properties, uint8_t memberIndex)
 {
     AJ_Status status = AJ_OK;
@@ -153,7 +207,8 @@ AJ_Status RapidModeTimedInterfaceOnGetProperty(AJ_Message* replyMsg, const char*
             uint16_t value;
             if (lt && lt->OnGetRapidModeMinutesRemaining) {
                 status = lt->OnGetRapidModeMinutesRemaining(objPath, &value);
-                if (status == AJ_OK) {
+                if (status == AJ_OK && !CdmIsReplyDeferred()) {
+                    CdmMarkValuePulled();
                     props->rapidModeMinutesRemaining = value;
                 }
             }
@@ -165,7 +220,8 @@ AJ_Status RapidModeTimedInterfaceOnGetProperty(AJ_Message* replyMsg, const char*
             uint16_t value;
             if (lt && lt->OnGetMaxSetMinutes) {
                 status = lt->OnGetMaxSetMinutes(objPath, &value);
-                if (status == AJ_OK) {
+                if (status == AJ_OK && !CdmIsReplyDeferred()) {
+                    CdmMarkValuePulled();
                     props->maxSetMinutes = value;
                 }
             }
@@ -216,6 +272,7 @@ AJ_Status RapidModeTimedInterfaceOnSetProperty(AJ_Message* replyMsg, const char*
                     if (props->rapidModeMinutesRemaining != value) {
                         props->rapidModeMinutesRemaining = value;
                         *propChanged = true;
+                        UpdateCountdown(props);
                     }
                 }
             }
@@ -271,6 +328,7 @@ AJ_Status Cdm_RapidModeTimedInterfaceSetRapidModeMinutesRemaining(AJ_BusAttachme
             props->rapidModeMinutesRemaining = value;
 
             status = EmitPropChanged(busAttachment, objPath, "RapidModeMinutesRemaining", "q", &(props->rapidModeMinutesRemaining));
+            UpdateCountdown(props);
         }
     } else {
         status = AJ_ERR_NO_MATCH;
@@ -321,3 +379,21 @@ AJ_Status Cdm_RapidModeTimedInterfaceSetMaxSetMinutes(AJ_BusAttachment* busAttac
 
     return status;
 }
+
+AJ_Status Cdm_RapidModeTimedInterfaceEnableCountdown(const char* objPath, RapidModeTimedExpiredHandler handler)
+{
+    RapidModeTimedProperties* props = NULL;
+
+    props = (RapidModeTimedProperties*)GetProperties(objPath, RAPID_MODE_TIMED_INTERFACE);
+    if (!props) {
+        return AJ_ERR_NO_MATCH;
+    }
+
+    props->countdownEnabled = true;
+    props->objPath = objPath;
+    props->handler = handler;
+    Cdm_TimerWheelInitTimer(&props->countdownTimer, CountdownTimerExpired, props);
+    UpdateCountdown(props);
+
+    return AJ_OK;
+}
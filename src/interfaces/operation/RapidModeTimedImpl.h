@@ -23,6 +23,8 @@ const char* const intfDescOperationRapidModeTimed[5];
 
 AJ_Status CreateRapidModeTimedInterface(void** properties);
 void DestroyRapidModeTimedInterface(void* properties);
+AJ_Status RapidModeTimedInterfaceSaveProperties(void* properties, CdmSnapshotWriter* writer);
+AJ_Status RapidModeTimedInterfaceLoadProperties(void* properties, CdmSnapshotReader* reader);
 AJ_Status RapidModeTimedInterfaceOnGetProperty(AJ_Message* replyMsg, const char* objPath, void* properties, uint8_t memberIndex, void* listener);
 AJ_Status RapidModeTimedInterfaceOnSetProperty(AJ_Message* replyMsg, const char* objPath, void* properties, uint8_t memberIndex, void* listener, bool* propChanged);
 AJ_Status RapidModeTimedInterfaceEmitPropertiesChanged(AJ_BusAttachment* busAttachment, const char* objPath, void* properties, uint8_t memberIndex);
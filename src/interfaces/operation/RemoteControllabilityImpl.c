@@ -41,6 +41,7 @@ AJ_Status CreateRemoteControllabilityInterface(void** properties)
     memset(*properties, 0, sizeof(RemoteControllabilityProperties));
 
     ((RemoteControllabilityProperties*)*properties)->version = (uint16_t)INTERFACE_VERSION;
+    ((RemoteControllabilityProperties*)*properties)->isControllable = true;
 
     return AJ_OK;
 }
@@ -54,10 +55,25 @@ void DestroyRemoteControllabilityInterface(void* properties)
     }
 }
 
+AJ_Status RemoteControllabilityInterfaceSaveProperties(void* properties, CdmSnapshotWriter* writer)
+{
+    return CdmSnapshotWrite(writer, properties, sizeof(RemoteControllabilityProperties));
+}
+
+AJ_Status RemoteControllabilityInterfaceLoadProperties(void* properties, CdmSnapshotReader* reader)
+{
+    if (reader->size != sizeof(RemoteControllabilityProperties)) {
+        return AJ_ERR_INVALID;
+    }
+
+    return CdmSnapshotRead(reader, properties, sizeof(RemoteControllabilityProperties));
+}
+
 static AJ_Status EmitPropChanged(AJ_BusAttachment* busAttachment, const char* objPath, const char* propName, const char* signature, void* val)
 {
     AJ_Status status = AJ_OK;
     uint32_t msgId = 0;
+    CdmPropChangedTarget target = { 0, 0, 0 };
     AJ_Message msg;
     AJ_Arg array, strc;
 
@@ -66,8 +82,8 @@ static AJ_Status EmitPropChanged(AJ_BusAttachment* busAttachment, const char* ob
     }
 
     status = MakePropChangedId(objPath, &msgId);
-    if (status == AJ_OK) {
-        AJ_MarshalSignal(busAttachment, &msg, msgId, NULL, 0, AJ_FLAG_GLOBAL_BROADCAST, 0);
+    while (status == AJ_OK && CdmNextPropChangedTarget(msgId, &target)) {
+        AJ_MarshalSignal(busAttachment, &msg, msgId, NULL, target.sessionId, target.flags, 0);
         AJ_MarshalArgs(&msg, "s", intfDescOperationRemoteControllability[0]+1); //To remove '$'
         AJ_MarshalContainer(&msg, &array, AJ_ARG_ARRAY);
         AJ_MarshalContainer(&msg, &strc, AJ_ARG_DICT_ENTRY);
@@ -86,6 +102,11 @@ static AJ_Status EmitPropChanged(AJ_BusAttachment* busAttachment, const char* ob
     return status;
 }
 
+bool RemoteControllabilityInterfaceIsControllable(const void* properties)
+{
+    return ((const RemoteControllabilityProperties*)properties)->isControllable;
+}
+
 AJ_Status RemoteControllabilityInterfaceOnGetProperty(AJ_Message* replyMsg, const char* objPath, void* properties, uint8_t memberIndex, void* listener)
 {
     AJ_Status status = AJ_OK;
@@ -110,7 +131,8 @@ AJ_Status RemoteControllabilityInterfaceOnGetProperty(AJ_Message* replyMsg, cons
             bool isControllable;
             if (lt && lt->OnGetIsControllable) {
                 status = lt->OnGetIsControllable(objPath, &isControllable);
-                if (status == AJ_OK) {
+                if (status == AJ_OK && !CdmIsReplyDeferred()) {
+                    CdmMarkValuePulled();
                     props->isControllable = isControllable;
                 }
             }
@@ -23,6 +23,9 @@ const char* const intfDescOperationRemoteControllability[4];
 
 AJ_Status CreateRemoteControllabilityInterface(void** properties);
 void DestroyRemoteControllabilityInterface(void* properties);
+AJ_Status RemoteControllabilityInterfaceSaveProperties(void* properties, CdmSnapshotWriter* writer);
+AJ_Status RemoteControllabilityInterfaceLoadProperties(void* properties, CdmSnapshotReader* reader);
+bool RemoteControllabilityInterfaceIsControllable(const void* properties);
 AJ_Status RemoteControllabilityInterfaceOnGetProperty(AJ_Message* replyMsg, const char* objPath, void* properties, uint8_t memberIndex, void* listener);
 
 #endif // REMOTECONTROLLABILITYIMPL_H_
@@ -23,6 +23,8 @@ const char* const intfDescOperationRepeatMode[4];
 
 AJ_Status CreateRepeatModeInterface(void** properties);
 void DestroyRepeatModeInterface(void* properties);
+AJ_Status RepeatModeInterfaceSaveProperties(void* properties, CdmSnapshotWriter* writer);
+AJ_Status RepeatModeInterfaceLoadProperties(void* properties, CdmSnapshotReader* reader);
 AJ_Status RepeatModeInterfaceOnGetProperty(AJ_Message* replyMsg, const char* objPath, void* properties, uint8_t memberIndex, void* listener);
 AJ_Status RepeatModeInterfaceOnSetProperty(AJ_Message* replyMsg, const char* objPath, void* properties, uint8_t memberIndex, void* listener, bool* propChanged);
 AJ_Status RepeatModeInterfaceEmitPropertiesChanged(AJ_BusAttachment* busAttachment, const char* objPath, void* properties, uint8_t memberIndex);
@@ -23,6 +23,8 @@ const char* const intfDescOperationResourceSaving[4];
 
 AJ_Status CreateResourceSavingInterface(void** properties);
 void DestroyResourceSavingInterface(void* properties);
+AJ_Status ResourceSavingInterfaceSaveProperties(void* properties, CdmSnapshotWriter* writer);
+AJ_Status ResourceSavingInterfaceLoadProperties(void* properties, CdmSnapshotReader* reader);
 AJ_Status ResourceSavingInterfaceOnGetProperty(AJ_Message* replyMsg, const char* objPath, void* properties, uint8_t memberIndex, void* listener);
 AJ_Status ResourceSavingInterfaceOnSetProperty(AJ_Message* replyMsg, const char* objPath, void* properties, uint8_t memberIndex, void* listener, bool* propChanged);
 AJ_Status ResourceSavingInterfaceEmitPropertiesChanged(AJ_BusAttachment* busAttachment, const char* objPath, void* properties, uint8_t memberIndex);
@@ -23,6 +23,8 @@ const char* const intfDescOperationRobotCleaningCyclePhase[6];
 
 AJ_Status CreateRobotCleaningCyclePhaseInterface(void** properties);
 void DestroyRobotCleaningCyclePhaseInterface(void* properties);
+AJ_Status RobotCleaningCyclePhaseInterfaceSaveProperties(void* properties, CdmSnapshotWriter* writer);
+AJ_Status RobotCleaningCyclePhaseInterfaceLoadProperties(void* properties, CdmSnapshotReader* reader);
 AJ_Status RobotCleaningCyclePhaseInterfaceOnGetProperty(AJ_Message* replyMsg, const char* objPath, void* properties, uint8_t memberIndex, void* listener);
 AJ_Status RobotCleaningCyclePhaseInterfaceOnMethodHandler(AJ_Message* msg, const char* objPath, uint8_t memberIndex, void* listener, CdmPropertiesChangedByMethod* propChangedByMethod);
 
@@ -23,6 +23,8 @@ const char* const intfDescOperationSoilLevel[6];
 
 AJ_Status CreateSoilLevelInterface(void** properties);
 void DestroySoilLevelInterface(void* properties);
+AJ_Status SoilLevelInterfaceSaveProperties(void* properties, CdmSnapshotWriter* writer);
+AJ_Status SoilLevelInterfaceLoadProperties(void* properties, CdmSnapshotReader* reader);
 AJ_Status SoilLevelInterfaceOnGetProperty(AJ_Message* replyMsg, const char* objPath, void* properties, uint8_t memberIndex, void* listener);
 AJ_Status SoilLevelInterfaceOnSetProperty(AJ_Message* replyMsg, const char* objPath, void* properties, uint8_t memberIndex, void* listener, bool* propChanged);
 AJ_Status SoilLevelInterfaceEmitPropertiesChanged(AJ_BusAttachment* busAttachment, const char* objPath, void* properties, uint8_t memberIndex);
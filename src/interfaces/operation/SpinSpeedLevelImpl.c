@@ -17,6 +17,7 @@
 #include <string.h>
 #include <ajtcl/cdm/interfaces/operation/SpinSpeedLevel.h>
 #include "../../CdmControllee/CdmControlleeImpl.h"
+#include "../CdmValueSetImpl.h"
 #include "SpinSpeedLevelImpl.h"
 
 #define INTERFACE_VERSION 1
@@ -36,6 +37,7 @@ typedef struct {
     uint8_t maxLevel;
     uint8_t targetLevel;
     uint8_t* selectableLevels;
+    CdmValueSet selectableLevelsSet;
 } SpinSpeedLevelProperties;
 
 static size_t listSize = 0;
@@ -47,23 +49,12 @@ AJ_Status SpinSpeedLevelTargetLevelValidationCheck(const char* objPath, uint8_t
     props = (SpinSpeedLevelProperties*)GetProperties(objPath, SPIN_SPEED_LEVEL_INTERFACE);
 
     if (props) {
-        int i = 0;
-        bool check = false;
-
         if (targetLevel > props->maxLevel) {
             status = AJ_ERR_RANGE;
         }
-        else {
-            for (i = 0; i < listSize; i++) {
-                if (props->selectableLevels[i] == targetLevel) {
-                    check = true;
-                    break;
-                }
-            }
-            if (!check) {
-                return AJ_ERR_RANGE;
-           }
-       }
+        else if (!CdmValueSetContains(&props->selectableLevelsSet, targetLevel)) {
+            return AJ_ERR_RANGE;
+        }
     } else {
         status = AJ_ERR_NO_MATCH;
     }
@@ -97,10 +88,60 @@ void DestroySpinSpeedLevelInterface(void* properties)
     }
 }
 
+AJ_Status SpinSpeedLevelInterfaceSaveProperties(void* properties, CdmSnapshotWriter* writer)
+{
+    AJ_Status status = AJ_OK;
+    SpinSpeedLevelProperties* props = (SpinSpeedLevelProperties*)properties;
+
+    status = CdmSnapshotWrite(writer, &props->maxLevel, sizeof(props->maxLevel));
+    if (status == AJ_OK) {
+        status = CdmSnapshotWrite(writer, &props->targetLevel, sizeof(props->targetLevel));
+    }
+    if (status == AJ_OK) {
+        status = CdmSnapshotWriteArray(writer, props->selectableLevels, sizeof(uint8_t), listSize);
+    }
+
+    return status;
+}
+
+AJ_Status SpinSpeedLevelInterfaceLoadProperties(void* properties, CdmSnapshotReader* reader)
+{
+    AJ_Status status = AJ_OK;
+    SpinSpeedLevelProperties* props = (SpinSpeedLevelProperties*)properties;
+    uint8_t maxLevel = 0;
+    uint8_t targetLevel = 0;
+    uint8_t* selectableLevels = NULL;
+    size_t selectableLevelsListSize = 0;
+
+    status = CdmSnapshotRead(reader, &maxLevel, sizeof(maxLevel));
+    if (status == AJ_OK) {
+        status = CdmSnapshotRead(reader, &targetLevel, sizeof(targetLevel));
+    }
+    if (status == AJ_OK) {
+        status = CdmSnapshotReadArray(reader, (void**)&selectableLevels, sizeof(uint8_t), &selectableLevelsListSize);
+    }
+    if (status != AJ_OK) {
+        free(selectableLevels);
+        return status;
+    }
+
+    props->maxLevel = maxLevel;
+    props->targetLevel = targetLevel;
+    if (props->selectableLevels) {
+        free(props->selectableLevels);
+    }
+    props->selectableLevels = selectableLevels;
+    listSize = selectableLevelsListSize;
+    CdmValueSetBuild(&props->selectableLevelsSet, props->selectableLevels, listSize);
+
+    return AJ_OK;
+}
+
 static AJ_Status EmitPropChanged(AJ_BusAttachment* busAttachment, const char* objPath, const char* propName, const char* signature, void* val)
 {
     AJ_Status status = AJ_OK;
     uint32_t msgId = 0;
+    CdmPropChangedTarget target = { 0, 0, 0 };
     AJ_Message msg;
     AJ_Arg array, strc;
 
@@ -109,8 +150,8 @@ static AJ_Status EmitPropChanged(AJ_BusAttachment* busAttachment, const char* ob
     }
 
     status = MakePropChangedId(objPath, &msgId);
-    if (status == AJ_OK) {
-        AJ_MarshalSignal(busAttachment, &msg, msgId, NULL, 0, AJ_FLAG_GLOBAL_BROADCAST, 0);
+    while (status == AJ_OK && CdmNextPropChangedTarget(msgId, &target)) {
+        AJ_MarshalSignal(busAttachment, &msg, msgId, NULL, target.sessionId, target.flags, 0);
         AJ_MarshalArgs(&msg, "s", intfDescOperationSpinSpeedLevel[0]+1); //To remove '$'
         AJ_MarshalContainer(&msg, &array, AJ_ARG_ARRAY);
         AJ_MarshalContainer(&msg, &strc, AJ_ARG_DICT_ENTRY);
@@ -177,7 +218,8 @@ AJ_Status SpinSpeedLevelInterfaceOnGetProperty(AJ_Message* replyMsg, const char*
             uint8_t maxLevel;
             if (lt && lt->OnGetMaxLevel) {
                 status = lt->OnGetMaxLevel(objPath, &maxLevel);
-                if (status == AJ_OK) {
+                if (status == AJ_OK && !CdmIsReplyDeferred()) {
+                    CdmMarkValuePulled();
                     props->maxLevel = maxLevel;
                 }
             }
@@ -189,7 +231,8 @@ AJ_Status SpinSpeedLevelInterfaceOnGetProperty(AJ_Message* replyMsg, const char*
             uint8_t targetLevel;
             if (lt && lt->OnGetTargetLevel) {
                 status = lt->OnGetTargetLevel(objPath, &targetLevel);
-                if (status == AJ_OK) {
+                if (status == AJ_OK && !CdmIsReplyDeferred()) {
+                    CdmMarkValuePulled();
                     props->targetLevel = targetLevel;
                 }
             }
@@ -201,13 +244,15 @@ AJ_Status SpinSpeedLevelInterfaceOnGetProperty(AJ_Message* replyMsg, const char*
             uint8_t* selectableLevels = (uint8_t*)malloc(sizeof(uint8_t) * listSize);
             if (lt && lt->OnGetSelectableLevels) {
                 status = lt->OnGetSelectableLevels(objPath, selectableLevels);
-                if (status == AJ_OK) {
+                if (status == AJ_OK && !CdmIsReplyDeferred()) {
+                    CdmMarkValuePulled();
                     if (props->selectableLevels) {
                         free(props->selectableLevels);
                     }
                     props->selectableLevels = (uint8_t*)malloc(sizeof(uint8_t) * listSize);
 
                     memcpy(props->selectableLevels, selectableLevels, sizeof(uint8_t) * listSize);
+                    CdmValueSetBuild(&props->selectableLevelsSet, props->selectableLevels, listSize);
                 }
             }
             if (!props->selectableLevels) {
@@ -422,6 +467,7 @@ AJ_Status Cdm_SpinSpeedLevelInterfaceSetSelectableLevels(AJ_BusAttachment* busAt
         props->selectableLevels = (uint8_t*)malloc(sizeof(uint8_t) * listSize);
 
         memcpy(props->selectableLevels, selectableLevels, sizeof(uint8_t) * listSize);
+        CdmValueSetBuild(&props->selectableLevelsSet, props->selectableLevels, listSize);
 
         status = EmitPropChanged(busAttachment, objPath, "SelectableLevels", "ay", props->selectableLevels);
     } else {
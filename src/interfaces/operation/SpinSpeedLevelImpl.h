@@ -23,6 +23,8 @@ const char* const intfDescOperationSpinSpeedLevel[6];
 
 AJ_Status CreateSpinSpeedLevelInterface(void** properties);
 void DestroySpinSpeedLevelInterface(void* properties);
+AJ_Status SpinSpeedLevelInterfaceSaveProperties(void* properties, CdmSnapshotWriter* writer);
+AJ_Status SpinSpeedLevelInterfaceLoadProperties(void* properties, CdmSnapshotReader* reader);
 AJ_Status SpinSpeedLevelInterfaceOnGetProperty(AJ_Message* replyMsg, const char* objPath, void* properties, uint8_t memberIndex, void* listener);
 AJ_Status SpinSpeedLevelInterfaceOnSetProperty(AJ_Message* replyMsg, const char* objPath, void* properties, uint8_t memberIndex, void* listener, bool* propChanged);
 AJ_Status SpinSpeedLevelInterfaceEmitPropertiesChanged(AJ_BusAttachment* busAttachment, const char* objPath, void* properties, uint8_t memberIndex);
@@ -17,9 +17,12 @@
 #include <string.h>
 #include <ajtcl/cdm/interfaces/operation/Timer.h>
 #include "../../CdmControllee/CdmControlleeImpl.h"
+#include "../CdmTimerWheelImpl.h"
 #include "TimerImpl.h"
 
 #define INTERFACE_VERSION 1
+#define NUMBER_OF_COUNTDOWN_PROPERTIES 4 //TargetTimeToStart, TargetTimeToStop, EstimatedTimeToEnd, RunningTime
+#define MAX_TARGET_TIME_CHUNK 86400 //seconds, target times are scheduled in chunks below the 2^31 ms limit of the timer wheel
 
 const char* const intfDescOperationTimer[11] = {
     "$org.alljoyn.SmartSpaces.Operation.Timer",
@@ -35,6 +38,26 @@ const char* const intfDescOperationTimer[11] = {
     NULL
 };
 
+typedef struct {
+    bool enabled;
+    const char* objPath;
+    uint16_t emitInterval;
+    TimerTargetTimeHandler handler;
+    uint32_t referenceEpoch; //clock time when ReferenceTimer was 0
+    bool running;
+    uint32_t runStart;
+    int32_t runningTimeBase;
+    bool endScheduled;
+    uint32_t endBase; //clock time when endSeconds was set
+    int32_t endSeconds;
+    CdmTimer startTimer;
+    int32_t startPending; //seconds left after the scheduled chunk
+    CdmTimer stopTimer;
+    int32_t stopPending;
+    CdmTimer emitTimer;
+    int32_t published[NUMBER_OF_COUNTDOWN_PROPERTIES];
+} TimerEngine;
+
 typedef struct {
     uint16_t version;
     int32_t referenceTimer;
@@ -43,8 +66,129 @@ typedef struct {
     int32_t estimatedTimeToEnd;
     int32_t runningTime;
     int32_t targetDuration;
+    TimerEngine engine;
 } TimerProperties;
 
+static const char* const countdownPropertyNames[NUMBER_OF_COUNTDOWN_PROPERTIES] = {
+    "TargetTimeToStart",
+    "TargetTimeToStop",
+    "EstimatedTimeToEnd",
+    "RunningTime"
+};
+
+static int32_t SecondsUntil(uint32_t deadline, uint32_t now)
+{
+    int32_t remaining = (int32_t)(deadline - now);
+
+    if (remaining <= 0) {
+        return 0;
+    }
+
+    return (remaining + 999) / 1000;
+}
+
+//Counts down whole seconds from base, which is moved forward so that it stays within the wrap of the ms clock
+static int32_t SecondsLeft(uint32_t* base, int32_t* seconds, uint32_t now)
+{
+    uint32_t elapsed = (now - *base) / 1000;
+
+    *base += elapsed * 1000;
+    *seconds = ((uint32_t)*seconds > elapsed) ? *seconds - (int32_t)elapsed : 0;
+
+    return *seconds;
+}
+
+static bool IsTimeValue(int32_t value)
+{
+    //TIMER_FEATURE_NOT_APPLIED and TIMER_NOT_SUPPORTED are negative
+    return value >= 0;
+}
+
+static void GetCountdownValues(const TimerProperties* props, int32_t* values)
+{
+    values[0] = props->targetTimeToStart;
+    values[1] = props->targetTimeToStop;
+    values[2] = props->estimatedTimeToEnd;
+    values[3] = props->runningTime;
+}
+
+static void UpdateTimerProperties(TimerProperties* props)
+{
+    TimerEngine* engine = &props->engine;
+    uint32_t now = 0;
+
+    if (!engine->enabled) {
+        return;
+    }
+
+    now = CdmTimerWheelNow();
+    props->referenceTimer = (int32_t)((now - engine->referenceEpoch) / 1000);
+    if (Cdm_TimerWheelIsScheduled(&engine->startTimer)) {
+        props->targetTimeToStart = SecondsUntil(engine->startTimer.expiry, now) + engine->startPending;
+    }
+    if (Cdm_TimerWheelIsScheduled(&engine->stopTimer)) {
+        props->targetTimeToStop = SecondsUntil(engine->stopTimer.expiry, now) + engine->stopPending;
+    }
+    if (engine->running) {
+        props->runningTime = engine->runningTimeBase + (int32_t)((now - engine->runStart) / 1000);
+        if (engine->endScheduled) {
+            props->estimatedTimeToEnd = SecondsLeft(&engine->endBase, &engine->endSeconds, now);
+        }
+    }
+}
+
+static void ScheduleTargetTime(CdmTimer* timer, int32_t* pending, int32_t value)
+{
+    if (value > 0) {
+        int32_t chunk = (value > MAX_TARGET_TIME_CHUNK) ? MAX_TARGET_TIME_CHUNK : value;
+
+        *pending = value - chunk;
+        Cdm_TimerWheelSchedule(timer, (uint32_t)chunk * 1000, 0);
+    } else {
+        *pending = 0;
+        Cdm_TimerWheelCancel(timer);
+    }
+}
+
+//Let the engine follow a value given by the application or a method call
+static void ApplyTimerValue(TimerProperties* props, uint8_t memberIndex)
+{
+    TimerEngine* engine = &props->engine;
+    uint32_t now = 0;
+
+    if (!engine->enabled) {
+        return;
+    }
+
+    now = CdmTimerWheelNow();
+    switch (memberIndex) {
+    case 1 :
+        engine->referenceEpoch = now - (uint32_t)props->referenceTimer * 1000;
+        break;
+    case 2 :
+        ScheduleTargetTime(&engine->startTimer, &engine->startPending, props->targetTimeToStart);
+        engine->published[0] = props->targetTimeToStart;
+        break;
+    case 3 :
+        ScheduleTargetTime(&engine->stopTimer, &engine->stopPending, props->targetTimeToStop);
+        engine->published[1] = props->targetTimeToStop;
+        break;
+    case 4 :
+        engine->endScheduled = IsTimeValue(props->estimatedTimeToEnd);
+        engine->endBase = now;
+        engine->endSeconds = props->estimatedTimeToEnd;
+        engine->published[2] = props->estimatedTimeToEnd;
+        break;
+    case 5 :
+        engine->runningTimeBase = props->runningTime;
+        engine->runStart = now;
+        engine->published[3] = props->runningTime;
+        break;
+    default:
+        break;
+    }
+}
+
 AJ_Status CreateTimerInterface(void** properties)
 {
     *properties = malloc(sizeof(TimerProperties));
@@ -63,14 +207,57 @@ void DestroyTimerInterface(void* properties)
     if (properties) {
         TimerProperties* props = (TimerProperties*)properties;
 
+        Cdm_TimerWheelCancel(&props->engine.startTimer);
+        Cdm_TimerWheelCancel(&props->engine.stopTimer);
+        Cdm_TimerWheelCancel(&props->engine.emitTimer);
         free(props);
     }
 }
 
+AJ_Status TimerInterfaceSaveProperties(void* properties, CdmSnapshotWriter* writer)
+{
+    TimerProperties* props = (TimerProperties*)properties;
+    int32_t values[6];
+
+    UpdateTimerProperties(props);
+    values[0] = props->referenceTimer;
+    values[1] = props->targetTimeToStart;
+    values[2] = props->targetTimeToStop;
+    values[3] = props->estimatedTimeToEnd;
+    values[4] = props->runningTime;
+    values[5] = props->targetDuration;
+
+    return CdmSnapshotWrite(writer, values, sizeof(values));
+}
+
+AJ_Status TimerInterfaceLoadProperties(void* properties, CdmSnapshotReader* reader)
+{
+    AJ_Status status = AJ_OK;
+    TimerProperties* props = (TimerProperties*)properties;
+    int32_t values[6];
+
+    if (reader->size != sizeof(values)) {
+        return AJ_ERR_INVALID;
+    }
+
+    status = CdmSnapshotRead(reader, values, sizeof(values));
+    if (status == AJ_OK) {
+        props->referenceTimer = values[0];
+        props->targetTimeToStart = values[1];
+        props->targetTimeToStop = values[2];
+        props->estimatedTimeToEnd = values[3];
+        props->runningTime = values[4];
+        props->targetDuration = values[5];
+    }
+
+    return status;
+}
+
 static AJ_Status EmitPropChanged(AJ_BusAttachment* busAttachment, const char* objPath, const char* propName, const char* signature, void* val)
 {
     AJ_Status status = AJ_OK;
     uint32_t msgId = 0;
+    CdmPropChangedTarget target = { 0, 0, 0 };
     AJ_Message msg;
     AJ_Arg array, strc;
 
@@ -79,8 +266,8 @@ static AJ_Status EmitPropChanged(AJ_BusAttachment* busAttachment, const char* ob
     }
 
     status = MakePropChangedId(objPath, &msgId);
-    if (status == AJ_OK) {
-        AJ_MarshalSignal(busAttachment, &msg, msgId, NULL, 0, AJ_FLAG_GLOBAL_BROADCAST, 0);
+    while (status == AJ_OK && CdmNextPropChangedTarget(msgId, &target)) {
+        AJ_MarshalSignal(busAttachment, &msg, msgId, NULL, target.sessionId, target.flags, 0);
         AJ_MarshalArgs(&msg, "s", intfDescOperationTimer[0]+1); //To remove '$'
         AJ_MarshalContainer(&msg, &array, AJ_ARG_ARRAY);
         AJ_MarshalContainer(&msg, &strc, AJ_ARG_DICT_ENTRY);
@@ -99,6 +286,120 @@ static AJ_Status EmitPropChanged(AJ_BusAttachment* busAttachment, const char* ob
     return status;
 }
 
+//Emit the countdown properties changed since the last emission in one signal
+static AJ_Status EmitCountdownPropertiesChanged(AJ_BusAttachment* busAttachment, TimerProperties* props)
+{
+    AJ_Status status = AJ_OK;
+    TimerEngine* engine = &props->engine;
+    uint32_t msgId = 0;
+    CdmPropChangedTarget target = { 0, 0, 0 };
+    AJ_Message msg;
+    AJ_Arg array, strc;
+    int32_t values[NUMBER_OF_COUNTDOWN_PROPERTIES];
+    bool changed = false;
+    int i = 0;
+
+    UpdateTimerProperties(props);
+    GetCountdownValues(props, values);
+    for (i = 0; i < NUMBER_OF_COUNTDOWN_PROPERTIES; i++) {
+        if (values[i] != engine->published[i]) {
+            changed = true;
+        }
+    }
+    if (!changed) {
+        return AJ_OK;
+    }
+
+    status = MakePropChangedId(engine->objPath, &msgId);
+    while (status == AJ_OK && CdmNextPropChangedTarget(msgId, &target)) {
+        AJ_MarshalSignal(busAttachment, &msg, msgId, NULL, target.sessionId, target.flags, 0);
+        AJ_MarshalArgs(&msg, "s", intfDescOperationTimer[0]+1); //To remove '$'
+        AJ_MarshalContainer(&msg, &array, AJ_ARG_ARRAY);
+        for (i = 0; i < NUMBER_OF_COUNTDOWN_PROPERTIES; i++) {
+            if (values[i] != engine->published[i]) {
+                AJ_MarshalContainer(&msg, &strc, AJ_ARG_DICT_ENTRY);
+                AJ_MarshalArgs(&msg, "sv", countdownPropertyNames[i], "i", values[i]);
+                AJ_MarshalCloseContainer(&msg, &strc);
+            }
+        }
+        AJ_MarshalCloseContainer(&msg, &array);
+        AJ_MarshalContainer(&msg, &array, AJ_ARG_ARRAY);
+        AJ_MarshalCloseContainer(&msg, &array);
+        status = AJ_DeliverMsg(&msg);
+    }
+    if (status == AJ_OK) {
+        memcpy(engine->published, values, sizeof(values));
+    }
+
+    return status;
+}
+
+static void EmitTimerExpired(AJ_BusAttachment* busAttachment, CdmTimer* timer, void* context)
+{
+    EmitCountdownPropertiesChanged(busAttachment, (TimerProperties*)context);
+}
+
+static void TargetTimeReached(AJ_BusAttachment* busAttachment, TimerProperties* props, TimerTargetTime targetTime)
+{
+    TimerEngine* engine = &props->engine;
+
+    if (targetTime == TIMER_TARGET_TIME_TO_START) {
+        props->targetTimeToStart = (int32_t)TIMER_FEATURE_NOT_APPLIED;
+    } else {
+        props->targetTimeToStop = (int32_t)TIMER_FEATURE_NOT_APPLIED;
+    }
+    EmitCountdownPropertiesChanged(busAttachment, props);
+
+    if (engine->handler) {
+        engine->handler(busAttachment, engine->objPath, targetTime);
+    }
+}
+
+static void StartTimerExpired(AJ_BusAttachment* busAttachment, CdmTimer* timer, void* context)
+{
+    TimerEngine* engine = &((TimerProperties*)context)->engine;
+
+    if (engine->startPending > 0) {
+        ScheduleTargetTime(timer, &engine->startPending, engine->startPending);
+        return;
+    }
+    TargetTimeReached(busAttachment, (TimerProperties*)context, TIMER_TARGET_TIME_TO_START);
+}
+
+static void StopTimerExpired(AJ_BusAttachment* busAttachment, CdmTimer* timer, void* context)
+{
+    TimerEngine* engine = &((TimerProperties*)context)->engine;
+
+    if (engine->stopPending > 0) {
+        ScheduleTargetTime(timer, &engine->stopPending, engine->stopPending);
+        return;
+    }
+    TargetTimeReached(busAttachment, (TimerProperties*)context, TIMER_TARGET_TIME_TO_STOP);
+}
+
+AJ_Status TimerInterfaceEmitPropertiesChanged(AJ_BusAttachment* busAttachment, const char* objPath, void* properties, uint8_t memberIndex)
+{
+    AJ_Status status = AJ_OK;
+    TimerProperties* props = (TimerProperties*)properties;
+
+    if (!props) {
+        return AJ_ERR_INVALID;
+    }
+
+    switch (memberIndex) {
+    case 2 :
+        status = EmitPropChanged(busAttachment, objPath, "TargetTimeToStart", "i", &(props->targetTimeToStart));
+        break;
+    case 3 :
+        status = EmitPropChanged(busAttachment, objPath, "TargetTimeToStop", "i", &(props->targetTimeToStop));
+        break;
+    default:
+        status = AJ_ERR_INVALID;
+    }
+
+    return status;
+}
+
 AJ_Status TimerInterfaceOnGetProperty(AJ_Message* replyMsg, const char* objPath, void* properties, uint8_t memberIndex, void* listener)
 {
     AJ_Status status = AJ_OK;
@@ -113,6 +414,7 @@ AJ_Status TimerInterfaceOnGetProperty(AJ_Message* replyMsg, const char* objPath,
         lt = (TimerListener*)listener;
     }
     props = (TimerProperties*)properties;
+    UpdateTimerProperties(props);
 
     switch (memberIndex) {
     case 0 :
@@ -123,7 +425,8 @@ AJ_Status TimerInterfaceOnGetProperty(AJ_Message* replyMsg, const char* objPath,
             int32_t referenceTimer;
             if (lt && lt->OnGetReferenceTimer) {
                 status = lt->OnGetReferenceTimer(objPath, &referenceTimer);
-                if (status == AJ_OK) {
+                if (status == AJ_OK && !CdmIsReplyDeferred()) {
+                    CdmMarkValuePulled();
                     props->referenceTimer = referenceTimer;
                 }
             }
@@ -135,7 +438,8 @@ AJ_Status TimerInterfaceOnGetProperty(AJ_Message* replyMsg, const char* objPath,
             int32_t targetTimeToStart;
             if (lt && lt->OnGetTargetTimeToStart) {
                 status = lt->OnGetTargetTimeToStart(objPath, &targetTimeToStart);
-                if (status == AJ_OK) {
+                if (status == AJ_OK && !CdmIsReplyDeferred()) {
+                    CdmMarkValuePulled();
                     props->targetTimeToStart = targetTimeToStart;
                 }
             }
@@ -147,7 +451,8 @@ AJ_Status TimerInterfaceOnGetProperty(AJ_Message* replyMsg, const char* objPath,
             int32_t targetTimeToStop;
             if (lt && lt->OnGetTargetTimeToStop) {
                 status = lt->OnGetTargetTimeToStop(objPath, &targetTimeToStop);
-                if (status == AJ_OK) {
+                if (status == AJ_OK && !CdmIsReplyDeferred()) {
+                    CdmMarkValuePulled();
                     props->targetTimeToStop = targetTimeToStop;
                 }
             }
@@ -159,7 +464,8 @@ AJ_Status TimerInterfaceOnGetProperty(AJ_Message* replyMsg, const char* objPath,
             int32_t estimatedTimeToEnd;
             if (lt && lt->OnGetEstimatedTimeToEnd) {
                 status = lt->OnGetEstimatedTimeToEnd(objPath, &estimatedTimeToEnd);
-                if (status == AJ_OK) {
+                if (status == AJ_OK && !CdmIsReplyDeferred()) {
+                    CdmMarkValuePulled();
                     props->estimatedTimeToEnd = estimatedTimeToEnd;
                 }
             }
@@ -171,7 +477,8 @@ AJ_Status TimerInterfaceOnGetProperty(AJ_Message* replyMsg, const char* objPath,
             int32_t runningTime;
             if (lt && lt->OnGetRunningTime) {
                 status = lt->OnGetRunningTime(objPath, &runningTime);
-                if (status == AJ_OK) {
+                if (status == AJ_OK && !CdmIsReplyDeferred()) {
+                    CdmMarkValuePulled();
                     props->runningTime = runningTime;
                 }
             }
@@ -183,7 +490,8 @@ AJ_Status TimerInterfaceOnGetProperty(AJ_Message* replyMsg, const char* objPath,
             int32_t targetDuration;
             if (lt && lt->OnGetTargetDuration) {
                 status = lt->OnGetTargetDuration(objPath, &targetDuration);
-                if (status == AJ_OK) {
+                if (status == AJ_OK && !CdmIsReplyDeferred()) {
+                    CdmMarkValuePulled();
                     props->targetDuration = targetDuration;
                 }
             }
@@ -197,64 +505,86 @@ AJ_Status TimerInterfaceOnGetProperty(AJ_Message* replyMsg, const char* objPath,
     return status;
 }
 
+static AJ_Status SetTargetTime(AJ_Message* msg, const char* objPath, TimerListener* lt, TimerProperties* props, uint8_t memberIndex, CdmPropertiesChangedByMethod* propChangedByMethod)
+{
+    AJ_Status status = AJ_OK;
+    AJ_Status listenerStatus = AJ_OK;
+    ErrorCode errorCode = NOT_ERROR;
+    AJ_Message reply;
+    int32_t targetTime;
+
+    status = AJ_UnmarshalArgs(msg, "i", &targetTime);
+    if (status != AJ_OK) {
+        return status;
+    }
+
+    if (memberIndex == 2) {
+        if (lt && lt->OnSetTargetTimeToStart) {
+            listenerStatus = lt->OnSetTargetTimeToStart(objPath, targetTime, &errorCode);
+        }
+    } else {
+        if (lt && lt->OnSetTargetTimeToStop) {
+            listenerStatus = lt->OnSetTargetTimeToStop(objPath, targetTime, &errorCode);
+        }
+    }
+    if (CdmIsReplyDeferred()) {
+        return listenerStatus;
+    }
+    if (listenerStatus == AJ_OK && props->engine.enabled && !IsTimeValue(targetTime) &&
+        targetTime != (int32_t)TIMER_FEATURE_NOT_APPLIED) {
+        listenerStatus = AJ_ERR_INVALID;
+        errorCode = INVALID_VALUE;
+    }
+
+    AJ_MarshalReplyMsg(msg, &reply);
+    if (listenerStatus != AJ_OK) {
+        AJ_MarshalErrorMsgWithInfo(msg, &reply, GetInterfaceErrorName(errorCode), GetInterfaceErrorMessage(errorCode));
+    }
+    status = AJ_DeliverMsg(&reply);
+
+    //The engine keeps the accepted value and counts it down
+    if (status == AJ_OK && listenerStatus == AJ_OK && props->engine.enabled) {
+        if (memberIndex == 2) {
+            props->targetTimeToStart = targetTime;
+        } else {
+            props->targetTimeToStop = targetTime;
+        }
+        ApplyTimerValue(props, memberIndex);
+        propChangedByMethod->member_index_mask |= (1 << memberIndex);
+    }
+
+    return status;
+}
+
 AJ_Status TimerInterfaceOnMethodHandler(AJ_Message* msg, const char* objPath, uint8_t memberIndex, void* listener, CdmPropertiesChangedByMethod* propChangedByMethod)
 {
     AJ_Status status = AJ_OK;
+    TimerListener* lt = NULL;
+    TimerProperties* props = NULL;
 
-    if (!listener) {
+    if (!propChangedByMethod || !propChangedByMethod->properties) {
         return AJ_ERR_INVALID;
     }
 
-    if (!propChangedByMethod) {
+    props = (TimerProperties*)propChangedByMethod->properties;
+    if (!listener && !props->engine.enabled) {
         return AJ_ERR_INVALID;
     }
-
-    TimerListener* lt = (TimerListener*)listener;
+    lt = (TimerListener*)listener;
 
     switch (memberIndex) {
     case 7 :
-        if (!lt->OnSetTargetTimeToStart) {
+        if (!props->engine.enabled && !lt->OnSetTargetTimeToStart) {
             status = AJ_ERR_NULL;
         } else {
-            int32_t targetTimeToStart;
-
-            status = AJ_UnmarshalArgs(msg, "i", &targetTimeToStart);
-
-            if (status == AJ_OK) {
-                ErrorCode errorCode = NOT_ERROR;
-                AJ_Message reply;
-                status = lt->OnSetTargetTimeToStart(objPath, targetTimeToStart, &errorCode);
-
-                if (status == AJ_OK) {
-                    AJ_MarshalReplyMsg(msg, &reply);
-                } else {
-                    AJ_MarshalReplyMsg(msg, &reply);
-                    AJ_MarshalErrorMsgWithInfo(msg, &reply, GetInterfaceErrorName(errorCode), GetInterfaceErrorMessage(errorCode));
-                }
-                status = AJ_DeliverMsg(&reply);
-            }
+            status = SetTargetTime(msg, objPath, lt, props, 2, propChangedByMethod);
         }
         break;
     case 8 :
-        if (!lt->OnSetTargetTimeToStop) {
+        if (!props->engine.enabled && !lt->OnSetTargetTimeToStop) {
             status = AJ_ERR_NULL;
         } else {
-            int32_t targetTimeToStop;
-
-            status = AJ_UnmarshalArgs(msg, "i", &targetTimeToStop);
-            if (status == AJ_OK) {
-                ErrorCode errorCode = NOT_ERROR;
-                AJ_Message reply;
-                status = lt->OnSetTargetTimeToStop(objPath, targetTimeToStop, &errorCode);
-
-                if (status == AJ_OK) {
-                    AJ_MarshalReplyMsg(msg, &reply);
-                } else {
-                    AJ_MarshalReplyMsg(msg, &reply);
-                    AJ_MarshalErrorMsgWithInfo(msg, &reply, GetInterfaceErrorName(errorCode), GetInterfaceErrorMessage(errorCode));
-                }
-                status = AJ_DeliverMsg(&reply);
-            }
+            status = SetTargetTime(msg, objPath, lt, props, 3, propChangedByMethod);
         }
         break;
     default:
@@ -275,6 +605,7 @@ AJ_Status Cdm_TimerInterfaceGetReferenceTimer(const char* objPath, int32_t* refe
 
     props = (TimerProperties*)GetProperties(objPath, TIMER_INTERFACE);
     if (props) {
+        UpdateTimerProperties(props);
         *referenceTimer = props->referenceTimer;
     } else {
         status = AJ_ERR_NO_MATCH;
@@ -293,8 +624,14 @@ AJ_Status Cdm_TimerInterfaceSetReferenceTimer(AJ_BusAttachment* busAttachment, c
     }
 
     props = (TimerProperties*)GetProperties(objPath, TIMER_INTERFACE);
+    if (!props) {
+        return AJ_ERR_NO_MATCH;
+    }
+
+    UpdateTimerProperties(props);
     if (props->referenceTimer != referenceTimer) {
         props->referenceTimer = referenceTimer;
+        ApplyTimerValue(props, 1);
 
         status = EmitPropChanged(busAttachment, objPath, "ReferenceTimer", "i", &(props->referenceTimer));
     } else {
@@ -315,6 +652,7 @@ AJ_Status Cdm_TimerInterfaceGetTargetTimeToStart(const char* objPath, int32_t* t
 
     props = (TimerProperties*)GetProperties(objPath, TIMER_INTERFACE);
     if (props) {
+        UpdateTimerProperties(props);
         *targetTimeToStart = props->targetTimeToStart;
     } else {
         status = AJ_ERR_NO_MATCH;
@@ -333,8 +671,14 @@ AJ_Status Cdm_TimerInterfaceSetTargetTimeToStart(AJ_BusAttachment* busAttachment
     }
 
     props = (TimerProperties*)GetProperties(objPath, TIMER_INTERFACE);
+    if (!props) {
+        return AJ_ERR_NO_MATCH;
+    }
+
+    UpdateTimerProperties(props);
     if (props->targetTimeToStart != targetTimeToStart) {
         props->targetTimeToStart = targetTimeToStart;
+        ApplyTimerValue(props, 2);
 
         status = EmitPropChanged(busAttachment, objPath, "TargetTimeToStart", "i", &(props->targetTimeToStart));
     } else {
@@ -355,6 +699,7 @@ AJ_Status Cdm_TimerInterfaceGetTargetTimeToStop(const char* objPath, int32_t* ta
 
     props = (TimerProperties*)GetProperties(objPath, TIMER_INTERFACE);
     if (props) {
+        UpdateTimerProperties(props);
         *targetTimeToStop = props->targetTimeToStop;
     } else {
         status = AJ_ERR_NO_MATCH;
@@ -373,8 +718,14 @@ AJ_Status Cdm_TimerInterfaceSetTargetTimeToStop(AJ_BusAttachment* busAttachment,
     }
 
     props = (TimerProperties*)GetProperties(objPath, TIMER_INTERFACE);
+    if (!props) {
+        return AJ_ERR_NO_MATCH;
+    }
+
+    UpdateTimerProperties(props);
     if (props->targetTimeToStop != targetTimeToStop) {
         props->targetTimeToStop = targetTimeToStop;
+        ApplyTimerValue(props, 3);
 
         status = EmitPropChanged(busAttachment, objPath, "TargetTimeToStop", "i", &(props->targetTimeToStop));
     } else {
@@ -395,6 +746,7 @@ AJ_Status Cdm_TimerInterfaceGetEstimatedTimeToEnd(const char* objPath, int32_t*
 
     props = (TimerProperties*)GetProperties(objPath, TIMER_INTERFACE);
     if (props) {
+        UpdateTimerProperties(props);
         *estimatedTimeToEnd = props->estimatedTimeToEnd;
     } else {
         status = AJ_ERR_NO_MATCH;
@@ -413,8 +765,14 @@ AJ_Status Cdm_TimerInterfaceSetEstimatedTimeToEnd(AJ_BusAttachment* busAttachmen
     }
 
     props = (TimerProperties*)GetProperties(objPath, TIMER_INTERFACE);
+    if (!props) {
+        return AJ_ERR_NO_MATCH;
+    }
+
+    UpdateTimerProperties(props);
     if (props->estimatedTimeToEnd != estimatedTimeToEnd) {
         props->estimatedTimeToEnd = estimatedTimeToEnd;
+        ApplyTimerValue(props, 4);
 
         status = EmitPropChanged(busAttachment, objPath, "EstimatedTimeToEnd", "i", &(props->estimatedTimeToEnd));
     } else {
@@ -435,6 +793,7 @@ AJ_Status Cdm_TimerInterfaceGetRunningTime(const char* objPath, int32_t* running
 
     props = (TimerProperties*)GetProperties(objPath, TIMER_INTERFACE);
     if (props) {
+        UpdateTimerProperties(props);
         *runningTime = props->runningTime;
     } else {
         status = AJ_ERR_NO_MATCH;
@@ -453,8 +812,14 @@ AJ_Status Cdm_TimerInterfaceSetRunningTime(AJ_BusAttachment* busAttachment, cons
     }
 
     props = (TimerProperties*)GetProperties(objPath, TIMER_INTERFACE);
+    if (!props) {
+        return AJ_ERR_NO_MATCH;
+    }
+
+    UpdateTimerProperties(props);
     if (props->runningTime != runningTime) {
         props->runningTime = runningTime;
+        ApplyTimerValue(props, 5);
 
         status = EmitPropChanged(busAttachment, objPath, "RunningTime", "i", &(props->runningTime));
     } else {
@@ -475,6 +840,7 @@ AJ_Status Cdm_TimerInterfaceGetTargetDuration(const char* objPath, int32_t* targ
 
     props = (TimerProperties*)GetProperties(objPath, TIMER_INTERFACE);
     if (props) {
+        UpdateTimerProperties(props);
         *targetDuration = props->targetDuration;
     } else {
         status = AJ_ERR_NO_MATCH;
@@ -493,8 +859,14 @@ AJ_Status Cdm_TimerInterfaceSetTargetDuration(AJ_BusAttachment* busAttachment, c
     }
 
     props = (TimerProperties*)GetProperties(objPath, TIMER_INTERFACE);
+    if (!props) {
+        return AJ_ERR_NO_MATCH;
+    }
+
+    UpdateTimerProperties(props);
     if (props->targetDuration != targetDuration) {
         props->targetDuration = targetDuration;
+        ApplyTimerValue(props, 6);
 
         status = EmitPropChanged(busAttachment, objPath, "TargetDuration", "i", &(props->targetDuration));
     } else {
@@ -504,4 +876,111 @@ AJ_Status Cdm_TimerInterfaceSetTargetDuration(AJ_BusAttachment* busAttachment, c
     return status;
 }
 
+AJ_Status Cdm_TimerInterfaceEnableEngine(const char* objPath, const uint16_t emitInterval, TimerTargetTimeHandler handler)
+{
+    TimerProperties* props = NULL;
+    TimerEngine* engine = NULL;
+    uint32_t now = 0;
 
+    props = (TimerProperties*)GetProperties(objPath, TIMER_INTERFACE);
+    if (!props) {
+        return AJ_ERR_NO_MATCH;
+    }
+
+    engine = &props->engine;
+    if (engine->enabled) {
+        return AJ_ERR_DISALLOWED;
+    }
+
+    now = CdmTimerWheelNow();
+    engine->enabled = true;
+    engine->objPath = objPath;
+    engine->emitInterval = emitInterval;
+    engine->handler = handler;
+    engine->referenceEpoch = now - (uint32_t)props->referenceTimer * 1000;
+    engine->running = false;
+    engine->endScheduled = false;
+    Cdm_TimerWheelInitTimer(&engine->startTimer, StartTimerExpired, props);
+    Cdm_TimerWheelInitTimer(&engine->stopTimer, StopTimerExpired, props);
+    Cdm_TimerWheelInitTimer(&engine->emitTimer, EmitTimerExpired, props);
+    ScheduleTargetTime(&engine->startTimer, &engine->startPending, props->targetTimeToStart);
+    ScheduleTargetTime(&engine->stopTimer, &engine->stopPending, props->targetTimeToStop);
+    GetCountdownValues(props, engine->published);
+    if (emitInterval) {
+        Cdm_TimerWheelSchedule(&engine->emitTimer, (uint32_t)emitInterval * 1000, (uint32_t)emitInterval * 1000);
+    }
+
+    return AJ_OK;
+}
+
+AJ_Status Cdm_TimerInterfaceStartRunning(AJ_BusAttachment* busAttachment, const char* objPath)
+{
+    TimerProperties* props = NULL;
+    TimerEngine* engine = NULL;
+    uint32_t now = 0;
+
+    if (!busAttachment) {
+        return AJ_ERR_INVALID;
+    }
+
+    props = (TimerProperties*)GetProperties(objPath, TIMER_INTERFACE);
+    if (!props) {
+        return AJ_ERR_NO_MATCH;
+    }
+
+    engine = &props->engine;
+    if (!engine->enabled) {
+        return AJ_ERR_DISALLOWED;
+    }
+    if (engine->running) {
+        return AJ_OK;
+    }
+
+    now = CdmTimerWheelNow();
+    engine->running = true;
+    engine->runStart = now;
+    engine->runningTimeBase = IsTimeValue(props->runningTime) ? props->runningTime : 0;
+    props->runningTime = engine->runningTimeBase;
+    engine->endScheduled = IsTimeValue(props->targetDuration);
+    if (engine->endScheduled) {
+        int32_t remaining = props->targetDuration - engine->runningTimeBase;
+
+        if (remaining < 0) {
+            remaining = 0;
+        }
+        engine->endBase = now;
+        engine->endSeconds = remaining;
+        props->estimatedTimeToEnd = remaining;
+    }
+
+    return EmitCountdownPropertiesChanged(busAttachment, props);
+}
+
+AJ_Status Cdm_TimerInterfaceStopRunning(AJ_BusAttachment* busAttachment, const char* objPath)
+{
+    TimerProperties* props = NULL;
+    TimerEngine* engine = NULL;
+
+    if (!busAttachment) {
+        return AJ_ERR_INVALID;
+    }
+
+    props = (TimerProperties*)GetProperties(objPath, TIMER_INTERFACE);
+    if (!props) {
+        return AJ_ERR_NO_MATCH;
+    }
+
+    engine = &props->engine;
+    if (!engine->enabled) {
+        return AJ_ERR_DISALLOWED;
+    }
+    if (!engine->running) {
+        return AJ_OK;
+    }
+
+    UpdateTimerProperties(props);
+    engine->running = false;
+    engine->endScheduled = false;
+
+    return EmitCountdownPropertiesChanged(busAttachment, props);
+}
@@ -14,8 +14,8 @@
  *    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
  ******************************************************************************/
 
-#ifndef TIMER_H_
-#define TIMER_H_
+#ifndef TIMERIMPL_H_
+#define TIMERIMPL_H_
 
 #include <ajtcl/alljoyn.h>
 
@@ -23,7 +23,10 @@ const char* const intfDescOperationTimer[11];
 
 AJ_Status CreateTimerInterface(void** properties);
 void DestroyTimerInterface(void* properties);
+AJ_Status TimerInterfaceSaveProperties(void* properties, CdmSnapshotWriter* writer);
+AJ_Status TimerInterfaceLoadProperties(void* properties, CdmSnapshotReader* reader);
 AJ_Status TimerInterfaceOnGetProperty(AJ_Message* replyMsg, const char* objPath, void* properties, uint8_t memberIndex, void* listener);
+AJ_Status TimerInterfaceEmitPropertiesChanged(AJ_BusAttachment* busAttachment, const char* objPath, void* properties, uint8_t memberIndex);
 AJ_Status TimerInterfaceOnMethodHandler(AJ_Message* msg, const char* objPath, uint8_t memberIndex, void* listener, CdmPropertiesChangedByMethod* propChangedByMethod);
 
-#endif /* TIMER_H_ */
+#endif /* TIMERIMPL_H_ */